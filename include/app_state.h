@@ -4,6 +4,10 @@
 #include <SDL3/SDL.h>
 #include <stdbool.h>
 
+// --- Project Includes ---
+#include "../include/sim_rng.h"
+#include "../include/sim_tuning.h"
+
 /**
  * @brief Enum defining different game states.
  */
@@ -26,6 +30,15 @@ typedef struct EntityManager_s *EntityManager;
 typedef struct BaseManagerState_s *BaseManagerState;
 typedef struct TowerManagerState_s *TowerManagerState;
 typedef struct HUDManager_s *HUDManager;
+typedef struct SimClock_s *SimClock;
+typedef struct SpatialHash_s *SpatialHash;
+typedef struct EcsWorld_s *EcsWorld;
+typedef struct JobSystem_s *JobSystem;
+typedef struct DamageBus_s *DamageBus;
+typedef struct CommandBuffer_s *CommandBuffer;
+typedef struct FlowField_s *FlowField;
+typedef struct NavGrid_s *NavGrid;
+typedef struct DesyncDetector_s *DesyncDetector;
 
 // --- Main Application State Structure ---
 
@@ -46,15 +59,29 @@ typedef struct AppState
     Uint64 server_start_time;
     Uint64 client_start_time;
     Uint64 sync_clock;
+    SimClock clock; /**< Source of all simulation and network time. Virtual in the test harness. */
+    float sim_step;        /**< Fixed simulation step in seconds (1 / --sim-hz). */
+    float sim_accumulator; /**< Elapsed time not simulated yet, in seconds. */
+    float render_alpha;    /**< sim_accumulator / sim_step: how far rendering is past the last step (0..1). */
+    bool uncapped_render;  /**< Skip frame pacing (--uncapped, or --vsync where the display paces). */
+    int job_workers;       /**< Worker threads for the simulation (--jobs); 0 runs it on the main thread only. */
+    SimRng rng[SIM_RNG_STREAM_COUNT]; /**< Seeded random streams, one per system (SimRngStream); no system draws from them yet. */
+    SimTuning tuning;                 /**< Balance values of the match (damage); see SimTuning_SetDefaults. */
 
     // --- Core State ---
     bool is_server;
+    bool headless; /**< No window: keyboard and mouse input are skipped and frames are never presented. */
     bool quit_requested;
     bool team;
     GameState currentGameState;
 
     bool winningTeam;
 
+    // --- Transport ---
+    const char *shm_name;  /**< Shared-memory segment name from --shm, or NULL to use TCP only. */
+    bool shm_only;         /**< Server: do not open the TCP port, so several servers can run in one process. */
+    bool resolve_all_hits; /**< Server with bots instead of clients: resolve the hits of every player's attacks, which no owner reports. */
+
     // --- Module State Pointers (ADTs) ---
     EntityManager entity_manager;
     MapState map_state;
@@ -67,4 +94,12 @@ typedef struct AppState
     BaseManagerState base_manager;
     TowerManagerState tower_manager;
     HUDManager HUD_manager;
+    SpatialHash spatial_hash;     /**< Broad phase for all collision and proximity queries. */
+    EcsWorld world;               /**< Component storage for buildings; iterated by the shared systems. */
+    JobSystem jobs;               /**< Thread pool the minion, tower and attack updates split their work across. */
+    DamageBus damage_bus;         /**< Hits of the current step, applied together after the simulation. */
+    CommandBuffer command_buffer; /**< Spawns, despawns and game state changes waiting for the sync point. */
+    FlowField flow_field;         /**< Per-team lane directions the minions steer by. */
+    NavGrid nav_grid;             /**< Point-to-point paths across the map for player-sized agents. */
+    DesyncDetector desync_detector; /**< Compares the world hashes of server and clients. */
 } AppState;
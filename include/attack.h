@@ -15,16 +15,23 @@
 #include "../include/camera.h"
 #include "../include/base.h"
 #include "../include/tower.h"
+#include "../include/spatial_hash.h"
+#include "../include/slot_map.h"
 
 // --- Constants ---
-#define MAX_ATTACKS 100 /**< Maximum number of concurrent attacks allowed. */
+#define MAX_ATTACKS 100 /**< Initial size of the attack pool; it grows on demand up to ATTACK_MAX_CAPACITY. */
+#define ATTACK_HANDLE_INDEX_BITS 16
+#define ATTACK_HANDLE_GENERATION_BITS 16
+#define ATTACK_MAX_CAPACITY (1 << ATTACK_HANDLE_INDEX_BITS) /**< Hard limit on concurrent attacks. */
+#define ATTACK_MAX_HITS 32 /**< Maximum number of objects a single impact can damage. */
+#define ATTACK_SWEEP_CHUNK 16 /**< Attacks swept per job; fewer run on the calling thread. */
 
 #define PLAYER_ATTACK_SPRITE_FRAME_WIDTH 48
 #define PLAYER_ATTACK_SPRITE_FRAME_HEIGHT 48
 #define PLAYER_ATTACK_RENDER_WIDTH 33.0f
 #define PLAYER_ATTACK_RENDER_HEIGHT 39.0f
 #define ATTACK_SPEED 100.0f           /**< Speed in pixels/second for attacks. */
-#define PLAYER_ATTACK_HIT_RANGE 10.0f /**< Collision radius for attacks. */
+#define PLAYER_ATTACK_HIT_RANGE 10.0f /**< Radius around the target at which the flight ends. */
 
 #define PLAYER_ATTACK_SPRITE_NUM_FRAMES 10
 #define PLAYER_ATTACK_SPRITE_TIME_PER_FRAME 0.1f
@@ -41,6 +48,47 @@
  */
 typedef struct AttackManager_s *AttackManager;
 
+// --- Structures ---
+
+/**
+ * @brief Represents a single active attack instance in the game world.
+ * Plain data: the texture follows from the team when drawing, so snapshots can copy it.
+ */
+typedef struct AttackInstance
+{
+    // --- Common Data ---
+    bool active;          /**< Whether this attack slot is currently in use and updated/rendered. */
+    uint32_t id;          /**< Slot map handle assigned by the server; also names the slot. */
+    AttackType type;      /**< The type of attack. */
+    uint8_t owner_id;     /**< The client ID of the player who launched the attack. */
+    SDL_FPoint position;  /**< World position (center) at impact, filled in when the impact resolves. */
+    SDL_FPoint start_pos; /**< World position (center) the attack was launched from. */
+    SDL_FPoint target;
+    SDL_FPoint velocity;  /**< Current velocity vector (pixels per second). */
+    float angle_deg;      /**< Current rendering angle in degrees. */
+    float render_width;   /**< Width used for rendering. */
+    float render_height;  /**< Height used for rendering. */
+    float hit_range;      /**< Radius or bounding box size used for collision detection. */
+    ObjectType attacker;
+    SDL_FRect sprite_portion; /**< The source rect defining the current animation frame. */
+    float spawn_time;         /**< AttackManager clock (seconds) when the attack was spawned. */
+    float impact_time;        /**< AttackManager clock (seconds) when the attack reaches its target unless it hits something first. */
+    bool team;
+} AttackInstance;
+
+/**
+ * @brief Fixed part of the AttackManager's state in a world snapshot.
+ * Impacts are scheduled by impact_time, so the attacks and the clock are all there is.
+ * The variable part (see AttackManager_GetStateSize) follows in the snapshot's data block:
+ * slot_words words of slot map state, then one AttackInstance per live attack in dense-list order.
+ */
+typedef struct AttackSnapshot
+{
+    float sim_time;   /**< AttackManager clock. */
+    int slot_words;   /**< Words of slot map state (SlotMap_SaveState) in the variable part. */
+    int record_count; /**< AttackInstances in the variable part. */
+} AttackSnapshot;
+
 // --- Public API Function Declarations ---
 
 /**
@@ -62,17 +110,29 @@ void AttackManager_Destroy(AttackManager am);
 
 /**
  * @brief Handles a spawn message received from the server for a new attack instance.
- * Finds an available slot and initializes the attack based on the received data.
+ * Records the spawn in the CommandBuffer; the attack is created at the next sync point.
+ * Ignored on the server, which spawned the attack already.
  * Called by the NetClient when receiving MSG_TYPE_S_SPAWN_ATTACK.
  * @param am The AttackManager instance.
+ * @param state Pointer to the main AppState.
  * @param data Pointer to the received Msg_ServerSpawnAttackData containing spawn details.
  */
-void AttackManager_HandleServerSpawn(AttackManager am, const Msg_ServerSpawnAttackData *data);
+void AttackManager_HandleServerSpawn(AttackManager am, AppState *state, const Msg_ServerSpawnAttackData *data);
+
+/**
+ * @brief Creates a recorded attack. On the server this assigns the ID and broadcasts the spawn;
+ * on a client it claims the slot named by the attack ID.
+ * Called by the CommandBuffer at the sync point.
+ * @param am The AttackManager instance.
+ * @param state Pointer to the main AppState.
+ * @param data The spawn message (attack_id is ignored on the server).
+ */
+void AttackManager_ApplySpawn(AttackManager am, AppState *state, const Msg_ServerSpawnAttackData *data);
 
 /**
  * @brief Handles a request from a client (forwarded by NetServer) to spawn an attack.
- * Performs validation, calculates start position and velocity, assigns an ID,
- * and requests the NetServer to broadcast the spawn message. Also spawns locally if server.
+ * Performs validation, calculates start position and velocity and records the spawn;
+ * the ID is assigned and the spawn broadcast at the next sync point.
  * @param am The AttackManager instance.
  * @param state The main AppState.
  * @param owner_id The ID of the client requesting the attack.
@@ -83,11 +143,65 @@ void AttackManager_HandleClientSpawnRequest(AttackManager am, AppState *state, u
 
 /**
  * @brief Handles a destroy message received from the server for an existing attack instance.
- * Marks the specified attack as inactive for removal during the next update cycle.
+ * Records the removal; the attack and its pending impact are removed at the next sync point.
  * Called by the NetClient when receiving MSG_TYPE_S_DESTROY_OBJECT if object_type is ATTACK.
  * @param am The AttackManager instance.
+ * @param state Pointer to the main AppState.
  * @param data Pointer to the received Msg_DestroyObjectData containing the object type and ID.
  */
-void AttackManager_HandleDestroyObject(AttackManager am, const Msg_DestroyObjectData *data);
+void AttackManager_HandleDestroyObject(AttackManager am, AppState *state, const Msg_DestroyObjectData *data);
+
+/**
+ * @brief Removes an attack and its pending impact. Called by the CommandBuffer at the sync point.
+ * @param am The AttackManager instance.
+ * @param attack_id The ID of the attack (unknown IDs are ignored).
+ */
+void AttackManager_ApplyDespawn(AttackManager am, uint32_t attack_id);
 
-void AttackManager_ServerSpawnTowerAttack(AttackManager am, AppState *state, AttackType type, SDL_FPoint target_pos, int towerIndex);
\ No newline at end of file
+/**
+ * @brief Grows the attack pool once so a batch of spawns needs no further allocation.
+ * Called by the CommandBuffer before it applies a frame's spawns.
+ * @param am The AttackManager instance.
+ * @param count Number of spawns in the batch.
+ */
+void AttackManager_ReserveSpawns(AttackManager am, int count);
+
+/**
+ * @brief Records a shot from a tower at a target position. Server only.
+ * The attack is created and broadcast at the next sync point.
+ * @param am The AttackManager instance.
+ * @param state The main AppState.
+ * @param type The type of attack (from AttackType enum).
+ * @param target_pos The world position the attack is aimed at.
+ * @param towerIndex The index of the firing tower.
+ */
+void AttackManager_ServerSpawnTowerAttack(AttackManager am, AppState *state, AttackType type, SDL_FPoint target_pos, int towerIndex);
+
+/**
+ * @brief Returns the bytes AttackManager_SaveState writes to its data block right now.
+ * @param am The AttackManager instance.
+ * @return Size of the slot map state plus one AttackInstance per live attack.
+ */
+size_t AttackManager_GetStateSize(AttackManager am);
+
+/**
+ * @brief Copies the live attacks, their slot map and the manager clock into a snapshot.
+ * Call between simulation steps.
+ * @param am The AttackManager instance.
+ * @param out Receives the fixed part of the state.
+ * @param data Receives the variable part; AttackManager_GetStateSize bytes, 4-byte aligned.
+ * @return True on success, false otherwise.
+ * @sa AttackManager_RestoreState
+ */
+bool AttackManager_SaveState(AttackManager am, AttackSnapshot *out, void *data);
+
+/**
+ * @brief Replaces the attacks with a saved state. Attacks spawned since are dropped without
+ * a despawn message; impacts resolve again as they did after the save.
+ * @param am The AttackManager instance.
+ * @param snapshot The fixed part of the saved state.
+ * @param data The variable part written by AttackManager_SaveState.
+ * @return True on success, false if the slot map state is invalid or the pool could not grow to the saved size;
+ *         the attacks are unchanged then.
+ */
+bool AttackManager_RestoreState(AttackManager am, const AttackSnapshot *snapshot, const void *data);
\ No newline at end of file
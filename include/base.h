@@ -4,6 +4,7 @@
 #include "../include/common.h"
 #include "../include/camera.h"
 #include "../include/entity.h"
+#include "../include/ecs.h"
 
 // --- Constants ---
 #define MAX_BASES 2
@@ -20,6 +21,10 @@
 #define BLUE_BASE_PATH "./resources/Sprites/Blue_Team/Castle_Blue.png"
 #define DESTROYED_BASE_PATH "./resources/Sprites/Castle_Destroyed.png"
 
+/** Components of a base entity; shared with towers, so both live in one archetype. */
+#define BASE_COMPONENTS (ECS_MASK(ECS_POSITION) | ECS_MASK(ECS_BOUNDS) | ECS_MASK(ECS_TEAM) | ECS_MASK(ECS_HEALTH) | \
+                         ECS_MASK(ECS_SPRITE) | ECS_MASK(ECS_HEALTH_LABEL) | ECS_MASK(ECS_COLLIDER))
+
 // --- Opaque Pointer Type ---
 /**
  * @brief Opaque handle to the BaseManager state.
@@ -29,16 +34,12 @@ typedef struct BaseManagerState_s *BaseManagerState;
 
 /**
  * @brief State of a single base.
+ * Position, bounds, team, health and sprite are components of the base's entity in state->world.
  */
 typedef struct BaseInstance
 {
     int index;
-    SDL_FRect rect;       /**< Rect for this base. */
-    SDL_FPoint position;  /**< World position (center). */
-    SDL_Texture *texture; /**< Texture for this base. */
-    int current_health;   /**< Current health points. */
-    bool team;            /**< Which team the base belongs to. */
-    bool immune;
+    EcsEntity entity; /**< The base's entity in state->world. */
 } BaseInstance;
 
 /**
@@ -72,11 +73,11 @@ BaseManagerState BaseManager_Init(AppState *state);
 void BaseManager_Destroy(BaseManagerState bm_state);
 
 /**
- * @brief Applies damage to a base, sends damageValue to server and checks if
- * base has been destroyed.
+ * @brief Handles a base whose health ran out: the instance that landed the final hit reports the match result.
+ * Called by the health system once the base's ECS_HEALTH reaches 0; gameplay code pushes a DamageEvent instead.
+ * The sprite system switches to the destroyed texture on its own.
  * @param state Pointer to the main AppState.
- * @param baseIndex The index of the base to apply damage to.
- * @param damageValue The amount of damage to apply.
- * @param sendToServer true if the local client is the one that hit the base.
+ * @param baseIndex The index of the base.
+ * @param local true if this instance landed the hit; it then reports the match result.
  */
-void damageBase(AppState *state, int baseIndex, float damageValue, bool sendToServer);
+void BaseManager_HandleDestroyed(AppState *state, int baseIndex, bool local);
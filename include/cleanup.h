@@ -12,6 +12,7 @@
 #include "../include/camera.h"
 #include "../include/net_server.h"
 #include "../include/net_client.h"
+#include "../include/setup.h"
 
 // --- Function Declarations ---
 
@@ -0,0 +1,42 @@
+#pragma once
+
+// --- SDL/External Library Includes ---
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// --- Public API Function Declarations ---
+//
+// Swept tests for objects that move in a straight line during a step. The moving
+// object is reduced to a segment from its position at the start of the step to its
+// position at the end; grow the obstacle by the mover's half size to sweep a box.
+// Results are fractions of the segment, so they do not depend on the step length.
+
+/**
+ * @brief Finds where a segment first touches an axis-aligned rectangle (slab test).
+ * @param from Start of the segment.
+ * @param to End of the segment.
+ * @param rect The rectangle, edges included.
+ * @param out_t Receives the fraction of the segment (0..1) at the first contact; 0 if from lies inside. May be NULL.
+ * @return True if the segment touches the rectangle, false otherwise.
+ */
+bool Collision_SegmentRect(SDL_FPoint from, SDL_FPoint to, const SDL_FRect *rect, float *out_t);
+
+/**
+ * @brief Finds where a segment first touches a circle.
+ * @param from Start of the segment.
+ * @param to End of the segment.
+ * @param center Center of the circle.
+ * @param radius Radius of the circle, boundary included.
+ * @param out_t Receives the fraction of the segment (0..1) at the first contact; 0 if from lies inside. May be NULL.
+ * @return True if the segment touches the circle, false otherwise.
+ */
+bool Collision_SegmentCircle(SDL_FPoint from, SDL_FPoint to, SDL_FPoint center, float radius, float *out_t);
+
+/**
+ * @brief Grows a rectangle by the given amount on every side.
+ * Sweeping a box of half size extent against rect is the same as sweeping its center against the grown rect.
+ * @param rect The rectangle.
+ * @param extent Half width and half height to add.
+ * @return The grown rectangle.
+ */
+SDL_FRect Collision_InflateRect(const SDL_FRect *rect, SDL_FPoint extent);
@@ -0,0 +1,113 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/entity.h"
+
+// --- Constants ---
+#define COMMAND_BUFFER_INITIAL_CAPACITY 64 /**< Commands allocated up front; doubled on demand. */
+
+// --- Enums ---
+
+/**
+ * @brief Structural changes that wait for the sync point.
+ */
+typedef enum CommandType
+{
+    COMMAND_SPAWN_ATTACK,       /**< attack: the server assigns the ID and broadcasts; clients claim attack_id. */
+    COMMAND_DESPAWN_ATTACK,     /**< id: attack ID. */
+    COMMAND_SPAWN_MINION,       /**< team: server only, spawns at the team's base and broadcasts. */
+    COMMAND_REPLICATE_MINION,   /**< minion: client only, creates a minion the server announced. */
+    COMMAND_APPLY_MINION_STATE, /**< minion_state: client only, adopts a server snapshot, removing minions missing from it. */
+    COMMAND_DESPAWN_MINION,     /**< id: minion handle. */
+    COMMAND_SET_GAME_STATE,     /**< game: new game state and, for GAME_STATE_FINISHED, the winner. */
+    COMMAND_CHECK_WORLD_HASH,   /**< world_hash: client only, compares the world against the server's hashes. */
+    COMMAND_TYPE_COUNT
+} CommandType;
+
+// --- Structures ---
+
+/**
+ * @brief One recorded request. Only the union member named by the type is valid.
+ */
+typedef struct Command
+{
+    CommandType type;
+    union
+    {
+        Msg_ServerSpawnAttackData attack;
+        Msg_MinionSpawn minion;
+        Msg_MinionStateBatch minion_state;
+        Msg_WorldHash world_hash;
+        uint32_t id;
+        bool team;
+        struct
+        {
+            GameState state;
+            bool winning_team;
+        } game;
+    };
+} Command;
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to the command buffer.
+ * Network handlers and simulation code record spawns, despawns and game state changes here
+ * instead of editing the pools they may be iterating. The buffer is applied once per frame at
+ * the sync point, ENTITY_PHASE_POST_SIM after the damage bus, in the order the commands were
+ * recorded. Attack spawns of one frame are allocated together before any of them is applied.
+ * Commands must be recorded from the main thread.
+ */
+typedef struct CommandBuffer_s *CommandBuffer;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Initializes the command buffer and registers its entity functions.
+ * Register it after the damage bus, whose resolve pass records minion deaths and match results,
+ * and before the HUD.
+ * @param state Pointer to the main AppState (provides entity manager).
+ * @return A new CommandBuffer instance on success, NULL on failure.
+ * @sa CommandBuffer_Destroy
+ */
+CommandBuffer CommandBuffer_Init(AppState *state);
+
+/**
+ * @brief Destroys the CommandBuffer instance. Pending commands are dropped.
+ * @param cb The CommandBuffer instance (NULL is ignored).
+ * @sa CommandBuffer_Init
+ */
+void CommandBuffer_Destroy(CommandBuffer cb);
+
+/**
+ * @brief Records a command for the next sync point.
+ * @param cb The CommandBuffer instance.
+ * @param command The command; copied into the buffer.
+ * @return True if the command was recorded, false if memory ran out.
+ */
+bool CommandBuffer_Record(CommandBuffer cb, const Command *command);
+
+/**
+ * @brief Records a game state change for the next sync point.
+ * @param cb The CommandBuffer instance.
+ * @param game_state The new game state.
+ * @param winning_team The winner, used when game_state is GAME_STATE_FINISHED.
+ * @return True if the command was recorded, false if memory ran out.
+ */
+bool CommandBuffer_SetGameState(CommandBuffer cb, GameState game_state, bool winning_team);
+
+/**
+ * @brief Applies every recorded command in order and empties the buffer.
+ * Runs automatically from the entity update; commands recorded while it runs are applied too.
+ * @param cb The CommandBuffer instance.
+ * @param state Pointer to the main AppState.
+ */
+void CommandBuffer_Flush(CommandBuffer cb, AppState *state);
+
+/**
+ * @brief Drops every recorded command without applying it.
+ * Used when the world is put back to a saved state, which the recorded commands no longer belong to.
+ * @param cb The CommandBuffer instance (NULL is ignored).
+ */
+void CommandBuffer_Clear(CommandBuffer cb);
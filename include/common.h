@@ -19,6 +19,9 @@
 #include "../include/app_state.h"
 #include "../include/entity.h"
 #include "../include/network_messages.h"
+#include "../include/sim_clock.h"
+#include "../include/sim_math.h"
+#include "../include/job_system.h"
 
 // --- Universal Constants ---
 #define MAX_NAME_LENGTH 64
@@ -29,9 +32,6 @@
 #define BLUE_TEAM 0
 #define RED_TEAM 1
 
-#define CLIFF_BOUNDARY 304.0f
-#define WATER_BOUNDARY 1432.0f
-
 #define BUILDINGS_POS_Y 850.0f // All buildings have the same Y position
 
 #define WINDOW_W 1280
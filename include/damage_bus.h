@@ -0,0 +1,105 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/entity.h"
+
+// --- Constants ---
+#define DAMAGE_BUS_INITIAL_CAPACITY 64 /**< Events allocated up front; doubled on demand. */
+
+// --- Enums ---
+
+/**
+ * @brief Kind of object a damage event is aimed at. Also sent on the wire in Msg_DamageBatch.
+ */
+typedef enum DamageTargetKind
+{
+    DAMAGE_TARGET_MINION = 0,
+    DAMAGE_TARGET_TOWER = 1,
+    DAMAGE_TARGET_BASE = 2,
+    DAMAGE_TARGET_PLAYER = 3,
+    DAMAGE_TARGET_KIND_COUNT
+} DamageTargetKind;
+
+// --- Structures ---
+
+/**
+ * @brief One hit waiting for the resolve pass.
+ * Local events were caused by this instance and are replicated; remote events arrived in a
+ * damage batch from another instance and are only applied.
+ */
+typedef struct DamageEvent
+{
+    Uint8 kind;    /**< DamageTargetKind. */
+    bool remote;   /**< Received from the network rather than caused locally. */
+    Uint16 target; /**< Index in the owning manager, or the minion handle for remote minion events. */
+    float amount;  /**< Damage to apply. */
+    float health;  /**< Remote tower events: the tower's health after the hit on the sender. */
+} DamageEvent;
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to the damage bus.
+ * Attacks, minions and network handlers push damage events during the step instead of
+ * changing health directly. A single resolve pass in ENTITY_PHASE_POST_SIM applies them in
+ * the order they were pushed through the ECS health system (Systems_ApplyDamage), which handles
+ * immunity and hands destruction to the owning managers, and sends every locally caused hit of
+ * the step in one MSG_TYPE_C_DAMAGE_BATCH.
+ * Pushes must come from the main thread; jobs collect their hits and push them afterwards.
+ */
+typedef struct DamageBus_s *DamageBus;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Initializes the damage bus and registers its entity functions.
+ * Register it before the HUD so a match decided in the resolve pass shows on the same frame.
+ * @param state Pointer to the main AppState (provides entity manager).
+ * @return A new DamageBus instance on success, NULL on failure.
+ * @sa DamageBus_Destroy
+ */
+DamageBus DamageBus_Init(AppState *state);
+
+/**
+ * @brief Destroys the DamageBus instance. Pending events are dropped.
+ * @param bus The DamageBus instance (NULL is ignored).
+ * @sa DamageBus_Init
+ */
+void DamageBus_Destroy(DamageBus bus);
+
+/**
+ * @brief Queues a hit caused by this instance.
+ * @param bus The DamageBus instance.
+ * @param kind Kind of the target.
+ * @param target Index of the target in its manager (pool slot for minions).
+ * @param amount Damage to apply.
+ * @return True if the event was queued, false if memory ran out.
+ */
+bool DamageBus_Push(DamageBus bus, DamageTargetKind kind, int target, float amount);
+
+/**
+ * @brief Queues a hit received from another instance. It is applied but not sent again.
+ * @param bus The DamageBus instance.
+ * @param kind Kind of the target.
+ * @param target Index of the target in its manager, or the handle for minions.
+ * @param amount Damage to apply.
+ * @param health Tower health after the hit on the sender (ignored for other kinds).
+ * @return True if the event was queued, false if memory ran out.
+ */
+bool DamageBus_PushRemote(DamageBus bus, DamageTargetKind kind, int target, float amount, float health);
+
+/**
+ * @brief Applies every queued event in order and sends the step's damage batch.
+ * Runs automatically from the entity update; call it directly to flush before a state change.
+ * @param bus The DamageBus instance.
+ * @param state Pointer to the main AppState.
+ */
+void DamageBus_Resolve(DamageBus bus, AppState *state);
+
+/**
+ * @brief Drops every queued event and the unsent batch without applying them.
+ * Used when the world is put back to a saved state, which the queued hits no longer belong to.
+ * @param bus The DamageBus instance (NULL is ignored).
+ */
+void DamageBus_Clear(DamageBus bus);
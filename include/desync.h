@@ -0,0 +1,66 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/world.h"
+
+// --- Constants ---
+#define DESYNC_CHECK_INTERVAL_MS 1000 /**< Minimum time between two world hashes sent by the server. */
+#define DESYNC_HISTORY 4              /**< Server only: snapshots kept for the reports of the last checks. */
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to the desync detector.
+ * About once a second the server hashes its world right after a minion state batch, keeps a
+ * snapshot and sends the hashes. Clients compare them against their own world at the sync
+ * point that applies the same batch. A section that disagrees is reported once: the client
+ * writes its snapshot to desync_<time>_client<id>.world and asks the server to write the
+ * matching one to desync_<time>_server.world.
+ */
+typedef struct DesyncDetector_s *DesyncDetector;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Initializes the desync detector and registers its entity functions.
+ * Register it after the MinionManager, so its network-out update runs after the state batch.
+ * @param state Pointer to the main AppState (provides entity manager).
+ * @return A new DesyncDetector instance on success, NULL on failure.
+ * @sa Desync_Destroy
+ */
+DesyncDetector Desync_Init(AppState *state);
+
+/**
+ * @brief Destroys the DesyncDetector instance.
+ * @param dd The DesyncDetector instance (NULL is ignored).
+ * @sa Desync_Init
+ */
+void Desync_Destroy(DesyncDetector dd);
+
+/**
+ * @brief Client-side: records a world hash from the server for the next sync point,
+ * where the state batch sent before it is applied too.
+ * @param state Pointer to the main AppState.
+ * @param data The received hashes.
+ */
+void Desync_HandleWorldHash(AppState *state, const Msg_WorldHash *data);
+
+/**
+ * @brief Client-side: compares the server's hashes against the local world. Called by the CommandBuffer.
+ * Minions must match on every check, since both sides hash the same batch. The other sections
+ * can lag behind messages still in flight (hits on buildings, the match result), so they only
+ * count as out of sync when they disagree on two checks in a row with neither side's value
+ * changing in between.
+ * @param state Pointer to the main AppState.
+ * @param data The recorded hashes.
+ */
+void Desync_CheckWorldHash(AppState *state, const Msg_WorldHash *data);
+
+/**
+ * @brief Server-side: writes the snapshot a client's report refers to, if it is still kept.
+ * @param state Pointer to the main AppState.
+ * @param client_id ID of the reporting client.
+ * @param data The received report.
+ */
+void Desync_HandleReport(AppState *state, uint8_t client_id, const Msg_DesyncReport *data);
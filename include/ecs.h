@@ -0,0 +1,190 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/slot_map.h"
+#include "../include/spatial_hash.h"
+
+// --- Constants ---
+#define ECS_MAX_ARCHETYPES 32          /**< Distinct component combinations a world can hold. */
+#define ECS_ARCHETYPE_INITIAL_ROWS 16  /**< Rows allocated when an archetype is first used; doubled on demand. */
+#define ECS_INITIAL_ENTITIES 64        /**< Entity slots allocated up front; grown on demand. */
+#define ECS_MAX_ENTITIES (1 << 16)     /**< Hard limit on live entities. */
+
+// --- Types ---
+
+/**
+ * @brief Generational handle of an entity. Stale handles stop resolving once the entity is destroyed.
+ */
+typedef SlotHandle EcsEntity;
+#define ECS_ENTITY_NONE SLOT_HANDLE_INVALID
+
+/**
+ * @brief Component identifiers. Each names one column type, given in brackets.
+ */
+typedef enum EcsComponent
+{
+    ECS_POSITION,      /**< [SDL_FPoint] World position (center). */
+    ECS_BOUNDS,        /**< [SDL_FRect] World-space collision bounds. */
+    ECS_TEAM,          /**< [bool] Owning team. */
+    ECS_HEALTH,        /**< [EcsHealth] Hit points. */
+    ECS_SPRITE,        /**< [EcsSprite] Texture drawn centered on the position. */
+    ECS_HEALTH_LABEL,  /**< [EcsHealthLabel] HUD text showing the health above the sprite. */
+    ECS_COLLIDER,      /**< [EcsCollider] Makes the entity visible to the spatial hash. */
+    ECS_PREV_POSITION, /**< [SDL_FPoint] Position at the start of the last simulation step, for render interpolation. */
+    ECS_VELOCITY,      /**< [SDL_FPoint] Movement in pixels per second, applied once per step. */
+    ECS_COOLDOWN,      /**< [float] Seconds until the entity may strike again. */
+    ECS_ANIM_TIMER,    /**< [float] Time into the current animation frame. */
+    ECS_ANIM_FRAME,    /**< [Sint32] Current animation frame. */
+    ECS_NET_FROM,      /**< [SDL_FPoint] Replicas: position at the start of the current interpolation. */
+    ECS_NET_TO,        /**< [SDL_FPoint] Replicas: latest position received from the server. */
+    ECS_NET_PROGRESS,  /**< [float] Replicas: interpolation progress from ECS_NET_FROM to ECS_NET_TO (0..1). */
+    ECS_COMPONENT_COUNT
+} EcsComponent;
+
+/**
+ * @brief Set of components, one bit per EcsComponent.
+ */
+typedef Uint32 EcsMask;
+#define ECS_MASK(component) ((EcsMask)1 << (component))
+
+SDL_COMPILE_TIME_ASSERT(ecs_mask_fits_components, ECS_COMPONENT_COUNT <= 32);
+
+// --- Component Structures ---
+
+typedef struct EcsHealth
+{
+    float current; /**< Current health points; at or below 0 the entity counts as destroyed. */
+    float max;     /**< Health at spawn, shown in the label. */
+    bool immune;   /**< Ignores damage while set. */
+} EcsHealth;
+
+typedef struct EcsSprite
+{
+    SDL_Texture *texture;           /**< Drawn while alive. */
+    SDL_Texture *destroyed_texture; /**< Drawn once health reaches 0 (optional). */
+    float width;                    /**< Render width in pixels. */
+    float height;                   /**< Render height in pixels. */
+} EcsSprite;
+
+typedef struct EcsHealthLabel
+{
+    int hud_index;  /**< HUD element that shows the text, -1 if none. */
+    float offset_y; /**< Offset of the text from the sprite's top edge. */
+} EcsHealthLabel;
+
+typedef struct EcsCollider
+{
+    SpatialKind kind; /**< Kind reported in spatial hash entries. */
+    int index;        /**< Index reported in spatial hash entries (the owning manager's index). */
+} EcsCollider;
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to an entity-component world.
+ * Entities with the same set of components share an archetype, which stores each
+ * component as a contiguous column. Queries visit only the archetypes whose set
+ * contains the requested components, so systems loop over packed arrays.
+ */
+typedef struct EcsWorld_s *EcsWorld;
+
+/**
+ * @brief Iterator over the archetypes matching a query.
+ * After each successful EcsIter_Next, count rows are available: entities[row] and the
+ * columns returned by EcsIter_Column. Do not add, remove or destroy entities of the
+ * current archetype while iterating.
+ */
+typedef struct EcsIter
+{
+    EcsWorld world;
+    EcsMask all;               /**< Components every match must have. */
+    EcsMask none;              /**< Components no match may have. */
+    int archetype;             /**< Current archetype (internal). */
+    int count;                 /**< Rows in the current archetype. */
+    const EcsEntity *entities; /**< Entity of each row. */
+} EcsIter;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Creates an empty world.
+ * @return A new EcsWorld on success, NULL on failure (use SDL_GetError()).
+ * @sa EcsWorld_Destroy
+ */
+EcsWorld EcsWorld_Create(void);
+
+/**
+ * @brief Destroys the world and all its entities. Textures referenced by components are not freed.
+ * @param world The EcsWorld instance (NULL is ignored).
+ */
+void EcsWorld_Destroy(EcsWorld world);
+
+/**
+ * @brief Creates an entity with the given components, all zero-initialized.
+ * @param world The EcsWorld instance.
+ * @param components The component set.
+ * @return The new entity, or ECS_ENTITY_NONE on failure (use SDL_GetError()).
+ */
+EcsEntity Ecs_CreateEntity(EcsWorld world, EcsMask components);
+
+/**
+ * @brief Destroys an entity. Its handle stops resolving.
+ * @param world The EcsWorld instance.
+ * @param entity The entity.
+ * @return True if the entity was alive.
+ */
+bool Ecs_DestroyEntity(EcsWorld world, EcsEntity entity);
+
+/**
+ * @brief Adds components to an entity, moving it to the matching archetype.
+ * New components are zero-initialized; existing ones keep their values.
+ * @param world The EcsWorld instance.
+ * @param entity The entity.
+ * @param components Components to add.
+ * @return True on success.
+ */
+bool Ecs_AddComponents(EcsWorld world, EcsEntity entity, EcsMask components);
+
+/**
+ * @brief Removes components from an entity, moving it to the matching archetype.
+ * @param world The EcsWorld instance.
+ * @param entity The entity.
+ * @param components Components to remove.
+ * @return True on success.
+ */
+bool Ecs_RemoveComponents(EcsWorld world, EcsEntity entity, EcsMask components);
+
+/**
+ * @brief Returns a pointer to one component of an entity.
+ * The pointer is valid until an entity of the same archetype is created, destroyed or moved.
+ * @param world The EcsWorld instance.
+ * @param entity The entity.
+ * @param component The component.
+ * @return The component, or NULL if the entity is dead or lacks it.
+ */
+void *Ecs_Get(EcsWorld world, EcsEntity entity, EcsComponent component);
+
+/**
+ * @brief Starts a query. Call EcsIter_Next before reading the first archetype.
+ * @param world The EcsWorld instance.
+ * @param all Components every match must have.
+ * @param none Components no match may have (0 for no filter).
+ * @return The iterator.
+ */
+EcsIter Ecs_Query(EcsWorld world, EcsMask all, EcsMask none);
+
+/**
+ * @brief Advances to the next non-empty matching archetype.
+ * @param it The iterator.
+ * @return False when no archetype is left.
+ */
+bool EcsIter_Next(EcsIter *it);
+
+/**
+ * @brief Returns the column of a component in the current archetype.
+ * @param it The iterator.
+ * @param component A component that is part of the query's "all" set.
+ * @return The column (it->count elements), or NULL if the archetype lacks the component.
+ */
+void *EcsIter_Column(const EcsIter *it, EcsComponent component);
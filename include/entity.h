@@ -6,6 +6,56 @@
 // --- Constants ---
 #define MAX_MANAGED_ENTITIES 100
 
+/** Bit of a GameState in EntityFunctions.game_states. */
+#define ENTITY_IN_STATE(game_state) (1u << (game_state))
+#define ENTITY_IN_ALL_STATES (ENTITY_IN_STATE(GAME_STATE_LOBBY) | ENTITY_IN_STATE(GAME_STATE_PLAYING) | ENTITY_IN_STATE(GAME_STATE_FINISHED))
+
+// --- Enums ---
+
+/**
+ * @brief Phases of a frame, run in this order.
+ * Update callbacks run in the simulation phases (INPUT .. NETWORK_OUT) once per fixed step,
+ * render callbacks in the render phases (PRE_RENDER .. HUD) once per frame. Within a phase,
+ * entities run in registration order.
+ */
+typedef enum EntityPhase
+{
+    ENTITY_PHASE_INPUT,       /**< Local input is sampled. */
+    ENTITY_PHASE_NETWORK_IN,  /**< Received messages are applied. */
+    ENTITY_PHASE_SIMULATE,    /**< The game simulation. */
+    ENTITY_PHASE_POST_SIM,    /**< Reactions to the finished step. */
+    ENTITY_PHASE_NETWORK_OUT, /**< State is replicated to the peers. */
+    ENTITY_PHASE_PRE_RENDER,  /**< View setup that must precede drawing (camera). */
+    ENTITY_PHASE_RENDER,      /**< The world is drawn. */
+    ENTITY_PHASE_HUD,         /**< Overlays are drawn on top of the world. */
+    ENTITY_PHASE_COUNT
+} EntityPhase;
+
+#define ENTITY_FIRST_RENDER_PHASE ENTITY_PHASE_PRE_RENDER
+
+/**
+ * @brief Shared state an entity's callbacks touch, as bit flags for EntityFunctions.reads/writes.
+ * Consecutive entities of a phase whose declarations do not conflict may run concurrently.
+ */
+typedef enum EntityResource
+{
+    ENTITY_RES_NETWORK = 1 << 0,      /**< Sockets, the transport and everything their message handlers touch. */
+    ENTITY_RES_INPUT = 1 << 1,        /**< Keyboard and mouse state. */
+    ENTITY_RES_RENDERER = 1 << 2,     /**< state->renderer and its textures. */
+    ENTITY_RES_HUD = 1 << 3,          /**< HUD elements. */
+    ENTITY_RES_CAMERA = 1 << 4,       /**< Camera position. */
+    ENTITY_RES_MAP = 1 << 5,          /**< Map data. */
+    ENTITY_RES_SPATIAL_HASH = 1 << 6, /**< The spatial hash. */
+    ENTITY_RES_WORLD = 1 << 7,        /**< Components in state->world. */
+    ENTITY_RES_PLAYERS = 1 << 8,      /**< The player manager. */
+    ENTITY_RES_MINIONS = 1 << 9,      /**< The minion manager. */
+    ENTITY_RES_ATTACKS = 1 << 10,     /**< The attack manager. */
+    ENTITY_RES_TOWERS = 1 << 11,      /**< Tower state outside the world (cooldowns, destroyed flags). */
+    ENTITY_RES_GAME_STATE = 1 << 12,  /**< currentGameState and winningTeam. */
+    ENTITY_RES_DAMAGE = 1 << 13,      /**< Events queued on the damage bus. */
+    ENTITY_RES_ALL = (1 << 14) - 1,
+} EntityResource;
+
 // --- Opaque Pointer Type ---
 /**
  * @brief Opaque handle to the EntityManager state.
@@ -24,6 +74,12 @@ typedef struct EntityFunctions
 {
     const char *name; /**< Unique name for identifying this entity type. */
 
+    EntityPhase update_phase; /**< Simulation phase the update callback runs in. */
+    EntityPhase render_phase; /**< Render phase the render callback runs in. */
+    Uint32 game_states;       /**< ENTITY_IN_STATE bits of the game states update and render run in; 0 means GAME_STATE_PLAYING only. */
+    Uint32 reads;             /**< EntityResource flags the callbacks read. */
+    Uint32 writes;            /**< EntityResource flags the callbacks modify. If reads and writes are both 0, the entity conflicts with everything. */
+
     /**
      * @brief Optional function called when the EntityManager is destroyed.
      * Used by the entity/module to free its specific resources.
@@ -56,6 +112,16 @@ typedef struct EntityFunctions
 
 } EntityFunctions;
 
+/**
+ * @brief Time one entity spent in its callbacks while profiling was on.
+ */
+typedef struct EntityProfile
+{
+    const char *name; /**< Registered name of the entity. */
+    Uint64 time_ns;   /**< Wall time of its update and render callbacks. Entities of one batch overlap when they run concurrently. */
+    Uint64 calls;     /**< Number of callback runs. */
+} EntityProfile;
+
 // --- Public API Function Declarations ---
 
 /**
@@ -77,7 +143,8 @@ void EntityManager_Destroy(EntityManager manager, AppState *state);
 
 /**
  * @brief Adds a new entity definition (set of callbacks) to the manager.
- * The manager stores these definitions and calls their functions during the main loop.
+ * The manager stores these definitions and calls their functions during the main loop,
+ * and rebuilds its phase schedule to include them.
  * @param manager The EntityManager instance.
  * @param funcs A pointer to an EntityFunctions struct defining the entity's behavior.
  * @return True on success, false on failure (e.g., manager is full or name conflict).
@@ -94,19 +161,32 @@ bool EntityManager_Add(EntityManager manager, const EntityFunctions *funcs);
 void EntityManager_HandleEventsAll(EntityManager manager, AppState *state, SDL_Event *event);
 
 /**
- * @brief Calls the update function for all registered entities that have one.
+ * @brief Runs one simulation step: the update callbacks of every simulation phase in order,
+ * skipping entities that are not enabled in the current game state.
+ * Non-conflicting neighbours within a phase run concurrently on state->jobs.
  * @param manager The EntityManager instance.
  * @param state Pointer to the main AppState.
  */
 void EntityManager_UpdateAll(EntityManager manager, AppState *state);
 
 /**
- * @brief Calls the render function for all registered entities that have one.
+ * @brief Renders one frame: the render callbacks of every render phase in order,
+ * skipping entities that are not enabled in the current game state.
  * @param manager The EntityManager instance.
  * @param state Pointer to the main AppState.
  */
 void EntityManager_RenderAll(EntityManager manager, AppState *state);
 
+/**
+ * @brief Runs the callbacks of a single phase (update callbacks for simulation phases,
+ * render callbacks for render phases). EntityManager_UpdateAll and EntityManager_RenderAll
+ * run every phase through this.
+ * @param manager The EntityManager instance.
+ * @param state Pointer to the main AppState.
+ * @param phase The phase to run.
+ */
+void EntityManager_RunPhase(EntityManager manager, AppState *state, EntityPhase phase);
+
 /**
  * @brief Finds an entity definition by its registered name.
  * Primarily for debugging or specific lookup needs.
@@ -116,3 +196,20 @@ void EntityManager_RenderAll(EntityManager manager, AppState *state);
  * @warning Do not modify the returned structure.
  */
 const EntityFunctions *EntityManager_FindDefinition(EntityManager manager, const char *name);
+
+/**
+ * @brief Starts or stops timing every callback. Starting clears the collected times.
+ * Off by default; while off, callbacks run without reading the clock.
+ * @param manager The EntityManager instance.
+ * @param enabled Whether to time the callbacks.
+ */
+void EntityManager_SetProfiling(EntityManager manager, bool enabled);
+
+/**
+ * @brief Returns the times collected since profiling was last started, in registration order.
+ * @param manager The EntityManager instance.
+ * @param out Receives one entry per registered entity.
+ * @param max_out Length of out.
+ * @return Number of entries written.
+ */
+int EntityManager_GetProfile(EntityManager manager, EntityProfile *out, int max_out);
@@ -0,0 +1,58 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/map.h"
+#include "../include/collision.h"
+
+// --- Constants ---
+#define FLOW_FIELD_CELL_SIZE 16.0f   /**< Cell edge in pixels: one map tile. */
+#define FLOW_FIELD_BLOCKED_FACTOR 100 /**< Cost multiplier for entering a blocked cell; only paid to walk out of one. */
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to the lane flow fields.
+ * One field per team over a grid of map tiles. Every cell stores the direction towards the
+ * nearest live enemy building, following the terrain of the map's collision layer and
+ * walking around friendly towers and ruins. Baked once at load and again whenever a tower
+ * falls; between bakes lookups only read the grid, so job-system workers may run them concurrently.
+ */
+typedef struct FlowField_s *FlowField;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Creates the flow fields and bakes them for the current buildings.
+ * Needs the map and every building, so initialize it after the tower manager.
+ * @param state Pointer to the main AppState (provides map, world and building managers).
+ * @param clearance Half width and half height of the units that follow the field; obstacles
+ *                  are grown by it so the whole body stays clear of them.
+ * @return A new FlowField instance on success, NULL on failure.
+ * @sa FlowField_Destroy
+ */
+FlowField FlowField_Init(AppState *state, SDL_FPoint clearance);
+
+/**
+ * @brief Destroys the FlowField instance.
+ * @param ff The FlowField instance (NULL is ignored).
+ * @sa FlowField_Init
+ */
+void FlowField_Destroy(FlowField ff);
+
+/**
+ * @brief Rebuilds both teams' fields from the terrain and the current state of the buildings.
+ * Call it from the main thread, outside the simulation jobs, after a building is destroyed.
+ * @param ff The FlowField instance.
+ * @param state Pointer to the main AppState.
+ */
+void FlowField_Bake(FlowField ff, AppState *state);
+
+/**
+ * @brief Looks up the direction a unit should move in.
+ * @param ff The FlowField instance.
+ * @param team Team of the unit.
+ * @param position World position of the unit (clamped to the map).
+ * @return Unit vector towards the nearest live enemy building, or {0, 0} once the unit has reached one.
+ */
+SDL_FPoint FlowField_GetDirection(FlowField ff, bool team, SDL_FPoint position);
@@ -15,6 +15,7 @@
 #include "../include/camera.h"
 #include "../include/net_server.h"
 #include "../include/net_client.h"
+#include "../include/setup.h"
 #include "../include/update.h"
 #include "../include/render.h"
 #include "../include/iterate.h"
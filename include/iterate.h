@@ -13,7 +13,8 @@
 
 /**
  * @brief Waits for the appropriate time to maintain the target frame rate.
- * Called by SDL_AppIterate in init.c.
+ * Called by SDL_AppIterate unless rendering is uncapped or vsynced. Only limits
+ * rendering; the simulation rate is fixed by state->sim_step.
  * @param appstate Void pointer to the main AppState struct.
  */
 void app_wait_for_next_frame(void *appstate);
@@ -0,0 +1,105 @@
+#pragma once
+
+// --- SDL/External Library Includes ---
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// --- Constants ---
+#define JOB_SYSTEM_AUTO_WORKERS (-1) /**< Worker count meaning one worker per logical core besides the caller's. */
+#define JOB_SYSTEM_MAX_WORKERS 31    /**< Hard limit on worker threads. */
+#define JOB_QUEUE_CAPACITY 256       /**< Jobs each queue holds; a submit to a full queue runs the job inline. */
+#define JOB_MAX_CHUNKS 64            /**< Upper bound on the chunks of one JobSystem_ParallelFor. */
+
+// --- Types ---
+
+/**
+ * @brief A unit of work. Runs on a worker or on a thread waiting in JobSystem_Wait.
+ */
+typedef void (*JobFunc)(void *data);
+
+/**
+ * @brief The body of a parallel loop, called once per chunk with the half-open range [begin, end).
+ */
+typedef void (*JobRangeFunc)(void *data, int begin, int end);
+
+/**
+ * @brief Counts the unfinished jobs of a group. Zero-initialize it, pass it to every submit of the
+ * group and wait on it with JobSystem_Wait. Owned by the caller; it must outlive the jobs.
+ */
+typedef struct JobCounter
+{
+    SDL_AtomicInt pending;
+} JobCounter;
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to a work-stealing thread pool.
+ * Every worker, plus the thread that created the pool, owns a job queue. A thread takes the
+ * newest job from its own queue and, when that is empty, steals the oldest job from another
+ * queue, so work spreads across cores without a shared central list. Waiting threads run jobs
+ * instead of blocking, which makes nested waits safe.
+ */
+typedef struct JobSystem_s *JobSystem;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Creates the pool and starts its workers.
+ * @param worker_count Worker threads to start (0 runs every job on the waiting thread),
+ *        or JOB_SYSTEM_AUTO_WORKERS. Clamped to JOB_SYSTEM_MAX_WORKERS.
+ * @return A new JobSystem on success, NULL on failure (use SDL_GetError()).
+ * @sa JobSystem_Destroy
+ */
+JobSystem JobSystem_Create(int worker_count);
+
+/**
+ * @brief Stops the workers and destroys the pool. Jobs still queued are dropped; wait for them first.
+ * @param js The JobSystem instance (NULL is ignored).
+ */
+void JobSystem_Destroy(JobSystem js);
+
+/**
+ * @brief Returns the number of worker threads (not counting the creating thread).
+ * @param js The JobSystem instance (NULL counts as 0).
+ */
+int JobSystem_GetWorkerCount(JobSystem js);
+
+/**
+ * @brief Queues a job on the calling thread's queue.
+ * @param js The JobSystem instance. NULL runs the job immediately.
+ * @param func The job.
+ * @param data Passed to func.
+ * @param counter Incremented now and decremented once the job has run (may be NULL).
+ */
+void JobSystem_Submit(JobSystem js, JobFunc func, void *data, JobCounter *counter);
+
+/**
+ * @brief Queues a job that may only start once another group has finished.
+ * A thread that picks the job up early puts it back and looks for other work.
+ * @param js The JobSystem instance. NULL runs the job immediately.
+ * @param func The job.
+ * @param data Passed to func.
+ * @param after The group to wait for (may be NULL).
+ * @param counter Incremented now and decremented once the job has run (may be NULL).
+ */
+void JobSystem_SubmitAfter(JobSystem js, JobFunc func, void *data, const JobCounter *after, JobCounter *counter);
+
+/**
+ * @brief Runs queued jobs on the calling thread until every job of a group has finished.
+ * @param js The JobSystem instance.
+ * @param counter The group to wait for.
+ */
+void JobSystem_Wait(JobSystem js, JobCounter *counter);
+
+/**
+ * @brief Splits [0, count) into chunks, runs them across the pool and waits for all of them.
+ * Ranges smaller than two chunks of min_chunk run inline on the caller. func must only write
+ * to state owned by its own range; collect side effects per element and apply them afterwards.
+ * @param js The JobSystem instance. NULL runs the whole range inline.
+ * @param count Number of elements.
+ * @param min_chunk Smallest number of elements worth a job of their own.
+ * @param func The loop body.
+ * @param data Passed to func.
+ */
+void JobSystem_ParallelFor(JobSystem js, int count, int min_chunk, JobRangeFunc func, void *data);
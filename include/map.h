@@ -14,6 +14,9 @@
 // --- Constants ---
 #define MAP_TILE_WIDTH 16  /**< Width of a single tile in pixels. */
 #define MAP_TILE_HEIGHT 16 /**< Height of a single tile in pixels. */
+#define MAP_FILE_PATH "./resources/Map/tiledMap.json" /**< Tiled map loaded by Map_Init. */
+#define MAP_COLLISION_LAYER "Collision" /**< Object layer whose rectangles mark terrain nothing can walk on (cliffs, water). */
+#define MAP_MAX_COLLISION_RECTS 64      /**< Maximum number of rectangles read from the collision layer. */
 
 // --- Opaque Pointer Type ---
 /**
@@ -54,3 +57,30 @@ int Map_GetWidthPixels(MapState ms);
  * @return The map height in pixels, or 0 if map state is invalid.
  */
 int Map_GetHeightPixels(MapState ms);
+
+/**
+ * @brief Gets the blocking rectangles read from the map's collision layer.
+ * @param ms The MapState instance.
+ * @param out_rects Receives a pointer to the rectangles (world pixels); valid until the map is destroyed.
+ * @return The number of rectangles, or 0 if map state is invalid.
+ */
+int Map_GetCollisionRects(MapState ms, const SDL_FRect **out_rects);
+
+/**
+ * @brief Reads only the size and the collision layer of a Tiled map, without loading any textures.
+ * For headless tools that need the terrain but have no renderer.
+ * @param map_path Path of the Tiled JSON file.
+ * @param out_rects Receives the rectangles (world pixels); must hold MAP_MAX_COLLISION_RECTS.
+ * @param out_count Receives the number of rectangles.
+ * @param out_size Receives the map size in pixels (may be NULL).
+ * @return True on success, false if the file could not be parsed (use SDL_GetError()).
+ */
+bool Map_LoadCollisionLayer(const char *map_path, SDL_FRect *out_rects, int *out_count, SDL_Point *out_size);
+
+/**
+ * @brief Checks whether a world position lies on blocked terrain.
+ * @param ms The MapState instance.
+ * @param point World position in pixels.
+ * @return True if a rectangle of the collision layer contains the point, false otherwise.
+ */
+bool Map_IsBlocked(MapState ms, SDL_FPoint point);
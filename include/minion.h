@@ -3,8 +3,14 @@
 #include "../include/entity.h"
 #include "../include/common.h"
 #include "../include/net_client.h"
+#include "../include/net_server.h"
 #include "../include/base.h"
 #include "../include/player.h"
+#include "../include/spatial_hash.h"
+#include "../include/flow_field.h"
+#include "../include/sim_kernels.h"
+#include "../include/slot_map.h"
+#include "../include/ecs.h"
 
 #define BLUE_MINION_PATH "./resources/Sprites/Blue_Team/Warrior_Blue.png"
 #define RED_MINION_PATH "./resources/Sprites/Red_Team/Warrior_Red.png"
@@ -12,13 +18,33 @@
 #define MINION_HEIGHT 32.0f
 #define MINION_HEALTH_MAX 100.
 #define MINION_WAVE_AMOUNT 6
-#define MINION_MAX_AMOUNT 24
-#define MINION_ATTACK_COOLDOWN 1000
+#define MINION_INITIAL_CAPACITY 32 /**< Pool slots allocated up front; the pool doubles on demand up to MINION_MAX_AMOUNT. */
+#define MINION_ATTACK_COOLDOWN 1.0f /**< Seconds between two strikes of a minion. */
+#define MINION_HIT_IMMUNITY 0.5f    /**< A minion that struck within this many seconds ignores player attacks. */
 
 #define MINION_SPEED 150.0f
 #define MINION_DAMAGE_VALUE 1.0f
+#define MINION_WAVE_INTERVAL 10000    /**< Time (ms) between two waves. */
+#define MINION_SPAWN_INTERVAL 500     /**< Time (ms) between two minion pairs within a wave. */
+#define MINION_STATE_INTERVAL_MS 50   /**< Interval (ms) between server minion state batches. */
+#define MINION_AI_CHUNK 8             /**< Minions per lane-AI job; smaller pools run on the calling thread. */
+#define MINION_AGGRO_RADIUS 160.0f      /**< Enemy minions and players closer than this draw a minion off its lane. */
+#define MINION_STRIKE_RANGE 28.0f       /**< Center distance at which a minion hits the unit it fights. */
+#define MINION_UNIT_DAMAGE_VALUE 10.0f  /**< Damage of one strike on a minion or player. */
+#define MINION_TARGET_RECHECK_TICKS 6   /**< Simulation steps between two aggro scans (or leash checks) of one minion. */
+#define MINION_AGGRO_CANDIDATES 32      /**< Units an aggro scan considers; the nearest living one wins. */
+#define MINION_LOD_RADIUS 320.0f        /**< A minion with no player, enemy minion or enemy building this close is idle. */
+#define MINION_LOD_IDLE_INTERVAL 4      /**< Simulation steps between two AI updates of an idle minion; staggered by slot. */
+#define MINION_LOD_CAMERA_MARGIN 64.0f  /**< Minions this far outside the camera view still animate, so none pop in frozen. */
 // #define TARGETS 3
 
+// Minion handles come from the manager's SlotMap: the pool slot in the low 11 bits and the slot's
+// generation in the high 5 bits, so they fit the 16-bit handle field of the network messages.
+#define MINION_HANDLE_INDEX_BITS 11
+#define MINION_HANDLE_GENERATION_BITS 5
+#define MINION_HANDLE_SLOT(handle) ((int)((handle) & ((1 << MINION_HANDLE_INDEX_BITS) - 1)))
+#define MINION_MAX_AMOUNT (1 << MINION_HANDLE_INDEX_BITS) /**< Hard limit on concurrent minions, set by the handle's index field. */
+
 #define MINION_SPRITE_FRAME_WIDTH 107.0f
 #define MINION_SPRITE_FRAME_HEIGHT 110.0f
 #define MINION_SPRITE_MOVE (MINION_SPRITE_FRAME_HEIGHT)
@@ -26,37 +52,276 @@
 #define MINION_SPRITE_NUM_FRAMES 6
 #define MINION_SPRITE_TIME_PER_FRAME 0.1f /**< Duration each animation frame is displayed. */
 
+/**
+ * @brief Components of a minion entity on the server. The fields touched every simulation step
+ * (position, velocity, cooldown, animation) are columns of this archetype, so the SimKernel
+ * functions stream them contiguously; ECS_COLLIDER holds the minion's pool slot.
+ */
+#define MINION_COMPONENTS (ECS_MASK(ECS_POSITION) | ECS_MASK(ECS_PREV_POSITION) | ECS_MASK(ECS_BOUNDS) | ECS_MASK(ECS_VELOCITY) | \
+                           ECS_MASK(ECS_TEAM) | ECS_MASK(ECS_HEALTH) | ECS_MASK(ECS_COLLIDER) | ECS_MASK(ECS_COOLDOWN) |        \
+                           ECS_MASK(ECS_ANIM_TIMER) | ECS_MASK(ECS_ANIM_FRAME))
+
+/** Components of a minion entity on clients, which interpolate between the server's state batches. */
+#define MINION_REPLICA_COMPONENTS (MINION_COMPONENTS | ECS_MASK(ECS_NET_FROM) | ECS_MASK(ECS_NET_TO) | ECS_MASK(ECS_NET_PROGRESS))
+
 typedef struct MinionData MinionData;
 typedef struct MinionManager_s *MinionManager;
 
+/**
+ * @brief Per-minion fields that are not components of the minion's entity, indexed by pool slot.
+ * Only read on spawn, contact, replication or rendering.
+ */
 struct MinionData
 {
-    bool team;
-    SDL_FPoint position;      /**< Current world position (center). */
-    SDL_FRect sprite_portion; /**< The source rect defining the current animation frame. */
+    EcsEntity entity;         /**< The minion's entity in state->world, ECS_ENTITY_NONE while the slot is free. */
+    SDL_FRect sprite_portion; /**< Source rect of the current animation row; x is derived from ECS_ANIM_FRAME. */
     SDL_FlipMode flip_mode;   /**< Rendering flip state (horizontal). */
     bool active;              /**< Whether this minion slot is currently in use. */
     bool is_attacking;
-    SDL_Texture *texture;
-    int current_health; /**< Current health points. */
-    float anim_timer;
-    int current_frame;
-    float attack_cooldown_timer;
+    uint16_t handle;          /**< Handle the server assigned to this minion. */
 };
 
+/**
+ * @brief A strike chosen by the minion AI, which runs on the job workers.
+ * The damage bus only takes pushes from the main thread, so they are queued after the jobs finish.
+ */
+typedef struct MinionStrike
+{
+    SpatialKind kind; /**< Kind of the target, 0 if the minion struck nothing this step. */
+    int target;       /**< Index of the target in its manager (pool slot for minions). */
+} MinionStrike;
+
+/**
+ * @brief Server only: the unit a minion fights, kept between steps so the aggro scan does not
+ * have to run every step. Only whether the target still lives is checked every step.
+ */
+typedef struct MinionTarget
+{
+    SpatialKind kind;  /**< SPATIAL_KIND_MINION or SPATIAL_KIND_PLAYER, 0 while the minion follows its lane. */
+    int index;         /**< Pool slot of the minion or index of the player. */
+    uint16_t handle;   /**< Handle of a targeted minion, so a reused slot is not mistaken for it. */
+    int recheck_ticks; /**< Steps until the next aggro scan or leash check; staggered by slot. */
+} MinionTarget;
+
+/**
+ * @brief Server only: how often the AI of a minion runs.
+ * Idle minions walk an empty stretch of lane, keep the velocity of their last update in
+ * between and only check whether something came close. Anything near brings them back to full rate.
+ */
+typedef enum MinionLod
+{
+    MINION_LOD_FULL, /**< AI every step: the minion fights, or a player, enemy or enemy building is near. */
+    MINION_LOD_IDLE  /**< AI every MINION_LOD_IDLE_INTERVAL steps. */
+} MinionLod;
+
 struct MinionManager_s
 {
-    MinionData minions[MINION_MAX_AMOUNT];
-    SDL_Texture *red_texture;
+    EcsWorld world;                 /**< state->world, which holds the minion entities. */
+    EcsMask components;             /**< MINION_COMPONENTS on the server, MINION_REPLICA_COMPONENTS on clients. */
+    MinionData *minions;            /**< Per-minion fields outside the ECS. */
+    SlotMap slots;                  /**< Hands out pool slots and handles; its dense list is the set of active minions. */
+    int capacity;                   /**< Length of every per-slot array, grown with the slot map. */
+    MinionStrike *pending_strikes;  /**< Server only: strikes of the current step, indexed by pool slot. */
+    MinionTarget *targets;          /**< Server only: the unit each minion fights, indexed by pool slot. */
+    Uint8 *ai_lod;                  /**< Server only: MinionLod of each minion, indexed by pool slot. */
+    int *ai_due;                    /**< Server only: pool slots whose AI runs this step. */
+    int ai_due_count;               /**< Server only: valid entries in ai_due. */
+    Uint64 ai_step;                 /**< Server only: simulation steps so far; spreads the idle updates. */
+    int *animate;                   /**< Pool slots near the camera, animated this step. */
+    Uint32 *state_seen;             /**< Client only: server_time of the last state batch that reported each slot. */
+    Uint64 *state_hashes;           /**< World hash of each minion's replicated state, 0 for free slots. */
+    Uint64 state_hash;              /**< XOR of state_hashes, kept up to date wherever that state changes. */
+    Uint32 state_time;              /**< Client only: server_time of the state batches being received. */
+    int state_parts;                /**< Client only: parts of that state received so far. */
+    SDL_Texture *red_texture;  /**< Shared by all minions; picked by team when drawing, so MinionData holds no pointers. */
     SDL_Texture *blue_texture;
     Uint64 minionWaveTimer;
     Uint64 recentMinionTimer;
+    Uint64 lastStateBroadcast; /**< Server only: sync clock of the last minion state batch. */
     int activeMinionAmount;
     int currentMinionWaveAmount;
     bool spawnNextMinion;
 };
 
+/**
+ * @brief One live minion in a world snapshot: its fields from every per-slot array and its components.
+ * Its slot is not stored; it follows from the position in the saved slot map's dense list.
+ * The entity is created anew on restore, so data.entity is left at ECS_ENTITY_NONE.
+ */
+typedef struct MinionRecord
+{
+    MinionData data;
+    MinionTarget target;
+    bool team;
+    EcsHealth health;
+    SDL_FPoint position;
+    SDL_FPoint prev_position;
+    SDL_FPoint velocity;
+    float attack_cooldown;
+    float anim_timer;
+    Sint32 frame;
+    SDL_FPoint net_from; /**< Client only, like net_to and net_progress. */
+    SDL_FPoint net_to;
+    float net_progress;
+    Uint8 ai_lod;
+} MinionRecord;
+
+/**
+ * @brief Fixed part of the MinionManager's state in a world snapshot.
+ * The variable part (see MinionManager_GetStateSize) follows in the snapshot's data block:
+ * slot_words words of slot map state, then one MinionRecord per live minion in dense-list order.
+ * Scratch of a single step (strikes, due list, animation list) is rebuilt every step and left out.
+ */
+typedef struct MinionSnapshot
+{
+    int slot_words;   /**< Words of slot map state (SlotMap_SaveState) in the variable part. */
+    int record_count; /**< MinionRecords in the variable part. */
+    Uint64 ai_step;
+    Uint64 minionWaveTimer;
+    Uint64 recentMinionTimer;
+    Uint64 lastStateBroadcast;
+    int activeMinionAmount;
+    int currentMinionWaveAmount;
+    bool spawnNextMinion;
+} MinionSnapshot;
+
 MinionManager MinionManager_Init(AppState *state);
 void MinionManager_Destroy(MinionManager mm);
-void damageMinion(AppState state, int minionIndex, float damageValue, bool senToServer, float sentCurrentHealth);
+
+/**
+ * @brief Returns the entity of an active minion.
+ * Minion health is a component of it, changed only on the server through the health system
+ * (Systems_ApplyDamage); clients send their hits in a damage batch and the result arrives with
+ * the next minion state batch. The server keeps it as a float, so fractional damage adds up;
+ * only the state batch rounds it (MinionManager_GetReplicatedHealth).
+ * @param mm The MinionManager instance.
+ * @param minionIndex The pool slot of the minion (-1 is allowed and yields ECS_ENTITY_NONE).
+ * @return The entity, or ECS_ENTITY_NONE if the slot is not active.
+ */
+EcsEntity MinionManager_GetEntity(MinionManager mm, int minionIndex);
+
+/**
+ * @brief Takes note of a hit the health system applied to a minion. If the hit killed it, the
+ * server records its removal; the minion leaves the pool at the next sync point.
+ * @param state Pointer to the main AppState.
+ * @param minionIndex The pool slot of the minion.
+ * @param killed True if the hit took the minion's health to 0 or below.
+ */
+void MinionManager_HandleHit(AppState *state, int minionIndex, bool killed);
+
+/**
+ * @brief Returns the handle the server assigned to an active minion.
+ * @param mm The MinionManager instance.
+ * @param minionIndex The pool slot of the minion.
+ * @return The handle, or SLOT_HANDLE_INVALID if the slot is not active.
+ */
+uint16_t MinionManager_GetHandle(MinionManager mm, int minionIndex);
+
+/**
+ * @brief Server only: spawns a minion at its team's base and announces it to all clients.
+ * Called by the CommandBuffer for the wave spawns recorded during the update.
+ * @param state Pointer to the main AppState.
+ * @param team The team of the new minion.
+ */
+void MinionManager_ApplySpawn(AppState *state, bool team);
+
+/**
+ * @brief Removes a minion by handle. Called by the CommandBuffer for recorded deaths.
+ * @param state Pointer to the main AppState.
+ * @param minionHandle The handle of the minion (stale handles are ignored).
+ */
+void MinionManager_ApplyDespawn(AppState *state, uint16_t minionHandle);
+
+/**
+ * @brief Client-side handler for MSG_TYPE_S_MINION_SPAWN.
+ * Records the spawn; the minion is created at the next sync point.
+ * @param state Pointer to the main AppState.
+ * @param data The received spawn message.
+ */
+void MinionManager_HandleServerSpawn(AppState *state, const Msg_MinionSpawn *data);
+
+/**
+ * @brief Client-side: creates a minion announced by the server. Called by the CommandBuffer.
+ * @param state Pointer to the main AppState.
+ * @param data The recorded spawn message.
+ */
+void MinionManager_ApplyReplicatedSpawn(AppState *state, const Msg_MinionSpawn *data);
+
+/**
+ * @brief Client-side handler for MSG_TYPE_S_MINION_STATE.
+ * Records the batch; it is applied at the next sync point.
+ * @param state Pointer to the main AppState.
+ * @param data The received state batch.
+ */
+void MinionManager_HandleStateBatch(AppState *state, const Msg_MinionStateBatch *data);
+
+/**
+ * @brief Client-side: adopts one part of a server snapshot. Called by the CommandBuffer.
+ * Updates interpolation targets, health and flags and spawns unknown minions. Once every part
+ * of the snapshot has arrived, removes the minions none of them reported.
+ * @param state Pointer to the main AppState.
+ * @param data The recorded state batch.
+ */
+void MinionManager_ApplyStateBatch(AppState *state, const Msg_MinionStateBatch *data);
+
 bool MinionManager_GetMinionPosition(MinionManager mm, int minionIndex, SDL_FPoint *out_pos);
+
+/**
+ * @brief Quantized position of a minion as the state batch carries it: the current position on
+ * the server, the last received one on clients. Both sides get the same value after a batch.
+ * @param mm The MinionManager instance.
+ * @param minionIndex Pool slot of the minion.
+ * @param is_server True to read the simulated position, false for the replicated one.
+ * @param out_x Receives the quantized X (see MSG_MINION_POS_SCALE).
+ * @param out_y Receives the quantized Y.
+ */
+void MinionManager_GetReplicatedPosition(MinionManager mm, int minionIndex, bool is_server, uint16_t *out_x, uint16_t *out_y);
+
+/**
+ * @brief Health of a minion as the state batch carries it: rounded up to whole points, so a
+ * living minion never reads 0, and clamped to 0..255. Both sides get the same value after a batch.
+ * @param mm The MinionManager instance.
+ * @param minionIndex Pool slot of the minion.
+ * @return The quantized health, 0 if the slot is not active.
+ */
+uint8_t MinionManager_GetReplicatedHealth(MinionManager mm, int minionIndex);
+
+/**
+ * @brief Returns the minion section of the world hash: one hash per live minion over the fields
+ * and quantization of Msg_MinionStateBatch, XOR-folded. Kept up to date as minions spawn, move,
+ * get hit or receive a state batch, so reading it costs nothing.
+ * @param mm The MinionManager instance.
+ * @return The folded hash, 0 for an empty pool.
+ */
+Uint64 MinionManager_GetStateHash(MinionManager mm);
+
+/**
+ * @brief Returns the bytes MinionManager_SaveState writes to its data block right now.
+ * @param mm The MinionManager instance.
+ * @return Size of the slot map state plus one MinionRecord per live minion.
+ */
+size_t MinionManager_GetStateSize(MinionManager mm);
+
+/**
+ * @brief Copies the live minions, the slot map and the wave timers into a snapshot.
+ * Call between simulation steps.
+ * @param mm The MinionManager instance.
+ * @param out Receives the fixed part of the state.
+ * @param data Receives the variable part; MinionManager_GetStateSize bytes, 4-byte aligned.
+ * @return True on success, false otherwise.
+ * @sa MinionManager_RestoreState
+ */
+bool MinionManager_SaveState(MinionManager mm, MinionSnapshot *out, void *data);
+
+/**
+ * @brief Replaces the minion pool with a saved state, growing it if the save holds more slots.
+ * The saved minions take over the entities of the live ones and overwrite their components; only
+ * the difference in count is created or destroyed.
+ * Clients are not told; a server that rewinds keeps them in step through its next state batch.
+ * @param mm The MinionManager instance.
+ * @param snapshot The fixed part of the saved state.
+ * @param data The variable part written by MinionManager_SaveState.
+ * @return True on success, false if the slot map state is invalid or memory ran out; the pool is
+ *         unchanged then.
+ */
+bool MinionManager_RestoreState(MinionManager mm, const MinionSnapshot *snapshot, const void *data);
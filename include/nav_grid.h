@@ -0,0 +1,133 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/map.h"
+#include "../include/collision.h"
+
+// --- Constants ---
+#define NAV_CLUSTER_SIZE 16         /**< Cluster edge in tiles. */
+#define NAV_ENTRANCE_SPLIT 6        /**< Border openings at least this many tiles wide get an entrance at each end instead of one in the middle. */
+#define NAV_MAX_ROUTE_POINTS 128    /**< Tiles a route may pass: start, cluster entrances and goal. */
+#define NAV_MAX_SEGMENT_POINTS (NAV_CLUSTER_SIZE * NAV_CLUSTER_SIZE) /**< Waypoints of one refined segment; it never leaves its cluster. */
+#define NAV_PATH_CACHE_SIZE 512     /**< Cluster-to-cluster routes kept by the LRU cache. */
+
+// --- Structures ---
+
+/**
+ * @brief A path being followed, owned by the caller (one per agent).
+ * NavGrid_FindPath fills the route through the cluster entrances; NavGrid_NextWaypoint
+ * refines it one segment at a time, so an agent that is redirected never pays for the
+ * rest of its old path.
+ */
+typedef struct NavPath
+{
+    int route[NAV_MAX_ROUTE_POINTS];             /**< Tile indices: the start, the entrances passed and the goal. */
+    int route_count;                             /**< Valid entries in route. */
+    int route_next;                              /**< Route entry the next segment to refine ends at. */
+    SDL_FPoint segment[NAV_MAX_SEGMENT_POINTS];  /**< Waypoints of the current segment (world pixels, tile centers). */
+    int segment_count;                           /**< Valid entries in segment. */
+    int segment_next;                            /**< Next waypoint of segment to hand out. */
+    SDL_FPoint goal;                             /**< Exact goal position; replaces the center of the last tile. */
+} NavPath;
+
+/**
+ * @brief Counters since the grid was created, for tuning the cache.
+ */
+typedef struct NavStats
+{
+    Uint64 queries;      /**< Calls to NavGrid_FindPath. */
+    Uint64 cache_hits;   /**< Queries answered from the route cache. */
+    Uint64 expanded;     /**< Tiles and abstract nodes taken off the open list by all searches. */
+} NavStats;
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to the navigation grid.
+ * Map tiles marked blocked or open, split into square clusters. Neighbouring clusters are
+ * joined by entrances on their shared border, and the shortest path between the entrances
+ * of each cluster is computed once when the grid is built. A query then only searches
+ * the small graph of entrances and refines the result inside one cluster at a time.
+ * The searches share scratch buffers, so use a grid from one thread at a time.
+ */
+typedef struct NavGrid_s *NavGrid;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Creates the navigation grid from the map's collision layer and the buildings.
+ * Buildings never move, and their ruins keep blocking, so the grid is built once.
+ * Initialize it after the tower manager.
+ * @param state Pointer to the main AppState (provides map and world).
+ * @param clearance Half width and half height of the agents; obstacles are grown by it.
+ * @return A new NavGrid instance on success, NULL on failure.
+ * @sa NavGrid_Destroy
+ */
+NavGrid NavGrid_Init(AppState *state, SDL_FPoint clearance);
+
+/**
+ * @brief Creates a navigation grid from a list of blocked rectangles, without an AppState.
+ * @param width Width of the area in pixels.
+ * @param height Height of the area in pixels.
+ * @param blocked Rectangles nothing can walk on (world pixels).
+ * @param blocked_count Number of rectangles.
+ * @param clearance Half width and half height of the agents; the rectangles are grown by it.
+ * @return A new NavGrid instance on success, NULL on failure.
+ * @sa NavGrid_Destroy
+ */
+NavGrid NavGrid_Create(int width, int height, const SDL_FRect *blocked, int blocked_count, SDL_FPoint clearance);
+
+/**
+ * @brief Destroys the NavGrid instance.
+ * @param ng The NavGrid instance (NULL is ignored).
+ * @sa NavGrid_Init
+ */
+void NavGrid_Destroy(NavGrid ng);
+
+/**
+ * @brief Plans a route between two positions through the cluster entrances.
+ * Routes between the same pair of clusters are served from an LRU cache, so later queries
+ * only connect their endpoints to the cached entrances. Cached routes are shortest for the
+ * query that created them and close to it for the others.
+ * @param ng The NavGrid instance.
+ * @param from Start position (world pixels).
+ * @param to Goal position (world pixels).
+ * @param out_path Receives the route; follow it with NavGrid_NextWaypoint.
+ * @return True if a route was found, false if either end is blocked or no route exists.
+ */
+bool NavGrid_FindPath(NavGrid ng, SDL_FPoint from, SDL_FPoint to, NavPath *out_path);
+
+/**
+ * @brief Hands out the next waypoint of a path, refining the next segment when needed.
+ * @param ng The NavGrid instance the path was planned on.
+ * @param path The path being followed.
+ * @param out_point Receives the waypoint (world pixels).
+ * @return True if a waypoint was written, false once the goal has been handed out.
+ */
+bool NavGrid_NextWaypoint(NavGrid ng, NavPath *path, SDL_FPoint *out_point);
+
+/**
+ * @brief Finds a path with plain A* over the whole grid, without clusters or cache.
+ * Cheaper than a route for short hops, and the reference the hierarchical search is measured against.
+ * @param ng The NavGrid instance.
+ * @param from Start position (world pixels).
+ * @param to Goal position (world pixels).
+ * @param out_points Receives the waypoints after the start, ending at to.
+ * @param max_points Capacity of out_points.
+ * @return Number of waypoints written, or -1 if there is no path or it does not fit.
+ */
+int NavGrid_FindDirectPath(NavGrid ng, SDL_FPoint from, SDL_FPoint to, SDL_FPoint *out_points, int max_points);
+
+/**
+ * @brief Drops every cached route.
+ * @param ng The NavGrid instance.
+ */
+void NavGrid_ClearCache(NavGrid ng);
+
+/**
+ * @brief Reads the query counters.
+ * @param ng The NavGrid instance.
+ * @param out_stats Receives the counters.
+ */
+void NavGrid_GetStats(NavGrid ng, NavStats *out_stats);
@@ -7,7 +7,11 @@
 #include "../include/camera.h"
 #include "../include/attack.h"
 #include "../include/entity.h"
+#include "../include/damage_bus.h"
+#include "../include/command_buffer.h"
 #include "../include/hud.h"
+#include "../include/net_transport.h"
+#include "../include/net_shm.h"
 
 // --- Opaque Pointer Type ---
 /**
@@ -49,6 +53,22 @@ int NetClient_GetClientID(NetClientState nc_state);
  */
 bool NetClient_IsConnected(NetClientState nc_state);
 
+/**
+ * @brief Returns the client's receive counters.
+ * @param nc_state The NetClientState instance.
+ * @return Array of NET_MESSAGE_TYPE_COUNT entries indexed by type byte, or NULL.
+ */
+const NetMessageStats *NetClient_GetMessageStats(NetClientState nc_state);
+
+/**
+ * @brief Drops every message the server has sent but the client has not read yet.
+ * For tools that put the world back between matches, so no message of the old match reaches the new one.
+ * A closed connection is left for the next update to notice.
+ * @param nc_state The NetClientState instance.
+ * @return Number of messages dropped.
+ */
+int NetClient_DiscardPending(NetClientState nc_state);
+
 /**
  * @brief Sends a request to the server to spawn an attack.
  * @param nc_state The NetClientState instance.
@@ -59,31 +79,28 @@ bool NetClient_IsConnected(NetClientState nc_state);
  */
 bool NetClient_SendSpawnAttackRequest(NetClientState nc_state, AttackType type, float target_world_x, float target_world_y, bool team);
 
-bool NetClient_SendDamageMinionRequest(NetClientState nc_state, int minionIndex, float sentCurrentHealth);
-
-bool NetClient_SendDamagePlayerRequest(NetClientState nc_state, int playerIndex, float damageValue);
 /**
- * @brief Sends a request to the server to damage a tower.
+ * @brief Sends the hits this client caused during one step to the server, which applies the
+ * minion entries and relays the batch to the other clients.
  * @param nc_state The NetClientState instance.
- * @param towerIndex The index of the tower to apply damage to.
- * @param damageValue The amount of damage to apply to the tower.
- * @return True if the request was sent successfully, false otherwise (e.g., not connected).
+ * @param batch The batch to send (message_type must be MSG_TYPE_C_DAMAGE_BATCH).
+ * @return True if the batch was sent successfully, false otherwise (e.g., not connected).
  */
-bool NetClient_SendDamageTowerRequest(NetClientState nc_state, int towerIndex, float damageValue, float current_health);
+bool NetClient_SendDamageBatch(NetClientState nc_state, const Msg_DamageBatch *batch);
 
 /**
- * @brief Sends a request to the server to damage a base.
+ * @brief Sends the match result to the server.
  * @param nc_state The NetClientState instance.
- * @param baseIndex The index of the base to apply damage to.
- * @param damageValue The amount of damage to apply to the base.
+ * @param winningTeam The team that won the match.
  * @return True if the request was sent successfully, false otherwise (e.g., not connected).
  */
-bool NetClient_SendDamageBaseRequest(NetClientState nc_state, int baseIndex, float damageValue);
+bool NetClient_SendMatchResult(NetClientState nc_state, bool winningTeam);
 
 /**
- * @brief Sends the match result to the server.
+ * @brief Tells the server that the world disagreed with one of its hashes.
  * @param nc_state The NetClientState instance.
- * @param winningTeam The team that won the match.
- * @return True if the request was sent successfully, false otherwise (e.g., not connected).
+ * @param server_time server_time of the hash message that disagreed.
+ * @param sections Bit per WorldHashSection that disagreed.
+ * @return True if the report was sent successfully, false otherwise (e.g., not connected).
  */
-bool NetClient_SendMatchResult(NetClientState nc_state, bool winningTeam);
+bool NetClient_SendDesyncReport(NetClientState nc_state, uint32_t server_time, uint8_t sections);
@@ -4,7 +4,11 @@
 #include "../include/common.h"
 #include "../include/attack.h"
 #include "../include/entity.h"
+#include "../include/damage_bus.h"
+#include "../include/command_buffer.h"
 #include "../include/tower.h"
+#include "../include/net_transport.h"
+#include "../include/net_shm.h"
 
 // --- Opaque Pointer Type ---
 /**
@@ -45,3 +49,27 @@ void NetServer_Destroy(NetServerState ns_state);
  * @param exclude_client_index Index of a client to skip sending to (-1 to broadcast to all).
  */
 void NetServer_BroadcastMessage(NetServerState ns_state, const void *buffer, int length, int exclude_client_index);
+
+/**
+ * @brief Starts the match: switches the host to GAME_STATE_PLAYING and broadcasts
+ * MSG_TYPE_S_GAME_START stamped with the host clock.
+ * Called from the lobby HUD when the host types 'start', and by tools that drive a match directly.
+ * @param state Pointer to the main AppState (must be running as server).
+ */
+void NetServer_StartMatch(AppState *state);
+
+/**
+ * @brief Returns the server's receive counters.
+ * @param ns_state The NetServerState instance.
+ * @return Array of NET_MESSAGE_TYPE_COUNT entries indexed by type byte, or NULL.
+ */
+const NetMessageStats *NetServer_GetMessageStats(NetServerState ns_state);
+
+/**
+ * @brief Drops every message the clients have sent but the server has not read yet.
+ * For tools that put the world back between matches, so no message of the old match reaches the new one.
+ * Closed connections are left for the next update to notice.
+ * @param ns_state The NetServerState instance.
+ * @return Number of messages dropped.
+ */
+int NetServer_DiscardPending(NetServerState ns_state);
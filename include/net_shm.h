@@ -0,0 +1,61 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/net_transport.h"
+
+// --- Constants ---
+#define NET_SHM_RING_SIZE (64 * 1024)       /**< Bytes per direction and client. Must be a power of two. */
+#define NET_SHM_BACKLOG_LIMIT (1024 * 1024) /**< Bytes a sender queues while the ring is full before it gives up on the peer. */
+#define NET_SHM_NAME_PREFIX "/lot_"         /**< Prefix of the POSIX shared-memory object name. */
+#define NET_SHM_LOCAL_PREFIX '@'            /**< Names starting with this stay inside the current process (tests, harness). */
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to a server-side shared-memory segment that local processes attach to.
+ * The segment holds one pair of single-producer/single-consumer rings per client slot.
+ * A write to a full ring is queued on the sender and moved into the ring on its next read or
+ * write, so a peer that skips a frame does not lose messages. A write fails only once
+ * NET_SHM_BACKLOG_LIMIT bytes are waiting, i.e. when the peer has stopped reading.
+ */
+typedef struct NetShmListener_s *NetShmListener;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Checks whether the shared-memory transport is available on this platform.
+ * @return True on POSIX systems, false otherwise. Process-local segments work everywhere.
+ */
+bool NetShm_IsSupported(void);
+
+/**
+ * @brief Creates the shared-memory segment and starts accepting local clients.
+ * @param name Name of the segment, shared with the clients (e.g. "match1"). A name starting with
+ *             NET_SHM_LOCAL_PREFIX ("@harness") creates a heap segment only visible inside this process,
+ *             which works on every platform.
+ * @return A new NetShmListener on success, NULL on failure (use SDL_GetError()).
+ * @sa NetShm_DestroyListener
+ */
+NetShmListener NetShm_CreateListener(const char *name);
+
+/**
+ * @brief Accepts the next client that attached to the segment, if any. Never blocks.
+ * @param listener The NetShmListener instance.
+ * @return A NetConnection for the new client, or NULL if none is waiting.
+ */
+NetConnection NetShm_Accept(NetShmListener listener);
+
+/**
+ * @brief Destroys the segment. New clients can no longer attach; connections still open keep the
+ * memory mapped until they are destroyed and then report the server as closed.
+ * @param listener The NetShmListener instance (NULL is ignored).
+ */
+void NetShm_DestroyListener(NetShmListener listener);
+
+/**
+ * @brief Attaches to a server's shared-memory segment and claims a client slot.
+ * @param name Name of the segment given to NetShm_CreateListener.
+ * @return A connected NetConnection, or NULL on failure (use SDL_GetError()).
+ */
+NetConnection NetShm_Connect(const char *name);
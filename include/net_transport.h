@@ -0,0 +1,94 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+
+// --- Types ---
+
+/**
+ * @brief Identifies the backend carrying a NetConnection.
+ */
+typedef enum NetTransportKind
+{
+    NET_TRANSPORT_TCP = 0, /**< SDL_net stream socket. */
+    NET_TRANSPORT_SHM = 1  /**< Shared-memory ring buffers between processes on the same machine. */
+} NetTransportKind;
+
+/**
+ * @brief Function table implemented by every transport backend.
+ * Each read returns at most one message, which is what the message dispatchers expect.
+ */
+typedef struct NetConnectionOps
+{
+    bool (*write)(void *impl, const void *buffer, int length);  /**< Sends one message. False on failure. */
+    int (*read)(void *impl, void *buffer, int max_length);      /**< Bytes read, 0 if nothing is pending, -1 if the connection closed. */
+    bool (*wait_readable)(void *impl, Sint32 timeout_ms);       /**< Blocks until data is pending or the timeout expires. May be NULL. */
+    void (*destroy)(void *impl);                                /**< Closes the connection and frees the backend state. */
+} NetConnectionOps;
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to a single bidirectional connection, independent of the transport used.
+ */
+typedef struct NetConnection_s *NetConnection;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Wraps backend state into a NetConnection. Used by the transport backends.
+ * @param kind The transport kind of the backend.
+ * @param ops The backend's function table (must outlive the connection).
+ * @param impl Backend state passed to every op. Ownership moves to the connection.
+ * @return A new NetConnection, or NULL on failure (impl is destroyed in that case).
+ */
+NetConnection NetConnection_Create(NetTransportKind kind, const NetConnectionOps *ops, void *impl);
+
+/**
+ * @brief Wraps an SDL_net stream socket into a NetConnection.
+ * Each message travels behind a 2-byte length and the receiver buffers partial messages,
+ * so reads return whole messages like the other backends. Both ends must use this framing.
+ * @param socket The connected stream socket. Ownership moves to the connection.
+ * @return A new NetConnection, or NULL on failure (the socket is destroyed in that case).
+ */
+NetConnection NetConnection_FromStreamSocket(SDLNet_StreamSocket *socket);
+
+/**
+ * @brief Sends a message over the connection.
+ * @param conn The NetConnection instance.
+ * @param buffer Pointer to the data to send.
+ * @param length Number of bytes to send.
+ * @return True on success, false on failure (use SDL_GetError()).
+ */
+bool NetConnection_Write(NetConnection conn, const void *buffer, int length);
+
+/**
+ * @brief Reads pending data from the connection without blocking.
+ * @param conn The NetConnection instance.
+ * @param buffer Destination buffer.
+ * @param max_length Size of the destination buffer.
+ * @return Number of bytes read, 0 if nothing is pending, -1 if the connection is closed.
+ */
+int NetConnection_Read(NetConnection conn, void *buffer, int max_length);
+
+/**
+ * @brief Blocks until data is pending on the connection or the timeout expires.
+ * Meant for bots and tools that do not run a frame loop.
+ * @param conn The NetConnection instance.
+ * @param timeout_ms Maximum wait in milliseconds, -1 to wait indefinitely.
+ * @return True if data is pending, false on timeout or error.
+ */
+bool NetConnection_WaitReadable(NetConnection conn, Sint32 timeout_ms);
+
+/**
+ * @brief Returns the transport kind of the connection.
+ * @param conn The NetConnection instance.
+ * @return The NetTransportKind of the backend.
+ */
+NetTransportKind NetConnection_GetKind(NetConnection conn);
+
+/**
+ * @brief Closes the connection and frees all associated resources.
+ * @param conn The NetConnection instance to destroy (NULL is ignored).
+ */
+void NetConnection_Destroy(NetConnection conn);
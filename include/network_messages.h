@@ -4,43 +4,113 @@
 #include <SDL3/SDL.h>
 #include <stdint.h>
 
+// --- Message Schema ---
+
+/**
+ * @brief Single definition of every network message.
+ * Each entry is X(name, id, payload, direction, requires, relay, handler):
+ * - name:      Suffix of the MSG_TYPE_ enumerator.
+ * - id:        Wire value of the first byte of the packet.
+ * - payload:   Struct sent on the wire; its size is the minimum accepted length.
+ * - direction: C2S (client to server) or S2C (server to client).
+ * - requires:  Connection state the receiver must be in (ANY, ACCEPTED, WELCOMED).
+ * - relay:     Message the server rebroadcasts to the other clients after handling, or INVALID.
+ * - handler:   Static function in the receiving module (net_server.c for C2S, net_client.c
+ *              for S2C), or NULL if the message is only relayed.
+ * Adding a message means adding one line here, the payload struct and its handler.
+ */
+#define NET_MESSAGE_SCHEMA(X)                                                                                             \
+    /* --- Client-to-Server Messages --- */                                                                             \
+    X(C_HELLO, 1, uint8_t, C2S, ACCEPTED, INVALID, server_on_hello)                                                     \
+    X(C_PLAYER_STATE, 2, Msg_PlayerStateData, C2S, WELCOMED, S_PLAYER_STATE, server_on_player_state)                    \
+    X(C_SPAWN_ATTACK, 3, Msg_ClientSpawnAttackData, C2S, WELCOMED, INVALID, server_on_spawn_attack)                     \
+    X(C_DAMAGE_BATCH, 8, Msg_DamageBatch, C2S, WELCOMED, S_DAMAGE_BATCH, server_on_damage_batch)                        \
+    X(C_DESYNC_REPORT, 10, Msg_DesyncReport, C2S, WELCOMED, INVALID, server_on_desync_report)                         \
+    X(C_MATCH_RESULT, 89, Msg_MatchResult, C2S, WELCOMED, S_GAME_RESULT, NULL)                                          \
+    /* --- Server-to-Client Messages --- */                                                                             \
+    X(S_WELCOME, 101, Msg_WelcomeData, S2C, ANY, INVALID, client_on_welcome)                                            \
+    X(S_PLAYER_STATE, 102, Msg_PlayerStateData, S2C, ANY, INVALID, client_on_player_state)                              \
+    X(S_SPAWN_ATTACK, 103, Msg_ServerSpawnAttackData, S2C, ANY, INVALID, client_on_spawn_attack)                        \
+    X(S_MINION_SPAWN, 107, Msg_MinionSpawn, S2C, ANY, INVALID, client_on_minion_spawn)                                  \
+    X(S_MINION_STATE, 108, Msg_MinionStateBatch, S2C, ANY, INVALID, client_on_minion_state)                             \
+    X(S_DAMAGE_BATCH, 109, Msg_DamageBatch, S2C, ANY, INVALID, client_on_damage_batch)                                  \
+    X(S_WORLD_HASH, 110, Msg_WorldHash, S2C, ANY, INVALID, client_on_world_hash)                                        \
+    X(S_GAME_START, 188, Msg_GameStart, S2C, ANY, INVALID, client_on_game_start)                                        \
+    X(S_GAME_RESULT, 189, Msg_MatchResult, S2C, ANY, INVALID, client_on_game_result)                                    \
+    X(S_DESTROY_OBJECT, 198, Msg_DestroyObjectData, S2C, ANY, INVALID, client_on_destroy_object)                        \
+    X(S_PLAYER_DISCONNECT, 199, Msg_PlayerDisconnectData, S2C, ANY, INVALID, client_on_player_disconnect)
+
 // --- Message Type Enum ---
 
 /**
  * @brief Identifies the type of network message being sent or received.
  * The first byte of any network packet should correspond to one of these values.
+ * Generated from NET_MESSAGE_SCHEMA.
  */
 typedef enum MessageType
 {
     MSG_TYPE_INVALID = 0, /**< Should not be used. */
-
-    // --- Client-to-Server Messages ---
-    MSG_TYPE_C_HELLO = 1,         /**< Client introduces itself upon connection. */
-    MSG_TYPE_C_PLAYER_STATE = 2,  /**< Client sends its current state update. */
-    MSG_TYPE_C_SPAWN_ATTACK = 3,  /**< Client requests to spawn an attack. */
-    MSG_TYPE_C_DAMAGE_PLAYER = 4, /**< Client requests to damage a player. */
-    MSG_TYPE_C_DAMAGE_TOWER = 5,  /**< Client requests to damage a tower. */
-    MSG_TYPE_C_DAMAGE_BASE = 6,   /**< Client requests to damage a base. */
-    MSG_TYPE_C_DAMAGE_MINION = 7,  /**< Client sends a request to damage a minion. */
-
-
-    MSG_TYPE_C_MATCH_RESULT = 89, /**< Client sends the match result. */
-
-    // --- Server-to-Client Messages ---
-    MSG_TYPE_S_WELCOME = 101,       /**< Server acknowledges client, assigns ID. */
-    MSG_TYPE_S_PLAYER_STATE = 102,  /**< Server broadcasts another player's state. */
-    MSG_TYPE_S_SPAWN_ATTACK = 103,  /**< Server confirms/broadcasts an attack spawn. */
-    MSG_TYPE_S_DAMAGE_PLAYER = 104, /**< Server confirms/broadcasts damage to a player. */
-    MSG_TYPE_S_DAMAGE_TOWER = 105,  /**< Server confirms/broadcasts damage to a tower. */
-    MSG_TYPE_S_DAMAGE_BASE = 106,   /**< Server confirms/broadcasts damage to a basea. */
-    MSG_TYPE_S_DAMAGE_MINION = 107,  /**< Serever confirms/broadcast damage to minion. */
-
-    MSG_TYPE_S_GAME_START = 188,
-    MSG_TYPE_S_GAME_RESULT = 189,       /**< Server confirms/broadcasts the match result. */
-    MSG_TYPE_S_DESTROY_OBJECT = 198,    /**< Server informs clients an object was destroyed. */
-    MSG_TYPE_S_PLAYER_DISCONNECT = 199, /**< Server informs clients a player disconnected. */
+#define NET_MESSAGE_ENUM_ENTRY(name, id, payload, direction, requires, relay, handler) MSG_TYPE_##name = id,
+    NET_MESSAGE_SCHEMA(NET_MESSAGE_ENUM_ENTRY)
+#undef NET_MESSAGE_ENUM_ENTRY
 } MessageType;
 
+/**
+ * @brief Direction a message travels in.
+ */
+typedef enum NetMessageDirection
+{
+    NET_DIR_C2S = 0, /**< Client to server. */
+    NET_DIR_S2C = 1  /**< Server to client. */
+} NetMessageDirection;
+
+/**
+ * @brief Connection state the receiver must be in for a message to be handled.
+ * On the server this is the sending client's status; on the client ANY is the only value used.
+ */
+typedef enum NetMessageRequirement
+{
+    NET_REQ_ANY = 0,      /**< Always accepted. */
+    NET_REQ_ACCEPTED = 1, /**< Connection accepted, C_HELLO not yet received. */
+    NET_REQ_WELCOMED = 2  /**< Handshake complete. */
+} NetMessageRequirement;
+
+/**
+ * @brief Static properties of one message type, taken from NET_MESSAGE_SCHEMA.
+ */
+typedef struct NetMessageInfo
+{
+    const char *name;      /**< Printable name (e.g. "C_HELLO"). */
+    uint16_t size;         /**< Size of the payload struct in bytes. */
+    uint8_t direction;     /**< NetMessageDirection. */
+    uint8_t requirement;   /**< NetMessageRequirement. */
+    uint8_t relay_type;    /**< Message the server rebroadcasts after handling, or MSG_TYPE_INVALID. */
+} NetMessageInfo;
+
+/**
+ * @brief Per-type receive counters kept by NetServer and NetClient.
+ */
+typedef struct NetMessageStats
+{
+    Uint32 handled; /**< Messages that passed the state and size checks. */
+    Uint32 dropped; /**< Messages rejected for state, size or a failed handler. */
+    Uint64 bytes;   /**< Payload bytes of handled messages. */
+} NetMessageStats;
+
+#define NET_MESSAGE_TYPE_COUNT 256 /**< Lookup tables are indexed by the raw type byte. */
+
+// --- Minion Replication Constants ---
+#define MSG_MINION_BATCH_MAX 24        /**< Maximum number of minions packed into one MSG_TYPE_S_MINION_STATE. */
+#define MSG_MINION_POS_SCALE 8.0f      /**< Quantization scale for minion positions (1/8 pixel precision). */
+#define MSG_MINION_FLAG_TEAM 0x01      /**< Set if the minion belongs to RED_TEAM. */
+#define MSG_MINION_FLAG_ATTACKING 0x02 /**< Set while the minion is attacking a building. */
+
+// --- Damage Replication Constants ---
+#define MSG_DAMAGE_BATCH_MAX 16 /**< Maximum number of damaged targets in one MSG_TYPE_C_DAMAGE_BATCH. */
+
+// --- Desync Detection Constants ---
+#define MSG_WORLD_HASH_SECTIONS 4 /**< Section hashes in one MSG_TYPE_S_WORLD_HASH (see WorldHashSection). */
+
 // --- Attack Type Enum ---
 
 /**
@@ -135,7 +205,7 @@ typedef struct Msg_ServerSpawnAttackData
 {
     uint8_t message_type; /**< Should be MSG_TYPE_S_SPAWN_ATTACK. */
     uint8_t attack_type;  /**< The type of attack (AttackType enum). */
-    uint32_t attack_id;   /**< Unique ID assigned by the server for this attack instance. */
+    uint32_t attack_id;   /**< SlotMap handle assigned by the server for this attack instance. */
     uint8_t owner_id;     /**< Client ID of the player who owns this attack. */
     SDL_FPoint start_pos; /**< Initial world position of the attack. */
     SDL_FPoint target_pos;
@@ -156,49 +226,79 @@ typedef struct Msg_DestroyObjectData
 } Msg_DestroyObjectData;
 
 /**
- * @brief Data structure for Msg_DamagePlayer.
- * Sent from when a player is damaged.
+ * @brief Data structure for MSG_TYPE_C_DAMAGE_BATCH and MSG_TYPE_S_DAMAGE_BATCH.
+ * Every hit one instance caused during a simulation step, one entry per damaged target, packed
+ * as parallel arrays like Msg_MinionStateBatch. Only the first @c count entries are valid.
+ * The server applies the minion entries (it owns minion health) and relays the batch; the
+ * other clients apply the tower, base and player entries.
+ */
+typedef struct Msg_DamageBatch
+{
+    uint8_t message_type;                  /**< MSG_TYPE_C_DAMAGE_BATCH or MSG_TYPE_S_DAMAGE_BATCH. */
+    uint8_t count;                         /**< Number of valid entries. */
+    uint8_t kind[MSG_DAMAGE_BATCH_MAX];    /**< DamageTargetKind of each target. */
+    uint16_t target[MSG_DAMAGE_BATCH_MAX]; /**< Manager index of the target, or the minion handle. */
+    float damage[MSG_DAMAGE_BATCH_MAX];    /**< Total damage dealt to the target during the step. */
+    float health[MSG_DAMAGE_BATCH_MAX];    /**< Towers: health after the hits on the sender. */
+} Msg_DamageBatch;
+
+/**
+ * @brief Data structure for MSG_TYPE_S_MINION_SPAWN.
+ * Sent from the server when it spawns a minion, so clients can create it immediately.
  */
-typedef struct Msg_DamagePlayer
+typedef struct Msg_MinionSpawn
 {
-    uint8_t message_type; /**< Should be MSG_TYPE_S_DAMAGE_PLAYER. */
-    int playerIndex;      /**< The index of the player that got damaged. */
-    float damageValue;    /**< The amount of damage that the player got. */
-} Msg_DamagePlayer;
+    uint8_t message_type;  /**< Should be MSG_TYPE_S_MINION_SPAWN. */
+    uint16_t minionHandle; /**< SlotMap handle assigned by the server. */
+    uint8_t flags;         /**< MSG_MINION_FLAG_* bits. */
+    uint16_t pos_x;        /**< Quantized world X (see MSG_MINION_POS_SCALE). */
+    uint16_t pos_y;        /**< Quantized world Y (see MSG_MINION_POS_SCALE). */
+} Msg_MinionSpawn;
 
 /**
- * @brief Data structure for Msg_DamageMinion.
- * Sent from when a minion is damaged.
+ * @brief Data structure for MSG_TYPE_S_MINION_STATE.
+ * Periodic snapshot of every active minion, packed as parallel arrays (one entry per minion).
+ * A snapshot with more than MSG_MINION_BATCH_MAX minions is split into several parts sharing
+ * its server_time. Only the first @c count entries are valid.
+ * Minions missing from every part of the snapshot have been removed by the server.
  */
-typedef struct Msg_DamageMinion
+typedef struct Msg_MinionStateBatch
 {
-    uint8_t message_type; /**< Should be MSG_TYPE_S_DAMAGE_MINION. */
-    int minionIndex;       /**< The index of the minion that got damaged. */
-    float current_health;  /**<  The current health of tower after receviving the message from server*/
-} Msg_DamageMinion;
+    uint8_t message_type;                    /**< Should be MSG_TYPE_S_MINION_STATE. */
+    uint8_t count;                           /**< Number of valid entries. */
+    uint8_t part;                            /**< Index of this part within the snapshot (0 .. part_count - 1). */
+    uint8_t part_count;                      /**< Number of parts the snapshot was split into. */
+    uint32_t server_time;                    /**< Server sync clock (ms) when the snapshot was taken. */
+    uint16_t handle[MSG_MINION_BATCH_MAX];   /**< Minion handles. */
+    uint16_t pos_x[MSG_MINION_BATCH_MAX];    /**< Quantized world X positions. */
+    uint16_t pos_y[MSG_MINION_BATCH_MAX];    /**< Quantized world Y positions. */
+    uint8_t health[MSG_MINION_BATCH_MAX];    /**< Current health, clamped to 0..255. */
+    uint8_t flags[MSG_MINION_BATCH_MAX];     /**< MSG_MINION_FLAG_* bits. */
+} Msg_MinionStateBatch;
 
 /**
- * @brief Data structure for Msg_DamageTower.
- * Sent from when a tower is damaged.
+ * @brief Data structure for MSG_TYPE_S_WORLD_HASH.
+ * Hashes of the server's world right after the state batch of the same server_time was sent,
+ * so a client that has applied that batch can compare its own world against them.
  */
-typedef struct Msg_DamageTower
+typedef struct Msg_WorldHash
 {
-    uint8_t message_type; /**< Should be MSG_TYPE_S_DAMAGE_TOWER. */
-    int towerIndex;       /**< The index of the tower that got damaged. */
-    float damageValue;    /**< The amount of damage that the tower got. */
-    float current_health;  /**<  The current health of tower after receviving the message from server*/
-} Msg_DamageTower;
+    uint8_t message_type;                       /**< Should be MSG_TYPE_S_WORLD_HASH. */
+    uint32_t server_time;                       /**< Server sync clock (ms), equal to the preceding batch's. */
+    uint64_t sections[MSG_WORLD_HASH_SECTIONS]; /**< One hash per WorldHashSection. */
+} Msg_WorldHash;
 
 /**
- * @brief Data structure for Msg_DamageBase.
- * Sent when a base is damaged.
+ * @brief Data structure for MSG_TYPE_C_DESYNC_REPORT.
+ * Sent by a client whose world disagrees with a MSG_TYPE_S_WORLD_HASH, so the server
+ * dumps its snapshot of that moment next to the one the client dumped.
  */
-typedef struct Msg_DamageBase
+typedef struct Msg_DesyncReport
 {
-    uint8_t message_type; /**< Should be MSG_TYPE_S_DAMAGE_BASE. */
-    int baseIndex;        /**< The index of the base that got damaged. */
-    float damageValue;    /**< The amount of damage that the base got. */
-} Msg_DamageBase;
+    uint8_t message_type; /**< Should be MSG_TYPE_C_DESYNC_REPORT. */
+    uint8_t sections;     /**< Bit per WorldHashSection that disagreed. */
+    uint32_t server_time; /**< server_time of the hash message that disagreed. */
+} Msg_DesyncReport;
 
 /**
  * @brief Data structure for Msg_MatchResult.
@@ -208,4 +308,34 @@ typedef struct Msg_MatchResult
 {
     uint8_t message_type; /**< Should be MSG_TYPE_S_. */
     bool winningTeam;
-} Msg_MatchResult;
\ No newline at end of file
+} Msg_MatchResult;
+
+// --- Generated Payload Union ---
+
+/**
+ * @brief Union of every payload in NET_MESSAGE_SCHEMA. Receivers copy a message into it so
+ * handlers can read an aligned struct through the member named after the message (e.g. as_C_HELLO).
+ */
+typedef union NetMessagePayload
+{
+    uint8_t message_type; /**< First byte of every message. */
+#define NET_MESSAGE_UNION_ENTRY(name, id, payload, direction, requires, relay, handler) payload as_##name;
+    NET_MESSAGE_SCHEMA(NET_MESSAGE_UNION_ENTRY)
+#undef NET_MESSAGE_UNION_ENTRY
+} NetMessagePayload;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Looks up the schema entry of a message type.
+ * @param message_type Raw type byte.
+ * @return The entry, or NULL if the type is not part of the schema.
+ */
+const NetMessageInfo *NetMessage_GetInfo(uint8_t message_type);
+
+/**
+ * @brief Logs one line per message type that was received at least once.
+ * @param tag Prefix for the log lines (e.g. "[Server]").
+ * @param stats Array of NET_MESSAGE_TYPE_COUNT counters indexed by type byte.
+ */
+void NetMessage_LogStats(const char *tag, const NetMessageStats *stats);
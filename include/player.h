@@ -17,6 +17,8 @@
 #include "../include/base.h"
 #include "../include/tower.h"
 #include "../include/entity.h"
+#include "../include/spatial_hash.h"
+#include "../include/ecs.h"
 
 // --- Constants ---
 #define PLAYER_WIDTH 32.0f
@@ -24,6 +26,9 @@
 #define PLAYER_SPEED 200.0f        /**< Player movement speed in pixels per second. */
 #define PLAYER_ATTACK_RANGE 100.0f /**< Maximum distance the player can initiate an attack from. */
 #define PLAYER_HEALTH_MAX 200
+/** Components of a player entity; ECS_COLLIDER holds the player's index. */
+#define PLAYER_COMPONENTS (ECS_MASK(ECS_POSITION) | ECS_MASK(ECS_PREV_POSITION) | ECS_MASK(ECS_BOUNDS) | ECS_MASK(ECS_TEAM) | \
+                           ECS_MASK(ECS_HEALTH) | ECS_MASK(ECS_COLLIDER))
 #define PLAYER_DEATH_TIMER 2000 /**< Duration for death in ms. */
 
 #define PLAYER_SPRITE_FRAME_WIDTH 64.0f
@@ -52,39 +57,52 @@
 typedef struct PlayerManager_s *PlayerManager;
 
 /**
- * @brief Holds all state data for a single player instance (local or remote).
+ * @brief Holds the state of a single player instance (local or remote) that is not a component
+ * of its entity. Position, bounds, team and health live in the entity (see PLAYER_COMPONENTS).
  */
 typedef struct PlayerInstance
 {
     int index;
-    SDL_FRect rect;
-    SDL_FPoint position;      /**< Current world position (center). */
+    EcsEntity entity;         /**< The player's entity in state->world, ECS_ENTITY_NONE while the slot is inactive. */
     SDL_FRect sprite_portion; /**< The source rect defining the current animation frame. */
-    SDL_Texture *texture;
     SDL_FlipMode flip_mode; /**< Rendering flip state (horizontal). */
     float anim_timer;       /**< Timer used to advance animation frames. */
     int current_frame;      /**< Index of the current frame within the current animation sequence. */
     bool active;            /**< Whether this player slot is currently in use. */
     bool is_local;          /**< True if this is the player controlled by this game instance. */
     bool is_moving;         /**< Tracks if the player is currently considered moving (for animation). */
-    bool team;
     bool dead;
     int deathTime;
     bool playDeathAnim;
     bool playHurtAnim;
     bool playAttackAnim;
-    int current_health; /**< Current health points. */
+    Uint64 player_hit_time; /**< Server only: sync clock of this player's last hit on an enemy player, 0 if none. */
+    int player_hit_victim;  /**< Server only: index of the player that hit landed on. */
 } PlayerInstance;
 
+/**
+ * @brief One player slot in a world snapshot: the instance and, if active, its components.
+ * The entity is created anew on restore, so instance.entity is left at ECS_ENTITY_NONE.
+ */
+typedef struct PlayerRecord
+{
+    PlayerInstance instance;
+    SDL_FPoint position;
+    SDL_FPoint prev_position;
+    bool team;
+    EcsHealth health;
+} PlayerRecord;
+
 /**
  * @brief Internal state for the PlayerManager module ADT.
  */
 struct PlayerManager_s
 {
+    EcsWorld world;                      /**< state->world, which holds the player entities. */
     PlayerInstance players[MAX_CLIENTS]; /**< Array holding data for all potential players. */
     int local_player_client_id;          /**< Client ID of the local player, or -1 if none/disconnected. */
     SDL_Texture *player_texture;         /**< Shared texture atlas for player sprites. */
-    SDL_Texture *red_texture;
+    SDL_Texture *red_texture;            /**< Team textures, picked by the player's ECS_TEAM when drawing. */
     SDL_Texture *blue_texture;
 };
 
@@ -142,6 +160,16 @@ void PlayerManager_RemovePlayer(PlayerManager pm, uint8_t client_id);
  */
 bool PlayerManager_GetLocalPlayerPosition(PlayerManager pm, SDL_FPoint *out_pos);
 
+/**
+ * @brief Gets the position the local player is drawn at this frame.
+ * Blends the last two simulation steps by @p alpha so rendering stays smooth at any frame rate.
+ * @param pm The PlayerManager instance.
+ * @param alpha Interpolation factor between the previous and the current step (state->render_alpha).
+ * @param out_pos Pointer to an SDL_FPoint to store the position.
+ * @return True if the local player exists and position was retrieved, false otherwise.
+ */
+bool PlayerManager_GetLocalPlayerRenderPosition(PlayerManager pm, float alpha, SDL_FPoint *out_pos);
+
 /**
  * @brief Gets the world position of any active player by their client ID.
  * Used by other systems like AttackManager or TowerManager.
@@ -161,4 +189,37 @@ bool PlayerManager_GetPlayerPosition(PlayerManager pm, uint8_t client_id, SDL_FP
  */
 bool PlayerManager_GetLocalPlayerState(PlayerManager pm, Msg_PlayerStateData *out_data);
 
-void damagePlayer(AppState state, int playerIndex, float damageValue, bool sendToServer);
+/**
+ * @brief Starts the hurt animation of a player that got hit, or the death animation and the
+ * respawn timer if the hit killed it. Called by the health system (Systems_ApplyDamage), which
+ * has already lowered the player's ECS_HEALTH; gameplay code pushes a DamageEvent instead.
+ * @param state Pointer to the main AppState.
+ * @param playerIndex The index of the player that got hit.
+ * @param killed True if the hit took the player's health to 0 or below.
+ */
+void PlayerManager_HandleHit(AppState *state, int playerIndex, bool killed);
+
+/**
+ * @brief Copies every player slot into a world snapshot.
+ * @param pm The PlayerManager instance.
+ * @param out Receives MAX_CLIENTS records.
+ */
+void PlayerManager_SaveState(PlayerManager pm, PlayerRecord *out);
+
+/**
+ * @brief Replaces every player slot with a saved one. Active slots keep their entity and have its
+ * components overwritten; an entity is only created or destroyed where a slot's activity changed.
+ * @param pm The PlayerManager instance.
+ * @param records MAX_CLIENTS records written by PlayerManager_SaveState.
+ * @return True on success, false if an entity could not be created (use SDL_GetError()); the slots
+ *         are unchanged then.
+ */
+bool PlayerManager_RestoreState(PlayerManager pm, const PlayerRecord *records);
+
+/**
+ * @brief Server only: remembers that a player hit an enemy player, for the towers' call for help.
+ * @param state Pointer to the main AppState.
+ * @param attacker Index of the player whose attack landed.
+ * @param victim Index of the player that got hit.
+ */
+void PlayerManager_RecordPlayerHit(AppState *state, int attacker, int victim);
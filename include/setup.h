@@ -0,0 +1,43 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/entity.h"
+#include "../include/map.h"
+#include "../include/spatial_hash.h"
+#include "../include/damage_bus.h"
+#include "../include/command_buffer.h"
+#include "../include/flow_field.h"
+#include "../include/nav_grid.h"
+#include "../include/ecs.h"
+#include "../include/systems.h"
+#include "../include/hud.h"
+#include "../include/base.h"
+#include "../include/tower.h"
+#include "../include/attack.h"
+#include "../include/player.h"
+#include "../include/minion.h"
+#include "../include/desync.h"
+#include "../include/camera.h"
+#include "../include/net_server.h"
+#include "../include/net_client.h"
+
+// --- Function Declarations ---
+
+/**
+ * @brief Creates the JobSystem, the EntityManager and the EcsWorld and initializes every game module in dependency order.
+ * Shared by SDL_AppInit and the tools that run the game without the SDL callbacks
+ * (e.g. the network harness). The caller sets up SDL, the renderer, SDLNet and
+ * state->clock beforehand.
+ * @param state Pointer to the main AppState (is_server, team, shm_name, headless and job_workers must be set).
+ * @param hostname Host the client module connects to.
+ * @return NULL on success, otherwise the name of the stage that failed (e.g. "Map_Init").
+ */
+const char *AppSetup_InitModules(AppState *state, const char *hostname);
+
+/**
+ * @brief Destroys the game modules, the EntityManager, the EcsWorld and the JobSystem created by AppSetup_InitModules.
+ * Does not touch SDL resources, SDLNet or state->clock; those belong to the caller.
+ * @param state Pointer to the main AppState.
+ */
+void AppSetup_DestroyModules(AppState *state);
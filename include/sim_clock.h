@@ -0,0 +1,58 @@
+#pragma once
+
+// --- SDL/External Library Includes ---
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to a millisecond clock.
+ * A real clock follows SDL_GetTicks(). A virtual clock only moves when it is
+ * advanced explicitly, which lets tests run a match faster than real time.
+ */
+typedef struct SimClock_s *SimClock;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Creates a clock that follows SDL_GetTicks().
+ * @return A new SimClock on success, NULL on failure.
+ * @sa SimClock_Destroy
+ */
+SimClock SimClock_CreateReal(void);
+
+/**
+ * @brief Creates a clock that only moves when SimClock_Advance is called.
+ * @param start_ms Initial reading of the clock in milliseconds.
+ * @return A new SimClock on success, NULL on failure.
+ * @sa SimClock_Destroy
+ */
+SimClock SimClock_CreateVirtual(Uint64 start_ms);
+
+/**
+ * @brief Destroys the clock.
+ * @param clock The SimClock instance (NULL is ignored).
+ */
+void SimClock_Destroy(SimClock clock);
+
+/**
+ * @brief Reads the clock.
+ * @param clock The SimClock instance. NULL falls back to SDL_GetTicks().
+ * @return Milliseconds since the clock's epoch.
+ */
+Uint64 SimClock_GetTicks(SimClock clock);
+
+/**
+ * @brief Moves a virtual clock forward. Has no effect on a real clock.
+ * @param clock The SimClock instance.
+ * @param ms Milliseconds to advance.
+ */
+void SimClock_Advance(SimClock clock, Uint64 ms);
+
+/**
+ * @brief Checks whether the clock is virtual.
+ * @param clock The SimClock instance.
+ * @return True for a virtual clock, false for a real clock or NULL.
+ */
+bool SimClock_IsVirtual(SimClock clock);
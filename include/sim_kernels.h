@@ -0,0 +1,104 @@
+#pragma once
+
+// --- SDL/External Library Includes ---
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// --- Constants ---
+#define SIM_KERNEL_MAX_WIDTH 8 /**< Widest vector the kernels use (AVX2, 8 floats). Pad pools to a multiple of this. */
+
+/**
+ * @brief Rounds an element count up to a whole number of SIM_KERNEL_MAX_WIDTH lanes.
+ * Arrays padded this way never need the scalar tail loop.
+ */
+#define SIM_KERNEL_PAD(count) ((((count) + SIM_KERNEL_MAX_WIDTH - 1) / SIM_KERNEL_MAX_WIDTH) * SIM_KERNEL_MAX_WIDTH)
+
+// --- Public API Function Declarations ---
+//
+// Batched per-step updates over structure-of-arrays storage. Each kernel has an
+// AVX2 path (when built with -mavx2), an SSE2 path (any x86-64 build) and a scalar
+// fallback that every other target uses. All paths produce the same results for
+// the same inputs. Arrays need no particular alignment; a count that is not a
+// multiple of the vector width is finished with scalar code.
+
+/**
+ * @brief Returns the instruction set the kernels were compiled for.
+ * @return "avx2", "sse2" or "scalar". Reports "scalar" while SimKernel_SetScalarOnly is on.
+ */
+const char *SimKernel_GetBackendName(void);
+
+/**
+ * @brief Forces the scalar fallback even when a vector path is compiled in.
+ * Used by the benchmark to compare paths, and handy when chasing a desync.
+ * @param enable True to use the scalar code, false to use the widest vector path.
+ */
+void SimKernel_SetScalarOnly(bool enable);
+
+/**
+ * @brief Moves points by their velocity: x += vx * dt, y += vy * dt.
+ * @param x X coordinates, updated in place.
+ * @param y Y coordinates, updated in place.
+ * @param vx X velocities in pixels per second.
+ * @param vy Y velocities in pixels per second.
+ * @param count Number of elements.
+ * @param dt Step length in seconds.
+ */
+void SimKernel_Integrate(float *x, float *y, const float *vx, const float *vy, int count, float dt);
+
+/**
+ * @brief Counts timers down towards zero: t = max(t - dt, 0).
+ * @param timers Remaining times in seconds, updated in place.
+ * @param count Number of elements.
+ * @param dt Step length in seconds.
+ */
+void SimKernel_Countdown(float *timers, int count, float dt);
+
+/**
+ * @brief Advances looping sprite animations by one step.
+ * Each timer gains dt; when it reaches frame_time it loses frame_time (keeping the
+ * remainder for frame skips) and the frame moves to the next one, wrapping at frame_count.
+ * @param timers Time into the current frame in seconds, updated in place.
+ * @param frames Current frame indices (0 .. frame_count - 1), updated in place.
+ * @param count Number of elements.
+ * @param dt Step length in seconds.
+ * @param frame_time Duration of one frame in seconds.
+ * @param frame_count Number of frames in the loop.
+ */
+void SimKernel_StepAnimation(float *timers, Sint32 *frames, int count, float dt, float frame_time, int frame_count);
+
+/**
+ * @brief Moves points along the segment between two network snapshots.
+ * Where t is below 1 it grows by rate and the point is placed at from + (to - from) * min(t, 1).
+ * Where t already reached 1 the point snaps to the target.
+ * @param x X coordinates, overwritten.
+ * @param y Y coordinates, overwritten.
+ * @param from_x Segment start X.
+ * @param from_y Segment start Y.
+ * @param to_x Segment end X.
+ * @param to_y Segment end Y.
+ * @param t Interpolation progress (0..1), updated in place.
+ * @param count Number of elements.
+ * @param rate Progress added to t this step.
+ */
+void SimKernel_Interpolate(float *x, float *y, const float *from_x, const float *from_y,
+                           const float *to_x, const float *to_y, float *t, int count, float rate);
+
+/**
+ * @brief SimKernel_Integrate for interleaved points, such as the ECS_POSITION and ECS_VELOCITY columns.
+ * @param points Positions, updated in place.
+ * @param velocities Velocities in pixels per second.
+ * @param count Number of points.
+ * @param dt Step length in seconds.
+ */
+void SimKernel_IntegratePoints(SDL_FPoint *points, const SDL_FPoint *velocities, int count, float dt);
+
+/**
+ * @brief SimKernel_Interpolate for interleaved points, such as the ECS_NET_FROM and ECS_NET_TO columns.
+ * @param points Positions, overwritten.
+ * @param from Segment starts.
+ * @param to Segment ends.
+ * @param t Interpolation progress (0..1) of each point, updated in place.
+ * @param count Number of points.
+ * @param rate Progress added to t this step.
+ */
+void SimKernel_InterpolatePoints(SDL_FPoint *points, const SDL_FPoint *from, const SDL_FPoint *to, float *t, int count, float rate);
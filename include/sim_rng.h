@@ -0,0 +1,72 @@
+#pragma once
+
+// --- SDL/External Library Includes ---
+#include <SDL3/SDL.h>
+
+// --- Constants ---
+#define SIM_RNG_DEFAULT_SEED 0x4c6f54u /**< Seed of the match streams until the server hands one out. */
+
+// --- Enums ---
+
+/**
+ * @brief One random stream per system, so a system that draws more numbers
+ * (or is turned off) never shifts the sequence another system sees.
+ * The simulation itself draws no random numbers yet; the streams are seeded and saved with
+ * the world so that randomness added later replays from a snapshot. The tools' bots use a
+ * stream of their own past SIM_RNG_STREAM_COUNT.
+ */
+typedef enum SimRngStream
+{
+    SIM_RNG_STREAM_MINIONS,
+    SIM_RNG_STREAM_TOWERS,
+    SIM_RNG_STREAM_ATTACKS,
+    SIM_RNG_STREAM_PLAYERS,
+    SIM_RNG_STREAM_COUNT
+} SimRngStream;
+
+// --- Structures ---
+
+/**
+ * @brief State of one PCG32 generator. Plain data: copying it forks the sequence,
+ * which snapshots and replays rely on.
+ */
+typedef struct SimRng
+{
+    Uint64 state;     /**< Position in the sequence. */
+    Uint64 increment; /**< Selects the stream; always odd. */
+} SimRng;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Starts a generator. The same seed and stream always give the same sequence,
+ * and different streams of one seed do not overlap in practice.
+ * @param rng The generator.
+ * @param seed The match seed.
+ * @param stream The stream (any value, usually a SimRngStream).
+ */
+void SimRng_Seed(SimRng *rng, Uint64 seed, Uint64 stream);
+
+/**
+ * @brief Seeds one generator per SimRngStream from a single match seed.
+ * @param streams Array of SIM_RNG_STREAM_COUNT generators.
+ * @param seed The match seed.
+ */
+void SimRng_SeedStreams(SimRng *streams, Uint64 seed);
+
+/**
+ * @brief Draws the next 32 random bits.
+ */
+Uint32 SimRng_Next(SimRng *rng);
+
+/**
+ * @brief Draws an integer in [0, range) without modulo bias.
+ * @param rng The generator.
+ * @param range Number of possible results; values below 1 give 0.
+ */
+int SimRng_Range(SimRng *rng, int range);
+
+/**
+ * @brief Draws a float in [0, 1) with 24 random bits, the same on every platform.
+ */
+float SimRng_Float(SimRng *rng);
@@ -0,0 +1,47 @@
+#pragma once
+
+// --- SDL/External Library Includes ---
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// --- Tuning Schema ---
+
+/**
+ * @brief Balance values the simulation reads from state->tuning instead of from constants,
+ * so tools can change them per match. Each entry is X(name); the defaults are the *_VALUE
+ * constants of the owning modules (see SimTuning_SetDefaults).
+ * Every peer of a match must use the same values: each applies the hits it reports itself.
+ */
+#define SIM_TUNING_SCHEMA(X)                                                     \
+    X(player_attack_damage) /* PLAYER_ATTACK_DAMAGE_VALUE, per attack */         \
+    X(tower_attack_damage)  /* TOWER_ATTACK_DAMAGE_VALUE, per tower shot */      \
+    X(minion_damage)        /* MINION_DAMAGE_VALUE, per strike on a building */  \
+    X(minion_unit_damage)   /* MINION_UNIT_DAMAGE_VALUE, per strike on a unit */
+
+// --- Structures ---
+
+/**
+ * @brief One float per SIM_TUNING_SCHEMA entry, named after it.
+ */
+typedef struct SimTuning
+{
+#define SIM_TUNING_FIELD(name) float name;
+    SIM_TUNING_SCHEMA(SIM_TUNING_FIELD)
+#undef SIM_TUNING_FIELD
+} SimTuning;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Sets every value to the constant it replaces.
+ * @param tuning The values to reset.
+ */
+void SimTuning_SetDefaults(SimTuning *tuning);
+
+/**
+ * @brief Looks up a value by its schema name (e.g. "tower_attack_damage").
+ * @param tuning The values.
+ * @param name Name of the entry.
+ * @return Pointer to the value, or NULL if there is no entry of that name.
+ */
+float *SimTuning_Find(SimTuning *tuning, const char *name);
@@ -0,0 +1,147 @@
+#pragma once
+
+// --- SDL/External Library Includes ---
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// --- Constants ---
+#define SLOT_HANDLE_INVALID 0u /**< Never returned by a successful allocation. */
+#define SLOT_MAP_STATE_WORDS(capacity) (3 + 2 * (capacity)) /**< Words SlotMap_SaveState writes for a map of this capacity. */
+
+// --- Types ---
+
+/**
+ * @brief Generational handle: the slot index in the low bits, the slot's generation above it.
+ * Freeing a slot bumps its generation, so handles to the previous occupant stop resolving.
+ * Generations start at 1, so a valid handle is never SLOT_HANDLE_INVALID.
+ */
+typedef Uint32 SlotHandle;
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to a slot allocator.
+ * The map only hands out slot indices; the caller keeps its data in arrays indexed by slot
+ * and grows them when SlotMap_GetCapacity increases. Allocation, lookup and removal are O(1),
+ * and live slots can be iterated densely with SlotMap_GetSlotAt.
+ */
+typedef struct SlotMap_s *SlotMap;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Creates a slot map.
+ * @param initial_capacity Number of slots available before the first growth.
+ * @param max_capacity Hard limit on the number of slots (at most 1 << index_bits).
+ * @param index_bits Bits of a handle used for the slot index.
+ * @param generation_bits Bits of a handle used for the generation (index_bits + generation_bits <= 32).
+ * @return A new SlotMap on success, NULL on failure (use SDL_GetError()).
+ * @sa SlotMap_Destroy
+ */
+SlotMap SlotMap_Create(int initial_capacity, int max_capacity, int index_bits, int generation_bits);
+
+/**
+ * @brief Destroys the slot map.
+ * @param sm The SlotMap instance (NULL is ignored).
+ */
+void SlotMap_Destroy(SlotMap sm);
+
+/**
+ * @brief Claims a free slot, growing the map when it is full.
+ * @param sm The SlotMap instance.
+ * @return The handle of the slot, or SLOT_HANDLE_INVALID if max_capacity is reached or growth failed.
+ */
+SlotHandle SlotMap_Alloc(SlotMap sm);
+
+/**
+ * @brief Grows the map once so the next count allocations need no further growth.
+ * @param sm The SlotMap instance.
+ * @param count Number of allocations to make room for.
+ * @return True on success, false if max_capacity would be exceeded or memory ran out.
+ */
+bool SlotMap_Reserve(SlotMap sm, int count);
+
+/**
+ * @brief Claims the slot named by a handle allocated elsewhere (e.g. by the server), with its generation.
+ * Grows the map if the slot lies beyond the current capacity.
+ * @param sm The SlotMap instance.
+ * @param handle The handle to mirror.
+ * @return True on success. False if the slot is in use (free it first) or out of range.
+ */
+bool SlotMap_AllocAt(SlotMap sm, SlotHandle handle);
+
+/**
+ * @brief Releases a slot. Outstanding handles to it stop resolving.
+ * @param sm The SlotMap instance.
+ * @param handle The handle of the slot.
+ * @return True if the handle was live and has been freed, false otherwise.
+ */
+bool SlotMap_Free(SlotMap sm, SlotHandle handle);
+
+/**
+ * @brief Looks up the slot of a live handle.
+ * @param sm The SlotMap instance.
+ * @param handle The handle to resolve.
+ * @return The slot index, or -1 if the handle is invalid or stale.
+ */
+int SlotMap_Resolve(SlotMap sm, SlotHandle handle);
+
+/**
+ * @brief Returns the current handle of a live slot.
+ * @param sm The SlotMap instance.
+ * @param slot The slot index.
+ * @return The handle, or SLOT_HANDLE_INVALID if the slot is free.
+ */
+SlotHandle SlotMap_GetHandle(SlotMap sm, int slot);
+
+/**
+ * @brief Returns the number of live slots.
+ */
+int SlotMap_GetCount(SlotMap sm);
+
+/**
+ * @brief Returns the number of slots currently allocated; data arrays must be at least this long.
+ */
+int SlotMap_GetCapacity(SlotMap sm);
+
+/**
+ * @brief Returns the n-th live slot, for iterating without scanning free slots.
+ * The order changes when slots are freed.
+ * @param sm The SlotMap instance.
+ * @param n Position in the live list (0 .. SlotMap_GetCount() - 1).
+ * @return The slot index, or -1 if n is out of range.
+ */
+int SlotMap_GetSlotAt(SlotMap sm, int n);
+
+/**
+ * @brief Copies the allocation state (generations, live list and free list order) into plain words,
+ * for snapshots of the data the map indexes.
+ * @param sm The SlotMap instance.
+ * @param words Receives SLOT_MAP_STATE_WORDS(SlotMap_GetCapacity(sm)) words.
+ * @param max_words Length of words.
+ * @return True on success, false if words is too short.
+ * @sa SlotMap_RestoreState
+ */
+bool SlotMap_SaveState(SlotMap sm, Uint32 *words, int max_words);
+
+/**
+ * @brief Puts the map back into a state saved by SlotMap_SaveState, so it hands out the same
+ * handles in the same order as it would have from there. Grows the map if it has been smaller;
+ * slots it gained after the save are free and come last.
+ * @param sm The SlotMap instance, created with the same layout as the saved one.
+ * @param words The saved state.
+ * @return True on success, false if the state does not fit this map or growth failed; the map is
+ *         unchanged then.
+ */
+bool SlotMap_RestoreState(SlotMap sm, const Uint32 *words);
+
+/**
+ * @brief Checks a saved state without applying it, so callers can size their data arrays
+ * before SlotMap_RestoreState changes anything.
+ * @param sm The SlotMap instance the state is meant for.
+ * @param words The saved state.
+ * @param out_capacity Receives the saved capacity (NULL to ignore).
+ * @param out_count Receives the number of live slots in the save (NULL to ignore).
+ * @return True if SlotMap_RestoreState would accept the state (growth aside), false otherwise.
+ */
+bool SlotMap_PeekState(SlotMap sm, const Uint32 *words, int *out_capacity, int *out_count);
@@ -0,0 +1,145 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/entity.h"
+#include "../include/slot_map.h"
+#include "../include/collision.h"
+
+// --- Constants ---
+#define SPATIAL_HASH_CELL_SIZE 128.0f   /**< Cell edge in pixels: a minion lane step and about half a building. */
+#define SPATIAL_HASH_BUCKET_COUNT 1024  /**< Number of hash buckets. Must be a power of two. */
+#define SPATIAL_HASH_ANY_TEAM (-1)      /**< Team filter that matches both teams. */
+
+// --- Enums ---
+
+/**
+ * @brief Kinds of objects stored in the spatial hash. Values are bit flags so a
+ * query can ask for several kinds at once.
+ */
+typedef enum SpatialKind
+{
+    SPATIAL_KIND_PLAYER = 1 << 0,
+    SPATIAL_KIND_MINION = 1 << 1,
+    SPATIAL_KIND_TOWER = 1 << 2,
+    SPATIAL_KIND_BASE = 1 << 3,
+    SPATIAL_KIND_BUILDING = SPATIAL_KIND_TOWER | SPATIAL_KIND_BASE,
+    SPATIAL_KIND_UNIT = SPATIAL_KIND_PLAYER | SPATIAL_KIND_MINION,
+    SPATIAL_KIND_ALL = SPATIAL_KIND_UNIT | SPATIAL_KIND_BUILDING,
+} SpatialKind;
+
+// --- Structures ---
+
+/**
+ * @brief One object as seen by the spatial hash at the last rebuild.
+ */
+typedef struct SpatialEntry
+{
+    SDL_FRect rect;      /**< World-space bounds used by rect queries. */
+    SDL_FPoint position; /**< World position (center) used by radius and nearest queries. */
+    SpatialKind kind;    /**< Which manager owns the object. */
+    bool team;           /**< Team of the object. */
+    int index;           /**< Index of the object in its manager's array. */
+    SlotHandle entity;   /**< EcsEntity of the object in state->world, or ECS_ENTITY_NONE if it has none. */
+} SpatialEntry;
+
+/**
+ * @brief One entry touched by a swept segment.
+ */
+typedef struct SpatialSweepHit
+{
+    SpatialEntry entry; /**< The entry that was touched. */
+    float t;            /**< Fraction of the segment (0..1) at the first contact. */
+} SpatialSweepHit;
+
+// --- Opaque Pointer Type ---
+
+/**
+ * @brief Opaque handle to the spatial hash.
+ * A uniform grid hashed into a fixed bucket table, rebuilt at the start of every
+ * simulation step from the ECS_COLLIDER entities of the world and the player and minion managers.
+ * Queries only read the hash, so job-system workers may query it concurrently; rebuilds must not
+ * overlap with queries.
+ */
+typedef struct SpatialHash_s *SpatialHash;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Initializes the spatial hash and registers its entity functions.
+ * Must be registered before the modules that query it so their updates see this step's positions.
+ * @param state Pointer to the main AppState (provides entity manager).
+ * @return A new SpatialHash instance on success, NULL on failure.
+ * @sa SpatialHash_Destroy
+ */
+SpatialHash SpatialHash_Init(AppState *state);
+
+/**
+ * @brief Destroys the SpatialHash instance.
+ * @param sh The SpatialHash instance (NULL is ignored).
+ * @sa SpatialHash_Init
+ */
+void SpatialHash_Destroy(SpatialHash sh);
+
+/**
+ * @brief Rebuilds the hash from the current state of every manager.
+ * Runs automatically from the entity update; call it directly after teleporting objects mid-step.
+ * @param sh The SpatialHash instance.
+ * @param state Pointer to the main AppState.
+ */
+void SpatialHash_Rebuild(SpatialHash sh, AppState *state);
+
+/**
+ * @brief Finds all entries whose bounds overlap a rectangle.
+ * @param sh The SpatialHash instance.
+ * @param rect World-space rectangle to test.
+ * @param kind_mask Bitwise OR of SpatialKind values to include.
+ * @param team Team to include, or SPATIAL_HASH_ANY_TEAM.
+ * @param out Array receiving the matching entries (copied).
+ * @param max_out Capacity of out.
+ * @return Number of entries written to out.
+ */
+int SpatialHash_QueryRect(SpatialHash sh, const SDL_FRect *rect, int kind_mask, int team, SpatialEntry *out, int max_out);
+
+/**
+ * @brief Finds all entries whose position lies within a radius of a point.
+ * @param sh The SpatialHash instance.
+ * @param center World-space center of the circle.
+ * @param radius Radius in pixels (inclusive).
+ * @param kind_mask Bitwise OR of SpatialKind values to include.
+ * @param team Team to include, or SPATIAL_HASH_ANY_TEAM.
+ * @param out Array receiving the matching entries (copied).
+ * @param max_out Capacity of out.
+ * @return Number of entries written to out.
+ */
+int SpatialHash_QueryRadius(SpatialHash sh, SDL_FPoint center, float radius, int kind_mask, int team, SpatialEntry *out, int max_out);
+
+/**
+ * @brief Finds all entries a moving box touches on its way along a segment.
+ * Each entry's bounds are grown by extent and tested against the segment, so the
+ * whole path is covered no matter how far the box moves in one step.
+ * @param sh The SpatialHash instance.
+ * @param from Position of the box center at the start of the movement.
+ * @param to Position of the box center at the end of the movement.
+ * @param extent Half width and half height of the box; {0, 0} sweeps a point.
+ * @param kind_mask Bitwise OR of SpatialKind values to include.
+ * @param team Team to include, or SPATIAL_HASH_ANY_TEAM.
+ * @param out Array receiving the touched entries, earliest contact first (ties by kind, then index).
+ * @param max_out Capacity of out. If more entries are touched, the earliest ones are kept.
+ * @return Number of entries written to out.
+ */
+int SpatialHash_QuerySegment(SpatialHash sh, SDL_FPoint from, SDL_FPoint to, SDL_FPoint extent, int kind_mask, int team,
+                             SpatialSweepHit *out, int max_out);
+
+/**
+ * @brief Finds the entry closest to a point within a radius.
+ * Ties are broken by kind and then by index so every peer picks the same target.
+ * @param sh The SpatialHash instance.
+ * @param center World-space point to measure from.
+ * @param radius Search radius in pixels (inclusive).
+ * @param kind_mask Bitwise OR of SpatialKind values to include.
+ * @param team Team to include, or SPATIAL_HASH_ANY_TEAM.
+ * @param out_entry Receives the closest entry.
+ * @return True if an entry was found, false otherwise.
+ */
+bool SpatialHash_FindNearest(SpatialHash sh, SDL_FPoint center, float radius, int kind_mask, int team, SpatialEntry *out_entry);
@@ -0,0 +1,53 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/entity.h"
+#include "../include/ecs.h"
+#include "../include/camera.h"
+#include "../include/hud.h"
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Registers the shared ECS systems with the EntityManager.
+ * They run over every entity in state->world that has the components they need,
+ * regardless of which module created it:
+ * - sprite_render_system: draws ECS_POSITION + ECS_SPRITE entities, switching to the
+ *   destroyed texture once ECS_HEALTH reaches 0.
+ * - health_label_system: keeps the HUD health text of ECS_HEALTH_LABEL entities above their sprite.
+ * Both render in ENTITY_PHASE_RENDER, where registration order is draw order, so call this
+ * where the buildings should be drawn.
+ * @param state Pointer to the main AppState (provides entity manager and world).
+ * @return True on success, false on failure (use SDL_GetError()).
+ */
+bool Systems_Init(AppState *state);
+
+/**
+ * @brief Health system: applies a hit to the ECS_HEALTH of any entity.
+ * This is the only place gameplay health goes down. Entities that are gone, immune or already
+ * at 0 health ignore the hit. What a hit means beyond the health is left to the owner, found
+ * through ECS_COLLIDER: players play their hurt or death animation (PlayerManager_HandleHit),
+ * minions update their state hash and die at 0 health (MinionManager_HandleHit), and once health
+ * drops to 0 towers and bases are handed to TowerManager_HandleDestroyed and BaseManager_HandleDestroyed.
+ * Called from the damage bus resolve pass; gameplay code pushes a DamageEvent instead.
+ * @param state Pointer to the main AppState.
+ * @param entity The entity that got hit.
+ * @param amount Damage to apply.
+ * @param local true if this instance landed the hit (a destroyed base then reports the match result).
+ * @param health_after Receives the entity's health after the hit (may be NULL).
+ * @return True if the hit was applied, false if it was ignored.
+ */
+bool Systems_ApplyDamage(AppState *state, EcsEntity entity, float amount, bool local, float *health_after);
+
+/**
+ * @brief Health system: sets the ECS_HEALTH of an entity to the value another instance reported.
+ * Like Systems_ApplyDamage, entities that are gone or immune ignore it, and one whose health drops
+ * to 0 is handed to its owner.
+ * @param state Pointer to the main AppState.
+ * @param entity The entity.
+ * @param current Its health on the instance that hit it.
+ * @param local true if this instance landed the hit.
+ * @return True if the health was set, false if it was ignored.
+ */
+bool Systems_SetHealth(AppState *state, EcsEntity entity, float current, bool local);
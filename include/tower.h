@@ -9,6 +9,8 @@
 #include "../include/entity.h"
 #include "../include/base.h"
 #include "../include/hud.h"
+#include "../include/spatial_hash.h"
+#include "../include/ecs.h"
 
 // --- Constants ---
 #define MAX_TOWERS_PER_TEAM 2
@@ -21,11 +23,18 @@
 #define TOWER_ATTACK_RANGE 200.0f
 #define TOWER_ATTACK_DAMAGE 50
 #define TOWER_ATTACK_COOLDOWN 1.5f // Seconds between shots
+#define TOWER_TARGETING_CHUNK 2    // Towers per targeting job
+#define TOWER_TARGET_CANDIDATES 32 // Units a target search considers
+#define TOWER_CALL_FOR_HELP_MS 2000 // A player who hit a defended player this recently is attacked first
+#define TOWER_TARGET_MATCH_RADIUS 48.0f // Clients: distance from a shot's aim point at which a unit counts as its target
+#define TOWER_TARGET_EVENT_CAPACITY 16  // Target changes kept for TowerManager_PollTargetEvent
 
 #define TOWER_RED_1_X 700.0f    // Position of the first red tower
 #define TOWER_BLUE_1_X 2500.0f  // Position of the first blue tower
 #define TOWER_DISTANCE_X 500.0f // Distance between each teams towers
 
+#define TOWER_COMPONENTS BASE_COMPONENTS // Same archetype as the bases
+
 // --- Opaque Pointer Type ---
 /**
  * @brief Opaque handle to the TowerManager state.
@@ -33,21 +42,44 @@
  */
 typedef struct TowerManagerState_s *TowerManagerState;
 
+/**
+ * @brief The unit a tower shoots at.
+ */
+typedef struct TowerTarget
+{
+    SpatialKind kind; /**< SPATIAL_KIND_MINION or SPATIAL_KIND_PLAYER, 0 if the tower has no target. */
+    int index;        /**< Pool slot of the minion or index of the player. */
+    Uint16 handle;    /**< Handle of a targeted minion, so a reused slot is not mistaken for it. */
+} TowerTarget;
+
+/**
+ * @brief A tower picked a new target or lost its old one.
+ * The server records them from its targeting. Clients derive them from the tower shots they
+ * already receive, so they cost no traffic: a shot aimed at another unit than the last one
+ * is a switch, and a tower that stops firing has lost its target.
+ */
+typedef struct TowerTargetEvent
+{
+    int tower;          /**< Index of the tower. */
+    TowerTarget target; /**< The new target; kind 0 if the tower lost its target. */
+} TowerTargetEvent;
+
 /**
  * @brief State of a single tower.
+ * Position, bounds, team, health and sprite are components of the tower's entity in state->world.
  */
 typedef struct TowerInstance
 {
     int index;
-    bool team;                   /**< Which team the tower belongs to. */
-    SDL_FRect rect;              /**< Rect for this tower. */
-    SDL_FPoint position;         /**< World position (center or base). */
-    SDL_Texture *texture;        /**< Texture for this tower. */
-    float current_health;        /**< Current health points. */
+    EcsEntity entity;            /**< The tower's entity in state->world. */
     float attack_cooldown_timer; /**< Time remaining until the next attack can occur. */
     bool teamFirstTower;
-    bool immune;
     bool destroyed;
+    bool pending_shot;           /**< Server only: targeting chose to fire this step; the shot is spawned after the parallel pass. */
+    SDL_FPoint pending_target;   /**< Server only: where the pending shot is aimed. */
+    TowerTarget target;          /**< The unit the tower shoots at; kept until it dies or leaves range. */
+    TowerTarget next_target;     /**< Server only: target chosen by the parallel pass, announced afterwards. */
+    Uint64 last_shot_time;       /**< Clients only: sync clock of the last shot received from this tower. */
 } TowerInstance;
 
 /**
@@ -60,6 +92,8 @@ struct TowerManagerState_s
     SDL_Texture *blue_texture;              /**< Texture for blue towers. */
     SDL_Texture *destroyed_texture;         /**< Texture for destroyed towers. */
     int tower_count;                        /**< Number of initialized towers. */
+    TowerTargetEvent target_events[TOWER_TARGET_EVENT_CAPACITY]; /**< Ring of the latest target changes. */
+    Uint32 target_event_count;              /**< Target changes recorded so far; the ring holds the latest ones. */
 };
 
 // --- Public API Function Declarations ---
@@ -82,11 +116,30 @@ TowerManagerState TowerManager_Init(AppState *state);
 void TowerManager_Destroy(TowerManagerState tm_state);
 
 /**
- * @brief Applies damage to a tower, sends damageValue to server and checks if
- * tower has been destroyed.
+ * @brief Marks a tower destroyed and lifts the immunity of the next building in its lane.
+ * Called by the health system once the tower's ECS_HEALTH reaches 0; gameplay code pushes a
+ * DamageEvent instead. The sprite system switches to the destroyed texture on its own.
+ * @param state Pointer to the main AppState.
+ * @param towerIndex The index of the tower.
+ */
+void TowerManager_HandleDestroyed(AppState *state, int towerIndex);
+
+/**
+ * @brief Clients only: updates a tower's target from a shot the server broadcast.
+ * Called when the tower attack is spawned.
  * @param state Pointer to the main AppState.
- * @param towerIndex The index of the tower to apply damage to.
- * @param damageValue The amount of damage to apply.
- * @param sendToServer true if the local client is the one that hit the tower.
+ * @param towerIndex The index of the tower that fired.
+ * @param target_pos Where the shot is aimed.
+ */
+void TowerManager_NoteShot(AppState *state, int towerIndex, SDL_FPoint target_pos);
+
+/**
+ * @brief Reads the next target change after a cursor.
+ * Each reader keeps its own cursor, starting at 0. A reader that falls more than
+ * TOWER_TARGET_EVENT_CAPACITY changes behind skips to the oldest one still kept.
+ * @param tm_state The TowerManagerState instance.
+ * @param cursor The reader's cursor, advanced past the returned event.
+ * @param out_event Receives the event.
+ * @return True if an event was written, false if the reader is up to date.
  */
-void damageTower(AppState state, int towerIndex, float damageValue, bool sendToServer, float current_health);
\ No newline at end of file
+bool TowerManager_PollTargetEvent(TowerManagerState tm_state, Uint32 *cursor, TowerTargetEvent *out_event);
\ No newline at end of file
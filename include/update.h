@@ -4,11 +4,26 @@
 #include "../include/common.h"
 #include "../include/entity.h"
 
+// --- Constants ---
+#define DEFAULT_SIM_HZ 60          /**< Simulation steps per second unless overridden with --sim-hz. */
+#define MAX_SIM_STEPS_PER_FRAME 5  /**< Catch-up limit; older backlog is dropped. */
+#define MAX_FRAME_TIME_MS 250      /**< Longest frame fed into the accumulator. */
+
 // --- Function Declarations ---
 
+/**
+ * @brief Advances the simulation by one fixed step of state->sim_step seconds.
+ * Sets delta_time and sync_clock for the step and calls the update function of all managed entities.
+ * @param state Pointer to the main AppState.
+ * @param step_tick Clock reading (ms) the step ends at.
+ */
+void app_simulate_step(AppState *state, Uint64 step_tick);
+
 /**
  * @brief Updates the application state for the current frame.
- * Calculates delta time and calls the update function for all managed entities.
+ * Feeds the elapsed clock time into an accumulator, runs as many fixed simulation steps
+ * as it covers (at most MAX_SIM_STEPS_PER_FRAME) and stores the leftover fraction of a
+ * step in state->render_alpha for render interpolation.
  * @param appstate Void pointer to the main AppState struct.
  */
 void app_update(void *appstate);
@@ -0,0 +1,131 @@
+#pragma once
+
+// --- Includes ---
+#include "../include/common.h"
+#include "../include/minion.h"
+#include "../include/player.h"
+#include "../include/attack.h"
+#include "../include/tower.h"
+#include "../include/base.h"
+
+// --- Enums ---
+
+/**
+ * @brief Parts of the world hashed separately, so a mismatch says where to look.
+ * Only state every peer holds is hashed: players are owned by their clients and attacks
+ * fly on every peer with its own timing, so neither is part of it.
+ */
+typedef enum WorldHashSection
+{
+    WORLD_HASH_MINIONS, /**< Handle, health, flags and replicated position of each active minion. */
+    WORLD_HASH_TOWERS,  /**< Health, immunity and destroyed flag of each tower. */
+    WORLD_HASH_BASES,   /**< Health of each base. */
+    WORLD_HASH_GAME,    /**< Game state and winner. */
+    WORLD_HASH_SECTION_COUNT
+} WorldHashSection;
+
+SDL_COMPILE_TIME_ASSERT(world_hash_fits_message, WORLD_HASH_SECTION_COUNT == MSG_WORLD_HASH_SECTIONS);
+
+// --- Structures ---
+
+/**
+ * @brief Hash of the replicated world, one value per WorldHashSection.
+ * Each section XOR-folds one hash per entity (mixed with the entity's slot), so the order
+ * entities are stored in does not matter and one changed entity changes the section.
+ * A pool can keep its fold up to date by XOR-ing out an entity's old hash and in its new one.
+ */
+typedef struct WorldHash
+{
+    Uint64 sections[WORLD_HASH_SECTION_COUNT];
+} WorldHash;
+
+/**
+ * @brief The simulation state of a match in one contiguous, pointer-free block.
+ * Entities refer to each other by index or handle and to textures only through their team,
+ * so a snapshot can be copied, written to disk or compared byte for byte as it is. Render, network and per-step
+ * scratch state is not part of it; neither are the tower target events, which only feed the HUD.
+ * The fixed-size managers are stored in the header. Pools that grow at run time store a fixed part in the
+ * header and their live entities in the data block behind it, so the snapshot's size follows the world's.
+ */
+typedef struct WorldSnapshot
+{
+    Uint64 size;                                  /**< Bytes of the whole snapshot, header and data block. */
+    Uint64 sync_clock;                            /**< Sync clock at the time of the save. */
+    GameState game_state;
+    bool winning_team;
+    SimRng rng[SIM_RNG_STREAM_COUNT];             /**< Random streams, so a restored match draws the same numbers again. */
+    PlayerRecord players[MAX_CLIENTS];
+    TowerInstance towers[MAX_TOTAL_TOWERS];
+    EcsHealth tower_health[MAX_TOTAL_TOWERS];     /**< Health components of the tower entities. */
+    EcsHealth base_health[MAX_BASES];             /**< Health components of the base entities. */
+    MinionSnapshot minions;                       /**< Fixed part of the minion state; the variable part starts at data. */
+    AttackSnapshot attacks;                       /**< Fixed part of the attack state; the variable part follows the minions'. */
+    Uint64 minion_bytes;                          /**< Bytes of the minion state in data, padded to 8. */
+    Uint64 attack_bytes;                          /**< Bytes of the attack state in data after the minions', padded to 8. */
+    Uint8 data[];                                 /**< Variable parts of the pool states. */
+} WorldSnapshot;
+
+// --- Public API Function Declarations ---
+
+/**
+ * @brief Starts an entity hash from its section and slot, so equal entities in different slots differ.
+ * @sa World_HashStep
+ */
+Uint64 World_HashBegin(WorldHashSection section, int slot);
+
+/**
+ * @brief Mixes one value into an entity hash (xor, then the 64-bit murmur finalizer step).
+ */
+Uint64 World_HashStep(Uint64 hash, Uint64 value);
+
+/**
+ * @brief Copies the simulation state of every manager into a snapshot.
+ * Call between simulation steps (e.g. before or after app_update), when the damage bus
+ * and the command buffer are empty. The snapshot is cleared before the save, so two saves
+ * of the same world compare equal byte for byte, padding included.
+ * @param state Pointer to the main AppState.
+ * @param snapshot In: a snapshot to reuse, or NULL. Out: the snapshot, reallocated if the world's size
+ *                 changed. It stays valid (and must be freed) even if the save fails.
+ * @return True on success, false on failure (use SDL_GetError()).
+ * @sa World_Restore, World_DestroySnapshot
+ */
+bool World_Save(AppState *state, WorldSnapshot **snapshot);
+
+/**
+ * @brief Frees a snapshot allocated by World_Save.
+ * @param snapshot The snapshot (NULL is ignored).
+ */
+void World_DestroySnapshot(WorldSnapshot *snapshot);
+
+/**
+ * @brief Puts every manager back into a saved state, then rebuilds what is derived from it:
+ * the spatial hash, and the flow fields if a tower fell or stands again. Pending damage bus events
+ * and recorded commands are dropped. Call between simulation steps. Peers are not told, and messages
+ * already on their way are not dropped; see MinionManager_RestoreState and NetServer_DiscardPending.
+ * @param state Pointer to the main AppState the snapshot was saved from (or one set up the same way).
+ * @param snapshot The saved state.
+ * @return True on success, false on failure (use SDL_GetError()). The minions, attacks and players are
+ *         restored in that order and each either fully or not at all, so a failure leaves the managers
+ *         before the failing one restored and the rest as they were.
+ */
+bool World_Restore(AppState *state, const WorldSnapshot *snapshot);
+
+/**
+ * @brief Hashes the state that server and clients must agree on.
+ * Minions are hashed as the state batch carries them, so a client that has applied the batch
+ * of a step gets the server's value for that step. Their section is the fold the MinionManager
+ * keeps as minions change (MinionManager_GetStateHash), so its cost does not grow with the pool.
+ * @param state Pointer to the main AppState.
+ * @param out Receives the hashes.
+ * @return True on success, false if the managers are missing.
+ */
+bool World_ComputeHash(AppState *state, WorldHash *out);
+
+/**
+ * @brief Writes a snapshot (its full size) to a file as raw bytes, for diffing the worlds of two peers.
+ * The file is only readable by a build with the same struct layout.
+ * @param snapshot The saved state.
+ * @param path File to create or replace.
+ * @return True on success, false on failure (use SDL_GetError()).
+ */
+bool World_WriteSnapshot(const WorldSnapshot *snapshot, const char *path);
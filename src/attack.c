@@ -3,257 +3,356 @@
 // --- Internal Structures ---
 
 /**
- * @brief Represents a single active attack instance in the game world.
- */
-typedef struct AttackInstance
-{
-    // --- Common Data ---
-    bool active;         /**< Whether this attack slot is currently in use and updated/rendered. */
-    uint32_t id;         /**< Unique identifier assigned by the server. */
-    AttackType type;     /**< The type of attack. */
-    uint8_t owner_id;    /**< The client ID of the player who launched the attack. */
-    SDL_FPoint position; /**< Current world position (center). */
-    SDL_FPoint target;
-    SDL_FPoint velocity;  /**< Current velocity vector (pixels per second). */
-    float angle_deg;      /**< Current rendering angle in degrees. */
-    SDL_Texture *texture; /**< Texture used for rendering this attack. */
-    float render_width;   /**< Width used for rendering. */
-    float render_height;  /**< Height used for rendering. */
-    float hit_range;      /**< Radius or bounding box size used for collision detection. */
-    ObjectType attacker;
-    SDL_FRect sprite_portion; /**< The source rect defining the current animation frame. */
-    float anim_timer;         /**< Timer used to advance animation frames. */
-    int current_frame;        /**< Index of the current frame within the current animation sequence. */
-    bool team;
-} AttackInstance;
+ * @brief Result of sweeping one attack over a step. Gathered on the job workers, applied on the main thread.
+ */
+typedef struct AttackHits
+{
+    int slot;                           /**< Slot of the attack. */
+    bool impact;                        /**< Whether the attack hit something or reached its target in this step. */
+    float time;                         /**< AttackManager clock (seconds) of the impact. */
+    float damage;                       /**< Damage dealt to towers, bases and players. */
+    int count;                          /**< Entries in hits; 0 if the impact has no effect on this peer. */
+    SpatialEntry hits[ATTACK_MAX_HITS]; /**< Objects overlapped at impact, filtered by kind and team. */
+} AttackHits;
+
+/**
+ * @brief Work shared by the sweep jobs of one step.
+ */
+typedef struct AttackSweepJob
+{
+    AttackManager am;
+    AppState *state;
+    float step_start; /**< AttackManager clock (seconds) at the start of the step. */
+} AttackSweepJob;
 
 /**
  * @brief Internal state for the AttackManager module ADT.
  */
 struct AttackManager_s
 {
-    AttackInstance attacks[MAX_ATTACKS];  /**< Pool of attack instances. */
-    int active_attack_count;              /**< Number of currently active attacks in the pool. */
-    SDL_Texture *fireball_texture;        /**< Shared texture for fireball attacks. */
-    SDL_Texture *lightning_arrow_texture; /**< Shared texture for lightning arrow attacks. */
-    uint32_t next_attack_id;              /**< Counter for assigning unique attack IDs. */
+    SlotMap slots;                          /**< Hands out attack slots and IDs; its dense list is the set of active attacks. */
+    AttackInstance *attacks;                /**< Attack instances indexed by slot, grown with the slot map. */
+    int capacity;                           /**< Length of attacks. */
+    AttackHits *due;                        /**< Sweep results of the current step; its impacts are moved to the front in impact order. */
+    int due_capacity;                       /**< Length of due. */
+    float sim_time;                         /**< Seconds of simulation time accumulated by this manager. */
+    SDL_Texture *fireball_texture;          /**< Shared texture for fireball attacks. */
+    SDL_Texture *lightning_arrow_texture;   /**< Shared texture for lightning arrow attacks. */
 };
 
 // --- Static Helper Functions ---
 
 /**
- * @brief Finds the index of an active attack instance by its unique ID.
- * Linearly searches the active portion of the attacks array.
+ * @brief Grows the attack arrays to at least the given number of slots.
+ * Call with the slot map's capacity after every allocation; the slot map may have grown to make room.
  * @param am The AttackManager instance.
- * @param attack_id The unique ID of the attack to find.
- * @return The index of the attack if found, otherwise -1.
+ * @param capacity Slots the arrays must hold.
+ * @return True on success, false if out of memory.
  */
-static int find_attack_by_id(AttackManager am, uint32_t attack_id)
+static bool reserve_attack_storage(AttackManager am, int capacity)
 {
-    if (!am)
-        return -1;
-    for (int i = 0; i < am->active_attack_count; ++i)
+    if (capacity <= am->capacity)
+        return true;
+
+    AttackInstance *attacks = (AttackInstance *)SDL_realloc(am->attacks, (size_t)capacity * sizeof(AttackInstance));
+    if (!attacks)
     {
-        if (am->attacks[i].id == attack_id)
-        {
-            return i;
-        }
+        SDL_OutOfMemory();
+        return false;
     }
-    return -1;
+    am->attacks = attacks;
+    memset(&am->attacks[am->capacity], 0, (size_t)(capacity - am->capacity) * sizeof(AttackInstance));
+    am->capacity = capacity;
+    return true;
 }
 
 /**
- * @brief Finds the first inactive slot in the attacks array using the compacting approach.
- * If the active count is less than the max capacity, the next slot is available.
- * @param am The AttackManager instance.
- * @return The index of the next available slot, or -1 if the pool is full.
+ * @brief Makes sure the due list holds at least the given number of sweep results.
+ * @return True on success, false if out of memory.
  */
-static int find_inactive_attack_slot(AttackManager am)
+static bool reserve_due_impacts(AttackManager am, int needed)
 {
-    if (!am)
-        return -1;
-    if (am->active_attack_count < MAX_ATTACKS)
+    if (needed <= am->due_capacity)
+        return true;
+
+    int capacity = am->due_capacity ? am->due_capacity * 2 : ATTACK_SWEEP_CHUNK * 4;
+    while (capacity < needed)
+        capacity *= 2;
+    AttackHits *due = (AttackHits *)SDL_realloc(am->due, (size_t)capacity * sizeof(AttackHits));
+    if (!due)
     {
-        return am->active_attack_count;
+        SDL_OutOfMemory();
+        return false;
     }
-    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Attack pool is full (%d/%d)", am->active_attack_count, MAX_ATTACKS);
-    return -1;
+    am->due = due;
+    am->due_capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Computes the time an attack needs to get within hit range of its target.
+ * Attacks travel in a straight line at constant speed, so this is known at spawn.
+ * @param attack Pointer to the freshly spawned AttackInstance.
+ * @return Travel time in seconds.
+ */
+static float compute_attack_travel_time(const AttackInstance *attack)
+{
+    float dx = attack->target.x - attack->start_pos.x;
+    float dy = attack->target.y - attack->start_pos.y;
+    float distance = SimMath_Length(dx, dy);
+    float speed = SimMath_Length(attack->velocity.x, attack->velocity.y);
+
+    // Not moving at all: resolve on the next update.
+    if (speed < 0.001f)
+        return 0.0f;
+
+    // The flight ends where the path first enters the hit range around the target.
+    float max_time = distance / speed;
+    SDL_FPoint end = {attack->start_pos.x + attack->velocity.x * max_time, attack->start_pos.y + attack->velocity.y * max_time};
+    float t;
+    if (!Collision_SegmentCircle(attack->start_pos, end, attack->target, attack->hit_range, &t))
+        return max_time;
+    return t * max_time;
+}
+
+/**
+ * @brief Returns the world position of an attack at the given manager time.
+ */
+static SDL_FPoint get_attack_position_at(const AttackInstance *attack, float time)
+{
+    float elapsed = time - attack->spawn_time;
+    if (elapsed > attack->impact_time - attack->spawn_time)
+        elapsed = attack->impact_time - attack->spawn_time;
+    SDL_FPoint pos = {
+        attack->start_pos.x + attack->velocity.x * elapsed,
+        attack->start_pos.y + attack->velocity.y * elapsed};
+    return pos;
+}
+
+/**
+ * @brief Removes an attack from the pool and releases its slot.
+ * @param am The AttackManager instance.
+ * @param slot Slot of the attack to remove.
+ */
+static void release_attack_slot(AttackManager am, int slot)
+{
+    SlotMap_Free(am->slots, am->attacks[slot].id);
+    memset(&am->attacks[slot], 0, sizeof(AttackInstance));
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Removed attack at slot %d. New count: %d", slot, SlotMap_GetCount(am->slots));
 }
 
 /**
- * @brief Updates the animation frame for a single attack instance.
- * @param attack Pointer to the AttackInstance to update.
- * @param delta_time Time since the last frame.
+ * @brief Finds what an attack hits at its impact position, without applying anything.
+ * Runs on the job workers: it only writes to the attack itself and to out.
+ * @param attack Pointer to the AttackInstance that hit.
+ * @param state Pointer to the main AppState.
+ * @param position World position of the impact.
+ * @param contact The entry whose contact ended the flight, or NULL if the attack reached its target.
+ * @param out Receives the overlapped objects; out->count is 0 if the impact has no effect here.
  */
-static void update_attack_animation(AttackInstance *attack, float delta_time)
+static void collect_attack_hits(AttackInstance *attack, AppState *state, SDL_FPoint position, const SpatialEntry *contact, AttackHits *out)
 {
-    if (!attack || !attack->active)
+    out->count = 0;
+    if (!attack || !attack->active || !state)
+        return;
+
+    attack->position = position;
+
+    if (!state->map_state || !state->spatial_hash)
+        return;
+
+    int kind_mask;
+    bool enemy_team;
+    float damage;
+    if (attack->attacker == OBJECT_TYPE_PLAYER)
+    {
+        // Only the owner reports hits from its own attacks, unless no owner is there to report them.
+        if (attack->owner_id != NetClient_GetClientID(state->net_client_state) && !state->resolve_all_hits)
+            return;
+        kind_mask = SPATIAL_KIND_ALL;
+        enemy_team = !attack->team;
+        damage = state->tuning.player_attack_damage;
+    }
+    else if (attack->attacker == OBJECT_TYPE_TOWER)
+    {
+        // Tower attacks are replayed on every peer; only the server damages minions.
+        kind_mask = state->is_server ? SPATIAL_KIND_UNIT : SPATIAL_KIND_PLAYER;
+        // The owner comes from the network; an out-of-range tower index resolves to no tower.
+        if (!state->tower_manager || attack->owner_id >= state->tower_manager->tower_count)
+            return;
+        const bool *tower_team = Ecs_Get(state->world, state->tower_manager->towers[attack->owner_id].entity, ECS_TEAM);
+        if (!tower_team)
+            return;
+        enemy_team = !*tower_team;
+        damage = state->tuning.tower_attack_damage;
+    }
+    else
+    {
         return;
+    }
+
+    // Minions are hit by the whole projectile, everything else by its center point.
+    SDL_FRect attackRect = {
+        attack->position.x - attack->render_width / 2.0f,
+        attack->position.y - attack->render_height / 2.0f,
+        attack->render_width,
+        attack->render_height};
 
-    attack->anim_timer += delta_time;
-    if (attack->anim_timer >= PLAYER_ATTACK_SPRITE_TIME_PER_FRAME)
+    out->damage = damage;
+    int count = SpatialHash_QueryRect(state->spatial_hash, &attackRect, kind_mask, enemy_team, out->hits, ATTACK_MAX_HITS);
+    for (int h = 0; h < count; h++)
     {
-        attack->anim_timer -= PLAYER_ATTACK_SPRITE_TIME_PER_FRAME;
-        attack->current_frame = (attack->current_frame + 1) % PLAYER_ATTACK_SPRITE_NUM_FRAMES;
-        attack->sprite_portion.x = (float)attack->current_frame * PLAYER_ATTACK_SPRITE_FRAME_WIDTH;
-        attack->sprite_portion.w = PLAYER_ATTACK_SPRITE_FRAME_WIDTH;
-        attack->sprite_portion.h = PLAYER_ATTACK_SPRITE_FRAME_HEIGHT;
-        attack->sprite_portion.y = PLAYER_ATTACK_SPRITE_ROW_Y;
+        const SpatialEntry *hit = &out->hits[h];
+        if (hit->kind == SPATIAL_KIND_MINION || SDL_PointInRectFloat(&attack->position, &hit->rect))
+            out->hits[out->count++] = *hit;
     }
+
+    // The contact point lies on the edge of the touched object, so rounding may have dropped it above.
+    if (!contact || !(contact->kind & kind_mask) || out->count == ATTACK_MAX_HITS)
+        return;
+    for (int h = 0; h < out->count; h++)
+    {
+        if (out->hits[h].kind == contact->kind && out->hits[h].index == contact->index)
+            return;
+    }
+    out->hits[out->count++] = *contact;
 }
 
 /**
- * @brief Updates the state of a single active attack instance for one frame.
- * Handles movement, boundary checks, and potential collision/lifetime logic.
- * @param attack Pointer to the AttackInstance to update.
+ * @brief Sweeps an attack along the part of its flight that falls into this step.
+ * The flight ends at the first enemy the projectile touches, or at its target if it touches none.
+ * Each peer sweeps against its own spatial hash, so peers that do not apply an attack's damage may
+ * see it stop at a slightly different point; only the peer that applies the damage decides the hit.
+ * Runs on the job workers: it only writes to the attack itself and to out.
+ * @param attack Pointer to the AttackInstance to sweep.
  * @param state Pointer to the main AppState.
+ * @param step_start AttackManager clock (seconds) at the start of the step.
+ * @param step_end AttackManager clock (seconds) at the end of the step.
+ * @param out Receives the impact, if any; out->impact is false if the attack is still in flight.
  */
-static void update_single_attack(AttackInstance *attack, AppState *state)
+static void sweep_attack(AttackInstance *attack, AppState *state, float step_start, float step_end, AttackHits *out)
 {
-    if (!attack || !attack->active || !state)
-        return;
+    out->impact = false;
+    out->count = 0;
 
-    // --- Movement ---
-    attack->position.x += attack->velocity.x * state->delta_time;
-    attack->position.y += attack->velocity.y * state->delta_time;
+    float start_time = SDL_max(step_start, attack->spawn_time);
+    float end_time = SDL_min(step_end, attack->impact_time);
+    if (state->spatial_hash && end_time > start_time)
+    {
+        // Minions are hit by the whole projectile, everything else by its center point.
+        int kind_mask = attack->attacker == OBJECT_TYPE_TOWER ? SPATIAL_KIND_UNIT : SPATIAL_KIND_ALL;
+        int enemy_team = !attack->team;
+        SDL_FPoint from = get_attack_position_at(attack, start_time);
+        SDL_FPoint to = get_attack_position_at(attack, end_time);
+        SDL_FPoint extent = {attack->render_width / 2.0f, attack->render_height / 2.0f};
+        SpatialSweepHit minion_hit, point_hit;
+        bool touched_minion = SpatialHash_QuerySegment(state->spatial_hash, from, to, extent, kind_mask & SPATIAL_KIND_MINION,
+                                                       enemy_team, &minion_hit, 1) > 0;
+        bool touched_other = SpatialHash_QuerySegment(state->spatial_hash, from, to, (SDL_FPoint){0.0f, 0.0f},
+                                                      kind_mask & ~SPATIAL_KIND_MINION, enemy_team, &point_hit, 1) > 0;
+        if (touched_minion || touched_other)
+        {
+            const SpatialSweepHit *first = (touched_minion && (!touched_other || minion_hit.t <= point_hit.t)) ? &minion_hit : &point_hit;
+            SDL_FPoint position = {from.x + (to.x - from.x) * first->t, from.y + (to.y - from.y) * first->t};
+            out->impact = true;
+            out->time = start_time + (end_time - start_time) * first->t;
+            collect_attack_hits(attack, state, position, &first->entry, out);
+            return;
+        }
+    }
 
-    update_attack_animation(attack, state->delta_time);
+    if (attack->impact_time <= step_end)
+    {
+        out->impact = true;
+        out->time = attack->impact_time;
+        collect_attack_hits(attack, state, get_attack_position_at(attack, attack->impact_time), NULL, out);
+    }
+}
 
-    static Uint64 attack_cooldown = 0;
+/**
+ * @brief Returns true if impact a comes before impact b. Ties are broken by attack ID, which every
+ * peer shares, so the damage is queued in the same order everywhere.
+ */
+static bool impact_before(AttackManager am, const AttackHits *a, const AttackHits *b)
+{
+    if (a->time != b->time)
+        return a->time < b->time;
+    return am->attacks[a->slot].id < am->attacks[b->slot].id;
+}
 
-    // --- Boundary Check / Lifetime ---
-    if (state->map_state)
+/**
+ * @brief Queues the damage of an attack that hit something or reached its target on the damage bus.
+ * Runs exactly once per attack, at its impact, after collect_attack_hits.
+ * @param attack Pointer to the AttackInstance that hit.
+ * @param state Pointer to the main AppState.
+ * @param hits The objects collected for this impact.
+ */
+static void apply_attack_hits(const AttackInstance *attack, AppState *state, const AttackHits *hits)
+{
+    float damage = hits->damage;
+    for (int h = 0; h < hits->count; h++)
     {
-        float dist_x = attack->position.x - attack->target.x;
-        float dist_y = attack->position.y - attack->target.y;
+        const SpatialEntry *hit = &hits->hits[h];
+        int i = hit->index;
 
-        float distance_to_target = sqrtf(dist_x * dist_x + dist_y * dist_y);
+        if (hit->kind == SPATIAL_KIND_MINION)
+        {
+            // Entries are captured at the start of the step; an earlier impact may have removed its entity.
+            const float *cooldown = Ecs_Get(state->world, hit->entity, ECS_COOLDOWN);
+            if (!cooldown)
+                continue;
+
+            // Minions that just struck are briefly immune to players (the cooldown is only tracked by the server).
+            // Tower shots always land; each attack applies its hits once, so no cooldown is needed against repeats.
+            if (attack->attacker != OBJECT_TYPE_PLAYER || MINION_ATTACK_COOLDOWN - *cooldown > MINION_HIT_IMMUNITY)
+                DamageBus_Push(state->damage_bus, DAMAGE_TARGET_MINION, i, damage);
+            continue;
+        }
 
-        if (distance_to_target < attack->hit_range)
+        switch (hit->kind)
         {
-            if (attack->attacker == OBJECT_TYPE_PLAYER)
-            {
-                if (attack->owner_id == NetClient_GetClientID(state->net_client_state))
-                {
-                    for (int i = 0; i < MAX_TOTAL_TOWERS; i++)
-                    {
-                        TowerInstance tempTower = state->tower_manager->towers[i];
-                        if (tempTower.team != state->team)
-                        {
-                            if (SDL_PointInRectFloat(&attack->position, &tempTower.rect))
-                            {
-                                SDL_Log("Attack Hit Tower %d", i);
-                                damageTower(*state, i, PLAYER_ATTACK_DAMAGE_VALUE, true, 0);
-                            }
-                        }
-                    }
-
-                    for (int i = 0; i < MAX_BASES; i++)
-                    {
-                        BaseInstance tempBase = state->base_manager->bases[i];
-                        if (tempBase.team != state->team)
-                        {
-                            if (SDL_PointInRectFloat(&attack->position, &tempBase.rect))
-                            {
-                                SDL_Log("Attack Hit Base %d", i);
-                                damageBase(state, i, PLAYER_ATTACK_DAMAGE_VALUE, true);
-                            }
-                        }
-                    }
-
-                    for (int i = 0; i < MINION_MAX_AMOUNT; i++)
-                    {
-                        MinionData minion = state->minion_manager->minions[i];
-                        SDL_FRect minionRect = {minion.position.x, minion.position.y, MINION_WIDTH, MINION_HEIGHT};
-                        SDL_FRect attackRect = {attack->position.x, attack->position.y, attack->render_width, attack->render_height};
-
-                        if (!minion.active)
-                            continue;
-
-                        if (minion.team != state->team)
-                        {
-                            if (SDL_HasRectIntersectionFloat(&attackRect, &minionRect))
-                            {
-                                if (state->sync_clock - minion.attack_cooldown_timer > 500)
-                                {
-                                    damageMinion(*state, i, PLAYER_ATTACK_DAMAGE_VALUE, true, 0);
-                                    attack_cooldown = state->sync_clock;
-                                }
-                            }
-                        }
-                    }
-
-                    for (int i = 0; i < MAX_CLIENTS; i++)
-                    {
-                        if (state->player_manager->players[i].active)
-                        {
-                            PlayerInstance tempPlayer = state->player_manager->players[i];
-                            if (tempPlayer.team != state->team)
-                            {
-                                if (SDL_PointInRectFloat(&attack->position, &tempPlayer.rect))
-                                {
-                                    SDL_Log("Attack Hit Player %d", i);
-                                    damagePlayer(*state, i, PLAYER_ATTACK_DAMAGE_VALUE, true);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            else if (attack->attacker == OBJECT_TYPE_TOWER)
+        case SPATIAL_KIND_TOWER:
+            SDL_Log("Attack Hit Tower %d", i);
+            DamageBus_Push(state->damage_bus, DAMAGE_TARGET_TOWER, i, damage);
+            break;
+        case SPATIAL_KIND_BASE:
+            SDL_Log("Attack Hit Base %d", i);
+            DamageBus_Push(state->damage_bus, DAMAGE_TARGET_BASE, i, damage);
+            break;
+        case SPATIAL_KIND_PLAYER:
+            if (state->player_manager->players[i].active)
             {
-                for (int i = 0; i < MAX_CLIENTS; i++)
-                {
-                    if (state->player_manager->players[i].active)
-                    {
-                        PlayerInstance tempPlayer = state->player_manager->players[i];
-                        if (tempPlayer.team != state->tower_manager->towers[attack->owner_id].team)
-                        {
-                            if (SDL_PointInRectFloat(&attack->position, &tempPlayer.rect))
-                            {
-                                SDL_Log("Attack Hit Player %d", i);
-                                damagePlayer(*state, i, TOWER_ATTACK_DAMAGE_VALUE, true);
-                            }
-                        }
-                    }
-                }
-                for (int i = 0; i < MINION_MAX_AMOUNT; i++)
-                {
-                    MinionData minion = state->minion_manager->minions[i];
-                    SDL_FRect minionRect = {minion.position.x, minion.position.y, MINION_WIDTH, MINION_HEIGHT};
-                    SDL_FRect attackRect = {attack->position.x, attack->position.y, attack->render_width, attack->render_height};
-
-                    if (!minion.active)
-                        continue;
-
-                    if (minion.team != state->tower_manager->towers[attack->owner_id].team)
-                    {
-                        if (SDL_HasRectIntersectionFloat(&attackRect, &minionRect))
-                        {
-                            if (state->sync_clock - attack_cooldown > 1000)
-                            {
-                                damageMinion(*state, i, PLAYER_ATTACK_DAMAGE_VALUE, true, 0);
-                                attack_cooldown = state->sync_clock;
-                            }
-                        }
-                    }
-                }
+                SDL_Log("Attack Hit Player %d", i);
+                DamageBus_Push(state->damage_bus, DAMAGE_TARGET_PLAYER, i, damage);
+                if (state->is_server && attack->attacker == OBJECT_TYPE_PLAYER)
+                    PlayerManager_RecordPlayerHit(state, attack->owner_id, i);
             }
-
-            attack->active = false;
-            return;
+            break;
+        default:
+            break;
         }
     }
 }
 
+/**
+ * @brief Returns the shared texture an attack is drawn with: fireballs for red, lightning arrows for blue.
+ */
+static SDL_Texture *get_attack_texture(AttackManager am, const AttackInstance *attack)
+{
+    return attack->team ? am->fireball_texture : am->lightning_arrow_texture;
+}
+
 /**
  * @brief Renders a single active attack instance to the screen.
+ * Position and animation frame are derived from the time since spawn.
+ * @param am The AttackManager instance.
  * @param attack Pointer to the AttackInstance to render.
  * @param state Pointer to the main AppState.
  */
-static void render_single_attack(const AttackInstance *attack, AppState *state)
+static void render_single_attack(AttackManager am, const AttackInstance *attack, AppState *state)
 {
-    if (!attack || !attack->active || !attack->texture || !state || !state->renderer || !state->camera_state)
+    SDL_Texture *texture = attack ? get_attack_texture(am, attack) : NULL;
+    if (!attack || !attack->active || !texture || !state || !state->renderer || !state->camera_state)
     {
         return;
     }
@@ -261,27 +360,138 @@ static void render_single_attack(const AttackInstance *attack, AppState *state)
     CameraState camera = state->camera_state;
     float cam_x = Camera_GetX(camera);
     float cam_y = Camera_GetY(camera);
+    // Attacks move analytically, so render exactly at the time between steps instead of blending.
+    float render_time = am->sim_time + state->render_alpha * state->sim_step;
+    SDL_FPoint position = get_attack_position_at(attack, render_time);
+
+    int frame = (int)((render_time - attack->spawn_time) / PLAYER_ATTACK_SPRITE_TIME_PER_FRAME) % PLAYER_ATTACK_SPRITE_NUM_FRAMES;
+    SDL_FRect sprite_portion = attack->sprite_portion;
+    sprite_portion.x = (float)frame * PLAYER_ATTACK_SPRITE_FRAME_WIDTH;
 
     SDL_FRect dst_rect = {
-        .x = attack->position.x - cam_x - attack->render_width / 2.0f,
-        .y = attack->position.y - cam_y - attack->render_height / 2.0f,
+        .x = position.x - cam_x - attack->render_width / 2.0f,
+        .y = position.y - cam_y - attack->render_height / 2.0f,
         .w = attack->render_width,
         .h = attack->render_height};
 
     SDL_RenderTextureRotated(state->renderer,
-                             attack->texture,
-                             &attack->sprite_portion,
+                             texture,
+                             &sprite_portion,
                              &dst_rect,
                              attack->angle_deg,
                              NULL,
                              SDL_FLIP_NONE);
 }
 
+/**
+ * @brief Initializes the attack in an already allocated slot from a spawn message and schedules its impact.
+ * @param am The AttackManager instance.
+ * @param slot Slot of the attack (allocated in am->slots, storage reserved).
+ * @param data The spawn message.
+ * @return True on success. On failure the slot is left for the caller to release.
+ */
+static bool spawn_attack_in_slot(AttackManager am, int slot, const Msg_ServerSpawnAttackData *data)
+{
+    AttackInstance *attack = &am->attacks[slot];
+    // Ensure the slot is clean before populating, preventing leftover data from previous use.
+    memset(attack, 0, sizeof(AttackInstance));
+
+    // --- Populate Common Data ---
+    attack->active = true;
+    attack->id = data->attack_id;
+    attack->type = (AttackType)data->attack_type;
+    attack->owner_id = data->owner_id;
+    attack->position = data->start_pos;
+    attack->start_pos = data->start_pos;
+    attack->target = data->target_pos;
+    attack->velocity = data->velocity;
+    attack->attacker = data->attacker;
+    attack->team = data->team;
+
+    // --- Populate Type-Specific Data ---
+    // switch (attack->attacker)
+    // {
+    // case OBJECT_TYPE_PLAYER:
+
+    attack->render_width = PLAYER_ATTACK_RENDER_WIDTH;
+    attack->render_height = PLAYER_ATTACK_RENDER_HEIGHT;
+    attack->hit_range = PLAYER_ATTACK_HIT_RANGE;
+    attack->angle_deg = SimMath_AngleDeg(attack->velocity.y, attack->velocity.x);
+
+    attack->sprite_portion = (SDL_FRect){
+        0.0f,
+        PLAYER_ATTACK_SPRITE_ROW_Y,
+        PLAYER_ATTACK_SPRITE_FRAME_WIDTH,
+        PLAYER_ATTACK_SPRITE_FRAME_HEIGHT};
+    //     break;
+
+    // default:
+    //     SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Attempted to spawn unknown attack type via network: %u", (unsigned int)attack->type);
+    //     attack->active = false;
+    //     return;
+    // }
+
+    // --- Schedule Impact ---
+    // Straight line at constant speed, so the arrival time is known right away. The per-step
+    // sweeps end the flight earlier if the projectile touches an enemy on the way.
+    attack->spawn_time = am->sim_time;
+    attack->impact_time = am->sim_time + compute_attack_travel_time(attack);
+
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Spawned attack ID %u (type %u) at slot %d, impact in %.2fs. Active count: %d",
+                 attack->id, (unsigned int)attack->type, slot, attack->impact_time - attack->spawn_time, SlotMap_GetCount(am->slots));
+    return true;
+}
+
+/**
+ * @brief Allocates a slot on the server, spawns the attack locally and broadcasts it.
+ * The slot's handle becomes the attack ID.
+ * @param am The AttackManager instance.
+ * @param state Pointer to the main AppState (server).
+ * @param spawn_msg The spawn message with everything but attack_id filled in.
+ * @return True on success, false if the pool is full or the attack could not be created.
+ */
+static bool server_spawn_attack(AttackManager am, AppState *state, Msg_ServerSpawnAttackData *spawn_msg)
+{
+    SlotHandle handle = SlotMap_Alloc(am->slots);
+    if (handle == SLOT_HANDLE_INVALID)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Attack pool is full (%d/%d): %s", SlotMap_GetCount(am->slots), ATTACK_MAX_CAPACITY, SDL_GetError());
+        return false;
+    }
+    spawn_msg->attack_id = handle;
+    if (!reserve_attack_storage(am, SlotMap_GetCapacity(am->slots)) || !spawn_attack_in_slot(am, SlotMap_Resolve(am->slots, handle), spawn_msg))
+    {
+        SlotMap_Free(am->slots, handle);
+        return false;
+    }
+
+    NetServer_BroadcastMessage(state->net_server_state, spawn_msg, sizeof(Msg_ServerSpawnAttackData), -1);
+    return true;
+}
+
+/**
+ * @brief JobRangeFunc sweeping a range of the active attacks (dense slot map order).
+ */
+static void run_sweep_range(void *data, int begin, int end)
+{
+    const AttackSweepJob *job = (const AttackSweepJob *)data;
+    AttackManager am = job->am;
+    for (int n = begin; n < end; n++)
+    {
+        AttackHits *out = &am->due[n];
+        out->slot = SlotMap_GetSlotAt(am->slots, n);
+        sweep_attack(&am->attacks[out->slot], job->state, job->step_start, am->sim_time, out);
+    }
+}
+
 // --- Static Callback Functions (for EntityManager) ---
 
 /**
- * @brief Internal function to update all active attacks and remove inactive ones.
- * Iterates backwards to allow safe removal using the compacting array method.
+ * @brief Internal function to advance the attack clock and resolve this step's impacts.
+ * Positions still follow from the time since spawn; each step only sweeps the path every attack
+ * covers during the step against the spatial hash, so no hit is skipped however long the step is.
+ * The sweeps run on the job workers and their impacts are applied here in impact order, so damage
+ * and network messages stay on the main thread.
  * @param am The AttackManager instance.
  * @param state The main application state.
  */
@@ -289,28 +499,40 @@ static void Internal_AttackManagerUpdate(AttackManager am, AppState *state)
 {
     if (!am || !state)
         return;
-    // Iterate backwards to allow safe removal of elements during iteration
-    // without skipping the next element after a removal.
-    for (int i = am->active_attack_count - 1; i >= 0; --i)
+    float step_start = am->sim_time;
+    am->sim_time += state->delta_time;
+
+    int count = SlotMap_GetCount(am->slots);
+    if (count == 0 || !reserve_due_impacts(am, count))
+        return;
+
+    // --- Sweep Every Attack in Parallel ---
+    AttackSweepJob job = {am, state, step_start};
+    JobSystem_ParallelFor(state->jobs, count, ATTACK_SWEEP_CHUNK, run_sweep_range, &job);
+
+    // --- Move the Impacts to the Front, in Impact Order ---
+    // Only a handful of attacks land per step, so an insertion sort is enough.
+    int due_count = 0;
+    for (int n = 0; n < count; n++)
     {
-        if (am->attacks[i].active)
+        if (!am->due[n].impact)
+            continue;
+        AttackHits impact = am->due[n];
+        int pos = due_count++;
+        while (pos > 0 && impact_before(am, &impact, &am->due[pos - 1]))
         {
-            update_single_attack(&am->attacks[i], state);
+            am->due[pos] = am->due[pos - 1];
+            pos--;
         }
+        am->due[pos] = impact;
+    }
 
-        // If attack became inactive, remove it by swapping with the last active element.
-        if (!am->attacks[i].active)
-        {
-            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Removing inactive attack at index %d (ID: %u). New count: %d", i, am->attacks[i].id, am->active_attack_count - 1);
-            // This compaction keeps all active elements contiguous at the start of the array,
-            // allowing simpler iteration for rendering and finding slots.
-            if (i < am->active_attack_count - 1)
-            {
-                am->attacks[i] = am->attacks[am->active_attack_count - 1];
-            }
-            memset(&am->attacks[am->active_attack_count - 1], 0, sizeof(AttackInstance));
-            am->active_attack_count--;
-        }
+    // --- Apply Them in Order ---
+    for (int d = 0; d < due_count; d++)
+    {
+        int slot = am->due[d].slot;
+        apply_attack_hits(&am->attacks[slot], state, &am->due[d]);
+        release_attack_slot(am, slot);
     }
 }
 
@@ -323,10 +545,9 @@ static void Internal_AttackManagerRender(AttackManager am, AppState *state)
 {
     if (!am || !state)
         return;
-    // Only need to iterate up to the active count due to compaction in update.
-    for (int i = 0; i < am->active_attack_count; ++i)
+    for (int n = 0; n < SlotMap_GetCount(am->slots); ++n)
     {
-        render_single_attack(&am->attacks[i], state);
+        render_single_attack(am, &am->attacks[SlotMap_GetSlotAt(am->slots, n)], state);
     }
 }
 
@@ -350,6 +571,15 @@ static void Internal_AttackManagerCleanup(AttackManager am)
         SDL_DestroyTexture(am->lightning_arrow_texture);
         am->lightning_arrow_texture = NULL;
     }
+
+    SlotMap_Destroy(am->slots);
+    SDL_free(am->attacks);
+    SDL_free(am->due);
+    am->slots = NULL;
+    am->attacks = NULL;
+    am->due = NULL;
+    am->capacity = 0;
+    am->due_capacity = 0;
 }
 
 /**
@@ -400,9 +630,9 @@ static void attack_manager_cleanup_callback(EntityManager manager, AppState *sta
  */
 AttackManager AttackManager_Init(AppState *state)
 {
-    if (!state || !state->renderer || !state->entity_manager)
+    if (!state || !state->entity_manager)
     {
-        SDL_SetError("Invalid AppState or missing renderer/entity_manager for AttackManager_Init");
+        SDL_SetError("Invalid AppState or missing entity_manager for AttackManager_Init");
         return NULL;
     }
 
@@ -412,33 +642,53 @@ AttackManager AttackManager_Init(AppState *state)
         SDL_OutOfMemory();
         return NULL;
     }
-    am->active_attack_count = 0;
-    am->next_attack_id = 1;
+    am->sim_time = 0.0f;
 
-    // --- Load Resources ---
-    const char fireball_path[] = "./resources/Sprites/Red_Team/Fire_Wizard/Fireball_Charge.png";
-    am->fireball_texture = IMG_LoadTexture(state->renderer, fireball_path);
-    if (!am->fireball_texture)
+    // Attack IDs are slot map handles; the pool starts at MAX_ATTACKS and grows on demand.
+    am->slots = SlotMap_Create(MAX_ATTACKS, ATTACK_MAX_CAPACITY, ATTACK_HANDLE_INDEX_BITS, ATTACK_HANDLE_GENERATION_BITS);
+    if (!am->slots || !reserve_attack_storage(am, SlotMap_GetCapacity(am->slots)))
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Attack Init] Failed load texture '%s': %s", fireball_path, SDL_GetError());
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Attack Init] Failed to create attack pool: %s", SDL_GetError());
+        Internal_AttackManagerCleanup(am);
         SDL_free(am);
         return NULL;
     }
-    SDL_SetTextureScaleMode(am->fireball_texture, SDL_SCALEMODE_NEAREST);
 
-    const char lightning_arrow_path[] = "./resources/Sprites/Blue_Team/Lightning_Wizard/Lightning_Arrow_Charge.png";
-    am->lightning_arrow_texture = IMG_LoadTexture(state->renderer, lightning_arrow_path);
-    if (!am->lightning_arrow_texture)
+    // --- Load Resources ---
+    // Attacks fly the same without their textures, which only a renderer can load.
+    if (state->renderer)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Attack Init] Failed load texture '%s': %s", lightning_arrow_path, SDL_GetError());
-        SDL_free(am);
-        return NULL;
+        const char fireball_path[] = "./resources/Sprites/Red_Team/Fire_Wizard/Fireball_Charge.png";
+        am->fireball_texture = IMG_LoadTexture(state->renderer, fireball_path);
+        if (!am->fireball_texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Attack Init] Failed load texture '%s': %s", fireball_path, SDL_GetError());
+            Internal_AttackManagerCleanup(am);
+            SDL_free(am);
+            return NULL;
+        }
+        SDL_SetTextureScaleMode(am->fireball_texture, SDL_SCALEMODE_NEAREST);
+
+        const char lightning_arrow_path[] = "./resources/Sprites/Blue_Team/Lightning_Wizard/Lightning_Arrow_Charge.png";
+        am->lightning_arrow_texture = IMG_LoadTexture(state->renderer, lightning_arrow_path);
+        if (!am->lightning_arrow_texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Attack Init] Failed load texture '%s': %s", lightning_arrow_path, SDL_GetError());
+            Internal_AttackManagerCleanup(am);
+            SDL_free(am);
+            return NULL;
+        }
+        SDL_SetTextureScaleMode(am->lightning_arrow_texture, SDL_SCALEMODE_NEAREST);
     }
-    SDL_SetTextureScaleMode(am->lightning_arrow_texture, SDL_SCALEMODE_NEAREST);
 
     // --- Register with EntityManager ---
     EntityFunctions attack_funcs = {
         .name = "attack_manager",
+        .update_phase = ENTITY_PHASE_SIMULATE,
+        .render_phase = ENTITY_PHASE_RENDER,
+        .reads = ENTITY_RES_SPATIAL_HASH | ENTITY_RES_CAMERA | ENTITY_RES_MINIONS | ENTITY_RES_PLAYERS,
+        // Impacts only queue damage; the damage bus applies it after the simulation.
+        .writes = ENTITY_RES_ATTACKS | ENTITY_RES_DAMAGE | ENTITY_RES_NETWORK | ENTITY_RES_RENDERER,
         .update = attack_manager_update_callback,
         .render = attack_manager_render_callback,
         .cleanup = attack_manager_cleanup_callback,
@@ -467,12 +717,10 @@ void AttackManager_Destroy(AttackManager am)
     if (am)
     {
         am->fireball_texture = NULL;
-        SDL_free(am);
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AttackManager state container destroyed.");
-    }
-    if (am)
-    {
         am->lightning_arrow_texture = NULL;
+        SlotMap_Destroy(am->slots);
+        SDL_free(am->attacks);
+        SDL_free(am->due);
         SDL_free(am);
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AttackManager state container destroyed.");
     }
@@ -480,69 +728,72 @@ void AttackManager_Destroy(AttackManager am)
 
 /**
  * @brief Handles a spawn message received from the server for a new attack instance.
- * Finds an available slot and initializes the attack based on the received data.
+ * Records the spawn; the attack is created at the next sync point.
  * Called by the NetClient when receiving MSG_TYPE_S_SPAWN_ATTACK.
  * @param am The AttackManager instance.
+ * @param state Pointer to the main AppState.
  * @param data Pointer to the received Msg_ServerSpawnAttackData containing spawn details.
  */
-void AttackManager_HandleServerSpawn(AttackManager am, const Msg_ServerSpawnAttackData *data)
+void AttackManager_HandleServerSpawn(AttackManager am, AppState *state, const Msg_ServerSpawnAttackData *data)
 {
-    if (!am || !data)
-        return;
-    int slot = find_inactive_attack_slot(am);
-    if (slot == -1)
+    // The server already spawned the attack in its own simulation.
+    if (!am || !state || !data || state->is_server)
         return;
 
-    AttackInstance *attack = &am->attacks[slot];
-    // Ensure the slot is clean before populating, preventing leftover data from previous use.
-    memset(attack, 0, sizeof(AttackInstance));
-
-    // --- Populate Common Data ---
-    attack->active = true;
-    attack->id = data->attack_id;
-    attack->type = (AttackType)data->attack_type;
-    attack->owner_id = data->owner_id;
-    attack->position = data->start_pos;
-    attack->target = data->target_pos;
-    attack->velocity = data->velocity;
-    attack->attacker = data->attacker;
-    attack->team = data->team;
-
-    // --- Populate Type-Specific Data ---
-    // switch (attack->attacker)
-    // {
-    // case OBJECT_TYPE_PLAYER:
+    Command command = {.type = COMMAND_SPAWN_ATTACK};
+    command.attack = *data;
+    CommandBuffer_Record(state->command_buffer, &command);
+}
 
-    attack->texture = attack->team ? am->fireball_texture : am->lightning_arrow_texture;
-    if (!attack->texture)
+/**
+ * @brief Creates a recorded attack. On the server this assigns the ID and broadcasts the spawn;
+ * on a client it claims the slot named by the attack ID.
+ * Called by the CommandBuffer at the sync point.
+ * @param am The AttackManager instance.
+ * @param state Pointer to the main AppState.
+ * @param data The spawn message (attack_id is ignored on the server).
+ */
+void AttackManager_ApplySpawn(AttackManager am, AppState *state, const Msg_ServerSpawnAttackData *data)
+{
+    if (!am || !state || !data)
+        return;
+    if (state->is_server)
     {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Attack texture missing for attack %u", attack->id);
-        attack->active = false;
+        Msg_ServerSpawnAttackData spawn_msg = *data;
+        if (server_spawn_attack(am, state, &spawn_msg))
+        {
+            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Spawn] Broadcasting attack ID %u (attacker %d, owner %u)", spawn_msg.attack_id, (int)spawn_msg.attacker, (unsigned int)spawn_msg.owner_id);
+        }
         return;
     }
-    attack->render_width = PLAYER_ATTACK_RENDER_WIDTH;
-    attack->render_height = PLAYER_ATTACK_RENDER_HEIGHT;
-    attack->hit_range = PLAYER_ATTACK_HIT_RANGE;
-    attack->angle_deg = atan2f(attack->velocity.y, attack->velocity.x) * (180.0f / (float)M_PI);
-
-    attack->current_frame = 0;
-    attack->anim_timer = 0.0f;
-    attack->sprite_portion = (SDL_FRect){
-        0.0f,
-        PLAYER_ATTACK_SPRITE_ROW_Y,
-        PLAYER_ATTACK_SPRITE_FRAME_WIDTH,
-        PLAYER_ATTACK_SPRITE_FRAME_HEIGHT};
-    //     break;
-
-    // default:
-    //     SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Attempted to spawn unknown attack type via network: %u", (unsigned int)attack->type);
-    //     attack->active = false;
-    //     return;
-    // }
+    if (SlotMap_Resolve(am->slots, data->attack_id) >= 0)
+        return; // Already known
+    if (data->attacker == OBJECT_TYPE_TOWER)
+        TowerManager_NoteShot(state, data->owner_id, data->target_pos);
+
+    // The server only reuses a slot after the previous attack in it has hit. If that impact is still
+    // pending here (this client runs slightly behind), finish the flight now to free the slot: the
+    // attack was swept up to the current clock, so sweep the rest of it and stop at the first contact.
+    int slot = (int)(data->attack_id & ((1u << ATTACK_HANDLE_INDEX_BITS) - 1));
+    SlotHandle previous = SlotMap_GetHandle(am->slots, slot);
+    if (previous != SLOT_HANDLE_INVALID)
+    {
+        AttackInstance *pending = &am->attacks[slot];
+        AttackHits hits;
+        sweep_attack(pending, state, am->sim_time, pending->impact_time, &hits);
+        apply_attack_hits(pending, state, &hits);
+        release_attack_slot(am, slot);
+    }
 
-    am->active_attack_count++;
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Spawned attack ID %u (type %u) at index %d. Active count: %d",
-                 attack->id, (unsigned int)attack->type, slot, am->active_attack_count);
+    if (!SlotMap_AllocAt(am->slots, data->attack_id))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not claim slot for attack ID %u: %s", data->attack_id, SDL_GetError());
+        return;
+    }
+    if (!reserve_attack_storage(am, SlotMap_GetCapacity(am->slots)) || !spawn_attack_in_slot(am, slot, data))
+    {
+        SlotMap_Free(am->slots, data->attack_id);
+    }
 }
 
 /**
@@ -578,31 +829,16 @@ void AttackManager_HandleClientSpawnRequest(AttackManager am, AppState *state, u
     // --- 3. Calculate Velocity ---
     float dx = data.target_pos.x - start_pos.x;
     float dy = data.target_pos.y - start_pos.y;
-    float len = sqrtf(dx * dx + dy * dy);
-    SDL_FPoint velocity = {0.0f, 0.0f};
+    // Zero if start and target positions are (nearly) the same.
+    SDL_FPoint direction = SimMath_Normalize(dx, dy, 0.01f);
     float speed = ATTACK_SPEED;
-
-    // Avoid division by zero or near-zero if start and target positions are the same.
-    if (len > 0.01f)
-    {
-        velocity.x = (dx / len) * speed;
-        velocity.y = (dy / len) * speed;
-    }
+    SDL_FPoint velocity = {direction.x * speed, direction.y * speed};
     SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Handle Req] Calculated velocity: (%.1f, %.1f)", velocity.x, velocity.y);
 
-    // --- 4. Generate Attack ID ---
-    uint32_t new_attack_id = am->next_attack_id++;
-    if (am->next_attack_id == 0)
-    {
-        am->next_attack_id = 1; // Prevent ID 0, though unlikely with uint32_t.
-    }
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Handle Req] Assigned attack ID: %u", new_attack_id);
-
-    // --- 5. Prepare Spawn Message ---
+    // --- 4. Prepare Spawn Message ---
     Msg_ServerSpawnAttackData spawn_msg;
     spawn_msg.message_type = MSG_TYPE_S_SPAWN_ATTACK;
     spawn_msg.attack_type = (uint8_t)data.attack_type;
-    spawn_msg.attack_id = new_attack_id;
     spawn_msg.owner_id = owner_id;
     spawn_msg.start_pos = start_pos;
     spawn_msg.target_pos = data.target_pos;
@@ -610,25 +846,19 @@ void AttackManager_HandleClientSpawnRequest(AttackManager am, AppState *state, u
     spawn_msg.attacker = OBJECT_TYPE_PLAYER;
     spawn_msg.team = data.team;
 
-    // --- 6. Broadcast via NetServer ---
-    NetServer_BroadcastMessage(state->net_server_state, &spawn_msg, sizeof(Msg_ServerSpawnAttackData), -1);
-
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Handle Req] Client %u requested spawn type %u, broadcasting attack ID %u", (unsigned int)owner_id, (unsigned int)data.attack_type, new_attack_id);
-
-    // --- 7. Spawn Locally on Server Immediately ---
-    // If running as server, spawn the attack in the server's own simulation
-    // immediately, otherwise clients won't see attacks spawned by the server player.
-    if (state->is_server)
-    {
-        AttackManager_HandleServerSpawn(am, &spawn_msg);
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Handle Req] Spawning attack locally on server.");
-    }
+    // --- 5. Record the Spawn ---
+    // The ID is assigned and the spawn broadcast at the sync point. The server simulates the
+    // attack itself; its own client ignores the broadcast.
+    Command command = {.type = COMMAND_SPAWN_ATTACK};
+    command.attack = spawn_msg;
+    CommandBuffer_Record(state->command_buffer, &command);
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Handle Req] Client %u requested spawn type %u", (unsigned int)owner_id, (unsigned int)data.attack_type);
 }
 
 /**
  * @brief Handles a request to spawn an attack originating from a specific tower.
- * Performs validation, calculates start position and velocity, assigns an ID,
- * requests the NetServer to broadcast the spawn message, and spawns locally on the server.
+ * Performs validation, calculates start position and velocity and records the spawn;
+ * the ID is assigned and the spawn broadcast at the next sync point.
  * @param am The AttackManager instance.
  * @param state The main AppState (must be the server's state).
  * @param type The type of attack requested (from AttackType enum).
@@ -655,74 +885,160 @@ void AttackManager_ServerSpawnTowerAttack(AttackManager am, AppState *state, Att
 
     // --- 1. Get Tower ---
     TowerInstance *firingTower = &state->tower_manager->towers[towerIndex];
+    const SDL_FPoint *tower_pos = Ecs_Get(state->world, firingTower->entity, ECS_POSITION);
+    const bool *tower_team = Ecs_Get(state->world, firingTower->entity, ECS_TEAM);
+    if (!tower_pos || !tower_team)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Attack Spawn Tower] Tower %d has no entity", towerIndex);
+        return;
+    }
 
     // --- 2. Get Start Position ---
-    SDL_FPoint start_pos = firingTower->position;
+    SDL_FPoint start_pos = *tower_pos;
 
     // --- 3. Calculate Velocity ---
     float dx = target_pos.x - start_pos.x;
     float dy = target_pos.y - start_pos.y;
-    float len = sqrtf(dx * dx + dy * dy);
-    SDL_FPoint velocity = {0.0f, 0.0f};
+    // Zero if start and target positions are (nearly) the same.
+    SDL_FPoint direction = SimMath_Normalize(dx, dy, 0.01f);
     float speed = ATTACK_SPEED;
-
-    // Avoid division by zero or near-zero if start and target positions are the same.
-    if (len > 0.01f)
-    {
-        velocity.x = (dx / len) * speed;
-        velocity.y = (dy / len) * speed;
-    }
+    SDL_FPoint velocity = {direction.x * speed, direction.y * speed};
     SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Spawn Tower] Tower %d firing type %u. Velocity: (%.1f, %.1f)", towerIndex, (unsigned int)type, velocity.x, velocity.y);
 
-    // --- 4. Generate Attack ID ---
-    uint32_t new_attack_id = am->next_attack_id++;
-    if (am->next_attack_id == 0)
-    {
-        am->next_attack_id = 1; // Prevent ID 0
-    }
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Spawn Tower] Assigned attack ID: %u", new_attack_id);
-
-    // --- 5. Prepare Spawn Message ---
+    // --- 4. Prepare Spawn Message ---
     Msg_ServerSpawnAttackData spawn_msg;
     spawn_msg.message_type = MSG_TYPE_S_SPAWN_ATTACK;
     spawn_msg.attack_type = (uint8_t)type;
-    spawn_msg.attack_id = new_attack_id;
     spawn_msg.owner_id = (uint8_t)towerIndex;
     spawn_msg.start_pos = start_pos;
     spawn_msg.target_pos = target_pos;
     spawn_msg.velocity = velocity;
     spawn_msg.attacker = OBJECT_TYPE_TOWER;
-    spawn_msg.team = firingTower->team;
-
-    // --- 6. Broadcast via NetServer ---
-    NetServer_BroadcastMessage(state->net_server_state, &spawn_msg, sizeof(Msg_ServerSpawnAttackData), -1);
+    spawn_msg.team = *tower_team;
 
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Spawn Tower] Broadcasting attack ID %u from tower %d", new_attack_id, towerIndex);
-
-    // --- 7. Spawn Locally on Server Immediately ---
-    AttackManager_HandleServerSpawn(am, &spawn_msg);
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Attack Spawn Tower] Spawning attack ID %u locally on server.", new_attack_id);
+    // --- 5. Record the Spawn ---
+    Command command = {.type = COMMAND_SPAWN_ATTACK};
+    command.attack = spawn_msg;
+    CommandBuffer_Record(state->command_buffer, &command);
 }
 
 /**
  * @brief Handles a destroy message received from the server for an existing attack instance.
- * Marks the specified attack as inactive for removal during the next update cycle.
+ * Records the removal; the attack and its pending impact are removed at the next sync point.
  * Called by the NetClient when receiving MSG_TYPE_S_DESTROY_OBJECT.
  * @param am The AttackManager instance.
+ * @param state Pointer to the main AppState.
  * @param data Pointer to the received Msg_DestroyObjectData containing the object type and ID.
  */
-void AttackManager_HandleDestroyObject(AttackManager am, const Msg_DestroyObjectData *data)
+void AttackManager_HandleDestroyObject(AttackManager am, AppState *state, const Msg_DestroyObjectData *data)
 {
-    if (!am || !data || data->object_type != OBJECT_TYPE_ATTACK)
+    if (!am || !state || !data || data->object_type != OBJECT_TYPE_ATTACK)
         return;
-    int index = find_attack_by_id(am, data->object_id);
+    Command command = {.type = COMMAND_DESPAWN_ATTACK};
+    command.id = data->object_id;
+    CommandBuffer_Record(state->command_buffer, &command);
+}
+
+/**
+ * @brief Removes an attack and its pending impact. Called by the CommandBuffer at the sync point.
+ * @param am The AttackManager instance.
+ * @param attack_id The ID of the attack.
+ */
+void AttackManager_ApplyDespawn(AttackManager am, uint32_t attack_id)
+{
+    if (!am)
+        return;
+    int index = SlotMap_Resolve(am->slots, attack_id);
     if (index != -1)
     {
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Marking attack ID %u at index %d for removal.", data->object_id, index);
-        am->attacks[index].active = false; // Mark for removal by the update loop.
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Removing attack ID %u at slot %d.", attack_id, index);
+        release_attack_slot(am, index);
     }
     else
     {
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Received destroy request for already removed/unknown attack ID %u", data->object_id);
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Received destroy request for already removed/unknown attack ID %u", attack_id);
+    }
+}
+
+/**
+ * @brief Grows the attack pool once so a batch of spawns needs no further allocation.
+ * Called by the CommandBuffer before it applies a frame's spawns.
+ * @param am The AttackManager instance.
+ * @param count Number of spawns in the batch.
+ */
+void AttackManager_ReserveSpawns(AttackManager am, int count)
+{
+    if (!am)
+        return;
+    // A full pool is reported per spawn when the allocation itself fails.
+    if (SlotMap_Reserve(am->slots, count))
+        reserve_attack_storage(am, SlotMap_GetCapacity(am->slots));
+}
+
+/**
+ * @brief Returns the bytes AttackManager_SaveState writes to its data block right now.
+ * @param am The AttackManager instance.
+ * @return Size of the slot map state plus one AttackInstance per live attack.
+ */
+size_t AttackManager_GetStateSize(AttackManager am)
+{
+    if (!am)
+        return 0;
+    return (size_t)SLOT_MAP_STATE_WORDS(SlotMap_GetCapacity(am->slots)) * sizeof(Uint32) +
+           (size_t)SlotMap_GetCount(am->slots) * sizeof(AttackInstance);
+}
+
+/**
+ * @brief Copies the live attacks, their slot map and the manager clock into a snapshot.
+ * @param am The AttackManager instance.
+ * @param out Receives the fixed part of the state.
+ * @param data Receives the variable part; AttackManager_GetStateSize bytes, 4-byte aligned.
+ * @return True on success, false otherwise.
+ */
+bool AttackManager_SaveState(AttackManager am, AttackSnapshot *out, void *data)
+{
+    if (!am || !out || !data)
+        return false;
+    out->slot_words = SLOT_MAP_STATE_WORDS(SlotMap_GetCapacity(am->slots));
+    out->record_count = SlotMap_GetCount(am->slots);
+    if (!SlotMap_SaveState(am->slots, (Uint32 *)data, out->slot_words))
+        return false;
+
+    AttackInstance *records = (AttackInstance *)((Uint32 *)data + out->slot_words);
+    for (int n = 0; n < out->record_count; n++)
+        records[n] = am->attacks[SlotMap_GetSlotAt(am->slots, n)];
+
+    out->sim_time = am->sim_time;
+    return true;
+}
+
+/**
+ * @brief Replaces the attacks with a saved state.
+ * @param am The AttackManager instance.
+ * @param snapshot The fixed part of the saved state.
+ * @param data The variable part written by AttackManager_SaveState.
+ * @return True on success, false if the slot map state is invalid or the pool could not grow to the saved size.
+ */
+bool AttackManager_RestoreState(AttackManager am, const AttackSnapshot *snapshot, const void *data)
+{
+    int capacity, count;
+    if (!am || !snapshot || !data || !SlotMap_PeekState(am->slots, (const Uint32 *)data, &capacity, &count))
+        return false;
+    if (count != snapshot->record_count)
+    {
+        SDL_SetError("Attack snapshot holds %d attacks, its slot map %d", snapshot->record_count, count);
+        return false;
     }
+    // Grow first, so a failure leaves the attacks as they were.
+    if (!reserve_attack_storage(am, capacity) || !SlotMap_RestoreState(am->slots, (const Uint32 *)data))
+        return false;
+
+    // Free slots are zeroed, like freshly grown ones.
+    memset(am->attacks, 0, (size_t)am->capacity * sizeof(AttackInstance));
+    const AttackInstance *records = (const AttackInstance *)((const Uint32 *)data + snapshot->slot_words);
+    for (int n = 0; n < snapshot->record_count; n++)
+        am->attacks[SlotMap_GetSlotAt(am->slots, n)] = records[n];
+
+    am->sim_time = snapshot->sim_time;
+    return true;
 }
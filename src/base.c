@@ -1,62 +1,7 @@
 #include "../include/base.h"
 
-// --- Static Helper Functions ---
-
-/*
- * @brief Renders a single base instance.
- * @param base Pointer to the BaseInstance to render.
- * @param state Pointer to the main AppState.
- */
-static void render_single_base(const BaseInstance *base, AppState *state)
-{
-  if (!base || !base->texture || !state || !state->renderer || !state->camera_state)
-  {
-    return;
-  }
-
-  CameraState camera = state->camera_state;
-  float cam_x = Camera_GetX(camera);
-  float cam_y = Camera_GetY(camera);
-
-  float baseX = base->position.x - cam_x - BASE_RENDER_WIDTH / 2.0f;
-  float baseY = base->position.y - cam_y - BASE_RENDER_HEIGHT / 2.0f;
-
-  // Calculate screen position (rendering from top-left based on center position)
-  SDL_FRect dst_rect = {
-      .x = baseX,
-      .y = baseY,
-      .w = BASE_RENDER_WIDTH,
-      .h = BASE_RENDER_HEIGHT};
-
-  SDL_RenderTexture(state->renderer, base->texture, NULL, &dst_rect);
-
-  char text_buffer[16];
-  snprintf(text_buffer, sizeof(text_buffer), "%d/%d", base->current_health, BASE_HEALTH_MAX);
-
-  char base_name[32];
-  snprintf(base_name, sizeof(base_name), "base_%d_health_value", base->index);
-
-  SDL_Color team_color = base->team ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){0, 0, 255, 255};
-
-  update_hud_instance(state, get_hud_index_by_name(state, base_name), text_buffer,
-                      team_color, (SDL_FPoint){baseX, baseY - 50}, 0);
-}
-
 // --- Static Callback Functions (for EntityManager) ---
 
-/**
- * @brief Internal function to render all bases.
- * @param bm_state The internal state of the base manager module.
- * @param state The main application state.
- */
-static void Internal_BaseManagerRender(BaseManagerState bm_state, AppState *state)
-{
-  if (!bm_state || !state)
-    return;
-  render_single_base(&bm_state->bases[0], state); // Render Red Base
-  render_single_base(&bm_state->bases[1], state); // Render Blue Base
-}
-
 /**
  * @brief Internal function to clean up BaseManager resources.
  * @param bm_state The internal state of the base manager module.
@@ -78,17 +23,6 @@ static void Internal_BaseManagerCleanup(BaseManagerState bm_state)
   }
 }
 
-/**
- * @brief Wrapper function conforming to EntityFunctions.render signature.
- * @param manager The EntityManager instance.
- * @param state Pointer to the main AppState.
- */
-static void base_manager_render_callback(EntityManager manager, AppState *state)
-{
-  (void)manager; // Manager instance is not used in this specific implementation
-  Internal_BaseManagerRender(state->base_manager, state);
-}
-
 /**
  * @brief Wrapper function conforming to EntityFunctions.cleanup signature.
  * @param manager The EntityManager instance.
@@ -97,6 +31,11 @@ static void base_manager_render_callback(EntityManager manager, AppState *state)
 static void base_manager_cleanup_callback(EntityManager manager, AppState *state)
 {
   (void)manager; // Manager instance is not used in this specific implementation
+  if (state && state->base_manager)
+  {
+    for (int i = 0; i < MAX_BASES; i++)
+      Ecs_DestroyEntity(state->world, state->base_manager->bases[i].entity);
+  }
   Internal_BaseManagerCleanup(state ? state->base_manager : NULL);
   if (state)
   {
@@ -108,9 +47,9 @@ static void base_manager_cleanup_callback(EntityManager manager, AppState *state
 
 BaseManagerState BaseManager_Init(AppState *state)
 {
-  if (!state || !state->renderer || !state->entity_manager)
+  if (!state || !state->entity_manager || !state->world)
   {
-    SDL_SetError("Invalid AppState or missing renderer/entity_manager for BaseManager_Init");
+    SDL_SetError("Invalid AppState or missing entity_manager/world for BaseManager_Init");
     return NULL;
   }
 
@@ -122,56 +61,73 @@ BaseManagerState BaseManager_Init(AppState *state)
     return NULL;
   }
 
-  bm_state->red_texture = IMG_LoadTexture(state->renderer, RED_BASE_PATH);
-  if (!bm_state->red_texture)
+  // Headless tools have no renderer; the sprites then stay without textures.
+  if (state->renderer)
   {
-    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Base Init] Failed load texture '%s': %s", RED_BASE_PATH, SDL_GetError());
-    SDL_free(bm_state);
-    return NULL;
-  }
-  SDL_SetTextureScaleMode(bm_state->red_texture, SDL_SCALEMODE_NEAREST);
+    bm_state->red_texture = IMG_LoadTexture(state->renderer, RED_BASE_PATH);
+    if (!bm_state->red_texture)
+    {
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Base Init] Failed load texture '%s': %s", RED_BASE_PATH, SDL_GetError());
+      SDL_free(bm_state);
+      return NULL;
+    }
+    SDL_SetTextureScaleMode(bm_state->red_texture, SDL_SCALEMODE_NEAREST);
 
-  bm_state->blue_texture = IMG_LoadTexture(state->renderer, BLUE_BASE_PATH);
-  if (!bm_state->blue_texture)
-  {
-    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Base Init] Failed load texture '%s': %s", BLUE_BASE_PATH, SDL_GetError());
-    SDL_DestroyTexture(bm_state->red_texture); // Clean up already loaded texture
-    SDL_free(bm_state);
-    return NULL;
-  }
-  SDL_SetTextureScaleMode(bm_state->blue_texture, SDL_SCALEMODE_NEAREST);
+    bm_state->blue_texture = IMG_LoadTexture(state->renderer, BLUE_BASE_PATH);
+    if (!bm_state->blue_texture)
+    {
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Base Init] Failed load texture '%s': %s", BLUE_BASE_PATH, SDL_GetError());
+      SDL_DestroyTexture(bm_state->red_texture); // Clean up already loaded texture
+      SDL_free(bm_state);
+      return NULL;
+    }
+    SDL_SetTextureScaleMode(bm_state->blue_texture, SDL_SCALEMODE_NEAREST);
 
-  bm_state->destroyed_texture = IMG_LoadTexture(state->renderer, DESTROYED_BASE_PATH);
-  if (!bm_state->destroyed_texture)
-  {
-    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Base Init] Failed load texture '%s': %s", DESTROYED_BASE_PATH, SDL_GetError());
-    SDL_DestroyTexture(bm_state->red_texture); // Clean up already loaded texture
-    SDL_free(bm_state);
-    return NULL;
+    bm_state->destroyed_texture = IMG_LoadTexture(state->renderer, DESTROYED_BASE_PATH);
+    if (!bm_state->destroyed_texture)
+    {
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Base Init] Failed load texture '%s': %s", DESTROYED_BASE_PATH, SDL_GetError());
+      SDL_DestroyTexture(bm_state->red_texture); // Clean up already loaded texture
+      SDL_free(bm_state);
+      return NULL;
+    }
+    SDL_SetTextureScaleMode(bm_state->destroyed_texture, SDL_SCALEMODE_NEAREST);
   }
-  SDL_SetTextureScaleMode(bm_state->destroyed_texture, SDL_SCALEMODE_NEAREST);
 
   for (int i = 0; i < MAX_BASES; i++)
   {
-    // --- Initialize Base Instances ---
-    bm_state->bases[i].position = (SDL_FPoint){(i ? BASE_RED_POS_X : BASE_BLUE_POS_X), BUILDINGS_POS_Y};
-    bm_state->bases[i].texture = i ? bm_state->red_texture : bm_state->blue_texture;
-    bm_state->bases[i].current_health = BASE_HEALTH_MAX;
-    bm_state->bases[i].rect = (SDL_FRect){(i ? BASE_RED_POS_X : BASE_BLUE_POS_X) - BASE_RENDER_WIDTH / 2.0f, BUILDINGS_POS_Y - BASE_RENDER_HEIGHT / 2.0f, BASE_RENDER_WIDTH, BASE_RENDER_HEIGHT};
-    bm_state->bases[i].team = i;
-    bm_state->bases[i].immune = true;
-    bm_state->bases[i].index = i;
-
     char base_name[32];
     snprintf(base_name, sizeof(base_name), "base_%d_health_value", i);
 
     create_hud_instance(state, get_hud_element_count(state->HUD_manager), base_name, true);
+
+    // --- Initialize Base Instances ---
+    EcsEntity entity = Ecs_CreateEntity(state->world, BASE_COMPONENTS);
+    if (entity == ECS_ENTITY_NONE)
+    {
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Base Init] Failed to create base entity: %s", SDL_GetError());
+      Internal_BaseManagerCleanup(bm_state);
+      SDL_free(bm_state);
+      return NULL;
+    }
+    bm_state->bases[i].entity = entity;
+    bm_state->bases[i].index = i;
+
+    SDL_FPoint position = {(i ? BASE_RED_POS_X : BASE_BLUE_POS_X), BUILDINGS_POS_Y};
+    *(SDL_FPoint *)Ecs_Get(state->world, entity, ECS_POSITION) = position;
+    *(SDL_FRect *)Ecs_Get(state->world, entity, ECS_BOUNDS) = (SDL_FRect){position.x - BASE_RENDER_WIDTH / 2.0f, position.y - BASE_RENDER_HEIGHT / 2.0f, BASE_RENDER_WIDTH, BASE_RENDER_HEIGHT};
+    *(bool *)Ecs_Get(state->world, entity, ECS_TEAM) = i;
+    *(EcsHealth *)Ecs_Get(state->world, entity, ECS_HEALTH) = (EcsHealth){BASE_HEALTH_MAX, BASE_HEALTH_MAX, true};
+    *(EcsSprite *)Ecs_Get(state->world, entity, ECS_SPRITE) = (EcsSprite){i ? bm_state->red_texture : bm_state->blue_texture, bm_state->destroyed_texture, BASE_RENDER_WIDTH, BASE_RENDER_HEIGHT};
+    *(EcsHealthLabel *)Ecs_Get(state->world, entity, ECS_HEALTH_LABEL) = (EcsHealthLabel){get_hud_index_by_name(state, base_name), -50.0f};
+    *(EcsCollider *)Ecs_Get(state->world, entity, ECS_COLLIDER) = (EcsCollider){SPATIAL_KIND_BASE, i};
   }
 
   // --- Register with EntityManager ---
+  // Drawing is done by the shared sprite and health label systems.
   EntityFunctions base_funcs = {
       .name = "base_manager",
-      .render = base_manager_render_callback,
+      .render = NULL,
       .cleanup = base_manager_cleanup_callback,
       .update = NULL,
       .handle_events = NULL};
@@ -201,42 +157,27 @@ void BaseManager_Destroy(BaseManagerState bm_state)
   }
 }
 
-void damageBase(AppState *state, int baseIndex, float damageValue, bool sendToServer)
+void BaseManager_HandleDestroyed(AppState *state, int baseIndex, bool local)
 {
-
-  BaseInstance *tempBase = &state->base_manager->bases[baseIndex];
-
-  if (tempBase->immune)
+  if (!state || !state->base_manager || baseIndex < 0 || baseIndex >= MAX_BASES)
   {
     return;
   }
 
-  if (tempBase->current_health > 0)
+  const bool *team = Ecs_Get(state->world, state->base_manager->bases[baseIndex].entity, ECS_TEAM);
+  if (!team)
   {
-    tempBase->current_health -= damageValue;
-    SDL_Log("Base %d health %d", baseIndex, tempBase->current_health);
+    return;
   }
 
-  if (tempBase->current_health <= 0)
+  // The instance that landed the final hit decides the match.
+  if (local)
   {
-    tempBase->texture = state->base_manager->destroyed_texture;
-
-    if (sendToServer)
-    {
-      bool winningTeam = (tempBase->team == BLUE_TEAM) ? RED_TEAM : BLUE_TEAM;
-
-      NetClient_SendMatchResult(state->net_client_state, winningTeam);
+    bool winningTeam = (*team == BLUE_TEAM) ? RED_TEAM : BLUE_TEAM;
 
-      state->currentGameState = GAME_STATE_FINISHED;
-      state->winningTeam = winningTeam;
-      hud_finish_msg(state);
-    }
-
-    SDL_Log("Base %d Destroyed", baseIndex);
+    NetClient_SendMatchResult(state->net_client_state, winningTeam);
+    CommandBuffer_SetGameState(state->command_buffer, GAME_STATE_FINISHED, winningTeam);
   }
 
-  if (sendToServer)
-  {
-    NetClient_SendDamageBaseRequest(state->net_client_state, baseIndex, damageValue);
-  }
+  SDL_Log("Base %d Destroyed", baseIndex);
 }
\ No newline at end of file
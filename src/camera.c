@@ -31,7 +31,7 @@ static void Internal_CameraRenderImplementation(CameraState camera_state, AppSta
   MapState map_state = state->map_state;
 
   SDL_FPoint player_pos;
-  if (PlayerManager_GetLocalPlayerPosition(player_mgr, &player_pos))
+  if (PlayerManager_GetLocalPlayerRenderPosition(player_mgr, state->render_alpha, &player_pos))
   {
     // Center the camera on the player position
     camera_state->x = player_pos.x - camera_state->w / 2.0f;
@@ -47,7 +47,8 @@ static void Internal_CameraRenderImplementation(CameraState camera_state, AppSta
 }
 
 /**
- * @brief Wrapper function conforming to EntityFunctions.update signature.
+ * @brief Wrapper function conforming to EntityFunctions.render signature.
+ * Registered in the pre-render phase, so the map and sprites of the same frame use the updated view.
  * @param manager The EntityManager instance.
  * @param state Pointer to the main AppState.
  */
@@ -96,6 +97,9 @@ CameraState Camera_Init(AppState *state)
   // --- Register with EntityManager ---
   EntityFunctions camera_entity_funcs = {
       .name = "camera",
+      .render_phase = ENTITY_PHASE_PRE_RENDER,
+      .reads = ENTITY_RES_PLAYERS | ENTITY_RES_MAP,
+      .writes = ENTITY_RES_CAMERA,
       .render = camera_render_callback,
       .cleanup = camera_cleanup_callback,
       .update = NULL,
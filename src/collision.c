@@ -0,0 +1,89 @@
+#include "../include/collision.h"
+
+// --- Constants ---
+#define COLLISION_PARALLEL_EPSILON 1e-6f /**< Segment components below this are treated as parallel to an axis. */
+
+// --- Public API Function Implementations ---
+
+bool Collision_SegmentRect(SDL_FPoint from, SDL_FPoint to, const SDL_FRect *rect, float *out_t)
+{
+    if (!rect)
+        return false;
+
+    const float start[2] = {from.x, from.y};
+    const float delta[2] = {to.x - from.x, to.y - from.y};
+    const float lo[2] = {rect->x, rect->y};
+    const float hi[2] = {rect->x + rect->w, rect->y + rect->h};
+    float t_enter = 0.0f;
+    float t_exit = 1.0f;
+
+    // Clip the segment against the slab of each axis; it touches the rect if something is left.
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (SDL_fabsf(delta[axis]) < COLLISION_PARALLEL_EPSILON)
+        {
+            if (start[axis] < lo[axis] || start[axis] > hi[axis])
+                return false;
+            continue;
+        }
+
+        float t0 = (lo[axis] - start[axis]) / delta[axis];
+        float t1 = (hi[axis] - start[axis]) / delta[axis];
+        if (t0 > t1)
+        {
+            float tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+        if (t0 > t_enter)
+            t_enter = t0;
+        if (t1 < t_exit)
+            t_exit = t1;
+        if (t_enter > t_exit)
+            return false;
+    }
+
+    if (out_t)
+        *out_t = t_enter;
+    return true;
+}
+
+bool Collision_SegmentCircle(SDL_FPoint from, SDL_FPoint to, SDL_FPoint center, float radius, float *out_t)
+{
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    float fx = from.x - center.x;
+    float fy = from.y - center.y;
+    float c = fx * fx + fy * fy - radius * radius;
+
+    if (c <= 0.0f)
+    {
+        if (out_t)
+            *out_t = 0.0f;
+        return true;
+    }
+
+    // Solve |from + t * d - center| = radius for the smaller root (b is half the usual coefficient).
+    float a = dx * dx + dy * dy;
+    float b = fx * dx + fy * dy;
+    if (a < COLLISION_PARALLEL_EPSILON || b >= 0.0f)
+        return false; // Not moving, or moving away from the circle
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f)
+        return false;
+
+    // Exact IEEE square root: the discriminant can exceed the Fixed range, and sqrt is
+    // correctly rounded on every conforming platform anyway.
+    float t = (-b - SDL_sqrtf(discriminant)) / a;
+    if (t > 1.0f)
+        return false;
+    if (out_t)
+        *out_t = t;
+    return true;
+}
+
+SDL_FRect Collision_InflateRect(const SDL_FRect *rect, SDL_FPoint extent)
+{
+    SDL_FRect grown = {rect->x - extent.x, rect->y - extent.y, rect->w + extent.x * 2.0f, rect->h + extent.y * 2.0f};
+    return grown;
+}
@@ -0,0 +1,183 @@
+#include "../include/command_buffer.h"
+#include "../include/attack.h"
+#include "../include/minion.h"
+#include "../include/hud.h"
+#include "../include/desync.h"
+
+// --- Internal Structures ---
+
+/**
+ * @brief Internal state for the command buffer.
+ */
+struct CommandBuffer_s
+{
+    Command *commands; /**< Commands of the current frame, in record order. */
+    int count;         /**< Number of recorded commands. */
+    int capacity;      /**< Commands allocated. */
+};
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Applies one command through the module that owns the affected pool.
+ */
+static void apply_command(AppState *state, const Command *command)
+{
+    switch (command->type)
+    {
+    case COMMAND_SPAWN_ATTACK:
+        AttackManager_ApplySpawn(state->attack_manager, state, &command->attack);
+        break;
+    case COMMAND_DESPAWN_ATTACK:
+        AttackManager_ApplyDespawn(state->attack_manager, command->id);
+        break;
+    case COMMAND_SPAWN_MINION:
+        MinionManager_ApplySpawn(state, command->team);
+        break;
+    case COMMAND_REPLICATE_MINION:
+        MinionManager_ApplyReplicatedSpawn(state, &command->minion);
+        break;
+    case COMMAND_APPLY_MINION_STATE:
+        MinionManager_ApplyStateBatch(state, &command->minion_state);
+        break;
+    case COMMAND_DESPAWN_MINION:
+        MinionManager_ApplyDespawn(state, (uint16_t)command->id);
+        break;
+    case COMMAND_SET_GAME_STATE:
+        state->currentGameState = command->game.state;
+        if (command->game.state == GAME_STATE_FINISHED)
+        {
+            state->winningTeam = command->game.winning_team;
+            hud_finish_msg(state);
+        }
+        break;
+    case COMMAND_CHECK_WORLD_HASH:
+        Desync_CheckWorldHash(state, &command->world_hash);
+        break;
+    default:
+        break;
+    }
+}
+
+static void command_buffer_update_callback(EntityManager manager, AppState *state)
+{
+    (void)manager;
+    if (!state)
+        return;
+    CommandBuffer_Flush(state->command_buffer, state);
+}
+
+// --- Public API Function Implementations ---
+
+CommandBuffer CommandBuffer_Init(AppState *state)
+{
+    if (!state || !state->entity_manager)
+    {
+        SDL_SetError("Invalid AppState or missing entity_manager for CommandBuffer_Init");
+        return NULL;
+    }
+
+    CommandBuffer cb = (CommandBuffer)SDL_calloc(1, sizeof(struct CommandBuffer_s));
+    if (!cb)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    cb->commands = (Command *)SDL_malloc(COMMAND_BUFFER_INITIAL_CAPACITY * sizeof(Command));
+    if (!cb->commands)
+    {
+        SDL_OutOfMemory();
+        SDL_free(cb);
+        return NULL;
+    }
+    cb->capacity = COMMAND_BUFFER_INITIAL_CAPACITY;
+
+    EntityFunctions command_funcs = {
+        .name = "command_buffer",
+        .update_phase = ENTITY_PHASE_POST_SIM,
+        // Game state changes are recorded in the lobby too.
+        .game_states = ENTITY_IN_ALL_STATES,
+        .writes = ENTITY_RES_ATTACKS | ENTITY_RES_MINIONS | ENTITY_RES_DAMAGE | ENTITY_RES_GAME_STATE | ENTITY_RES_HUD |
+                  ENTITY_RES_NETWORK,
+        .update = command_buffer_update_callback,
+        .render = NULL,
+        .cleanup = NULL,
+        .handle_events = NULL};
+
+    if (!EntityManager_Add(state->entity_manager, &command_funcs))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[CommandBuffer Init] Failed to add entity to manager: %s", SDL_GetError());
+        CommandBuffer_Destroy(cb);
+        return NULL;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "CommandBuffer initialized and entity registered.");
+    return cb;
+}
+
+void CommandBuffer_Destroy(CommandBuffer cb)
+{
+    if (!cb)
+        return;
+    SDL_free(cb->commands);
+    SDL_free(cb);
+}
+
+bool CommandBuffer_Record(CommandBuffer cb, const Command *command)
+{
+    if (!cb || !command)
+        return false;
+    if (cb->count == cb->capacity)
+    {
+        int capacity = cb->capacity * 2;
+        Command *commands = (Command *)SDL_realloc(cb->commands, (size_t)capacity * sizeof(Command));
+        if (!commands)
+        {
+            SDL_OutOfMemory();
+            return false;
+        }
+        cb->commands = commands;
+        cb->capacity = capacity;
+    }
+    cb->commands[cb->count++] = *command;
+    return true;
+}
+
+bool CommandBuffer_SetGameState(CommandBuffer cb, GameState game_state, bool winning_team)
+{
+    Command command = {.type = COMMAND_SET_GAME_STATE};
+    command.game.state = game_state;
+    command.game.winning_team = winning_team;
+    return CommandBuffer_Record(cb, &command);
+}
+
+void CommandBuffer_Flush(CommandBuffer cb, AppState *state)
+{
+    if (!cb || !state || cb->count == 0)
+        return;
+
+    // Grow the attack pool once for the whole frame instead of once per spawn.
+    int attack_spawns = 0;
+    for (int i = 0; i < cb->count; i++)
+    {
+        if (cb->commands[i].type == COMMAND_SPAWN_ATTACK)
+            attack_spawns++;
+    }
+    if (attack_spawns > 0)
+        AttackManager_ReserveSpawns(state->attack_manager, attack_spawns);
+
+    // Copy each command out: applying one may record more and move the array.
+    for (int i = 0; i < cb->count; i++)
+    {
+        Command command = cb->commands[i];
+        apply_command(state, &command);
+    }
+    cb->count = 0;
+}
+
+void CommandBuffer_Clear(CommandBuffer cb)
+{
+    if (!cb)
+        return;
+    cb->count = 0;
+}
@@ -0,0 +1,240 @@
+#include "../include/damage_bus.h"
+#include "../include/base.h"
+#include "../include/tower.h"
+#include "../include/player.h"
+#include "../include/minion.h"
+#include "../include/net_client.h"
+#include "../include/systems.h"
+
+// --- Internal Structures ---
+
+/**
+ * @brief Internal state for the damage bus.
+ * Events are resolved in push order. Hits on the same target within one step are merged
+ * into a single batch entry, so the batch holds at most one entry per target.
+ */
+struct DamageBus_s
+{
+    DamageEvent *events;      /**< Events of the current step, in push order. */
+    int count;                /**< Number of queued events. */
+    int capacity;             /**< Events allocated. */
+    Msg_DamageBatch outgoing; /**< Local hits of the current resolve pass, not sent yet. */
+};
+
+// --- Static Helper Functions ---
+
+static bool push_event(DamageBus bus, DamageEvent event)
+{
+    if (!bus)
+        return false;
+    if (bus->count == bus->capacity)
+    {
+        int capacity = bus->capacity ? bus->capacity * 2 : DAMAGE_BUS_INITIAL_CAPACITY;
+        DamageEvent *events = (DamageEvent *)SDL_realloc(bus->events, (size_t)capacity * sizeof(DamageEvent));
+        if (!events)
+        {
+            SDL_OutOfMemory();
+            return false;
+        }
+        bus->events = events;
+        bus->capacity = capacity;
+    }
+    bus->events[bus->count++] = event;
+    return true;
+}
+
+/**
+ * @brief Sends the pending batch entries, if any, and empties the batch.
+ */
+static void flush_outgoing(DamageBus bus, AppState *state)
+{
+    if (bus->outgoing.count == 0)
+        return;
+    bus->outgoing.message_type = MSG_TYPE_C_DAMAGE_BATCH;
+    NetClient_SendDamageBatch(state->net_client_state, &bus->outgoing);
+    bus->outgoing.count = 0;
+}
+
+/**
+ * @brief Adds a local hit to the outgoing batch, merging it with an earlier hit on the same target.
+ * @param health The target's health after the hit (towers only).
+ */
+static void add_outgoing(DamageBus bus, AppState *state, DamageTargetKind kind, Uint16 target, float amount, float health)
+{
+    Msg_DamageBatch *batch = &bus->outgoing;
+    for (int i = 0; i < batch->count; i++)
+    {
+        if (batch->kind[i] == kind && batch->target[i] == target)
+        {
+            batch->damage[i] += amount;
+            batch->health[i] = health;
+            return;
+        }
+    }
+
+    if (batch->count == MSG_DAMAGE_BATCH_MAX)
+        flush_outgoing(bus, state);
+    int i = batch->count++;
+    batch->kind[i] = (uint8_t)kind;
+    batch->target[i] = target;
+    batch->damage[i] = amount;
+    batch->health[i] = health;
+}
+
+/**
+ * @brief Finds the entity an event is aimed at.
+ * @return The entity, or ECS_ENTITY_NONE if the index or handle is invalid (or the minion is gone).
+ */
+static EcsEntity resolve_target(AppState *state, const DamageEvent *e)
+{
+    switch ((DamageTargetKind)e->kind)
+    {
+    case DAMAGE_TARGET_MINION:
+        if (!state->minion_manager)
+            return ECS_ENTITY_NONE;
+        // Remote minion events carry the handle; a stale one resolves to no slot.
+        return MinionManager_GetEntity(state->minion_manager, e->remote ? SlotMap_Resolve(state->minion_manager->slots, e->target) : e->target);
+    case DAMAGE_TARGET_TOWER:
+        if (!state->tower_manager || e->target >= state->tower_manager->tower_count)
+            return ECS_ENTITY_NONE;
+        return state->tower_manager->towers[e->target].entity;
+    case DAMAGE_TARGET_BASE:
+        if (!state->base_manager || e->target >= MAX_BASES)
+            return ECS_ENTITY_NONE;
+        return state->base_manager->bases[e->target].entity;
+    case DAMAGE_TARGET_PLAYER:
+        if (!state->player_manager || e->target >= MAX_CLIENTS)
+            return ECS_ENTITY_NONE;
+        return state->player_manager->players[e->target].entity;
+    default:
+        return ECS_ENTITY_NONE;
+    }
+}
+
+/**
+ * @brief Applies one event through the ECS health system.
+ */
+static void resolve_event(DamageBus bus, AppState *state, const DamageEvent *e)
+{
+    float health = 0.0f;
+    // The server owns minion health; clients forward their hits by handle.
+    if (e->kind == DAMAGE_TARGET_MINION && !state->is_server)
+    {
+        uint16_t handle = e->remote ? (uint16_t)SLOT_HANDLE_INVALID : MinionManager_GetHandle(state->minion_manager, e->target);
+        if (handle != SLOT_HANDLE_INVALID)
+            add_outgoing(bus, state, DAMAGE_TARGET_MINION, handle, e->amount, 0.0f);
+        return;
+    }
+
+    EcsEntity entity = resolve_target(state, e);
+    if (entity == ECS_ENTITY_NONE)
+    {
+        if (e->kind == DAMAGE_TARGET_MINION && e->remote)
+            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Server] Ignoring damage for stale minion handle 0x%04x", (unsigned int)e->target);
+        return;
+    }
+
+    // Remote tower hits carry the tower's health on the sender, so peers do not drift apart.
+    if (e->kind == DAMAGE_TARGET_TOWER && e->remote)
+    {
+        Systems_SetHealth(state, entity, e->health, false);
+        return;
+    }
+    if (Systems_ApplyDamage(state, entity, e->amount, !e->remote, &health) && !e->remote && e->kind != DAMAGE_TARGET_MINION)
+        add_outgoing(bus, state, (DamageTargetKind)e->kind, e->target, e->amount, health);
+}
+
+static void damage_bus_update_callback(EntityManager manager, AppState *state)
+{
+    (void)manager;
+    if (!state)
+        return;
+    DamageBus_Resolve(state->damage_bus, state);
+}
+
+// --- Public API Function Implementations ---
+
+DamageBus DamageBus_Init(AppState *state)
+{
+    if (!state || !state->entity_manager)
+    {
+        SDL_SetError("Invalid AppState or missing entity_manager for DamageBus_Init");
+        return NULL;
+    }
+
+    DamageBus bus = (DamageBus)SDL_calloc(1, sizeof(struct DamageBus_s));
+    if (!bus)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    bus->events = (DamageEvent *)SDL_malloc(DAMAGE_BUS_INITIAL_CAPACITY * sizeof(DamageEvent));
+    if (!bus->events)
+    {
+        SDL_OutOfMemory();
+        SDL_free(bus);
+        return NULL;
+    }
+    bus->capacity = DAMAGE_BUS_INITIAL_CAPACITY;
+
+    EntityFunctions damage_funcs = {
+        .name = "damage_bus",
+        .update_phase = ENTITY_PHASE_POST_SIM,
+        // Hits reach every kind of object and a destroyed base ends the match.
+        .writes = ENTITY_RES_DAMAGE | ENTITY_RES_MINIONS | ENTITY_RES_PLAYERS | ENTITY_RES_TOWERS | ENTITY_RES_WORLD |
+                  ENTITY_RES_HUD | ENTITY_RES_GAME_STATE | ENTITY_RES_NETWORK,
+        .update = damage_bus_update_callback,
+        .render = NULL,
+        .cleanup = NULL,
+        .handle_events = NULL};
+
+    if (!EntityManager_Add(state->entity_manager, &damage_funcs))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[DamageBus Init] Failed to add entity to manager: %s", SDL_GetError());
+        DamageBus_Destroy(bus);
+        return NULL;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "DamageBus initialized and entity registered.");
+    return bus;
+}
+
+void DamageBus_Destroy(DamageBus bus)
+{
+    if (!bus)
+        return;
+    SDL_free(bus->events);
+    SDL_free(bus);
+}
+
+bool DamageBus_Push(DamageBus bus, DamageTargetKind kind, int target, float amount)
+{
+    DamageEvent event = {(Uint8)kind, false, (Uint16)target, amount, 0.0f};
+    return push_event(bus, event);
+}
+
+bool DamageBus_PushRemote(DamageBus bus, DamageTargetKind kind, int target, float amount, float health)
+{
+    DamageEvent event = {(Uint8)kind, true, (Uint16)target, amount, health};
+    return push_event(bus, event);
+}
+
+void DamageBus_Resolve(DamageBus bus, AppState *state)
+{
+    if (!bus || !state || bus->count == 0)
+        return;
+
+    bus->outgoing.count = 0;
+    for (int i = 0; i < bus->count; i++)
+        resolve_event(bus, state, &bus->events[i]);
+    bus->count = 0;
+    flush_outgoing(bus, state);
+}
+
+void DamageBus_Clear(DamageBus bus)
+{
+    if (!bus)
+        return;
+    bus->count = 0;
+    bus->outgoing.count = 0;
+}
@@ -0,0 +1,198 @@
+#include "../include/desync.h"
+#include "../include/command_buffer.h"
+
+// --- Internal Structures ---
+
+/**
+ * @brief Internal state for the desync detector.
+ */
+struct DesyncDetector_s
+{
+    WorldSnapshot *history[DESYNC_HISTORY]; /**< Server only: ring of snapshots, one per hash sent; NULL until used. */
+    int history_next;          /**< Server only: ring entry the next snapshot goes to. */
+    Uint64 last_check;         /**< Server only: sync clock of the last hash sent. */
+    bool has_previous;         /**< Client only: previous_* hold the last check. */
+    WorldHash previous_local;  /**< Client only: own hashes at the last check. */
+    WorldHash previous_remote; /**< Client only: server hashes of the last check. */
+    Uint8 reported;            /**< Client only: sections reported and not matching again since. */
+};
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Saves the world and writes it to a file, logging the outcome.
+ */
+static void dump_world(AppState *state, const char *path)
+{
+    // Only needed when something already went wrong, so it is not kept around.
+    WorldSnapshot *snapshot = NULL;
+    if (World_Save(state, &snapshot) && World_WriteSnapshot(snapshot, path))
+        SDL_Log("[Desync] World written to %s", path);
+    else
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Desync] Failed to write %s: %s", path, SDL_GetError());
+    World_DestroySnapshot(snapshot);
+}
+
+/**
+ * @brief Server-side: hashes the world right after a state batch, keeps a snapshot and sends the hashes.
+ */
+static void server_send_world_hash(DesyncDetector dd, AppState *state)
+{
+    WorldHash hash;
+    if (!World_ComputeHash(state, &hash))
+        return;
+
+    if (!World_Save(state, &dd->history[dd->history_next]))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Desync] World_Save failed: %s", SDL_GetError());
+        return;
+    }
+    dd->history_next = (dd->history_next + 1) % DESYNC_HISTORY;
+
+    Msg_WorldHash msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.message_type = MSG_TYPE_S_WORLD_HASH;
+    msg.server_time = (uint32_t)state->sync_clock;
+    memcpy(msg.sections, hash.sections, sizeof(msg.sections));
+    NetServer_BroadcastMessage(state->net_server_state, &msg, sizeof(Msg_WorldHash), -1);
+}
+
+static void desync_update_callback(EntityManager manager, AppState *state)
+{
+    (void)manager;
+    DesyncDetector dd = state ? state->desync_detector : NULL;
+    if (!dd || !state->is_server || !state->net_server_state || !state->minion_manager)
+        return;
+
+    // Only on steps that sent a state batch: those are the steps clients can reproduce.
+    if (state->minion_manager->lastStateBroadcast != state->sync_clock ||
+        state->sync_clock - dd->last_check < DESYNC_CHECK_INTERVAL_MS)
+        return;
+
+    server_send_world_hash(dd, state);
+    dd->last_check = state->sync_clock;
+}
+
+// --- Public API Function Implementations ---
+
+DesyncDetector Desync_Init(AppState *state)
+{
+    if (!state || !state->entity_manager)
+    {
+        SDL_SetError("Invalid AppState or missing entity_manager for Desync_Init");
+        return NULL;
+    }
+
+    DesyncDetector dd = (DesyncDetector)SDL_calloc(1, sizeof(struct DesyncDetector_s));
+    if (!dd)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    EntityFunctions desync_funcs = {
+        .name = "desync_detector",
+        .update_phase = ENTITY_PHASE_NETWORK_OUT,
+        .reads = ENTITY_RES_WORLD | ENTITY_RES_PLAYERS | ENTITY_RES_MINIONS | ENTITY_RES_ATTACKS | ENTITY_RES_TOWERS |
+                 ENTITY_RES_GAME_STATE,
+        .writes = ENTITY_RES_NETWORK,
+        .update = desync_update_callback,
+        .render = NULL,
+        .cleanup = NULL,
+        .handle_events = NULL};
+
+    if (!EntityManager_Add(state->entity_manager, &desync_funcs))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Desync Init] Failed to add entity to manager: %s", SDL_GetError());
+        Desync_Destroy(dd);
+        return NULL;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "DesyncDetector initialized and entity registered.");
+    return dd;
+}
+
+void Desync_Destroy(DesyncDetector dd)
+{
+    if (!dd)
+        return;
+    for (int i = 0; i < DESYNC_HISTORY; i++)
+        World_DestroySnapshot(dd->history[i]);
+    SDL_free(dd);
+}
+
+void Desync_HandleWorldHash(AppState *state, const Msg_WorldHash *data)
+{
+    if (!state || !state->desync_detector || !data || state->is_server)
+        return;
+
+    Command command = {.type = COMMAND_CHECK_WORLD_HASH};
+    command.world_hash = *data;
+    CommandBuffer_Record(state->command_buffer, &command);
+}
+
+void Desync_CheckWorldHash(AppState *state, const Msg_WorldHash *data)
+{
+    DesyncDetector dd = state ? state->desync_detector : NULL;
+    WorldHash local;
+    if (!dd || !data || state->is_server || !World_ComputeHash(state, &local))
+        return;
+
+    Uint8 mismatched = 0;
+    for (int s = 0; s < WORLD_HASH_SECTION_COUNT; s++)
+    {
+        if (local.sections[s] == data->sections[s])
+        {
+            dd->reported &= (Uint8)~(1u << s);
+            continue;
+        }
+        bool settled = dd->has_previous && dd->previous_local.sections[s] == local.sections[s] &&
+                       dd->previous_remote.sections[s] == data->sections[s];
+        if (s == WORLD_HASH_MINIONS || settled)
+            mismatched |= (Uint8)(1u << s);
+    }
+    dd->previous_local = local;
+    memcpy(dd->previous_remote.sections, data->sections, sizeof(dd->previous_remote.sections));
+    dd->has_previous = true;
+
+    Uint8 fresh = mismatched & (Uint8)~dd->reported;
+    if (!fresh)
+        return;
+    dd->reported |= fresh;
+
+    for (int s = 0; s < WORLD_HASH_SECTION_COUNT; s++)
+    {
+        if (fresh & (1u << s))
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Desync] Section %d differs at server time %u: local %016" SDL_PRIx64 ", server %016" SDL_PRIx64,
+                        s, data->server_time, local.sections[s], (Uint64)data->sections[s]);
+    }
+
+    char path[64];
+    SDL_snprintf(path, sizeof(path), "desync_%u_client%d.world", data->server_time,
+                 NetClient_GetClientID(state->net_client_state));
+    dump_world(state, path);
+    NetClient_SendDesyncReport(state->net_client_state, data->server_time, fresh);
+}
+
+void Desync_HandleReport(AppState *state, uint8_t client_id, const Msg_DesyncReport *data)
+{
+    DesyncDetector dd = state ? state->desync_detector : NULL;
+    if (!dd || !state->is_server || !data)
+        return;
+
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Desync] Client %u reports sections 0x%02x differing at server time %u",
+                client_id, data->sections, data->server_time);
+    for (int i = 0; i < DESYNC_HISTORY; i++)
+    {
+        if (dd->history[i] && (uint32_t)dd->history[i]->sync_clock == data->server_time)
+        {
+            char path[64];
+            SDL_snprintf(path, sizeof(path), "desync_%u_server.world", data->server_time);
+            if (World_WriteSnapshot(dd->history[i], path))
+                SDL_Log("[Desync] World written to %s", path);
+            else
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Desync] Failed to write %s: %s", path, SDL_GetError());
+            return;
+        }
+    }
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Desync] Snapshot of server time %u is no longer kept", data->server_time);
+}
@@ -0,0 +1,345 @@
+#include "../include/ecs.h"
+
+// --- Internal Structures ---
+
+/**
+ * @brief All entities that have exactly one component set.
+ * Columns of components outside the set stay NULL. Rows are packed: removing an
+ * entity moves the last row into the hole.
+ */
+typedef struct EcsArchetype
+{
+    EcsMask mask;
+    void *columns[ECS_COMPONENT_COUNT]; /**< One array per component in mask, capacity elements each. */
+    EcsEntity *entities;                /**< Entity of each row. */
+    int count;                          /**< Rows in use. */
+    int capacity;                       /**< Rows allocated. */
+} EcsArchetype;
+
+/**
+ * @brief Internal state for the EcsWorld.
+ * Entity handles come from a SlotMap; per slot the world records where the entity's row lives.
+ */
+struct EcsWorld_s
+{
+    SlotMap slots;
+    int *entity_archetype; /**< Archetype of each live entity slot. */
+    int *entity_row;       /**< Row of each live entity slot within its archetype. */
+    int entity_capacity;   /**< Length of entity_archetype and entity_row. */
+    EcsArchetype archetypes[ECS_MAX_ARCHETYPES];
+    int archetype_count;
+};
+
+// --- Static Variables ---
+
+/** Size of one element of each component column. */
+static const size_t component_sizes[ECS_COMPONENT_COUNT] = {
+    [ECS_POSITION] = sizeof(SDL_FPoint),
+    [ECS_BOUNDS] = sizeof(SDL_FRect),
+    [ECS_TEAM] = sizeof(bool),
+    [ECS_HEALTH] = sizeof(EcsHealth),
+    [ECS_SPRITE] = sizeof(EcsSprite),
+    [ECS_HEALTH_LABEL] = sizeof(EcsHealthLabel),
+    [ECS_COLLIDER] = sizeof(EcsCollider),
+    [ECS_PREV_POSITION] = sizeof(SDL_FPoint),
+    [ECS_VELOCITY] = sizeof(SDL_FPoint),
+    [ECS_COOLDOWN] = sizeof(float),
+    [ECS_ANIM_TIMER] = sizeof(float),
+    [ECS_ANIM_FRAME] = sizeof(Sint32),
+    [ECS_NET_FROM] = sizeof(SDL_FPoint),
+    [ECS_NET_TO] = sizeof(SDL_FPoint),
+    [ECS_NET_PROGRESS] = sizeof(float),
+};
+
+// --- Static Helper Functions ---
+
+static bool mask_has(EcsMask mask, EcsComponent component)
+{
+    return (mask & ECS_MASK(component)) != 0;
+}
+
+static void *column_at(const EcsArchetype *arch, EcsComponent component, int row)
+{
+    return (char *)arch->columns[component] + (size_t)row * component_sizes[component];
+}
+
+/**
+ * @brief Grows the per-entity arrays to match the slot map's capacity.
+ */
+static bool reserve_entities(EcsWorld world)
+{
+    int capacity = SlotMap_GetCapacity(world->slots);
+    if (capacity <= world->entity_capacity)
+        return true;
+
+    int *archetype = (int *)SDL_realloc(world->entity_archetype, (size_t)capacity * sizeof(int));
+    if (archetype)
+        world->entity_archetype = archetype;
+    int *row = (int *)SDL_realloc(world->entity_row, (size_t)capacity * sizeof(int));
+    if (row)
+        world->entity_row = row;
+    if (!archetype || !row)
+    {
+        SDL_OutOfMemory();
+        return false;
+    }
+    world->entity_capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Makes room for at least one more row in an archetype.
+ */
+static bool reserve_row(EcsArchetype *arch)
+{
+    if (arch->count < arch->capacity)
+        return true;
+
+    int capacity = arch->capacity ? arch->capacity * 2 : ECS_ARCHETYPE_INITIAL_ROWS;
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++)
+    {
+        if (!mask_has(arch->mask, (EcsComponent)c))
+            continue;
+        void *column = SDL_realloc(arch->columns[c], (size_t)capacity * component_sizes[c]);
+        if (!column)
+        {
+            SDL_OutOfMemory();
+            return false;
+        }
+        arch->columns[c] = column;
+    }
+    EcsEntity *entities = (EcsEntity *)SDL_realloc(arch->entities, (size_t)capacity * sizeof(EcsEntity));
+    if (!entities)
+    {
+        SDL_OutOfMemory();
+        return false;
+    }
+    arch->entities = entities;
+    arch->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Returns the archetype for a component set, creating it on first use.
+ * @return The archetype index, or -1 if ECS_MAX_ARCHETYPES is reached.
+ */
+static int find_or_create_archetype(EcsWorld world, EcsMask mask)
+{
+    for (int i = 0; i < world->archetype_count; i++)
+    {
+        if (world->archetypes[i].mask == mask)
+            return i;
+    }
+    if (world->archetype_count >= ECS_MAX_ARCHETYPES)
+    {
+        SDL_SetError("EcsWorld has no room for another archetype (max %d)", ECS_MAX_ARCHETYPES);
+        return -1;
+    }
+    int index = world->archetype_count++;
+    SDL_zero(world->archetypes[index]);
+    world->archetypes[index].mask = mask;
+    return index;
+}
+
+/**
+ * @brief Appends a zeroed row for an entity. The row's storage must already be reserved.
+ * @return The new row.
+ */
+static int push_row(EcsWorld world, int archetype, EcsEntity entity)
+{
+    EcsArchetype *arch = &world->archetypes[archetype];
+    int row = arch->count++;
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++)
+    {
+        if (mask_has(arch->mask, (EcsComponent)c))
+            SDL_memset(column_at(arch, (EcsComponent)c, row), 0, component_sizes[c]);
+    }
+    arch->entities[row] = entity;
+
+    int slot = SlotMap_Resolve(world->slots, entity);
+    world->entity_archetype[slot] = archetype;
+    world->entity_row[slot] = row;
+    return row;
+}
+
+/**
+ * @brief Removes a row by moving the archetype's last row into it.
+ */
+static void remove_row(EcsWorld world, int archetype, int row)
+{
+    EcsArchetype *arch = &world->archetypes[archetype];
+    int last = --arch->count;
+    if (row == last)
+        return;
+
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++)
+    {
+        if (mask_has(arch->mask, (EcsComponent)c))
+            SDL_memcpy(column_at(arch, (EcsComponent)c, row), column_at(arch, (EcsComponent)c, last), component_sizes[c]);
+    }
+    EcsEntity moved = arch->entities[last];
+    arch->entities[row] = moved;
+    world->entity_row[SlotMap_Resolve(world->slots, moved)] = row;
+}
+
+/**
+ * @brief Moves a live entity to the archetype of a new component set, keeping shared components.
+ */
+static bool move_entity(EcsWorld world, EcsEntity entity, EcsMask mask)
+{
+    int slot = SlotMap_Resolve(world->slots, entity);
+    if (slot < 0)
+    {
+        SDL_SetError("Stale EcsEntity %u", entity);
+        return false;
+    }
+    int from = world->entity_archetype[slot];
+    int from_row = world->entity_row[slot];
+    if (world->archetypes[from].mask == mask)
+        return true;
+
+    int to = find_or_create_archetype(world, mask);
+    if (to < 0 || !reserve_row(&world->archetypes[to]))
+        return false;
+
+    int to_row = push_row(world, to, entity);
+    EcsArchetype *src = &world->archetypes[from];
+    EcsArchetype *dst = &world->archetypes[to];
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++)
+    {
+        if (mask_has(src->mask & dst->mask, (EcsComponent)c))
+            SDL_memcpy(column_at(dst, (EcsComponent)c, to_row), column_at(src, (EcsComponent)c, from_row), component_sizes[c]);
+    }
+    remove_row(world, from, from_row);
+    return true;
+}
+
+// --- Public API Function Implementations ---
+
+EcsWorld EcsWorld_Create(void)
+{
+    EcsWorld world = (EcsWorld)SDL_calloc(1, sizeof(struct EcsWorld_s));
+    if (!world)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    world->slots = SlotMap_Create(ECS_INITIAL_ENTITIES, ECS_MAX_ENTITIES, 16, 16);
+    if (!world->slots || !reserve_entities(world))
+    {
+        EcsWorld_Destroy(world);
+        return NULL;
+    }
+    return world;
+}
+
+void EcsWorld_Destroy(EcsWorld world)
+{
+    if (!world)
+        return;
+    for (int i = 0; i < world->archetype_count; i++)
+    {
+        EcsArchetype *arch = &world->archetypes[i];
+        for (int c = 0; c < ECS_COMPONENT_COUNT; c++)
+            SDL_free(arch->columns[c]);
+        SDL_free(arch->entities);
+    }
+    SlotMap_Destroy(world->slots);
+    SDL_free(world->entity_archetype);
+    SDL_free(world->entity_row);
+    SDL_free(world);
+}
+
+EcsEntity Ecs_CreateEntity(EcsWorld world, EcsMask components)
+{
+    if (!world)
+    {
+        SDL_SetError("EcsWorld is NULL");
+        return ECS_ENTITY_NONE;
+    }
+    int archetype = find_or_create_archetype(world, components);
+    if (archetype < 0 || !reserve_row(&world->archetypes[archetype]))
+        return ECS_ENTITY_NONE;
+
+    EcsEntity entity = SlotMap_Alloc(world->slots);
+    if (entity == ECS_ENTITY_NONE)
+        return ECS_ENTITY_NONE;
+    if (!reserve_entities(world))
+    {
+        SlotMap_Free(world->slots, entity);
+        return ECS_ENTITY_NONE;
+    }
+
+    push_row(world, archetype, entity);
+    return entity;
+}
+
+bool Ecs_DestroyEntity(EcsWorld world, EcsEntity entity)
+{
+    if (!world)
+        return false;
+    int slot = SlotMap_Resolve(world->slots, entity);
+    if (slot < 0)
+        return false;
+    remove_row(world, world->entity_archetype[slot], world->entity_row[slot]);
+    SlotMap_Free(world->slots, entity);
+    return true;
+}
+
+bool Ecs_AddComponents(EcsWorld world, EcsEntity entity, EcsMask components)
+{
+    int slot = world ? SlotMap_Resolve(world->slots, entity) : -1;
+    if (slot < 0)
+        return false;
+    return move_entity(world, entity, world->archetypes[world->entity_archetype[slot]].mask | components);
+}
+
+bool Ecs_RemoveComponents(EcsWorld world, EcsEntity entity, EcsMask components)
+{
+    int slot = world ? SlotMap_Resolve(world->slots, entity) : -1;
+    if (slot < 0)
+        return false;
+    return move_entity(world, entity, world->archetypes[world->entity_archetype[slot]].mask & ~components);
+}
+
+void *Ecs_Get(EcsWorld world, EcsEntity entity, EcsComponent component)
+{
+    int slot = world ? SlotMap_Resolve(world->slots, entity) : -1;
+    if (slot < 0)
+        return NULL;
+    EcsArchetype *arch = &world->archetypes[world->entity_archetype[slot]];
+    if (!mask_has(arch->mask, component))
+        return NULL;
+    return column_at(arch, component, world->entity_row[slot]);
+}
+
+EcsIter Ecs_Query(EcsWorld world, EcsMask all, EcsMask none)
+{
+    EcsIter it = {world, all, none, -1, 0, NULL};
+    return it;
+}
+
+bool EcsIter_Next(EcsIter *it)
+{
+    if (!it || !it->world)
+        return false;
+    while (++it->archetype < it->world->archetype_count)
+    {
+        const EcsArchetype *arch = &it->world->archetypes[it->archetype];
+        if ((arch->mask & it->all) != it->all || (arch->mask & it->none) || arch->count == 0)
+            continue;
+        it->count = arch->count;
+        it->entities = arch->entities;
+        return true;
+    }
+    it->count = 0;
+    it->entities = NULL;
+    return false;
+}
+
+void *EcsIter_Column(const EcsIter *it, EcsComponent component)
+{
+    if (!it || !it->world || it->archetype < 0 || it->archetype >= it->world->archetype_count)
+        return NULL;
+    return it->world->archetypes[it->archetype].columns[component];
+}
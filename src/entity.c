@@ -2,16 +2,143 @@
 
 // --- Internal Structures ---
 
+typedef void (*EntityCallback)(EntityManager manager, AppState *state);
+
 /**
  * @brief Internal state for the EntityManager module.
+ * The schedule lists, per phase, the entities with a callback in that phase in registration order.
+ * It is cut into batches: a new batch starts at every entity that conflicts with an earlier
+ * member of the current one, so the members of a batch may run in any order, or concurrently.
  */
 struct EntityManager_s
 {
-    EntityFunctions *entities; /**< Dynamic array of registered entity functions. */
-    int count;                 /**< Current number of registered entities. */
-    int capacity;              /**< Max number of entities the array can hold. */
+    EntityFunctions *entities;               /**< Dynamic array of registered entity functions. */
+    int count;                               /**< Current number of registered entities. */
+    int capacity;                            /**< Max number of entities the array can hold. */
+    int *schedule;                           /**< Entity indices grouped by phase (2 * capacity entries). */
+    bool *batch_start;                       /**< Whether the schedule entry starts a new batch. */
+    int phase_start[ENTITY_PHASE_COUNT + 1]; /**< schedule[phase_start[p] .. phase_start[p + 1]) run in phase p. */
+    bool profiling;                          /**< Whether callbacks are timed. */
+    Uint64 *profile_ns;                      /**< Callback time per entity while profiling. */
+    Uint64 *profile_calls;                   /**< Callback runs per entity while profiling. */
 };
 
+/**
+ * @brief One member of a batch handed to the job system.
+ */
+typedef struct EntityJob
+{
+    EntityManager manager;
+    AppState *state;
+    EntityCallback callback;
+    int entity; /**< Index of the entity, for profiling. */
+} EntityJob;
+
+// --- Static Helper Functions ---
+
+static bool is_render_phase(EntityPhase phase)
+{
+    return phase >= ENTITY_FIRST_RENDER_PHASE && phase < ENTITY_PHASE_COUNT;
+}
+
+/**
+ * @brief Returns the callback an entity runs in a phase, or NULL if it has none there.
+ */
+static EntityCallback phase_callback(const EntityFunctions *e, EntityPhase phase)
+{
+    if (is_render_phase(phase))
+        return e->render_phase == phase ? e->render : NULL;
+    return e->update_phase == phase ? e->update : NULL;
+}
+
+/**
+ * @brief Resources an entity modifies. An entity without declarations claims all of them.
+ */
+static Uint32 declared_writes(const EntityFunctions *e)
+{
+    return (e->reads | e->writes) ? e->writes : (Uint32)ENTITY_RES_ALL;
+}
+
+static bool entities_conflict(const EntityFunctions *a, const EntityFunctions *b)
+{
+    Uint32 a_writes = declared_writes(a), b_writes = declared_writes(b);
+    return (a_writes & (b->reads | b_writes)) || (b_writes & (a->reads | a_writes));
+}
+
+/**
+ * @brief Recomputes the phase schedule and its batches from the registered entities.
+ */
+static void rebuild_schedule(EntityManager manager)
+{
+    int n = 0;
+    for (int phase = 0; phase < ENTITY_PHASE_COUNT; ++phase)
+    {
+        manager->phase_start[phase] = n;
+        int batch_begin = n;
+        for (int i = 0; i < manager->count; ++i)
+        {
+            const EntityFunctions *e = &manager->entities[i];
+            if (!phase_callback(e, (EntityPhase)phase))
+                continue;
+
+            bool starts = (n == batch_begin);
+            for (int k = batch_begin; k < n && !starts; ++k)
+                starts = entities_conflict(&manager->entities[manager->schedule[k]], e);
+            if (starts)
+                batch_begin = n;
+
+            manager->batch_start[n] = starts;
+            manager->schedule[n++] = i;
+        }
+    }
+    manager->phase_start[ENTITY_PHASE_COUNT] = n;
+}
+
+static void run_entity_job(void *data)
+{
+    const EntityJob *job = (const EntityJob *)data;
+    if (!job->manager->profiling)
+    {
+        job->callback(job->manager, job->state);
+        return;
+    }
+    // An entity runs at most once per batch, so its counters have a single writer.
+    Uint64 start = SDL_GetTicksNS();
+    job->callback(job->manager, job->state);
+    job->manager->profile_ns[job->entity] += SDL_GetTicksNS() - start;
+    job->manager->profile_calls[job->entity]++;
+}
+
+/**
+ * @brief Runs the enabled members of one batch: inline if only one is enabled or there are no
+ * workers, otherwise all but the first on the job system while the caller runs the first.
+ */
+static void run_batch(EntityManager manager, AppState *state, EntityPhase phase, int begin, int end)
+{
+    EntityJob jobs[MAX_MANAGED_ENTITIES];
+    int job_count = 0;
+    for (int n = begin; n < end; ++n)
+    {
+        const EntityFunctions *e = &manager->entities[manager->schedule[n]];
+        if (e->game_states & ENTITY_IN_STATE(state->currentGameState))
+            jobs[job_count++] = (EntityJob){manager, state, phase_callback(e, phase), manager->schedule[n]};
+    }
+
+    if (job_count <= 1 || JobSystem_GetWorkerCount(state->jobs) == 0)
+    {
+        for (int j = 0; j < job_count; ++j)
+            run_entity_job(&jobs[j]);
+        return;
+    }
+
+    JobCounter counter;
+    SDL_SetAtomicInt(&counter.pending, 0);
+    for (int j = 1; j < job_count; ++j)
+        JobSystem_Submit(state->jobs, run_entity_job, &jobs[j], &counter);
+    run_entity_job(&jobs[0]);
+    JobSystem_Wait(state->jobs, &counter);
+}
+
 // --- Public API Function Implementations ---
 
 EntityManager EntityManager_Create(int max_entities)
@@ -22,7 +149,7 @@ EntityManager EntityManager_Create(int max_entities)
         return NULL;
     }
 
-    EntityManager manager = (EntityManager)SDL_malloc(sizeof(struct EntityManager_s));
+    EntityManager manager = (EntityManager)SDL_calloc(1, sizeof(struct EntityManager_s));
     if (!manager)
     {
         SDL_OutOfMemory();
@@ -30,9 +157,19 @@ EntityManager EntityManager_Create(int max_entities)
     }
 
     manager->entities = (EntityFunctions *)SDL_calloc(max_entities, sizeof(EntityFunctions));
-    if (!manager->entities)
+    // Every entity is scheduled at most twice: once for its update and once for its render.
+    manager->schedule = (int *)SDL_calloc((size_t)max_entities * 2, sizeof(int));
+    manager->batch_start = (bool *)SDL_calloc((size_t)max_entities * 2, sizeof(bool));
+    manager->profile_ns = (Uint64 *)SDL_calloc(max_entities, sizeof(Uint64));
+    manager->profile_calls = (Uint64 *)SDL_calloc(max_entities, sizeof(Uint64));
+    if (!manager->entities || !manager->schedule || !manager->batch_start || !manager->profile_ns || !manager->profile_calls)
     {
         SDL_OutOfMemory();
+        SDL_free(manager->entities);
+        SDL_free(manager->schedule);
+        SDL_free(manager->batch_start);
+        SDL_free(manager->profile_ns);
+        SDL_free(manager->profile_calls);
         SDL_free(manager);
         return NULL;
     }
@@ -63,6 +200,10 @@ void EntityManager_Destroy(EntityManager manager, AppState *state)
     }
 
     SDL_free(manager->entities);
+    SDL_free(manager->schedule);
+    SDL_free(manager->batch_start);
+    SDL_free(manager->profile_ns);
+    SDL_free(manager->profile_calls);
     SDL_free(manager);
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "EntityManager destroyed.");
 }
@@ -85,6 +226,17 @@ bool EntityManager_Add(EntityManager manager, const EntityFunctions *funcs)
         return false;
     }
 
+    if (funcs->update && (funcs->update_phase < 0 || is_render_phase(funcs->update_phase)))
+    {
+        SDL_SetError("Entity '%s' has an update callback outside the simulation phases", funcs->name);
+        return false;
+    }
+    if (funcs->render && !is_render_phase(funcs->render_phase))
+    {
+        SDL_SetError("Entity '%s' has a render callback outside the render phases", funcs->name);
+        return false;
+    }
+
     if (manager->count >= manager->capacity)
     {
         SDL_SetError("EntityManager is full (capacity: %d)", manager->capacity);
@@ -102,7 +254,12 @@ bool EntityManager_Add(EntityManager manager, const EntityFunctions *funcs)
     }
 
     manager->entities[manager->count] = *funcs;
+    if (!manager->entities[manager->count].game_states)
+    {
+        manager->entities[manager->count].game_states = ENTITY_IN_STATE(GAME_STATE_PLAYING);
+    }
     manager->count++;
+    rebuild_schedule(manager);
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Added entity '%s' to EntityManager (count: %d).", funcs->name, manager->count);
     return true;
@@ -126,43 +283,36 @@ void EntityManager_HandleEventsAll(EntityManager manager, AppState *state, SDL_E
 
 void EntityManager_UpdateAll(EntityManager manager, AppState *state)
 {
-    if (!manager || !state)
+    for (int phase = 0; phase < ENTITY_FIRST_RENDER_PHASE; ++phase)
     {
-        return;
+        EntityManager_RunPhase(manager, state, (EntityPhase)phase);
     }
+}
 
-    for (int i = 0; i < manager->count; ++i)
+void EntityManager_RenderAll(EntityManager manager, AppState *state)
+{
+    for (int phase = ENTITY_FIRST_RENDER_PHASE; phase < ENTITY_PHASE_COUNT; ++phase)
     {
-        if (manager->entities[i].update)
-        {
-            if (state->currentGameState == GAME_STATE_PLAYING ||
-                !strcmp(manager->entities[i].name, "HUD_manager") ||
-                !strcmp(manager->entities[i].name, "net_client") ||
-                !strcmp(manager->entities[i].name, "net_server"))
-            {
-                manager->entities[i].update(manager, state);
-            }
-        }
+        EntityManager_RunPhase(manager, state, (EntityPhase)phase);
     }
 }
 
-void EntityManager_RenderAll(EntityManager manager, AppState *state)
+void EntityManager_RunPhase(EntityManager manager, AppState *state, EntityPhase phase)
 {
-    if (!manager || !state)
+    if (!manager || !state || phase < 0 || phase >= ENTITY_PHASE_COUNT)
     {
         return;
     }
 
-    for (int i = 0; i < manager->count; ++i)
+    int end = manager->phase_start[phase + 1];
+    for (int n = manager->phase_start[phase]; n < end;)
     {
-        if (manager->entities[i].render)
-        {
-            if (state->currentGameState == GAME_STATE_PLAYING ||
-                !strcmp(manager->entities[i].name, "HUD_manager"))
-            {
-                manager->entities[i].render(manager, state);
-            }
-        }
+        int batch_end = n + 1;
+        while (batch_end < end && !manager->batch_start[batch_end])
+            batch_end++;
+        // The game state is checked per batch: a network message may start the match mid-phase.
+        run_batch(manager, state, phase, n, batch_end);
+        n = batch_end;
     }
 }
 
@@ -181,3 +331,31 @@ const EntityFunctions *EntityManager_FindDefinition(EntityManager manager, const
     }
     return NULL; // Not found
 }
+
+void EntityManager_SetProfiling(EntityManager manager, bool enabled)
+{
+    if (!manager)
+    {
+        return;
+    }
+    if (enabled)
+    {
+        SDL_memset(manager->profile_ns, 0, (size_t)manager->capacity * sizeof(Uint64));
+        SDL_memset(manager->profile_calls, 0, (size_t)manager->capacity * sizeof(Uint64));
+    }
+    manager->profiling = enabled;
+}
+
+int EntityManager_GetProfile(EntityManager manager, EntityProfile *out, int max_out)
+{
+    if (!manager || !out)
+    {
+        return 0;
+    }
+    int count = SDL_min(manager->count, max_out);
+    for (int i = 0; i < count; ++i)
+    {
+        out[i] = (EntityProfile){manager->entities[i].name, manager->profile_ns[i], manager->profile_calls[i]};
+    }
+    return count;
+}
@@ -0,0 +1,357 @@
+#include "../include/flow_field.h"
+#include "../include/ecs.h"
+
+// --- Constants ---
+#define FLOW_DIR_COUNT 8            /**< Neighbours of a cell; odd directions are diagonal. */
+#define FLOW_DIR_NONE FLOW_DIR_COUNT /**< Direction stored at goals and in cells no goal can be reached from. */
+#define FLOW_COST_STRAIGHT 10u
+#define FLOW_COST_DIAGONAL 14u
+#define FLOW_COST_UNREACHED 0xFFFFFFFFu
+
+// --- Enums ---
+
+/**
+ * @brief What a cell holds for the team being baked.
+ */
+typedef enum FlowCell
+{
+    FLOW_CELL_OPEN,
+    FLOW_CELL_BLOCKED, /**< Terrain, a friendly building or a ruin. */
+    FLOW_CELL_GOAL,    /**< Touching distance of a live enemy building. */
+} FlowCell;
+
+// --- Static Variables ---
+
+static const int flow_dx[FLOW_DIR_COUNT] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int flow_dy[FLOW_DIR_COUNT] = {0, 1, 1, 1, 0, -1, -1, -1};
+static const SDL_FPoint flow_vectors[FLOW_DIR_COUNT + 1] = {
+    {1.0f, 0.0f}, {0.70710678f, 0.70710678f}, {0.0f, 1.0f}, {-0.70710678f, 0.70710678f},
+    {-1.0f, 0.0f}, {-0.70710678f, -0.70710678f}, {0.0f, -1.0f}, {0.70710678f, -0.70710678f},
+    {0.0f, 0.0f}};
+
+// --- Internal Structures ---
+
+/**
+ * @brief Internal state for the flow fields.
+ * Cells are stored row-major, cols * rows of them. The search buffers are kept between
+ * bakes so a rebake after a tower falls does not allocate.
+ */
+struct FlowField_s
+{
+    int cols;                  /**< Cells per row. */
+    int rows;                  /**< Cells per column. */
+    SDL_FPoint clearance;      /**< Half size of the units following the field. */
+    Uint8 *terrain;            /**< FlowCell per cell from the map's collision layer alone. */
+    Uint8 *cells;              /**< Bake scratch: FlowCell per cell for the team being baked. */
+    Uint8 *directions[2];      /**< Per team (indexed by team): direction per cell, FLOW_DIR_NONE at goals. */
+    Uint32 *cost;              /**< Bake scratch: integrated cost from each cell to the nearest goal. */
+    int *heap;                 /**< Bake scratch: open cells, a min-heap on cost. */
+    int *heap_pos;             /**< Bake scratch: position of each cell in heap, -1 if not queued. */
+    int heap_count;            /**< Number of cells in heap. */
+};
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Sets every cell whose center lies inside a rectangle.
+ */
+static void mark_rect(FlowField ff, Uint8 *cells, const SDL_FRect *rect, FlowCell value)
+{
+    int c0 = (int)SDL_ceilf(rect->x / FLOW_FIELD_CELL_SIZE - 0.5f);
+    int c1 = (int)SDL_floorf((rect->x + rect->w) / FLOW_FIELD_CELL_SIZE - 0.5f);
+    int r0 = (int)SDL_ceilf(rect->y / FLOW_FIELD_CELL_SIZE - 0.5f);
+    int r1 = (int)SDL_floorf((rect->y + rect->h) / FLOW_FIELD_CELL_SIZE - 0.5f);
+    c0 = SDL_max(c0, 0);
+    r0 = SDL_max(r0, 0);
+    c1 = SDL_min(c1, ff->cols - 1);
+    r1 = SDL_min(r1, ff->rows - 1);
+
+    for (int r = r0; r <= r1; r++)
+        for (int c = c0; c <= c1; c++)
+            cells[r * ff->cols + c] = (Uint8)value;
+}
+
+/**
+ * @brief Stamps the buildings into the cells of one team: live enemy buildings become goals,
+ * everything else an obstacle.
+ */
+static void mark_buildings(FlowField ff, AppState *state, bool team)
+{
+    // Obstacles first, so a goal that overlaps one still wins.
+    for (int pass = 0; pass < 2; pass++)
+    {
+        EcsIter it = Ecs_Query(state->world, ECS_MASK(ECS_COLLIDER) | ECS_MASK(ECS_BOUNDS) | ECS_MASK(ECS_TEAM) | ECS_MASK(ECS_HEALTH), 0);
+        while (EcsIter_Next(&it))
+        {
+            const SDL_FRect *bounds = EcsIter_Column(&it, ECS_BOUNDS);
+            const bool *owner = EcsIter_Column(&it, ECS_TEAM);
+            const EcsHealth *health = EcsIter_Column(&it, ECS_HEALTH);
+            const EcsCollider *collider = EcsIter_Column(&it, ECS_COLLIDER);
+            for (int row = 0; row < it.count; row++)
+            {
+                if (!(collider[row].kind & SPATIAL_KIND_BUILDING))
+                    continue;
+                bool goal = owner[row] != team && health[row].current > 0;
+                if (goal != (pass == 1))
+                    continue;
+
+                // A unit touches a building once its center is within its clearance of the bounds;
+                // goals reach one cell further so the contact happens before the goal is entered.
+                SDL_FPoint grow = ff->clearance;
+                if (goal)
+                {
+                    grow.x += FLOW_FIELD_CELL_SIZE;
+                    grow.y += FLOW_FIELD_CELL_SIZE;
+                }
+                SDL_FRect area = Collision_InflateRect(&bounds[row], grow);
+                mark_rect(ff, ff->cells, &area, goal ? FLOW_CELL_GOAL : FLOW_CELL_BLOCKED);
+            }
+        }
+    }
+}
+
+static void heap_swap(FlowField ff, int a, int b)
+{
+    int tmp = ff->heap[a];
+    ff->heap[a] = ff->heap[b];
+    ff->heap[b] = tmp;
+    ff->heap_pos[ff->heap[a]] = a;
+    ff->heap_pos[ff->heap[b]] = b;
+}
+
+static void heap_sift_up(FlowField ff, int pos)
+{
+    while (pos > 0)
+    {
+        int parent = (pos - 1) / 2;
+        if (ff->cost[ff->heap[parent]] <= ff->cost[ff->heap[pos]])
+            break;
+        heap_swap(ff, parent, pos);
+        pos = parent;
+    }
+}
+
+static void heap_sift_down(FlowField ff, int pos)
+{
+    for (;;)
+    {
+        int left = pos * 2 + 1;
+        int right = left + 1;
+        int smallest = pos;
+        if (left < ff->heap_count && ff->cost[ff->heap[left]] < ff->cost[ff->heap[smallest]])
+            smallest = left;
+        if (right < ff->heap_count && ff->cost[ff->heap[right]] < ff->cost[ff->heap[smallest]])
+            smallest = right;
+        if (smallest == pos)
+            return;
+        heap_swap(ff, pos, smallest);
+        pos = smallest;
+    }
+}
+
+/**
+ * @brief Queues a cell or moves it up after its cost dropped.
+ */
+static void heap_update(FlowField ff, int cell)
+{
+    if (ff->heap_pos[cell] < 0)
+    {
+        ff->heap_pos[cell] = ff->heap_count;
+        ff->heap[ff->heap_count++] = cell;
+    }
+    heap_sift_up(ff, ff->heap_pos[cell]);
+}
+
+static int heap_pop(FlowField ff)
+{
+    int cell = ff->heap[0];
+    heap_swap(ff, 0, --ff->heap_count);
+    heap_sift_down(ff, 0);
+    ff->heap_pos[cell] = -1;
+    return cell;
+}
+
+/**
+ * @brief Checks a move between neighbouring cells. Diagonal moves out of open cells may not
+ * cut the corner of a blocked cell; moves out of blocked cells may, so units can always get out.
+ */
+static bool move_allowed(FlowField ff, int from_c, int from_r, int to_c, int to_r)
+{
+    if (from_c == to_c || from_r == to_r)
+        return true;
+    if (ff->cells[from_r * ff->cols + from_c] == FLOW_CELL_BLOCKED)
+        return true;
+    return ff->cells[from_r * ff->cols + to_c] != FLOW_CELL_BLOCKED && ff->cells[to_r * ff->cols + from_c] != FLOW_CELL_BLOCKED;
+}
+
+/**
+ * @brief Cost of moving into a cell in the given direction.
+ */
+static Uint32 move_cost(FlowField ff, int to_cell, int dir)
+{
+    Uint32 cost = (dir & 1) ? FLOW_COST_DIAGONAL : FLOW_COST_STRAIGHT;
+    return ff->cells[to_cell] == FLOW_CELL_BLOCKED ? cost * FLOW_FIELD_BLOCKED_FACTOR : cost;
+}
+
+/**
+ * @brief Bakes the field of one team from ff->cells: integrates the cost to the nearest goal
+ * (Dijkstra from all goals at once), then points every cell at its cheapest neighbour.
+ */
+static void bake_team(FlowField ff, Uint8 *directions)
+{
+    int count = ff->cols * ff->rows;
+    ff->heap_count = 0;
+    for (int i = 0; i < count; i++)
+    {
+        ff->heap_pos[i] = -1;
+        ff->cost[i] = FLOW_COST_UNREACHED;
+        if (ff->cells[i] == FLOW_CELL_GOAL)
+        {
+            ff->cost[i] = 0;
+            heap_update(ff, i);
+        }
+    }
+
+    // --- Integrate ---
+    // The search runs backwards from the goals, so a step from cell u to neighbour v is the unit's move v -> u.
+    while (ff->heap_count > 0)
+    {
+        int u = heap_pop(ff);
+        int uc = u % ff->cols;
+        int ur = u / ff->cols;
+        for (int dir = 0; dir < FLOW_DIR_COUNT; dir++)
+        {
+            int vc = uc - flow_dx[dir];
+            int vr = ur - flow_dy[dir];
+            if (vc < 0 || vr < 0 || vc >= ff->cols || vr >= ff->rows || !move_allowed(ff, vc, vr, uc, ur))
+                continue;
+            int v = vr * ff->cols + vc;
+            Uint32 cost = ff->cost[u] + move_cost(ff, u, dir);
+            if (cost < ff->cost[v])
+            {
+                ff->cost[v] = cost;
+                heap_update(ff, v);
+            }
+        }
+    }
+
+    // --- Pick Directions ---
+    // Ties keep the first direction in flow_dx order, so every bake of the same map gives the same field.
+    for (int v = 0; v < count; v++)
+    {
+        directions[v] = FLOW_DIR_NONE;
+        if (ff->cells[v] == FLOW_CELL_GOAL)
+            continue;
+
+        int vc = v % ff->cols;
+        int vr = v / ff->cols;
+        Uint32 best = FLOW_COST_UNREACHED;
+        for (int dir = 0; dir < FLOW_DIR_COUNT; dir++)
+        {
+            int uc = vc + flow_dx[dir];
+            int ur = vr + flow_dy[dir];
+            if (uc < 0 || ur < 0 || uc >= ff->cols || ur >= ff->rows || !move_allowed(ff, vc, vr, uc, ur))
+                continue;
+            int u = ur * ff->cols + uc;
+            if (ff->cost[u] == FLOW_COST_UNREACHED)
+                continue;
+            Uint32 cost = ff->cost[u] + move_cost(ff, u, dir);
+            if (cost < best)
+            {
+                best = cost;
+                directions[v] = (Uint8)dir;
+            }
+        }
+    }
+}
+
+// --- Public API Function Implementations ---
+
+FlowField FlowField_Init(AppState *state, SDL_FPoint clearance)
+{
+    if (!state || !state->map_state || !state->world)
+    {
+        SDL_SetError("Invalid AppState or missing map_state/world for FlowField_Init");
+        return NULL;
+    }
+
+    FlowField ff = (FlowField)SDL_calloc(1, sizeof(struct FlowField_s));
+    if (!ff)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ff->cols = (int)SDL_ceilf(Map_GetWidthPixels(state->map_state) / FLOW_FIELD_CELL_SIZE);
+    ff->rows = (int)SDL_ceilf(Map_GetHeightPixels(state->map_state) / FLOW_FIELD_CELL_SIZE);
+    ff->clearance = clearance;
+
+    size_t count = (size_t)ff->cols * (size_t)ff->rows;
+    ff->terrain = (Uint8 *)SDL_calloc(count, sizeof(Uint8));
+    ff->cells = (Uint8 *)SDL_malloc(count * sizeof(Uint8));
+    ff->directions[0] = (Uint8 *)SDL_malloc(count * sizeof(Uint8));
+    ff->directions[1] = (Uint8 *)SDL_malloc(count * sizeof(Uint8));
+    ff->cost = (Uint32 *)SDL_malloc(count * sizeof(Uint32));
+    ff->heap = (int *)SDL_malloc(count * sizeof(int));
+    ff->heap_pos = (int *)SDL_malloc(count * sizeof(int));
+    if (count == 0 || !ff->terrain || !ff->cells || !ff->directions[0] || !ff->directions[1] || !ff->cost || !ff->heap || !ff->heap_pos)
+    {
+        if (count == 0)
+            SDL_SetError("FlowField_Init: map has no size");
+        else
+            SDL_OutOfMemory();
+        FlowField_Destroy(ff);
+        return NULL;
+    }
+
+    // --- Rasterize the Collision Layer ---
+    const SDL_FRect *rects = NULL;
+    int rect_count = Map_GetCollisionRects(state->map_state, &rects);
+    for (int i = 0; i < rect_count; i++)
+    {
+        SDL_FRect area = Collision_InflateRect(&rects[i], clearance);
+        mark_rect(ff, ff->terrain, &area, FLOW_CELL_BLOCKED);
+    }
+
+    FlowField_Bake(ff, state);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FlowField initialized (%dx%d cells, %d terrain rects).", ff->cols, ff->rows, rect_count);
+    return ff;
+}
+
+void FlowField_Destroy(FlowField ff)
+{
+    if (!ff)
+        return;
+    SDL_free(ff->terrain);
+    SDL_free(ff->cells);
+    SDL_free(ff->directions[0]);
+    SDL_free(ff->directions[1]);
+    SDL_free(ff->cost);
+    SDL_free(ff->heap);
+    SDL_free(ff->heap_pos);
+    SDL_free(ff);
+}
+
+void FlowField_Bake(FlowField ff, AppState *state)
+{
+    if (!ff || !state || !state->world)
+        return;
+
+    Uint64 start = SDL_GetTicksNS();
+    for (int team = 0; team < 2; team++)
+    {
+        SDL_memcpy(ff->cells, ff->terrain, (size_t)ff->cols * (size_t)ff->rows);
+        mark_buildings(ff, state, team != 0);
+        bake_team(ff, ff->directions[team]);
+    }
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[FlowField] Baked both teams in %.2f ms.", (double)(SDL_GetTicksNS() - start) / 1e6);
+}
+
+SDL_FPoint FlowField_GetDirection(FlowField ff, bool team, SDL_FPoint position)
+{
+    if (!ff)
+        return flow_vectors[FLOW_DIR_NONE];
+
+    int col = CLAMP((int)SDL_floorf(position.x / FLOW_FIELD_CELL_SIZE), 0, ff->cols - 1);
+    int row = CLAMP((int)SDL_floorf(position.y / FLOW_FIELD_CELL_SIZE), 0, ff->rows - 1);
+    return flow_vectors[ff->directions[team ? 1 : 0][row * ff->cols + col]];
+}
@@ -91,8 +91,9 @@ void create_hud_instance(AppState *state, int index, char name[], bool changeabl
 void update_hud_instance(AppState *state, int index, char text_buffer[], SDL_Color color, SDL_FPoint dest_point, FontSize fontSize)
 {
     HUDManager hm = state ? state->HUD_manager : NULL;
-    // Ensure local HUD exists and required managers are available.
-    if (!hm || !state)
+    // Ensure local HUD exists and required managers are available. Lookups of missing elements return -1.
+    // Without a renderer (headless tools) there is nothing to draw the text with.
+    if (!hm || !state || !state->renderer || index < 0 || index >= HUD_MAX_ELEMENTS_AMOUNT)
     {
         return;
     }
@@ -146,18 +147,8 @@ static void HUD_manager_event_callback(EntityManager manager, AppState *state, S
                 // Process the command when Enter is pressed
                 if (strcmp(command_input_buffer, "start") == 0)
                 {
-                    SDL_Log("Host selected 'start'. Transitioning to GAME_STATE_PLAYING.");
-                    state->currentGameState = GAME_STATE_PLAYING;
+                    NetServer_StartMatch(state);
                     SDL_StopTextInput(state->window);
-
-                    // Broadcast MSG_TYPE_S_GAME_START to all clients
-                    if (state->net_server_state)
-                    {
-                        Msg_GameStart msg;
-                        msg.message_type = MSG_TYPE_S_GAME_START;
-                        msg.server_start_time_stamp = SDL_GetTicks();
-                        NetServer_BroadcastMessage(state->net_server_state, &msg, sizeof(Msg_GameStart), -1);
-                    }
                     hm->elements[get_hud_index_by_name(state, "lobby_host_msg")].visible = false;
                     hm->elements[get_hud_index_by_name(state, "lobby_host_input")].visible = false;
                 }
@@ -234,9 +225,9 @@ static void HUD_manager_cleanup_callback(EntityManager manager, AppState *state)
 // --- Static Helper Functions ---
 HUDManager HUDManager_Init(AppState *state)
 {
-    if (!state || !state->renderer || !state->entity_manager)
+    if (!state || !state->entity_manager)
     {
-        SDL_SetError("Invalid AppState or missing renderer/entity_manager for HUDManager_Init");
+        SDL_SetError("Invalid AppState or missing entity_manager for HUDManager_Init");
         return NULL;
     }
 
@@ -284,6 +275,11 @@ HUDManager HUDManager_Init(AppState *state)
     // --- Register with EntityManager ---
     EntityFunctions HUD_funcs = {
         .name = "HUD_manager",
+        .update_phase = ENTITY_PHASE_POST_SIM,
+        .render_phase = ENTITY_PHASE_HUD,
+        .game_states = ENTITY_IN_ALL_STATES,
+        .reads = ENTITY_RES_GAME_STATE,
+        .writes = ENTITY_RES_HUD | ENTITY_RES_RENDERER,
         .update = HUD_manager_update_callback,
         .render = HUD_manager_render_callback,
         .cleanup = HUD_manager_cleanup_callback,
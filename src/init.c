@@ -36,6 +36,11 @@ static void cleanup_on_failure(AppState *state, const char *failure_stage)
   {
     BaseManager_Destroy(state->base_manager);
   }
+  NavGrid_Destroy(state->nav_grid);             // NULL until its stage succeeded
+  FlowField_Destroy(state->flow_field);         // NULL until its stage succeeded
+  SpatialHash_Destroy(state->spatial_hash);     // NULL until its stage succeeded
+  DamageBus_Destroy(state->damage_bus);         // NULL until its stage succeeded
+  CommandBuffer_Destroy(state->command_buffer); // NULL until its stage succeeded
   if (strcmp(failure_stage, "Map_Init") != 0 && strcmp(failure_stage, "Base_Init") != 0 && strcmp(failure_stage, "Tower_Init") != 0 && strcmp(failure_stage, "Attack_Init") != 0 && strcmp(failure_stage, "PlayerManager_Init") != 0 && strcmp(failure_stage, "Camera_Init") != 0)
   {
     Map_Destroy(state->map_state);
@@ -58,6 +63,8 @@ static void cleanup_on_failure(AppState *state, const char *failure_stage)
   {
     EntityManager_Destroy(state->entity_manager, state);
   }
+  EcsWorld_Destroy(state->world); // NULL until its stage succeeded
+  JobSystem_Destroy(state->jobs);  // NULL until its stage succeeded
 
   // --- SDL Subsystem Cleanup ---
   if (strcmp(failure_stage, "SDLNet_Init") != 0)
@@ -72,6 +79,7 @@ static void cleanup_on_failure(AppState *state, const char *failure_stage)
   {
     SDL_QuitSubSystem(SDL_INIT_VIDEO);
   }
+  SimClock_Destroy(state->clock);
   SDL_free(state);
 }
 
@@ -83,6 +91,11 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv)
   bool is_server_arg = true;                   // Default to server unless --client is specified
   bool team_arg = BLUE_TEAM;                   // Default team
   const char *hostname_arg = DEFAULT_HOSTNAME; // Default hostname
+  const char *shm_arg = NULL;                  // Shared-memory segment, TCP only if NULL
+  int sim_hz_arg = DEFAULT_SIM_HZ;             // Fixed simulation rate
+  bool vsync_arg = false;                      // Let the display pace rendering
+  bool uncapped_arg = false;                   // Render as fast as possible
+  int jobs_arg = JOB_SYSTEM_AUTO_WORKERS;      // One simulation worker per extra core
 
   for (int i = 1; i < argc; ++i)
   {
@@ -99,6 +112,29 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv)
       hostname_arg = argv[i + 1];
       i++;
     }
+    else if (!strcmp(argv[i], "--shm") && (i + 1 < argc))
+    {
+      shm_arg = argv[i + 1];
+      i++;
+    }
+    else if (!strcmp(argv[i], "--sim-hz") && (i + 1 < argc))
+    {
+      sim_hz_arg = CLAMP(SDL_atoi(argv[i + 1]), 10, 240);
+      i++;
+    }
+    else if (!strcmp(argv[i], "--vsync"))
+    {
+      vsync_arg = true;
+    }
+    else if (!strcmp(argv[i], "--uncapped"))
+    {
+      uncapped_arg = true;
+    }
+    else if (!strcmp(argv[i], "--jobs") && (i + 1 < argc))
+    {
+      jobs_arg = CLAMP(SDL_atoi(argv[i + 1]), 0, JOB_SYSTEM_MAX_WORKERS);
+      i++;
+    }
   }
 
   SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Running as %s.", is_server_arg ? "server" : "client");
@@ -107,6 +143,11 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv)
   {
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Connecting to host: %s", hostname_arg);
   }
+  if (shm_arg)
+  {
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Using shared-memory transport: %s", shm_arg);
+  }
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Simulating at %d Hz, rendering %s.", sim_hz_arg, vsync_arg ? "vsynced" : (uncapped_arg ? "uncapped" : "capped"));
 
   SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Running as %s.", is_server_arg ? "server (default)" : "client");
   SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Playing for team %s.", team_arg ? "RED" : "BLUE");
@@ -122,9 +163,25 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv)
     return SDL_APP_FAILURE;
   }
   state->is_server = is_server_arg;
+  state->shm_name = shm_arg;
+  state->sim_step = 1.0f / (float)sim_hz_arg;
+  state->uncapped_render = vsync_arg || uncapped_arg;
+  state->job_workers = jobs_arg;
   state->quit_requested = false;
+  SimRng_SeedStreams(state->rng, SIM_RNG_DEFAULT_SEED);
+  SimTuning_SetDefaults(&state->tuning);
   *appstate = state;
 
+  // --- Clock ---
+  state->clock = SimClock_CreateReal();
+  if (!state->clock)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Init] SimClock_CreateReal failed: %s", SDL_GetError());
+    SDL_free(state);
+    *appstate = NULL;
+    return SDL_APP_FAILURE;
+  }
+
   // --- SDL Initialization ---
   if (!SDL_Init(SDL_INIT_VIDEO))
   {
@@ -154,6 +211,12 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv)
     return SDL_APP_FAILURE;
   }
 
+  if (vsync_arg && !SDL_SetRenderVSync(state->renderer, 1))
+  {
+    SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "[Init] SDL_SetRenderVSync failed, falling back to capped rendering: %s", SDL_GetError());
+    state->uncapped_render = uncapped_arg;
+  }
+
   // --- Set Logical Presentation ---
   if (!SDL_SetRenderLogicalPresentation(state->renderer, (int)CAMERA_VIEW_WIDTH, (int)CAMERA_VIEW_HEIGHT, SDL_LOGICAL_PRESENTATION_LETTERBOX))
   {
@@ -169,97 +232,11 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv)
     return SDL_APP_FAILURE;
   }
 
-  // --- Create Entity Manager ---
-  state->entity_manager = EntityManager_Create(MAX_MANAGED_ENTITIES);
-  if (!state->entity_manager)
-  {
-    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Init] EntityManager_Create failed: %s", SDL_GetError());
-    cleanup_on_failure(state, "EntityManager_Create");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  // --- Initialize Core Modules (Order Matters!) ---
-  if (state->is_server)
-  {
-    state->net_server_state = NetServer_Init(state);
-    if (!state->net_server_state)
-    {
-      cleanup_on_failure(state, "NetServer_Init");
-      *appstate = NULL;
-      return SDL_APP_FAILURE;
-    }
-  }
-
-  // Always initialize the client module
-  state->net_client_state = NetClient_Init(state, hostname_arg);
-  if (!state->net_client_state)
-  {
-    cleanup_on_failure(state, "NetClient_Init");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  state->map_state = Map_Init(state);
-  if (!state->map_state)
-  {
-    cleanup_on_failure(state, "Map_Init");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  state->HUD_manager = HUDManager_Init(state);
-  if (!state->HUD_manager)
-  {
-    cleanup_on_failure(state, "HUDManager_Init");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  state->base_manager = BaseManager_Init(state);
-  if (!state->base_manager)
-  {
-    cleanup_on_failure(state, "Base_Init");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  state->tower_manager = TowerManager_Init(state);
-  if (!state->tower_manager)
-  {
-    cleanup_on_failure(state, "Tower_Init");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  state->attack_manager = AttackManager_Init(state);
-  if (!state->attack_manager)
-  {
-    cleanup_on_failure(state, "Attack_Init");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  state->player_manager = PlayerManager_Init(state);
-  if (!state->player_manager)
-  {
-    cleanup_on_failure(state, "PlayerManager_Init");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  state->minion_manager = MinionManager_Init(state);
-  if (!state->minion_manager)
-  {
-    cleanup_on_failure(state, "MinionManager_Init");
-    *appstate = NULL;
-    return SDL_APP_FAILURE;
-  }
-
-  state->camera_state = Camera_Init(state);
-  if (!state->camera_state)
+  // --- Create Entity Manager and Modules ---
+  const char *failed_stage = AppSetup_InitModules(state, hostname_arg);
+  if (failed_stage)
   {
-    cleanup_on_failure(state, "Camera_Init");
+    cleanup_on_failure(state, failed_stage);
     *appstate = NULL;
     return SDL_APP_FAILURE;
   }
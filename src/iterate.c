@@ -20,7 +20,10 @@ SDL_AppResult SDL_AppIterate(void *appstate)
 
   app_update(state);
   app_render(state);
-  app_wait_for_next_frame(state);
+  if (!state->uncapped_render)
+  {
+    app_wait_for_next_frame(state);
+  }
 
   return state->quit_requested ? SDL_APP_SUCCESS : SDL_APP_CONTINUE;
 }
\ No newline at end of file
@@ -0,0 +1,426 @@
+#include "../include/job_system.h"
+
+// --- Constants ---
+#define JOB_CHUNKS_PER_THREAD 4 /**< ParallelFor chunks per thread, so faster threads can steal the remainder. */
+
+// --- Internal Structures ---
+
+/**
+ * @brief A queued job and the group it belongs to.
+ */
+typedef struct Job
+{
+    JobFunc func;
+    void *data;
+    JobCounter *counter;     /**< Decremented after the job ran (may be NULL). */
+    const JobCounter *after; /**< The job may not start before this group finished (may be NULL). */
+} Job;
+
+/**
+ * @brief Ring buffer of jobs owned by one thread.
+ * The owner pushes and pops at the back (newest first, which keeps its data in cache);
+ * other threads steal from the front (oldest first, usually the largest remaining work).
+ */
+typedef struct JobQueue
+{
+    SDL_Mutex *lock;
+    Job jobs[JOB_QUEUE_CAPACITY];
+    int head;  /**< Position of the oldest job. */
+    int count; /**< Number of queued jobs. */
+} JobQueue;
+
+/**
+ * @brief Per-thread identity, stored in thread-local storage so jobs submitted from a worker
+ * go to that worker's queue.
+ */
+typedef struct JobWorker
+{
+    JobSystem js;
+    int queue;          /**< Index of the thread's own queue. */
+    SDL_Thread *thread; /**< NULL for the creating thread. */
+} JobWorker;
+
+/**
+ * @brief Internal state for the JobSystem.
+ * Queue 0 belongs to the creating thread (and any other thread that is not a worker),
+ * queue i + 1 to worker i.
+ */
+struct JobSystem_s
+{
+    int worker_count;  /**< Workers the queues are laid out for; fixed before the first thread starts. */
+    int thread_count;  /**< Workers actually started. */
+    JobWorker workers[JOB_SYSTEM_MAX_WORKERS];
+    JobQueue queues[JOB_SYSTEM_MAX_WORKERS + 1];
+    SDL_AtomicInt queued; /**< Jobs across all queues; workers sleep while it is 0. */
+    SDL_AtomicInt quit;
+    SDL_Mutex *sleep_lock;
+    SDL_Condition *wake;
+};
+
+/**
+ * @brief Describes one chunk of a JobSystem_ParallelFor.
+ */
+typedef struct ParallelForChunk
+{
+    JobRangeFunc func;
+    void *data;
+    int begin;
+    int end;
+} ParallelForChunk;
+
+// --- Static Variables ---
+
+static SDL_TLSID current_worker; /**< JobWorker of the calling thread, NULL outside the workers. */
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Returns the queue the calling thread owns in this pool.
+ */
+static int own_queue(JobSystem js)
+{
+    const JobWorker *worker = (const JobWorker *)SDL_GetTLS(&current_worker);
+    return (worker && worker->js == js) ? worker->queue : 0;
+}
+
+static bool counter_done(const JobCounter *counter)
+{
+    return !counter || SDL_GetAtomicInt((SDL_AtomicInt *)&counter->pending) <= 0;
+}
+
+/**
+ * @brief Appends a job at the owner's end.
+ * @return False if the queue is full.
+ */
+static bool queue_push_back(JobQueue *q, const Job *job)
+{
+    SDL_LockMutex(q->lock);
+    bool pushed = q->count < JOB_QUEUE_CAPACITY;
+    if (pushed)
+        q->jobs[(q->head + q->count++) % JOB_QUEUE_CAPACITY] = *job;
+    SDL_UnlockMutex(q->lock);
+    return pushed;
+}
+
+/**
+ * @brief Puts a job back at the thieves' end, behind the work its owner will try first.
+ * @return False if the queue is full.
+ */
+static bool queue_push_front(JobQueue *q, const Job *job)
+{
+    SDL_LockMutex(q->lock);
+    bool pushed = q->count < JOB_QUEUE_CAPACITY;
+    if (pushed)
+    {
+        q->head = (q->head + JOB_QUEUE_CAPACITY - 1) % JOB_QUEUE_CAPACITY;
+        q->jobs[q->head] = *job;
+        q->count++;
+    }
+    SDL_UnlockMutex(q->lock);
+    return pushed;
+}
+
+/**
+ * @brief Takes the newest job (owner side).
+ */
+static bool queue_pop_back(JobQueue *q, Job *out)
+{
+    SDL_LockMutex(q->lock);
+    bool popped = q->count > 0;
+    if (popped)
+        *out = q->jobs[(q->head + --q->count) % JOB_QUEUE_CAPACITY];
+    SDL_UnlockMutex(q->lock);
+    return popped;
+}
+
+/**
+ * @brief Takes the oldest job (thief side).
+ */
+static bool queue_steal_front(JobQueue *q, Job *out)
+{
+    SDL_LockMutex(q->lock);
+    bool stolen = q->count > 0;
+    if (stolen)
+    {
+        *out = q->jobs[q->head];
+        q->head = (q->head + 1) % JOB_QUEUE_CAPACITY;
+        q->count--;
+    }
+    SDL_UnlockMutex(q->lock);
+    return stolen;
+}
+
+/**
+ * @brief Wakes sleeping workers after jobs were queued.
+ * Taking the lock orders the wake-up after a worker's last look at the queued count.
+ */
+static void wake_workers(JobSystem js, bool all)
+{
+    if (js->worker_count == 0)
+        return;
+    SDL_LockMutex(js->sleep_lock);
+    if (all)
+        SDL_BroadcastCondition(js->wake);
+    else
+        SDL_SignalCondition(js->wake);
+    SDL_UnlockMutex(js->sleep_lock);
+}
+
+/**
+ * @brief Finds work for a thread: its own queue first, then the other queues in turn.
+ */
+static bool find_job(JobSystem js, int self, Job *out)
+{
+    if (queue_pop_back(&js->queues[self], out))
+    {
+        SDL_AddAtomicInt(&js->queued, -1);
+        return true;
+    }
+    int queue_count = js->worker_count + 1;
+    for (int n = 1; n < queue_count; n++)
+    {
+        if (queue_steal_front(&js->queues[(self + n) % queue_count], out))
+        {
+            SDL_AddAtomicInt(&js->queued, -1);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void finish_job(const Job *job)
+{
+    job->func(job->data);
+    if (job->counter)
+        SDL_AddAtomicInt(&job->counter->pending, -1);
+}
+
+/**
+ * @brief Runs a job taken from a queue, or requeues it if its dependency is still running.
+ * @return True if the job ran.
+ */
+static bool run_job(JobSystem js, int self, const Job *job)
+{
+    if (!counter_done(job->after))
+    {
+        if (queue_push_front(&js->queues[self], job))
+        {
+            SDL_AddAtomicInt(&js->queued, 1);
+            return false;
+        }
+        JobSystem_Wait(js, (JobCounter *)job->after);
+    }
+    finish_job(job);
+    return true;
+}
+
+/**
+ * @brief Queues a job on the calling thread's queue, running it inline if the queue is full.
+ * @return True if the job was queued and workers should be woken.
+ */
+static bool enqueue(JobSystem js, const Job *job)
+{
+    if (job->counter)
+        SDL_AddAtomicInt(&job->counter->pending, 1);
+
+    if (queue_push_back(&js->queues[own_queue(js)], job))
+    {
+        SDL_AddAtomicInt(&js->queued, 1);
+        return true;
+    }
+
+    if (!counter_done(job->after))
+        JobSystem_Wait(js, (JobCounter *)job->after);
+    finish_job(job);
+    return false;
+}
+
+static int worker_main(void *data)
+{
+    JobWorker *worker = (JobWorker *)data;
+    JobSystem js = worker->js;
+    SDL_SetTLS(&current_worker, worker, NULL);
+
+    while (!SDL_GetAtomicInt(&js->quit))
+    {
+        Job job;
+        if (find_job(js, worker->queue, &job))
+        {
+            if (!run_job(js, worker->queue, &job))
+                SDL_CPUPauseInstruction();
+            continue;
+        }
+
+        SDL_LockMutex(js->sleep_lock);
+        while (!SDL_GetAtomicInt(&js->quit) && SDL_GetAtomicInt(&js->queued) == 0)
+            SDL_WaitCondition(js->wake, js->sleep_lock);
+        SDL_UnlockMutex(js->sleep_lock);
+    }
+    return 0;
+}
+
+static void run_chunk(void *data)
+{
+    const ParallelForChunk *chunk = (const ParallelForChunk *)data;
+    chunk->func(chunk->data, chunk->begin, chunk->end);
+}
+
+// --- Public API Function Implementations ---
+
+JobSystem JobSystem_Create(int worker_count)
+{
+    if (worker_count == JOB_SYSTEM_AUTO_WORKERS)
+        worker_count = SDL_GetNumLogicalCPUCores() - 1;
+    worker_count = SDL_clamp(worker_count, 0, JOB_SYSTEM_MAX_WORKERS);
+
+    JobSystem js = (JobSystem)SDL_calloc(1, sizeof(struct JobSystem_s));
+    if (!js)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    js->sleep_lock = SDL_CreateMutex();
+    js->wake = SDL_CreateCondition();
+    if (!js->sleep_lock || !js->wake)
+    {
+        JobSystem_Destroy(js);
+        return NULL;
+    }
+    for (int i = 0; i <= worker_count; i++)
+    {
+        js->queues[i].lock = SDL_CreateMutex();
+        if (!js->queues[i].lock)
+        {
+            JobSystem_Destroy(js);
+            return NULL;
+        }
+    }
+
+    js->worker_count = worker_count;
+    for (int i = 0; i < worker_count; i++)
+    {
+        JobWorker *worker = &js->workers[i];
+        worker->js = js;
+        worker->queue = i + 1;
+        worker->thread = SDL_CreateThread(worker_main, "job_worker", worker);
+        if (!worker->thread)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[JobSystem] Failed to start worker %d: %s", i, SDL_GetError());
+            JobSystem_Destroy(js);
+            return NULL;
+        }
+        js->thread_count++;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "JobSystem started with %d worker thread(s).", js->worker_count);
+    return js;
+}
+
+void JobSystem_Destroy(JobSystem js)
+{
+    if (!js)
+        return;
+
+    SDL_SetAtomicInt(&js->quit, 1);
+    if (js->sleep_lock && js->wake)
+    {
+        SDL_LockMutex(js->sleep_lock);
+        SDL_BroadcastCondition(js->wake);
+        SDL_UnlockMutex(js->sleep_lock);
+    }
+    for (int i = 0; i < js->thread_count; i++)
+        SDL_WaitThread(js->workers[i].thread, NULL);
+
+    for (int i = 0; i <= JOB_SYSTEM_MAX_WORKERS; i++)
+    {
+        if (js->queues[i].lock)
+            SDL_DestroyMutex(js->queues[i].lock);
+    }
+    if (js->wake)
+        SDL_DestroyCondition(js->wake);
+    if (js->sleep_lock)
+        SDL_DestroyMutex(js->sleep_lock);
+    SDL_free(js);
+}
+
+int JobSystem_GetWorkerCount(JobSystem js)
+{
+    return js ? js->worker_count : 0;
+}
+
+void JobSystem_Submit(JobSystem js, JobFunc func, void *data, JobCounter *counter)
+{
+    JobSystem_SubmitAfter(js, func, data, NULL, counter);
+}
+
+void JobSystem_SubmitAfter(JobSystem js, JobFunc func, void *data, const JobCounter *after, JobCounter *counter)
+{
+    if (!func)
+        return;
+
+    Job job = {func, data, counter, after};
+    if (!js)
+    {
+        // Without a pool everything runs in submission order, so the dependency has finished.
+        func(data);
+        return;
+    }
+    if (enqueue(js, &job))
+        wake_workers(js, false);
+}
+
+void JobSystem_Wait(JobSystem js, JobCounter *counter)
+{
+    if (!js || !counter)
+        return;
+
+    int self = own_queue(js);
+    while (!counter_done(counter))
+    {
+        Job job;
+        if (!find_job(js, self, &job) || !run_job(js, self, &job))
+            SDL_CPUPauseInstruction();
+    }
+}
+
+void JobSystem_ParallelFor(JobSystem js, int count, int min_chunk, JobRangeFunc func, void *data)
+{
+    if (!func || count <= 0)
+        return;
+
+    min_chunk = SDL_max(min_chunk, 1);
+    int chunk_count = 1;
+    if (js && js->worker_count > 0)
+        chunk_count = SDL_min(count / min_chunk, SDL_min(JOB_MAX_CHUNKS, (js->worker_count + 1) * JOB_CHUNKS_PER_THREAD));
+    if (chunk_count < 2)
+    {
+        func(data, 0, count);
+        return;
+    }
+
+    ParallelForChunk chunks[JOB_MAX_CHUNKS];
+    JobCounter counter;
+    SDL_SetAtomicInt(&counter.pending, 0);
+
+    for (int c = 0; c < chunk_count; c++)
+    {
+        chunks[c].func = func;
+        chunks[c].data = data;
+        chunks[c].begin = (int)((Sint64)count * c / chunk_count);
+        chunks[c].end = (int)((Sint64)count * (c + 1) / chunk_count);
+    }
+
+    // Queue all but the first chunk, wake everyone once, then work on the first chunk here.
+    bool queued = false;
+    for (int c = 1; c < chunk_count; c++)
+    {
+        Job job = {run_chunk, &chunks[c], &counter, NULL};
+        queued |= enqueue(js, &job);
+    }
+    if (queued)
+        wake_workers(js, true);
+
+    run_chunk(&chunks[0]);
+    JobSystem_Wait(js, &counter);
+}
@@ -25,10 +25,48 @@ typedef struct TilesetTexture
  */
 struct MapState_s
 {
-  cute_tiled_map_t *map_data;       /**< Parsed Tiled map data. */
-  TilesetTexture *tileset_textures; /**< Linked list of loaded tileset textures. */
+  cute_tiled_map_t *map_data;                         /**< Parsed Tiled map data. */
+  TilesetTexture *tileset_textures;                   /**< Linked list of loaded tileset textures. */
+  SDL_FRect collision_rects[MAP_MAX_COLLISION_RECTS]; /**< Rectangles of the collision layer (world pixels). */
+  int collision_count;                                /**< Number of valid collision_rects. */
 };
 
+// --- Static Helper Functions ---
+
+/**
+ * @brief Copies the rectangles of the collision object layer of a parsed map.
+ * Ellipses count as their bounding box; points, polylines and polygons are skipped.
+ * @param map The parsed Tiled map.
+ * @param out_rects Receives up to MAP_MAX_COLLISION_RECTS rectangles (world pixels).
+ * @return The number of rectangles copied.
+ */
+static int read_collision_rects(const cute_tiled_map_t *map, SDL_FRect *out_rects)
+{
+  int count = 0;
+  for (cute_tiled_layer_t *layer = map->layers; layer; layer = layer->next)
+  {
+    if (strcmp(layer->type.ptr, "objectgroup") != 0 || strcmp(layer->name.ptr, MAP_COLLISION_LAYER) != 0)
+      continue;
+
+    for (cute_tiled_object_t *object = layer->objects; object; object = object->next)
+    {
+      if (object->point || object->vert_count > 0 || object->width <= 0.0f || object->height <= 0.0f)
+        continue;
+      if (count == MAP_MAX_COLLISION_RECTS)
+      {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Map Init] Collision layer has more than %d rectangles, ignoring the rest.", MAP_MAX_COLLISION_RECTS);
+        return count;
+      }
+      out_rects[count++] = (SDL_FRect){
+          object->x + layer->offsetx, object->y + layer->offsety, object->width, object->height};
+    }
+  }
+
+  if (count == 0)
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Map Init] No '%s' object layer found, all terrain is walkable.", MAP_COLLISION_LAYER);
+  return count;
+}
+
 // --- Static Callback Functions (for EntityManager) ---
 
 /**
@@ -180,13 +218,13 @@ static void map_cleanup_callback(EntityManager manager, AppState *state)
 
 MapState Map_Init(AppState *state)
 {
-  if (!state || !state->renderer || !state->entity_manager)
+  if (!state || !state->entity_manager)
   {
-    SDL_SetError("Invalid AppState or missing renderer/entity_manager for Map_Init");
+    SDL_SetError("Invalid AppState or missing entity_manager for Map_Init");
     return NULL;
   }
 
-  const char map_path[] = "./resources/Map/tiledMap.json";
+  const char map_path[] = MAP_FILE_PATH;
 
   // --- Allocate State ---
   MapState map_state = (MapState)SDL_calloc(1, sizeof(struct MapState_s));
@@ -204,6 +242,7 @@ MapState Map_Init(AppState *state)
     SDL_free(map_state);
     return NULL;
   }
+  map_state->collision_count = read_collision_rects(map_state->map_data, map_state->collision_rects);
 
   // --- Load Tileset Textures ---
   cute_tiled_tileset_t *tiled_tileset = map_state->map_data->tilesets;
@@ -239,16 +278,20 @@ MapState Map_Init(AppState *state)
       return NULL;
     }
 
-    new_node->texture = IMG_LoadTexture(state->renderer, image_path);
-    if (!new_node->texture)
+    // Headless tools only need the collision layer; the tiles stay without a texture.
+    if (state->renderer)
     {
-      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Map Init] Failed to load texture '%s': %s", image_path, SDL_GetError());
-      SDL_free(new_node);
-      Internal_MapCleanupImplementation(map_state); // Cleanup
-      SDL_free(map_state);
-      return NULL;
+      new_node->texture = IMG_LoadTexture(state->renderer, image_path);
+      if (!new_node->texture)
+      {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Map Init] Failed to load texture '%s': %s", image_path, SDL_GetError());
+        SDL_free(new_node);
+        Internal_MapCleanupImplementation(map_state); // Cleanup
+        SDL_free(map_state);
+        return NULL;
+      }
+      SDL_SetTextureScaleMode(new_node->texture, SDL_SCALEMODE_NEAREST);
     }
-    SDL_SetTextureScaleMode(new_node->texture, SDL_SCALEMODE_NEAREST);
 
     // Append to linked list
     if (!list_head)
@@ -268,6 +311,9 @@ MapState Map_Init(AppState *state)
   // --- Register with EntityManager ---
   EntityFunctions map_entity_funcs = {
       .name = "map",
+      .render_phase = ENTITY_PHASE_RENDER,
+      .reads = ENTITY_RES_MAP | ENTITY_RES_CAMERA,
+      .writes = ENTITY_RES_RENDERER,
       .render = map_render_callback,
       .cleanup = map_cleanup_callback,
       .update = NULL,
@@ -315,3 +361,52 @@ int Map_GetHeightPixels(MapState map_state)
   }
   return 0;
 }
+
+int Map_GetCollisionRects(MapState map_state, const SDL_FRect **out_rects)
+{
+  if (!map_state || !out_rects)
+  {
+    return 0;
+  }
+  *out_rects = map_state->collision_rects;
+  return map_state->collision_count;
+}
+
+bool Map_LoadCollisionLayer(const char *map_path, SDL_FRect *out_rects, int *out_count, SDL_Point *out_size)
+{
+  if (!map_path || !out_rects || !out_count)
+  {
+    SDL_SetError("Invalid arguments for Map_LoadCollisionLayer");
+    return false;
+  }
+
+  cute_tiled_map_t *map = cute_tiled_load_map_from_file(map_path, NULL);
+  if (!map)
+  {
+    SDL_SetError("Failed to load map '%s': %s", map_path, cute_tiled_error_reason);
+    return false;
+  }
+  *out_count = read_collision_rects(map, out_rects);
+  if (out_size)
+  {
+    *out_size = (SDL_Point){map->width * map->tilewidth, map->height * map->tileheight};
+  }
+  cute_tiled_free_map(map);
+  return true;
+}
+
+bool Map_IsBlocked(MapState map_state, SDL_FPoint point)
+{
+  if (!map_state)
+  {
+    return false;
+  }
+  for (int i = 0; i < map_state->collision_count; i++)
+  {
+    if (SDL_PointInRectFloat(&point, &map_state->collision_rects[i]))
+    {
+      return true;
+    }
+  }
+  return false;
+}
@@ -1,4 +1,70 @@
 #include "../include/minion.h"
+#include "../include/world.h"
+
+SDL_COMPILE_TIME_ASSERT(minion_parts_fit_batch, (MINION_MAX_AMOUNT + MSG_MINION_BATCH_MAX - 1) / MSG_MINION_BATCH_MAX <= 255);
+
+/**
+ * @brief Grows one per-slot array and zeroes the new elements.
+ * @return The grown array, or NULL if out of memory (the old array is left as it was).
+ */
+static void *grow_slot_array(void *array, int old_capacity, int capacity, size_t size)
+{
+    Uint8 *grown = (Uint8 *)SDL_realloc(array, (size_t)capacity * size);
+    if (!grown)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    memset(&grown[(size_t)old_capacity * size], 0, (size_t)(capacity - old_capacity) * size);
+    return grown;
+}
+
+/**
+ * @brief Grows every per-slot array to at least the given number of slots.
+ * Call with the slot map's capacity after every allocation; the slot map may have grown to make room.
+ * @param mm The MinionManager instance.
+ * @param capacity Slots every array must hold.
+ * @return True on success, false if out of memory.
+ */
+static bool reserve_minion_storage(MinionManager mm, int capacity)
+{
+    if (capacity <= mm->capacity)
+        return true;
+
+#define GROW_SLOT_ARRAY(array)                                                          \
+    do                                                                                  \
+    {                                                                                   \
+        void *grown = grow_slot_array((array), mm->capacity, capacity, sizeof(*(array))); \
+        if (!grown)                                                                     \
+            return false;                                                               \
+        (array) = grown;                                                                \
+    } while (0)
+
+    GROW_SLOT_ARRAY(mm->minions);
+    GROW_SLOT_ARRAY(mm->pending_strikes);
+    GROW_SLOT_ARRAY(mm->targets);
+    GROW_SLOT_ARRAY(mm->ai_lod);
+    GROW_SLOT_ARRAY(mm->ai_due);
+    GROW_SLOT_ARRAY(mm->animate);
+    GROW_SLOT_ARRAY(mm->state_seen);
+    GROW_SLOT_ARRAY(mm->state_hashes);
+#undef GROW_SLOT_ARRAY
+
+    mm->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Frees the per-slot arrays, the slot map and the manager itself.
+ */
+static void free_minion_manager(MinionManager mm)
+{
+    void *arrays[] = {mm->minions, mm->pending_strikes, mm->targets, mm->ai_lod, mm->ai_due, mm->animate, mm->state_seen, mm->state_hashes};
+    for (size_t a = 0; a < SDL_arraysize(arrays); a++)
+        SDL_free(arrays[a]);
+    SlotMap_Destroy(mm->slots);
+    SDL_free(mm);
+}
 
 static void minion_manager_cleanup_callback(EntityManager manager, AppState *state)
 {
@@ -8,6 +74,8 @@ static void minion_manager_cleanup_callback(EntityManager manager, AppState *sta
         return;
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MinionManager entity cleanup callback triggered.");
+    for (int n = 0; n < SlotMap_GetCount(mm->slots); n++)
+        Ecs_DestroyEntity(mm->world, mm->minions[SlotMap_GetSlotAt(mm->slots, n)].entity);
     if (mm->red_texture || mm->blue_texture)
     {
         SDL_DestroyTexture(mm->blue_texture);
@@ -15,145 +83,473 @@ static void minion_manager_cleanup_callback(EntityManager manager, AppState *sta
         mm->red_texture = NULL;
         mm->blue_texture = NULL;
     }
-    SDL_free(mm);
+    free_minion_manager(mm);
+    state->minion_manager = NULL; // Indicate cleanup happened
+}
+
+/**
+ * @brief Returns one component of the entity in a pool slot.
+ * @return The component, or NULL if the slot is free or the entity lacks it.
+ */
+static void *minion_component(MinionManager mm, int i, EcsComponent component)
+{
+    return Ecs_Get(mm->world, mm->minions[i].entity, component);
+}
+
+/**
+ * @brief Work shared by the lane-AI jobs of one step.
+ */
+typedef struct MinionAIJob
+{
+    MinionManager mm;
+    AppState *state;
+} MinionAIJob;
+
+/**
+ * @brief Looks up the position of the unit a minion fights.
+ * @param mm The MinionManager instance.
+ * @param target The cached target.
+ * @param state Pointer to the main AppState.
+ * @param out_pos Receives the target's position.
+ * @return True if the target still lives (and, for minions, is still the same minion), false otherwise.
+ */
+static bool get_target_position(MinionManager mm, const MinionTarget *target, AppState *state, SDL_FPoint *out_pos)
+{
+    if (target->kind == SPATIAL_KIND_MINION)
+    {
+        const MinionData *enemy = &mm->minions[target->index];
+        const EcsHealth *health = minion_component(mm, target->index, ECS_HEALTH);
+        if (!enemy->active || enemy->handle != target->handle || !health || health->current <= 0)
+            return false;
+        *out_pos = *(const SDL_FPoint *)minion_component(mm, target->index, ECS_POSITION);
+        return true;
+    }
+    if (target->kind == SPATIAL_KIND_PLAYER && state->player_manager)
+    {
+        const PlayerInstance *player = &state->player_manager->players[target->index];
+        const SDL_FPoint *position = Ecs_Get(state->world, player->entity, ECS_POSITION);
+        if (!player->active || player->dead || !position)
+            return false;
+        *out_pos = *position;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Scans the aggro radius for the nearest living enemy unit and makes it the minion's target.
+ * Ties are broken by kind and then by index, like SpatialHash_FindNearest.
+ * @param mm The MinionManager instance.
+ * @param i The pool slot of the minion.
+ * @param state Pointer to the main AppState.
+ * @param position The minion's position.
+ * @param team The minion's team.
+ */
+static void acquire_target(MinionManager mm, int i, AppState *state, SDL_FPoint position, bool team)
+{
+    MinionTarget *target = &mm->targets[i];
+    SpatialEntry candidates[MINION_AGGRO_CANDIDATES];
+    int count = SpatialHash_QueryRadius(state->spatial_hash, position, MINION_AGGRO_RADIUS, SPATIAL_KIND_UNIT,
+                                        !team, candidates, MINION_AGGRO_CANDIDATES);
+    float best_sq = 0.0f;
+    target->kind = 0;
+    for (int c = 0; c < count; c++)
+    {
+        const SpatialEntry *e = &candidates[c];
+        MinionTarget candidate = {e->kind, e->index, 0, 0};
+        if (e->kind == SPATIAL_KIND_MINION)
+            candidate.handle = mm->minions[e->index].handle;
+        SDL_FPoint at;
+        if (!get_target_position(mm, &candidate, state, &at))
+            continue; // Dead players stay in the hash
+
+        float dx = at.x - position.x;
+        float dy = at.y - position.y;
+        float dist_sq = dx * dx + dy * dy;
+        bool closer = dist_sq < best_sq ||
+                      (dist_sq == best_sq && (e->kind < target->kind || (e->kind == target->kind && e->index < target->index)));
+        if (target->kind == 0 || closer)
+        {
+            candidate.recheck_ticks = target->recheck_ticks;
+            *target = candidate;
+            best_sq = dist_sq;
+        }
+    }
 }
 
-static void update_local_minion_movment(MinionData *m, AppState *state)
+/**
+ * @brief Checks whether a minion walks an empty stretch of lane.
+ * @param state Pointer to the main AppState.
+ * @param position The minion's position.
+ * @param team The minion's team.
+ * @return True if no player of either team and no enemy minion or building is within MINION_LOD_RADIUS.
+ */
+static bool minion_is_idle(AppState *state, SDL_FPoint position, bool team)
 {
-    if (!m || !m->active)
+    SpatialEntry near;
+    if (SpatialHash_QueryRadius(state->spatial_hash, position, MINION_LOD_RADIUS, SPATIAL_KIND_PLAYER,
+                                SPATIAL_HASH_ANY_TEAM, &near, 1) > 0)
+        return false;
+    return SpatialHash_QueryRadius(state->spatial_hash, position, MINION_LOD_RADIUS, SPATIAL_KIND_MINION | SPATIAL_KIND_BUILDING,
+                                   !team, &near, 1) == 0;
+}
+
+/**
+ * @brief Server-side minion AI: picks this step's velocity for one minion and records its strike.
+ * A minion fights the nearest enemy minion or player in its aggro radius; without one it follows
+ * the lane and attacks the enemy buildings it runs into. The position itself is advanced afterwards
+ * for all minions at once by SimKernel_IntegratePoints, and the strikes are pushed by push_minion_strikes.
+ * Idle minions (see MinionLod) skip the aggro scan and only check whether anything came close.
+ * Runs on the job workers, so it only writes to its own slot and its own entity's components.
+ * @param mm The MinionManager instance.
+ * @param i The pool slot of the minion.
+ * @param state Pointer to the main AppState.
+ */
+static void update_local_minion_movment(MinionManager mm, int i, AppState *state)
+{
+    MinionData *m = &mm->minions[i];
+    mm->pending_strikes[i].kind = 0;
+    SDL_FPoint *velocity = minion_component(mm, i, ECS_VELOCITY);
+    float *cooldown = minion_component(mm, i, ECS_COOLDOWN);
+    if (!m->active || !velocity || !cooldown)
         return;
+    *velocity = (SDL_FPoint){0.0f, 0.0f};
+    m->is_attacking = false;
 
-    float move_x = 0.0f;
-    float move_y = 0.0f;
-    if (m->team)
+    // --- Fight Nearby Units ---
+    // Whether the target lives is checked every step; the aggro scan and the leash only every
+    // MINION_TARGET_RECHECK_TICKS steps, or as soon as the target dies.
+    MinionTarget *target = &mm->targets[i];
+    SDL_FPoint position = *(const SDL_FPoint *)minion_component(mm, i, ECS_POSITION);
+    bool team = *(const bool *)minion_component(mm, i, ECS_TEAM);
+    SDL_FPoint target_pos = {0.0f, 0.0f};
+    bool has_target = get_target_position(mm, target, state, &target_pos);
+    bool target_lost = target->kind != 0 && !has_target;
+    bool recheck = --target->recheck_ticks <= 0 || target_lost;
+    if (mm->ai_lod[i] == MINION_LOD_IDLE)
     {
-        move_x += 1.0f;
-        move_y += 1.0f;
+        // Idle minions have no target, and nothing to find while nothing is near.
+        recheck = !minion_is_idle(state, position, team);
+        if (recheck)
+            mm->ai_lod[i] = MINION_LOD_FULL;
     }
-    else
+    if (recheck)
     {
-        move_x -= 1.0f;
-        move_y += 1.0f;
+        target->recheck_ticks = MINION_TARGET_RECHECK_TICKS;
+        float dx = target_pos.x - position.x;
+        float dy = target_pos.y - position.y;
+        if (!has_target || dx * dx + dy * dy > MINION_AGGRO_RADIUS * MINION_AGGRO_RADIUS)
+        {
+            acquire_target(mm, i, state, position, team);
+            has_target = get_target_position(mm, target, state, &target_pos);
+            if (!has_target && minion_is_idle(state, position, team))
+                mm->ai_lod[i] = MINION_LOD_IDLE;
+        }
     }
 
-    // --- Normalize and Apply Movement ---
-    float len_sq = move_x * move_x + move_y * move_y;
-    // Normalize the movement vector only if there is input, prevents division by zero
-    // and ensures consistent speed regardless of direction (diagonal vs cardinal).
-    if (len_sq > 0.001f)
+    if (has_target)
     {
-        float len = sqrtf(len_sq);
-        move_x = (move_x / len) * MINION_SPEED * state->delta_time;
-        move_y = (move_y / len) * MINION_SPEED * state->delta_time;
+        float dx = target_pos.x - position.x;
+        float dy = target_pos.y - position.y;
+        if (dx * dx + dy * dy > MINION_STRIKE_RANGE * MINION_STRIKE_RANGE)
+        {
+            SDL_FPoint direction = SimMath_Normalize(dx, dy, 0.0f);
+            *velocity = (SDL_FPoint){direction.x * MINION_SPEED, direction.y * MINION_SPEED};
+            return;
+        }
+        m->is_attacking = true;
+        if (*cooldown <= 0.0f)
+        {
+            mm->pending_strikes[i] = (MinionStrike){target->kind, target->index};
+            *cooldown = MINION_ATTACK_COOLDOWN;
+        }
+        return;
     }
-    // Create Rect of Minion
+
+    // --- Follow the Lane ---
+    // The flow field already walks around terrain and friendly towers, and points at the
+    // nearest enemy building still standing.
+    SDL_FPoint direction = FlowField_GetDirection(state->flow_field, team, position);
+    float vel_x = direction.x * MINION_SPEED;
+    float vel_y = direction.y * MINION_SPEED;
+
+    // Create Rect of Minion at the position it would reach this step
     SDL_FRect minionRect = {
-        m->position.x + move_x - MINION_WIDTH / 2.0f,
-        m->position.y + move_y - MINION_HEIGHT / 2.0f,
+        position.x + vel_x * state->delta_time - MINION_WIDTH / 2.0f,
+        position.y + vel_y * state->delta_time - MINION_HEIGHT / 2.0f,
         MINION_WIDTH,
         MINION_HEIGHT};
 
-    bool collision = false;
-    for (int i = 0; i < MAX_TOTAL_TOWERS; i++)
+    SpatialEntry hits[MAX_TOTAL_TOWERS + MAX_BASES];
+    int hit_count = SpatialHash_QueryRect(state->spatial_hash, &minionRect, SPATIAL_KIND_BUILDING, SPATIAL_HASH_ANY_TEAM, hits, MAX_TOTAL_TOWERS + MAX_BASES);
+    for (int h = 0; h < hit_count; h++)
     {
-        TowerInstance temp_tower = state->tower_manager->towers[i];
-        if (SDL_HasRectIntersectionFloat(&minionRect, &temp_tower.rect))
+        int target = hits[h].index;
+        const EcsHealth *health = Ecs_Get(state->world, hits[h].entity, ECS_HEALTH);
+        if (!health)
+            continue;
+        if (hits[h].kind == SPATIAL_KIND_TOWER)
         {
-            if (temp_tower.team != m->team)
+            if (hits[h].team != team && health->current > 0)
             {
-                if (temp_tower.current_health > 0)
-                {
-                    m->is_attacking = true;
-                    if ((state->sync_clock - m->attack_cooldown_timer) > MINION_ATTACK_COOLDOWN)
-                    {
-                        damageTower(*state, i, MINION_DAMAGE_VALUE, true, 0);
-                        m->attack_cooldown_timer = state->sync_clock;
-                    }
-                }
-                else
+                m->is_attacking = true;
+                if (*cooldown <= 0.0f)
                 {
-                    m->is_attacking = false;
+                    mm->pending_strikes[i] = (MinionStrike){SPATIAL_KIND_TOWER, target};
+                    *cooldown = MINION_ATTACK_COOLDOWN;
                 }
             }
-            collision = true;
         }
-    }
-
-    // Check for collision with the enemy's base
-    if (m->team)
-    {
-        BaseInstance tempBase = state->base_manager->bases[0];
-        if (SDL_HasRectIntersectionFloat(&minionRect, &tempBase.rect))
+        // Check for collision with the enemy's base
+        else if (hits[h].team != team)
         {
             m->is_attacking = true;
-            collision = true;
-            if (tempBase.current_health > 0)
+            if (health->current > 0)
             {
-                if (SDL_GetTicks() - m->attack_cooldown_timer > MINION_ATTACK_COOLDOWN)
+                if (*cooldown <= 0.0f)
                 {
-                    damageBase(state, 0, MINION_DAMAGE_VALUE, true);
-                    m->attack_cooldown_timer = SDL_GetTicks();
+                    mm->pending_strikes[i] = (MinionStrike){SPATIAL_KIND_BASE, target};
+                    *cooldown = MINION_ATTACK_COOLDOWN;
                 }
             }
         }
     }
-    if (!m->team)
+
+    if (!m->is_attacking)
+    {
+        *velocity = (SDL_FPoint){vel_x, vel_y};
+    }
+}
+
+/**
+ * @brief JobRangeFunc running the minion AI for a range of positions in the ai_due list.
+ */
+static void run_minion_ai_range(void *data, int begin, int end)
+{
+    const MinionAIJob *job = (const MinionAIJob *)data;
+    for (int n = begin; n < end; n++)
+        update_local_minion_movment(job->mm, job->mm->ai_due[n], job->state);
+}
+
+/**
+ * @brief Lists the minions whose AI runs this step: every minion at full rate, and each idle
+ * minion once every MINION_LOD_IDLE_INTERVAL steps, offset by its slot so the idle updates
+ * spread evenly over the steps. The others keep moving with their last velocity.
+ * @param mm The MinionManager instance.
+ */
+static void collect_due_minions(MinionManager mm)
+{
+    mm->ai_due_count = 0;
+    for (int n = 0; n < SlotMap_GetCount(mm->slots); n++)
+    {
+        int i = SlotMap_GetSlotAt(mm->slots, n);
+        if (mm->ai_lod[i] == MINION_LOD_FULL || (mm->ai_step + (Uint64)i) % MINION_LOD_IDLE_INTERVAL == 0)
+            mm->ai_due[mm->ai_due_count++] = i;
+    }
+    mm->ai_step++;
+}
+
+/**
+ * @brief Pushes the strikes recorded by the minion AI onto the damage bus, in dense-list order so
+ * the result does not depend on how the jobs were scheduled. Every strike of a step was decided
+ * on the health at the start of that step, so two minions can still kill each other.
+ * @param mm The MinionManager instance.
+ * @param state Pointer to the main AppState.
+ */
+static void push_minion_strikes(MinionManager mm, AppState *state)
+{
+    for (int n = 0; n < SlotMap_GetCount(mm->slots); n++)
+    {
+        MinionStrike *strike = &mm->pending_strikes[SlotMap_GetSlotAt(mm->slots, n)];
+        switch (strike->kind)
+        {
+        case SPATIAL_KIND_TOWER:
+            DamageBus_Push(state->damage_bus, DAMAGE_TARGET_TOWER, strike->target, state->tuning.minion_damage);
+            break;
+        case SPATIAL_KIND_BASE:
+            DamageBus_Push(state->damage_bus, DAMAGE_TARGET_BASE, strike->target, state->tuning.minion_damage);
+            break;
+        case SPATIAL_KIND_MINION:
+            DamageBus_Push(state->damage_bus, DAMAGE_TARGET_MINION, strike->target, state->tuning.minion_unit_damage);
+            break;
+        case SPATIAL_KIND_PLAYER:
+            DamageBus_Push(state->damage_bus, DAMAGE_TARGET_PLAYER, strike->target, state->tuning.minion_unit_damage);
+            break;
+        default:
+            break;
+        }
+        strike->kind = 0;
+    }
+}
+
+/**
+ * @brief Advances the animation of every minion near the camera by one step.
+ * Minions nobody can see keep their frame until they come into view again; without a
+ * camera (headless server) nothing is animated. Row changes (walking/attacking) restart
+ * the sequence; the frame timers then run as one kernel per archetype column when every
+ * minion is in view.
+ * @param mm The MinionManager instance.
+ * @param state Pointer to the main AppState.
+ */
+static void update_minion_animations(MinionManager mm, AppState *state)
+{
+    if (!state->camera_state)
+        return;
+
+    SDL_FRect view = {Camera_GetX(state->camera_state) - MINION_LOD_CAMERA_MARGIN,
+                      Camera_GetY(state->camera_state) - MINION_LOD_CAMERA_MARGIN,
+                      Camera_GetWidth(state->camera_state) + 2.0f * MINION_LOD_CAMERA_MARGIN,
+                      Camera_GetHeight(state->camera_state) + 2.0f * MINION_LOD_CAMERA_MARGIN};
+    int count = 0;
+    for (int n = 0; n < SlotMap_GetCount(mm->slots); n++)
     {
-        BaseInstance tempBase = state->base_manager->bases[1];
-        if (SDL_HasRectIntersectionFloat(&minionRect, &tempBase.rect))
+        int i = SlotMap_GetSlotAt(mm->slots, n);
+        MinionData *m = &mm->minions[i];
+        const SDL_FPoint *position = minion_component(mm, i, ECS_POSITION);
+        if (!position || !SDL_PointInRectFloat(position, &view))
+            continue;
+        mm->animate[count++] = i;
+
+        float target_row_y = m->is_attacking ? MINION_SPRITE_ATTACK : MINION_SPRITE_MOVE;
+
+        // Switch animation sequence row if movement state changed.
+        if (m->sprite_portion.y != target_row_y)
         {
-            m->is_attacking = true;
-            collision = true;
-            if (tempBase.current_health > 0)
-            {
-                if (SDL_GetTicks() - m->attack_cooldown_timer > MINION_ATTACK_COOLDOWN)
-                {
-                    damageBase(state, 1, MINION_DAMAGE_VALUE, true);
-                    m->attack_cooldown_timer = SDL_GetTicks();
-                }
-            }
+            *(Sint32 *)minion_component(mm, i, ECS_ANIM_FRAME) = 0;
+            *(float *)minion_component(mm, i, ECS_ANIM_TIMER) = 0.0f;
+            m->sprite_portion.y = target_row_y;
         }
     }
 
-    if (!collision && !m->is_attacking)
+    if (count == SlotMap_GetCount(mm->slots))
     {
-        m->position.x += move_x;
-        if (m->position.y > BUILDINGS_POS_Y)
-            m->position.y -= move_y;
+        EcsIter it = Ecs_Query(mm->world, MINION_COMPONENTS, 0);
+        while (EcsIter_Next(&it))
+            SimKernel_StepAnimation(EcsIter_Column(&it, ECS_ANIM_TIMER), EcsIter_Column(&it, ECS_ANIM_FRAME), it.count,
+                                    state->delta_time, MINION_SPRITE_TIME_PER_FRAME, MINION_SPRITE_NUM_FRAMES);
+        return;
     }
-    else if (collision && !m->is_attacking)
+    for (int n = 0; n < count; n++)
     {
-        m->position.y += move_y;
+        int i = mm->animate[n];
+        SimKernel_StepAnimation(minion_component(mm, i, ECS_ANIM_TIMER), minion_component(mm, i, ECS_ANIM_FRAME), 1,
+                                state->delta_time, MINION_SPRITE_TIME_PER_FRAME, MINION_SPRITE_NUM_FRAMES);
     }
 }
 
-static void update_local_minion_animation(MinionData *m, float delta_time)
+/**
+ * @brief Moves the collision bounds of every minion to its position, one archetype column at a time.
+ * @param mm The MinionManager instance.
+ */
+static void update_minion_bounds(MinionManager mm)
 {
-    if (!m || !m->active)
-        return;
+    EcsIter it = Ecs_Query(mm->world, MINION_COMPONENTS, 0);
+    while (EcsIter_Next(&it))
+    {
+        const SDL_FPoint *position = EcsIter_Column(&it, ECS_POSITION);
+        SDL_FRect *bounds = EcsIter_Column(&it, ECS_BOUNDS);
+        for (int row = 0; row < it.count; row++)
+        {
+            bounds[row].x = position[row].x - MINION_WIDTH / 2.0f;
+            bounds[row].y = position[row].y - MINION_HEIGHT / 2.0f;
+        }
+    }
+}
+
+static uint16_t quantize_minion_coord(float value)
+{
+    float q = value * MSG_MINION_POS_SCALE + 0.5f;
+    return (uint16_t)CLAMP(q, 0.0f, 65535.0f);
+}
+
+static float dequantize_minion_coord(uint16_t value)
+{
+    return (float)value / MSG_MINION_POS_SCALE;
+}
+
+static uint8_t pack_minion_flags(MinionManager mm, int i)
+{
+    uint8_t flags = 0;
+    if (*(const bool *)minion_component(mm, i, ECS_TEAM))
+        flags |= MSG_MINION_FLAG_TEAM;
+    if (mm->minions[i].is_attacking)
+        flags |= MSG_MINION_FLAG_ATTACKING;
+    return flags;
+}
+
+/**
+ * @brief Hashes the replicated state of one slot again and swaps it into the pool's fold.
+ * Call on the main thread after anything the hash covers changed: handle, replicated health,
+ * team, is_attacking or replicated position. A free slot hashes as 0, which takes it out.
+ * @param mm The MinionManager instance.
+ * @param i The pool slot of the minion.
+ */
+static void refresh_minion_hash(MinionManager mm, int i)
+{
+    Uint64 hash = 0;
+    const MinionData *m = &mm->minions[i];
+    if (m->active)
+    {
+        // The same fields and quantization as Msg_MinionStateBatch.
+        uint16_t x, y;
+        MinionManager_GetReplicatedPosition(mm, i, !(mm->components & ECS_MASK(ECS_NET_TO)), &x, &y);
+        hash = World_HashBegin(WORLD_HASH_MINIONS, i);
+        hash = World_HashStep(hash, m->handle);
+        hash = World_HashStep(hash, MinionManager_GetReplicatedHealth(mm, i));
+        hash = World_HashStep(hash, ((Uint64)*(const bool *)minion_component(mm, i, ECS_TEAM) << 1) | m->is_attacking);
+        hash = World_HashStep(hash, ((Uint64)x << 16) | y);
+    }
+    mm->state_hash ^= mm->state_hashes[i] ^ hash;
+    mm->state_hashes[i] = hash;
+}
 
-    float target_row_y = m->is_attacking ? MINION_SPRITE_ATTACK : MINION_SPRITE_MOVE;
+/**
+ * @brief Server only: refreshes the hashes of the minions this step changed, after they moved.
+ * Only minions whose AI ran can change is_attacking, and only moving minions change position.
+ * @param mm The MinionManager instance.
+ */
+static void refresh_changed_minion_hashes(MinionManager mm)
+{
+    for (int n = 0; n < mm->ai_due_count; n++)
+        refresh_minion_hash(mm, mm->ai_due[n]);
 
-    // Switch animation sequence row if movement state changed.
-    if (m->sprite_portion.y != target_row_y)
+    EcsIter it = Ecs_Query(mm->world, MINION_COMPONENTS, 0);
+    while (EcsIter_Next(&it))
     {
-        m->current_frame = 0;
-        m->anim_timer = 0;
-        m->sprite_portion.y = target_row_y;
+        const SDL_FPoint *velocity = EcsIter_Column(&it, ECS_VELOCITY);
+        const EcsCollider *collider = EcsIter_Column(&it, ECS_COLLIDER);
+        for (int row = 0; row < it.count; row++)
+        {
+            if (velocity[row].x != 0.0f || velocity[row].y != 0.0f)
+                refresh_minion_hash(mm, collider[row].index);
+        }
     }
-    m->anim_timer += delta_time;
-    if (m->anim_timer >= MINION_SPRITE_TIME_PER_FRAME)
+}
+
+/**
+ * @brief Puts a minion at a position without interpolating there: the previous position, the
+ * bounds and (for replicas) both interpolation ends all move with it.
+ * @param mm The MinionManager instance.
+ * @param i The pool slot of the minion.
+ * @param position The new world position.
+ */
+static void place_minion(MinionManager mm, int i, SDL_FPoint position)
+{
+    *(SDL_FPoint *)minion_component(mm, i, ECS_POSITION) = position;
+    *(SDL_FPoint *)minion_component(mm, i, ECS_PREV_POSITION) = position;
+    *(SDL_FRect *)minion_component(mm, i, ECS_BOUNDS) = (SDL_FRect){position.x - MINION_WIDTH / 2.0f, position.y - MINION_HEIGHT / 2.0f,
+                                                                    MINION_WIDTH, MINION_HEIGHT};
+    SDL_FPoint *net_from = minion_component(mm, i, ECS_NET_FROM);
+    if (net_from)
     {
-        m->anim_timer -= MINION_SPRITE_TIME_PER_FRAME; // Subtract, don't reset, to handle frame skips.
-        m->current_frame = (m->current_frame + 1) % MINION_SPRITE_NUM_FRAMES;
+        *net_from = position;
+        *(SDL_FPoint *)minion_component(mm, i, ECS_NET_TO) = position;
+        *(float *)minion_component(mm, i, ECS_NET_PROGRESS) = 1.0f;
     }
-    // Update the source rectangle for rendering based on the current frame.
-    m->sprite_portion.x = (float)m->current_frame * MINION_SPRITE_FRAME_WIDTH;
-    m->sprite_portion.w = MINION_SPRITE_FRAME_WIDTH;
-    m->sprite_portion.h = MINION_SPRITE_FRAME_HEIGHT;
+    refresh_minion_hash(mm, i);
 }
 
-static bool Minion_Init(MinionManager mm, uint8_t minionIndex, bool team)
+static bool Minion_Init(MinionManager mm, int minionIndex, bool team)
 {
     if (!mm)
     {
@@ -161,37 +557,168 @@ static bool Minion_Init(MinionManager mm, uint8_t minionIndex, bool team)
         return false;
     }
     MinionData *currentMinion = &mm->minions[minionIndex];
-    currentMinion->texture = mm->blue_texture;
-    currentMinion->position = (SDL_FPoint){BASE_BLUE_POS_X - 350, BUILDINGS_POS_Y};
+    SDL_FPoint position = {BASE_BLUE_POS_X - 350, BUILDINGS_POS_Y};
     currentMinion->flip_mode = SDL_FLIP_HORIZONTAL;
 
     if (team)
     {
-        currentMinion->texture = mm->red_texture;
-        currentMinion->position = (SDL_FPoint){BASE_RED_POS_X + 350, BUILDINGS_POS_Y};
+        position = (SDL_FPoint){BASE_RED_POS_X + 350, BUILDINGS_POS_Y};
         currentMinion->flip_mode = SDL_FLIP_NONE;
     }
-    if (!currentMinion->texture)
+
+    // New components start zeroed (no velocity, cooldown or animation progress).
+    currentMinion->entity = Ecs_CreateEntity(mm->world, mm->components);
+    if (currentMinion->entity == ECS_ENTITY_NONE)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Minion_Init] Failed load texture : %s", SDL_GetError());
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Minion_Init] Failed to create entity: %s", SDL_GetError());
         return false;
     }
-    SDL_SetTextureScaleMode(currentMinion->texture, SDL_SCALEMODE_NEAREST);
+    *(bool *)minion_component(mm, minionIndex, ECS_TEAM) = team;
+    *(EcsHealth *)minion_component(mm, minionIndex, ECS_HEALTH) = (EcsHealth){MINION_HEALTH_MAX, MINION_HEALTH_MAX, false};
+    *(EcsCollider *)minion_component(mm, minionIndex, ECS_COLLIDER) = (EcsCollider){SPATIAL_KIND_MINION, minionIndex};
+    place_minion(mm, minionIndex, position);
+
     currentMinion->sprite_portion = (SDL_FRect){0, MINION_SPRITE_MOVE, MINION_SPRITE_FRAME_WIDTH, MINION_SPRITE_FRAME_HEIGHT};
-    currentMinion->current_health = MINION_HEALTH_MAX;
-    currentMinion->anim_timer = 0;
-    currentMinion->current_frame = 0;
     currentMinion->is_attacking = false;
     currentMinion->active = true;
-    currentMinion->team = team;
-
-    SDL_Log("[Minion_Init] Initialized minion %d\n", mm->activeMinionAmount);
+    // Stagger the aggro scans so a wave does not scan on the same step.
+    mm->targets[minionIndex] = (MinionTarget){0, 0, 0, minionIndex % MINION_TARGET_RECHECK_TICKS + 1};
+    mm->ai_lod[minionIndex] = MINION_LOD_FULL;
+    refresh_minion_hash(mm, minionIndex);
 
     mm->activeMinionAmount++;
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Minion_Init] Initialized minion %d (active: %d)", minionIndex, mm->activeMinionAmount);
 
     return true;
 }
 
+/**
+ * @brief Removes a minion from the pool.
+ * @param mm The MinionManager instance.
+ * @param minionIndex The pool slot of the minion.
+ */
+static void Minion_Deactivate(MinionManager mm, int minionIndex)
+{
+    MinionData *m = &mm->minions[minionIndex];
+    if (!m->active)
+        return;
+    m->active = false;
+    m->is_attacking = false;
+    refresh_minion_hash(mm, minionIndex);
+    Ecs_DestroyEntity(mm->world, m->entity);
+    m->entity = ECS_ENTITY_NONE;
+    SlotMap_Free(mm->slots, m->handle);
+    mm->activeMinionAmount--;
+}
+
+/**
+ * @brief Spawns a minion on the server and announces it to all clients.
+ * @param state Pointer to the main AppState.
+ * @param team The team of the new minion.
+ */
+static void server_spawn_minion(AppState *state, bool team)
+{
+    MinionManager mm = state->minion_manager;
+    SlotHandle handle = SlotMap_Alloc(mm->slots);
+    if (handle == SLOT_HANDLE_INVALID || !reserve_minion_storage(mm, SlotMap_GetCapacity(mm->slots)))
+    {
+        // Only reached at MINION_MAX_AMOUNT live minions or when memory runs out.
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server] Cannot spawn minion (%d active): %s", mm->activeMinionAmount, SDL_GetError());
+        if (handle != SLOT_HANDLE_INVALID)
+            SlotMap_Free(mm->slots, handle);
+        return;
+    }
+
+    int slot = SlotMap_Resolve(mm->slots, handle);
+    MinionData *m = &mm->minions[slot];
+    m->handle = (uint16_t)handle;
+    if (!Minion_Init(mm, slot, team))
+    {
+        SlotMap_Free(mm->slots, handle);
+        return;
+    }
+
+    if (state->net_server_state)
+    {
+        Msg_MinionSpawn msg;
+        msg.message_type = MSG_TYPE_S_MINION_SPAWN;
+        msg.minionHandle = m->handle;
+        const SDL_FPoint *position = minion_component(mm, slot, ECS_POSITION);
+        msg.flags = pack_minion_flags(mm, slot);
+        msg.pos_x = quantize_minion_coord(position->x);
+        msg.pos_y = quantize_minion_coord(position->y);
+        NetServer_BroadcastMessage(state->net_server_state, &msg, sizeof(Msg_MinionSpawn), -1);
+    }
+}
+
+/**
+ * @brief Packs every active minion into state batches of up to MSG_MINION_BATCH_MAX entries and
+ * broadcasts them. An empty pool still sends one (empty) part, so clients remove their last minions.
+ * @param mm The MinionManager instance.
+ * @param state Pointer to the main AppState.
+ */
+static void server_broadcast_minion_state(MinionManager mm, AppState *state)
+{
+    if (!state->net_server_state)
+        return;
+
+    int total = SlotMap_GetCount(mm->slots);
+    int part_count = total > 0 ? (total + MSG_MINION_BATCH_MAX - 1) / MSG_MINION_BATCH_MAX : 1;
+    for (int part = 0; part < part_count; part++)
+    {
+        Msg_MinionStateBatch batch;
+        memset(&batch, 0, sizeof(batch));
+        batch.message_type = MSG_TYPE_S_MINION_STATE;
+        batch.part = (uint8_t)part;
+        batch.part_count = (uint8_t)part_count;
+        batch.server_time = (uint32_t)state->sync_clock;
+
+        int first = part * MSG_MINION_BATCH_MAX;
+        for (int n = first; n < total && n < first + MSG_MINION_BATCH_MAX; n++)
+        {
+            int i = SlotMap_GetSlotAt(mm->slots, n);
+            const SDL_FPoint *position = minion_component(mm, i, ECS_POSITION);
+            int e = batch.count++;
+            batch.handle[e] = mm->minions[i].handle;
+            batch.pos_x[e] = quantize_minion_coord(position->x);
+            batch.pos_y[e] = quantize_minion_coord(position->y);
+            batch.health[e] = MinionManager_GetReplicatedHealth(mm, i);
+            batch.flags[e] = pack_minion_flags(mm, i);
+        }
+
+        NetServer_BroadcastMessage(state->net_server_state, &batch, sizeof(Msg_MinionStateBatch), -1);
+    }
+}
+
+/**
+ * @brief Client-side: (re)creates a minion announced by the server in the given slot.
+ * @param mm The MinionManager instance.
+ * @param minionHandle The handle assigned by the server.
+ * @param flags MSG_MINION_FLAG_* bits.
+ * @param position The initial world position.
+ */
+static void client_activate_minion(MinionManager mm, uint16_t minionHandle, uint8_t flags, SDL_FPoint position)
+{
+    int slot = MINION_HANDLE_SLOT(minionHandle);
+    if (slot < mm->capacity)
+        Minion_Deactivate(mm, slot); // Slot may still hold an older minion the server already replaced
+    if (!SlotMap_AllocAt(mm->slots, minionHandle))
+        return;
+    if (!reserve_minion_storage(mm, SlotMap_GetCapacity(mm->slots)))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Client] Cannot replicate minion 0x%04x: %s", (unsigned int)minionHandle, SDL_GetError());
+        SlotMap_Free(mm->slots, minionHandle);
+        return;
+    }
+    mm->minions[slot].handle = minionHandle;
+    if (!Minion_Init(mm, slot, (flags & MSG_MINION_FLAG_TEAM) != 0))
+    {
+        SlotMap_Free(mm->slots, minionHandle);
+        return;
+    }
+    place_minion(mm, slot, position);
+}
+
 static void minion_manager_update_callback(EntityManager manager, AppState *state)
 {
     (void)manager;
@@ -199,16 +726,36 @@ static void minion_manager_update_callback(EntityManager manager, AppState *stat
     if (!mm || !state)
         return;
 
-    if ((state->sync_clock - mm->minionWaveTimer) > 10000 && mm->activeMinionAmount < MINION_MAX_AMOUNT - 1)
+    EcsIter it = Ecs_Query(mm->world, MINION_COMPONENTS, 0);
+    while (EcsIter_Next(&it))
+        SDL_memcpy(EcsIter_Column(&it, ECS_PREV_POSITION), EcsIter_Column(&it, ECS_POSITION), (size_t)it.count * sizeof(SDL_FPoint));
+
+    // Clients only interpolate between server snapshots (over one state interval) and animate locally.
+    if (!state->is_server)
     {
-        if ((state->sync_clock - mm->recentMinionTimer) > 500)
+        it = Ecs_Query(mm->world, MINION_REPLICA_COMPONENTS, 0);
+        while (EcsIter_Next(&it))
+            SimKernel_InterpolatePoints(EcsIter_Column(&it, ECS_POSITION), EcsIter_Column(&it, ECS_NET_FROM), EcsIter_Column(&it, ECS_NET_TO),
+                                        EcsIter_Column(&it, ECS_NET_PROGRESS), it.count, state->delta_time * (1000.0f / MINION_STATE_INTERVAL_MS));
+        update_minion_bounds(mm);
+        update_minion_animations(mm, state);
+        return;
+    }
+
+    // --- Server: wave spawning and AI ---
+    if ((state->sync_clock - mm->minionWaveTimer) > MINION_WAVE_INTERVAL)
+    {
+        if ((state->sync_clock - mm->recentMinionTimer) > MINION_SPAWN_INTERVAL)
         {
-            Minion_Init(mm, mm->activeMinionAmount, BLUE_TEAM);
-            Minion_Init(mm, mm->activeMinionAmount, RED_TEAM);
+            Command spawn = {.type = COMMAND_SPAWN_MINION};
+            spawn.team = BLUE_TEAM;
+            CommandBuffer_Record(state->command_buffer, &spawn);
+            spawn.team = RED_TEAM;
+            CommandBuffer_Record(state->command_buffer, &spawn);
             mm->recentMinionTimer = state->sync_clock;
             mm->currentMinionWaveAmount++;
 
-            if (mm->currentMinionWaveAmount == 6)
+            if (mm->currentMinionWaveAmount == MINION_WAVE_AMOUNT)
             {
                 mm->currentMinionWaveAmount = 0;
                 mm->minionWaveTimer = state->sync_clock;
@@ -216,29 +763,65 @@ static void minion_manager_update_callback(EntityManager manager, AppState *stat
         }
     }
 
-    for (int i = 0; i < MINION_MAX_AMOUNT; i++)
+    // Decide the velocities of the minions due this step first (in parallel), then queue the
+    // strikes, then move and cool down the whole pool at once and animate what the camera sees.
+    it = Ecs_Query(mm->world, MINION_COMPONENTS, 0);
+    while (EcsIter_Next(&it))
+        SimKernel_Countdown(EcsIter_Column(&it, ECS_COOLDOWN), it.count, state->delta_time);
+    collect_due_minions(mm);
+    MinionAIJob ai_job = {mm, state};
+    JobSystem_ParallelFor(state->jobs, mm->ai_due_count, MINION_AI_CHUNK, run_minion_ai_range, &ai_job);
+    push_minion_strikes(mm, state);
+    it = Ecs_Query(mm->world, MINION_COMPONENTS, 0);
+    while (EcsIter_Next(&it))
+        SimKernel_IntegratePoints(EcsIter_Column(&it, ECS_POSITION), EcsIter_Column(&it, ECS_VELOCITY), it.count, state->delta_time);
+    update_minion_bounds(mm);
+    refresh_changed_minion_hashes(mm);
+    update_minion_animations(mm, state);
+}
+
+/**
+ * @brief Server only: broadcasts the minion snapshot once the state interval has passed.
+ * Runs in the network-out phase so the snapshot reflects this frame's finished simulation.
+ */
+static void minion_replication_update_callback(EntityManager manager, AppState *state)
+{
+    (void)manager;
+    MinionManager mm = state ? state->minion_manager : NULL;
+    if (!mm || !state->is_server)
+        return;
+
+    if (state->sync_clock - mm->lastStateBroadcast >= MINION_STATE_INTERVAL_MS)
     {
-        if (mm->minions[i].active)
-        {
-            update_local_minion_movment(&mm->minions[i], state);
-            update_local_minion_animation(&mm->minions[i], state->delta_time);
-        }
+        server_broadcast_minion_state(mm, state);
+        mm->lastStateBroadcast = state->sync_clock;
     }
 }
 
-static void render_single_minion(MinionData *m, AppState *state)
+static void render_single_minion(MinionManager mm, int i, AppState *state)
 {
+    const MinionData *m = &mm->minions[i];
+    const SDL_FPoint *prev = minion_component(mm, i, ECS_PREV_POSITION);
+    const SDL_FPoint *pos = minion_component(mm, i, ECS_POSITION);
+    const Sint32 *frame = minion_component(mm, i, ECS_ANIM_FRAME);
+    const bool *team = minion_component(mm, i, ECS_TEAM);
+    if (!prev || !pos || !frame || !team)
+        return;
     CameraState camera = state->camera_state;
     float cam_x = Camera_GetX(camera);
     float cam_y = Camera_GetY(camera);
-    // Calculate screen coordinates relative to the camera's view.
-    float screen_x = m->position.x - cam_x - MINION_WIDTH / 2.0f;
-    float screen_y = m->position.y - cam_y - MINION_HEIGHT / 2.0f;
+    // Blend the last two simulation steps, then convert to the camera's view.
+    float world_x = prev->x + (pos->x - prev->x) * state->render_alpha;
+    float world_y = prev->y + (pos->y - prev->y) * state->render_alpha;
+    float screen_x = world_x - cam_x - MINION_WIDTH / 2.0f;
+    float screen_y = world_y - cam_y - MINION_HEIGHT / 2.0f;
 
     SDL_FRect dst_rect = {screen_x, screen_y, MINION_WIDTH, MINION_HEIGHT};
+    SDL_FRect src_rect = {(float)*frame * MINION_SPRITE_FRAME_WIDTH, m->sprite_portion.y,
+                          MINION_SPRITE_FRAME_WIDTH, MINION_SPRITE_FRAME_HEIGHT};
     SDL_RenderTextureRotated(state->renderer,
-                             m->texture,
-                             &m->sprite_portion, // Source rect from atlas
+                             *team ? mm->red_texture : mm->blue_texture,
+                             &src_rect,          // Source rect from atlas
                              &dst_rect,          // Destination rect on screen
                              0.0,                // No rotation needed for player sprite
                              NULL,               // Render around center
@@ -253,44 +836,151 @@ static void minion_manager_render_callback(EntityManager manager, AppState *stat
         return;
 
     // Render all minions currently marked as active.
-    for (int i = 0; i < MINION_MAX_AMOUNT; i++)
+    for (int n = 0; n < SlotMap_GetCount(mm->slots); n++)
     {
-        if (mm->minions[i].active)
-        {
-            render_single_minion(&mm->minions[i], state);
-        }
+        render_single_minion(mm, SlotMap_GetSlotAt(mm->slots, n), state);
     }
 }
 
-void damageMinion(AppState state, int minionIndex, float damageValue, bool sendToServer, float sentCurrentHealth)
+EcsEntity MinionManager_GetEntity(MinionManager mm, int minionIndex)
+{
+    if (!mm || minionIndex < 0 || minionIndex >= mm->capacity || !mm->minions[minionIndex].active)
+        return ECS_ENTITY_NONE;
+    return mm->minions[minionIndex].entity;
+}
+
+void MinionManager_HandleHit(AppState *state, int minionIndex, bool killed)
+{
+    MinionManager mm = state ? state->minion_manager : NULL;
+    if (!mm || minionIndex < 0 || minionIndex >= mm->capacity || !mm->minions[minionIndex].active)
+        return;
+    refresh_minion_hash(mm, minionIndex);
+    if (!killed || !state->is_server)
+        return;
+
+    // The health system reports the kill once; the despawn runs at the next sync point.
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Server] Minion %d destroyed", minionIndex);
+    Command despawn = {.type = COMMAND_DESPAWN_MINION};
+    despawn.id = mm->minions[minionIndex].handle;
+    CommandBuffer_Record(state->command_buffer, &despawn);
+}
+
+uint16_t MinionManager_GetHandle(MinionManager mm, int minionIndex)
+{
+    if (!mm || minionIndex < 0 || minionIndex >= mm->capacity || !mm->minions[minionIndex].active)
+        return (uint16_t)SLOT_HANDLE_INVALID;
+    return mm->minions[minionIndex].handle;
+}
+
+void MinionManager_ApplySpawn(AppState *state, bool team)
+{
+    if (!state || !state->minion_manager || !state->is_server)
+        return;
+    server_spawn_minion(state, team);
+}
+
+void MinionManager_ApplyDespawn(AppState *state, uint16_t minionHandle)
+{
+    MinionManager mm = state ? state->minion_manager : NULL;
+    if (!mm)
+        return;
+
+    int slot = SlotMap_Resolve(mm->slots, minionHandle);
+    if (slot >= 0)
+        Minion_Deactivate(mm, slot);
+}
+
+void MinionManager_HandleServerSpawn(AppState *state, const Msg_MinionSpawn *data)
+{
+    // The server already created the minion in its own simulation.
+    if (!state || !state->minion_manager || !data || state->is_server)
+        return;
+
+    Command command = {.type = COMMAND_REPLICATE_MINION};
+    command.minion = *data;
+    CommandBuffer_Record(state->command_buffer, &command);
+}
+
+void MinionManager_ApplyReplicatedSpawn(AppState *state, const Msg_MinionSpawn *data)
+{
+    MinionManager mm = state ? state->minion_manager : NULL;
+    if (!mm || !data || state->is_server)
+        return;
+
+    SDL_FPoint position = {dequantize_minion_coord(data->pos_x), dequantize_minion_coord(data->pos_y)};
+    client_activate_minion(mm, data->minionHandle, data->flags, position);
+}
+
+void MinionManager_HandleStateBatch(AppState *state, const Msg_MinionStateBatch *data)
 {
-    MinionData *m = &state.minion_manager->minions[minionIndex];
+    if (!state || !state->minion_manager || !data || state->is_server)
+        return;
 
-    if (!sendToServer)
+    Command command = {.type = COMMAND_APPLY_MINION_STATE};
+    command.minion_state = *data;
+    CommandBuffer_Record(state->command_buffer, &command);
+}
+
+void MinionManager_ApplyStateBatch(AppState *state, const Msg_MinionStateBatch *data)
+{
+    MinionManager mm = state ? state->minion_manager : NULL;
+    if (!mm || !data || state->is_server)
+        return;
+
+    // Parts of one snapshot arrive in order; a part of a newer snapshot starts counting again.
+    if (data->server_time != mm->state_time || data->part == 0)
     {
-        m->current_health = sentCurrentHealth;
+        mm->state_time = data->server_time;
+        mm->state_parts = 0;
     }
+    mm->state_parts++;
 
-    if (m->current_health > 0 && sendToServer)
+    int count = data->count < MSG_MINION_BATCH_MAX ? data->count : MSG_MINION_BATCH_MAX;
+    for (int n = 0; n < count; n++)
     {
-        m->current_health -= damageValue;
-        sentCurrentHealth = m->current_health;
-        NetClient_SendDamageMinionRequest(state.net_client_state, minionIndex, sentCurrentHealth);
+        int slot = MINION_HANDLE_SLOT(data->handle[n]);
+        SDL_FPoint position = {dequantize_minion_coord(data->pos_x[n]), dequantize_minion_coord(data->pos_y[n])};
+
+        // Unknown minion or a slot reused by the server (e.g. the spawn message was missed)
+        if (SlotMap_Resolve(mm->slots, data->handle[n]) != slot)
+        {
+            client_activate_minion(mm, data->handle[n], data->flags[n], position);
+            if (SlotMap_Resolve(mm->slots, data->handle[n]) != slot)
+                continue;
+        }
+        else
+        {
+            *(SDL_FPoint *)minion_component(mm, slot, ECS_NET_FROM) = *(const SDL_FPoint *)minion_component(mm, slot, ECS_POSITION);
+            *(SDL_FPoint *)minion_component(mm, slot, ECS_NET_TO) = position;
+            *(float *)minion_component(mm, slot, ECS_NET_PROGRESS) = 0.0f;
+        }
+
+        MinionData *m = &mm->minions[slot];
+        ((EcsHealth *)minion_component(mm, slot, ECS_HEALTH))->current = (float)data->health[n];
+        m->is_attacking = (data->flags[n] & MSG_MINION_FLAG_ATTACKING) != 0;
+        mm->state_seen[slot] = data->server_time;
+        refresh_minion_hash(mm, slot);
     }
 
-    if (m->current_health <= 0)
+    // Anything no part of the snapshot reported has died. Only decided once every part arrived;
+    // walk backwards: removal moves the last live slot forward.
+    if (mm->state_parts < data->part_count)
+        return;
+    for (int n = SlotMap_GetCount(mm->slots) - 1; n >= 0; n--)
     {
-        if (!sendToServer)
-            SDL_Log("[client] destryed minion\n");
-        m->active = false;
+        int i = SlotMap_GetSlotAt(mm->slots, n);
+        if (mm->state_seen[i] != data->server_time)
+        {
+            Minion_Deactivate(mm, i);
+        }
     }
 }
 
 MinionManager MinionManager_Init(AppState *state)
 {
-    if (!state || !state->renderer || !state->entity_manager)
+    if (!state || !state->entity_manager || !state->world)
     {
-        SDL_SetError("Invalid AppState or missing renderer/entity_manager for MinionManager_Init");
+        SDL_SetError("Invalid AppState or missing entity_manager/world for MinionManager_Init");
         return NULL;
     }
     MinionManager mm = (MinionManager)SDL_calloc(1, sizeof(struct MinionManager_s));
@@ -301,29 +991,50 @@ MinionManager MinionManager_Init(AppState *state)
         return NULL;
     }
 
+    mm->world = state->world;
+    mm->components = state->is_server ? MINION_COMPONENTS : MINION_REPLICA_COMPONENTS;
     mm->minionWaveTimer = 0;
     mm->recentMinionTimer = 0;
+    mm->lastStateBroadcast = 0;
     mm->activeMinionAmount = 0;
     mm->currentMinionWaveAmount = 0;
     mm->spawnNextMinion = false;
 
-    mm->blue_texture = IMG_LoadTexture(state->renderer, BLUE_MINION_PATH);
-    mm->red_texture = IMG_LoadTexture(state->renderer, RED_MINION_PATH);
-
-    if (!mm->blue_texture || !mm->red_texture)
+    // A headless state has no renderer to load them with, and never draws.
+    if (state->renderer)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[MinionManager Init] Failed load texture : %s", SDL_GetError());
-        SDL_free(mm);
-        return NULL;
+        mm->blue_texture = IMG_LoadTexture(state->renderer, BLUE_MINION_PATH);
+        mm->red_texture = IMG_LoadTexture(state->renderer, RED_MINION_PATH);
+
+        if (!mm->blue_texture || !mm->red_texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[MinionManager Init] Failed load texture : %s", SDL_GetError());
+            SDL_DestroyTexture(mm->red_texture);
+            SDL_DestroyTexture(mm->blue_texture);
+            SDL_free(mm);
+            return NULL;
+        }
+        SDL_SetTextureScaleMode(mm->blue_texture, SDL_SCALEMODE_NEAREST);
+        SDL_SetTextureScaleMode(mm->red_texture, SDL_SCALEMODE_NEAREST);
     }
 
-    for (int i = 0; i < MINION_MAX_AMOUNT; i++)
+    // The per-slot arrays grow with the slot map; handles must fit 16 bits on the wire.
+    mm->slots = SlotMap_Create(MINION_INITIAL_CAPACITY, MINION_MAX_AMOUNT, MINION_HANDLE_INDEX_BITS, MINION_HANDLE_GENERATION_BITS);
+    if (!mm->slots || !reserve_minion_storage(mm, SlotMap_GetCapacity(mm->slots)))
     {
-        mm->minions[i].active = false;
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[MinionManager Init] Failed to create minion pool: %s", SDL_GetError());
+        SDL_DestroyTexture(mm->red_texture);
+        SDL_DestroyTexture(mm->blue_texture);
+        free_minion_manager(mm);
+        return NULL;
     }
 
     EntityFunctions minion_funcs = {
         .name = "minion_manager",
+        .update_phase = ENTITY_PHASE_SIMULATE,
+        .render_phase = ENTITY_PHASE_RENDER,
+        .reads = ENTITY_RES_SPATIAL_HASH | ENTITY_RES_CAMERA | ENTITY_RES_WORLD,
+        .writes = ENTITY_RES_MINIONS | ENTITY_RES_DAMAGE | ENTITY_RES_NETWORK | ENTITY_RES_RENDERER,
         .update = minion_manager_update_callback,
         .render = minion_manager_render_callback,
         .cleanup = minion_manager_cleanup_callback,
@@ -335,7 +1046,23 @@ MinionManager MinionManager_Init(AppState *state)
         if (mm->red_texture || mm->red_texture)
             SDL_DestroyTexture(mm->red_texture);
         SDL_DestroyTexture(mm->blue_texture);
-        SDL_free(mm);
+        free_minion_manager(mm);
+        return NULL;
+    }
+
+    EntityFunctions replication_funcs = {
+        .name = "minion_replication",
+        .update_phase = ENTITY_PHASE_NETWORK_OUT,
+        .reads = ENTITY_RES_MINIONS,
+        .writes = ENTITY_RES_NETWORK,
+        .update = minion_replication_update_callback};
+
+    if (!EntityManager_Add(state->entity_manager, &replication_funcs))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[MinionManager Init] Failed to add replication entity to manager: %s", SDL_GetError());
+        SDL_DestroyTexture(mm->red_texture);
+        SDL_DestroyTexture(mm->blue_texture);
+        free_minion_manager(mm);
         return NULL;
     }
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MinionManager initialized and entity registered.");
@@ -348,19 +1075,178 @@ void MinionManager_Destroy(MinionManager mm)
     {
         mm->blue_texture = NULL;
         mm->red_texture = NULL;
-        SDL_free(mm);
+        free_minion_manager(mm);
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MinonManager state container destroyed.");
     }
 }
 
 bool MinionManager_GetMinionPosition(MinionManager mm, int minionIndex, SDL_FPoint *out_pos)
 {
-    MinionData minion = mm->minions[minionIndex];
-    if (!minion.active)
+    const SDL_FPoint *position = minion_component(mm, minionIndex, ECS_POSITION);
+    if (!mm->minions[minionIndex].active || !position)
     {
         return false; // No minion was found in the given index
     }
 
-    *out_pos = minion.position;
+    *out_pos = *position;
+    return true;
+}
+void MinionManager_GetReplicatedPosition(MinionManager mm, int minionIndex, bool is_server, uint16_t *out_x, uint16_t *out_y)
+{
+    // Clients hold the dequantized batch value in net_to, which quantizes back to the same number.
+    const SDL_FPoint *position = minion_component(mm, minionIndex, is_server ? ECS_POSITION : ECS_NET_TO);
+    *out_x = position ? quantize_minion_coord(position->x) : 0;
+    *out_y = position ? quantize_minion_coord(position->y) : 0;
+}
+
+Uint64 MinionManager_GetStateHash(MinionManager mm)
+{
+    return mm ? mm->state_hash : 0;
+}
+
+uint8_t MinionManager_GetReplicatedHealth(MinionManager mm, int minionIndex)
+{
+    const EcsHealth *health = minion_component(mm, minionIndex, ECS_HEALTH);
+    if (!health)
+        return 0;
+    return (uint8_t)CLAMP(SDL_ceilf(health->current), 0.0f, 255.0f);
+}
+
+size_t MinionManager_GetStateSize(MinionManager mm)
+{
+    if (!mm)
+        return 0;
+    return (size_t)SLOT_MAP_STATE_WORDS(SlotMap_GetCapacity(mm->slots)) * sizeof(Uint32) +
+           (size_t)SlotMap_GetCount(mm->slots) * sizeof(MinionRecord);
+}
+
+bool MinionManager_SaveState(MinionManager mm, MinionSnapshot *out, void *data)
+{
+    if (!mm || !out || !data)
+        return false;
+    out->slot_words = SLOT_MAP_STATE_WORDS(SlotMap_GetCapacity(mm->slots));
+    out->record_count = SlotMap_GetCount(mm->slots);
+    if (!SlotMap_SaveState(mm->slots, (Uint32 *)data, out->slot_words))
+        return false;
+
+    MinionRecord *records = (MinionRecord *)((Uint32 *)data + out->slot_words);
+    for (int n = 0; n < out->record_count; n++)
+    {
+        int i = SlotMap_GetSlotAt(mm->slots, n);
+        MinionRecord *record = &records[n];
+        memset(record, 0, sizeof(*record));
+        record->data = mm->minions[i];
+        record->data.entity = ECS_ENTITY_NONE;
+        record->target = mm->targets[i];
+        record->team = *(const bool *)minion_component(mm, i, ECS_TEAM);
+        record->health = *(const EcsHealth *)minion_component(mm, i, ECS_HEALTH);
+        record->position = *(const SDL_FPoint *)minion_component(mm, i, ECS_POSITION);
+        record->prev_position = *(const SDL_FPoint *)minion_component(mm, i, ECS_PREV_POSITION);
+        record->velocity = *(const SDL_FPoint *)minion_component(mm, i, ECS_VELOCITY);
+        record->attack_cooldown = *(const float *)minion_component(mm, i, ECS_COOLDOWN);
+        record->anim_timer = *(const float *)minion_component(mm, i, ECS_ANIM_TIMER);
+        record->frame = *(const Sint32 *)minion_component(mm, i, ECS_ANIM_FRAME);
+        if (mm->components & ECS_MASK(ECS_NET_FROM))
+        {
+            record->net_from = *(const SDL_FPoint *)minion_component(mm, i, ECS_NET_FROM);
+            record->net_to = *(const SDL_FPoint *)minion_component(mm, i, ECS_NET_TO);
+            record->net_progress = *(const float *)minion_component(mm, i, ECS_NET_PROGRESS);
+        }
+        record->ai_lod = mm->ai_lod[i];
+    }
+
+    out->ai_step = mm->ai_step;
+    out->minionWaveTimer = mm->minionWaveTimer;
+    out->recentMinionTimer = mm->recentMinionTimer;
+    out->lastStateBroadcast = mm->lastStateBroadcast;
+    out->activeMinionAmount = mm->activeMinionAmount;
+    out->currentMinionWaveAmount = mm->currentMinionWaveAmount;
+    out->spawnNextMinion = mm->spawnNextMinion;
+    return true;
+}
+
+bool MinionManager_RestoreState(MinionManager mm, const MinionSnapshot *snapshot, const void *data)
+{
+    if (!mm || !snapshot || !data)
+        return false;
+
+    int capacity, count;
+    if (!SlotMap_PeekState(mm->slots, (const Uint32 *)data, &capacity, &count))
+        return false;
+    if (count != snapshot->record_count)
+    {
+        SDL_SetError("Minion snapshot holds %d minions, its slot map %d", snapshot->record_count, count);
+        return false;
+    }
+    if (!reserve_minion_storage(mm, capacity))
+        return false;
+
+    // The saved minions take over the entities of the live ones and overwrite their components in
+    // place; entities are only created or destroyed for the difference in count. Everything that can
+    // fail happens before the pool changes, so a failed restore leaves it as it was.
+    int live = SlotMap_GetCount(mm->slots);
+    EcsEntity *entities = SDL_malloc((size_t)SDL_max(SDL_max(count, live), 1) * sizeof(EcsEntity));
+    if (!entities)
+        return false;
+    for (int n = 0; n < live; n++)
+        entities[n] = mm->minions[SlotMap_GetSlotAt(mm->slots, n)].entity;
+    int created = live;
+    while (created < count && (entities[created] = Ecs_CreateEntity(mm->world, mm->components)) != ECS_ENTITY_NONE)
+        created++;
+    if (created < count || !SlotMap_RestoreState(mm->slots, (const Uint32 *)data))
+    {
+        for (int n = live; n < created; n++)
+            Ecs_DestroyEntity(mm->world, entities[n]);
+        SDL_free(entities);
+        return false;
+    }
+    for (int n = count; n < live; n++)
+        Ecs_DestroyEntity(mm->world, entities[n]);
+
+    // Free slots are zeroed, like freshly grown ones: inactive and without an entity.
+    memset(mm->minions, 0, (size_t)mm->capacity * sizeof(MinionData));
+    memset(mm->targets, 0, (size_t)mm->capacity * sizeof(MinionTarget));
+    memset(mm->ai_lod, 0, (size_t)mm->capacity * sizeof(Uint8));
+    memset(mm->state_hashes, 0, (size_t)mm->capacity * sizeof(Uint64));
+    mm->state_hash = 0;
+
+    const MinionRecord *records = (const MinionRecord *)((const Uint32 *)data + snapshot->slot_words);
+    for (int n = 0; n < snapshot->record_count; n++)
+    {
+        int i = SlotMap_GetSlotAt(mm->slots, n);
+        const MinionRecord *record = &records[n];
+        mm->minions[i] = record->data;
+        mm->minions[i].entity = entities[n];
+        mm->targets[i] = record->target;
+        *(bool *)minion_component(mm, i, ECS_TEAM) = record->team;
+        *(EcsHealth *)minion_component(mm, i, ECS_HEALTH) = record->health;
+        *(EcsCollider *)minion_component(mm, i, ECS_COLLIDER) = (EcsCollider){SPATIAL_KIND_MINION, i};
+        *(SDL_FPoint *)minion_component(mm, i, ECS_POSITION) = record->position;
+        *(SDL_FPoint *)minion_component(mm, i, ECS_PREV_POSITION) = record->prev_position;
+        *(SDL_FRect *)minion_component(mm, i, ECS_BOUNDS) = (SDL_FRect){record->position.x - MINION_WIDTH / 2.0f,
+                                                                        record->position.y - MINION_HEIGHT / 2.0f,
+                                                                        MINION_WIDTH, MINION_HEIGHT};
+        *(SDL_FPoint *)minion_component(mm, i, ECS_VELOCITY) = record->velocity;
+        *(float *)minion_component(mm, i, ECS_COOLDOWN) = record->attack_cooldown;
+        *(float *)minion_component(mm, i, ECS_ANIM_TIMER) = record->anim_timer;
+        *(Sint32 *)minion_component(mm, i, ECS_ANIM_FRAME) = record->frame;
+        if (mm->components & ECS_MASK(ECS_NET_FROM))
+        {
+            *(SDL_FPoint *)minion_component(mm, i, ECS_NET_FROM) = record->net_from;
+            *(SDL_FPoint *)minion_component(mm, i, ECS_NET_TO) = record->net_to;
+            *(float *)minion_component(mm, i, ECS_NET_PROGRESS) = record->net_progress;
+        }
+        mm->ai_lod[i] = record->ai_lod;
+        refresh_minion_hash(mm, i);
+    }
+    SDL_free(entities);
+
+    mm->ai_step = snapshot->ai_step;
+    mm->minionWaveTimer = snapshot->minionWaveTimer;
+    mm->recentMinionTimer = snapshot->recentMinionTimer;
+    mm->lastStateBroadcast = snapshot->lastStateBroadcast;
+    mm->activeMinionAmount = snapshot->activeMinionAmount;
+    mm->currentMinionWaveAmount = snapshot->currentMinionWaveAmount;
+    mm->spawnNextMinion = snapshot->spawnNextMinion;
     return true;
-}
\ No newline at end of file
+}
@@ -0,0 +1,913 @@
+#include "../include/nav_grid.h"
+#include "../include/ecs.h"
+#include "../include/tower.h"
+
+// --- Constants ---
+#define NAV_TILE_SIZE ((float)MAP_TILE_WIDTH) /**< Tiles are square. */
+#define NAV_COST_STRAIGHT 10u
+#define NAV_COST_DIAGONAL 14u
+#define NAV_COST_NONE 0xFFFFFFFFu
+#define NAV_HEAP_CLOSED -2      /**< heap_pos of an id that has been expanded. */
+#define NAV_INITIAL_CAPACITY 64 /**< First allocation of the node and link arrays; doubled on demand. */
+
+// --- Static Variables ---
+
+static const int nav_dx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int nav_dy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+// --- Internal Structures ---
+
+/**
+ * @brief A cluster entrance: one tile on a cluster border.
+ */
+typedef struct NavNode
+{
+    int tile;       /**< Tile index of the entrance. */
+    int cluster;    /**< Cluster containing the tile. */
+    int slot;       /**< Position among the nodes of its cluster. */
+    int first_edge; /**< First outgoing edge in edges. */
+    int edge_count; /**< Number of outgoing edges. */
+} NavNode;
+
+typedef struct NavEdge
+{
+    int to;      /**< Target node. */
+    Uint32 cost; /**< Cost of the shortest tile path to it. */
+} NavEdge;
+
+/**
+ * @brief Edge collected while building, before the edges are grouped by node.
+ */
+typedef struct NavLink
+{
+    int from;
+    int to;
+    Uint32 cost;
+} NavLink;
+
+typedef struct NavLinkList
+{
+    NavLink *links;
+    int count;
+    int capacity;
+} NavLinkList;
+
+/**
+ * @brief Half-open rectangle of tiles a search may not leave.
+ */
+typedef struct NavBounds
+{
+    int x0, y0, x1, y1;
+} NavBounds;
+
+/**
+ * @brief Scratch state of a best-first search over ids 0..size-1.
+ * Entries are only valid for ids stamped with the current search, so starting a
+ * search does not have to clear the arrays.
+ */
+typedef struct NavSearch
+{
+    Uint32 *stamp;    /**< Search that last touched each id. */
+    Uint32 *g;        /**< Cost from the start. */
+    Uint32 *f;        /**< g plus the heuristic; the heap key. */
+    int *parent;      /**< Id the best path arrived from, -1 at the start. */
+    int *heap_pos;    /**< Position in heap, -1 if not queued, NAV_HEAP_CLOSED once expanded. */
+    int *heap;        /**< Open ids, a min-heap on f. */
+    int heap_count;   /**< Number of ids in heap. */
+    Uint32 current;   /**< Stamp of the running search. */
+} NavSearch;
+
+/**
+ * @brief Cached entrance chain between two clusters.
+ */
+typedef struct NavRoute
+{
+    Uint64 last_used;                       /**< Cache clock at the last hit; the smallest is evicted. */
+    int count;                              /**< Valid entries in nodes. */
+    int nodes[NAV_MAX_ROUTE_POINTS - 2];    /**< Entrance nodes from the start cluster to the goal cluster. */
+} NavRoute;
+
+/**
+ * @brief Internal state for the navigation grid.
+ */
+struct NavGrid_s
+{
+    int cols;                                  /**< Tiles per row. */
+    int rows;                                  /**< Tiles per column. */
+    int cluster_cols;                          /**< Clusters per row. */
+    int cluster_rows;                          /**< Clusters per column. */
+    Uint8 *blocked;                            /**< Per tile: nonzero if nothing can stand on it. */
+    NavNode *nodes;                            /**< Cluster entrances. */
+    int node_count;                            /**< Number of entrances. */
+    int node_capacity;                         /**< Entrances allocated. */
+    int *node_of_tile;                         /**< Per tile: entrance on it, -1 if none. */
+    NavEdge *edges;                            /**< Outgoing edges, grouped by node. */
+    int edge_count;                            /**< Number of edges. */
+    int *cluster_first;                        /**< Per cluster (plus one): first entry in cluster_nodes. */
+    int *cluster_nodes;                        /**< Entrance nodes grouped by cluster. */
+    Uint32 *start_cost;                        /**< Query scratch: cost from the start to each node of its cluster, by slot. */
+    Uint32 *goal_cost;                         /**< Query scratch: cost from each node of the goal cluster to the goal, by slot. */
+    NavSearch tiles;                           /**< Scratch of the tile searches. */
+    NavSearch graph;                           /**< Scratch of the entrance search (nodes plus the start and goal). */
+    int cache_keys[NAV_PATH_CACHE_SIZE];       /**< start cluster * cluster count + goal cluster, -1 if empty. */
+    NavRoute cache[NAV_PATH_CACHE_SIZE];       /**< Cached routes, parallel to cache_keys. */
+    Uint64 cache_clock;                        /**< Incremented on every cache use. */
+    NavStats stats;                            /**< Query counters. */
+};
+
+// --- Static Helper Functions ---
+
+static bool search_alloc(NavSearch *s, int size)
+{
+    s->stamp = (Uint32 *)SDL_calloc((size_t)size, sizeof(Uint32));
+    s->g = (Uint32 *)SDL_malloc((size_t)size * sizeof(Uint32));
+    s->f = (Uint32 *)SDL_malloc((size_t)size * sizeof(Uint32));
+    s->parent = (int *)SDL_malloc((size_t)size * sizeof(int));
+    s->heap_pos = (int *)SDL_malloc((size_t)size * sizeof(int));
+    s->heap = (int *)SDL_malloc((size_t)size * sizeof(int));
+    s->current = 0;
+    return s->stamp && s->g && s->f && s->parent && s->heap_pos && s->heap;
+}
+
+static void search_free(NavSearch *s)
+{
+    SDL_free(s->stamp);
+    SDL_free(s->g);
+    SDL_free(s->f);
+    SDL_free(s->parent);
+    SDL_free(s->heap_pos);
+    SDL_free(s->heap);
+}
+
+static void search_begin(NavSearch *s, int size)
+{
+    s->heap_count = 0;
+    if (++s->current == 0)
+    {
+        // The stamp wrapped around: old stamps could match again.
+        SDL_memset(s->stamp, 0, (size_t)size * sizeof(Uint32));
+        s->current = 1;
+    }
+}
+
+static void search_touch(NavSearch *s, int id)
+{
+    if (s->stamp[id] == s->current)
+        return;
+    s->stamp[id] = s->current;
+    s->g[id] = NAV_COST_NONE;
+    s->parent[id] = -1;
+    s->heap_pos[id] = -1;
+}
+
+static Uint32 search_cost(const NavSearch *s, int id)
+{
+    return s->stamp[id] == s->current ? s->g[id] : NAV_COST_NONE;
+}
+
+static void heap_swap(NavSearch *s, int a, int b)
+{
+    int tmp = s->heap[a];
+    s->heap[a] = s->heap[b];
+    s->heap[b] = tmp;
+    s->heap_pos[s->heap[a]] = a;
+    s->heap_pos[s->heap[b]] = b;
+}
+
+static void heap_sift_up(NavSearch *s, int pos)
+{
+    while (pos > 0)
+    {
+        int parent = (pos - 1) / 2;
+        if (s->f[s->heap[parent]] <= s->f[s->heap[pos]])
+            break;
+        heap_swap(s, parent, pos);
+        pos = parent;
+    }
+}
+
+static void heap_sift_down(NavSearch *s, int pos)
+{
+    for (;;)
+    {
+        int left = pos * 2 + 1;
+        int right = left + 1;
+        int smallest = pos;
+        if (left < s->heap_count && s->f[s->heap[left]] < s->f[s->heap[smallest]])
+            smallest = left;
+        if (right < s->heap_count && s->f[s->heap[right]] < s->f[s->heap[smallest]])
+            smallest = right;
+        if (smallest == pos)
+            return;
+        heap_swap(s, pos, smallest);
+        pos = smallest;
+    }
+}
+
+/**
+ * @brief Records a path to an id if it is cheaper than the known one, and queues the id.
+ */
+static void search_relax(NavSearch *s, int id, Uint32 g, Uint32 h, int parent)
+{
+    search_touch(s, id);
+    if (s->heap_pos[id] == NAV_HEAP_CLOSED || g >= s->g[id])
+        return;
+    s->g[id] = g;
+    s->f[id] = g + h;
+    s->parent[id] = parent;
+    if (s->heap_pos[id] < 0)
+    {
+        s->heap_pos[id] = s->heap_count;
+        s->heap[s->heap_count++] = id;
+    }
+    heap_sift_up(s, s->heap_pos[id]);
+}
+
+static int search_pop(NavSearch *s)
+{
+    int id = s->heap[0];
+    heap_swap(s, 0, --s->heap_count);
+    heap_sift_down(s, 0);
+    s->heap_pos[id] = NAV_HEAP_CLOSED;
+    return id;
+}
+
+/**
+ * @brief Octile distance between two tiles: the cost of the path without obstacles.
+ */
+static Uint32 octile(NavGrid ng, int a, int b)
+{
+    int dx = SDL_abs(a % ng->cols - b % ng->cols);
+    int dy = SDL_abs(a / ng->cols - b / ng->cols);
+    return NAV_COST_STRAIGHT * (Uint32)SDL_max(dx, dy) + (NAV_COST_DIAGONAL - NAV_COST_STRAIGHT) * (Uint32)SDL_min(dx, dy);
+}
+
+static int tile_at(NavGrid ng, SDL_FPoint point)
+{
+    int col = (int)SDL_floorf(point.x / NAV_TILE_SIZE);
+    int row = (int)SDL_floorf(point.y / NAV_TILE_SIZE);
+    if (col < 0 || row < 0 || col >= ng->cols || row >= ng->rows)
+        return -1;
+    return row * ng->cols + col;
+}
+
+static SDL_FPoint tile_center(NavGrid ng, int tile)
+{
+    return (SDL_FPoint){(tile % ng->cols + 0.5f) * NAV_TILE_SIZE, (tile / ng->cols + 0.5f) * NAV_TILE_SIZE};
+}
+
+static int cluster_of(NavGrid ng, int tile)
+{
+    return (tile / ng->cols) / NAV_CLUSTER_SIZE * ng->cluster_cols + (tile % ng->cols) / NAV_CLUSTER_SIZE;
+}
+
+static NavBounds cluster_bounds(NavGrid ng, int cluster)
+{
+    int x0 = cluster % ng->cluster_cols * NAV_CLUSTER_SIZE;
+    int y0 = cluster / ng->cluster_cols * NAV_CLUSTER_SIZE;
+    return (NavBounds){x0, y0, SDL_min(x0 + NAV_CLUSTER_SIZE, ng->cols), SDL_min(y0 + NAV_CLUSTER_SIZE, ng->rows)};
+}
+
+/**
+ * @brief Searches tiles inside bounds, 8-connected, never cutting the corner of a blocked tile.
+ * @param goal Tile to stop at (A*), or -1 to reach every tile in bounds (Dijkstra).
+ * @return True if the goal was reached; always true without a goal.
+ */
+static bool tile_search(NavGrid ng, int start, int goal, const NavBounds *bounds)
+{
+    NavSearch *s = &ng->tiles;
+    search_begin(s, ng->cols * ng->rows);
+    search_relax(s, start, 0, goal < 0 ? 0 : octile(ng, start, goal), -1);
+
+    while (s->heap_count > 0)
+    {
+        int u = search_pop(s);
+        ng->stats.expanded++;
+        if (u == goal)
+            return true;
+
+        int ux = u % ng->cols;
+        int uy = u / ng->cols;
+        for (int dir = 0; dir < 8; dir++)
+        {
+            int vx = ux + nav_dx[dir];
+            int vy = uy + nav_dy[dir];
+            if (vx < bounds->x0 || vy < bounds->y0 || vx >= bounds->x1 || vy >= bounds->y1)
+                continue;
+            int v = vy * ng->cols + vx;
+            if (ng->blocked[v])
+                continue;
+            bool diagonal = dir & 1;
+            if (diagonal && (ng->blocked[uy * ng->cols + vx] || ng->blocked[vy * ng->cols + ux]))
+                continue;
+            Uint32 g = s->g[u] + (diagonal ? NAV_COST_DIAGONAL : NAV_COST_STRAIGHT);
+            search_relax(s, v, g, goal < 0 ? 0 : octile(ng, v, goal), u);
+        }
+    }
+    return goal < 0;
+}
+
+/**
+ * @brief Writes the tile path of the last tile search, start excluded, as tile centers.
+ * @return Number of points written, or -1 if they do not fit.
+ */
+static int tile_path(NavGrid ng, int start, int goal, SDL_FPoint *out_points, int max_points)
+{
+    int count = 0;
+    for (int tile = goal; tile != start; tile = ng->tiles.parent[tile])
+        count++;
+    if (count > max_points)
+    {
+        SDL_SetError("Path of %d tiles does not fit in %d points", count, max_points);
+        return -1;
+    }
+    int n = count;
+    for (int tile = goal; tile != start; tile = ng->tiles.parent[tile])
+        out_points[--n] = tile_center(ng, tile);
+    return count;
+}
+
+/**
+ * @brief Blocks every tile whose center lies inside a rectangle.
+ */
+static void mark_blocked(NavGrid ng, const SDL_FRect *rect)
+{
+    int c0 = SDL_max((int)SDL_ceilf(rect->x / NAV_TILE_SIZE - 0.5f), 0);
+    int c1 = SDL_min((int)SDL_floorf((rect->x + rect->w) / NAV_TILE_SIZE - 0.5f), ng->cols - 1);
+    int r0 = SDL_max((int)SDL_ceilf(rect->y / NAV_TILE_SIZE - 0.5f), 0);
+    int r1 = SDL_min((int)SDL_floorf((rect->y + rect->h) / NAV_TILE_SIZE - 0.5f), ng->rows - 1);
+    for (int r = r0; r <= r1; r++)
+        for (int c = c0; c <= c1; c++)
+            ng->blocked[r * ng->cols + c] = 1;
+}
+
+static bool push_link(NavLinkList *list, int from, int to, Uint32 cost)
+{
+    if (list->count == list->capacity)
+    {
+        int capacity = list->capacity ? list->capacity * 2 : NAV_INITIAL_CAPACITY;
+        NavLink *links = (NavLink *)SDL_realloc(list->links, (size_t)capacity * sizeof(NavLink));
+        if (!links)
+        {
+            SDL_OutOfMemory();
+            return false;
+        }
+        list->links = links;
+        list->capacity = capacity;
+    }
+    list->links[list->count++] = (NavLink){from, to, cost};
+    return true;
+}
+
+/**
+ * @brief Returns the entrance on a tile, creating it if needed.
+ * @return The node index, or -1 if out of memory.
+ */
+static int get_node(NavGrid ng, int tile)
+{
+    if (ng->node_of_tile[tile] >= 0)
+        return ng->node_of_tile[tile];
+    if (ng->node_count == ng->node_capacity)
+    {
+        int capacity = ng->node_capacity ? ng->node_capacity * 2 : NAV_INITIAL_CAPACITY;
+        NavNode *nodes = (NavNode *)SDL_realloc(ng->nodes, (size_t)capacity * sizeof(NavNode));
+        if (!nodes)
+        {
+            SDL_OutOfMemory();
+            return -1;
+        }
+        ng->nodes = nodes;
+        ng->node_capacity = capacity;
+    }
+    ng->nodes[ng->node_count] = (NavNode){.tile = tile, .cluster = cluster_of(ng, tile)};
+    ng->node_of_tile[tile] = ng->node_count;
+    return ng->node_count++;
+}
+
+/**
+ * @brief Adds the entrances along one border between two clusters.
+ * Tiles a_k = (ax, ay) + k * step lie on one side, b_k = a_k + (bx - ax, by - ay) on the other.
+ * Every run of open pairs gets one entrance in its middle, or one at each end if it is wide.
+ */
+static bool add_border(NavGrid ng, NavLinkList *links, int ax, int ay, int bx, int by, int step_x, int step_y, int length)
+{
+    int run_start = -1;
+    for (int k = 0; k <= length; k++)
+    {
+        bool open = false;
+        if (k < length)
+        {
+            int a = (ay + k * step_y) * ng->cols + ax + k * step_x;
+            int b = (by + k * step_y) * ng->cols + bx + k * step_x;
+            open = !ng->blocked[a] && !ng->blocked[b];
+        }
+        if (open && run_start < 0)
+            run_start = k;
+        if (open || run_start < 0)
+            continue;
+
+        int run_end = k - 1;
+        int picks[2] = {(run_start + run_end) / 2, -1};
+        if (run_end - run_start + 1 >= NAV_ENTRANCE_SPLIT)
+        {
+            picks[0] = run_start;
+            picks[1] = run_end;
+        }
+        for (int p = 0; p < 2 && picks[p] >= 0; p++)
+        {
+            int a = get_node(ng, (ay + picks[p] * step_y) * ng->cols + ax + picks[p] * step_x);
+            int b = get_node(ng, (by + picks[p] * step_y) * ng->cols + bx + picks[p] * step_x);
+            if (a < 0 || b < 0 || !push_link(links, a, b, NAV_COST_STRAIGHT) || !push_link(links, b, a, NAV_COST_STRAIGHT))
+                return false;
+        }
+        run_start = -1;
+    }
+    return true;
+}
+
+/**
+ * @brief Builds the abstract graph: entrances, the edges across borders and the
+ * shortest paths between the entrances of each cluster.
+ */
+static bool build_graph(NavGrid ng)
+{
+    NavLinkList links = {0};
+    int cluster_count = ng->cluster_cols * ng->cluster_rows;
+
+    // --- Entrances ---
+    for (int cy = 0; cy < ng->cluster_rows; cy++)
+    {
+        for (int cx = 0; cx < ng->cluster_cols; cx++)
+        {
+            NavBounds b = cluster_bounds(ng, cy * ng->cluster_cols + cx);
+            if (b.x1 < ng->cols && !add_border(ng, &links, b.x1 - 1, b.y0, b.x1, b.y0, 0, 1, b.y1 - b.y0))
+                goto fail;
+            if (b.y1 < ng->rows && !add_border(ng, &links, b.x0, b.y1 - 1, b.x0, b.y1, 1, 0, b.x1 - b.x0))
+                goto fail;
+        }
+    }
+
+    // --- Group Nodes by Cluster ---
+    ng->cluster_first = (int *)SDL_calloc((size_t)cluster_count + 1, sizeof(int));
+    ng->cluster_nodes = (int *)SDL_malloc((size_t)SDL_max(ng->node_count, 1) * sizeof(int));
+    if (!ng->cluster_first || !ng->cluster_nodes)
+    {
+        SDL_OutOfMemory();
+        goto fail;
+    }
+    for (int i = 0; i < ng->node_count; i++)
+        ng->cluster_first[ng->nodes[i].cluster + 1]++;
+    int max_cluster_nodes = 1;
+    for (int c = 0; c < cluster_count; c++)
+    {
+        max_cluster_nodes = SDL_max(max_cluster_nodes, ng->cluster_first[c + 1]);
+        ng->cluster_first[c + 1] += ng->cluster_first[c];
+    }
+    int *fill = (int *)SDL_calloc((size_t)cluster_count, sizeof(int));
+    if (!fill)
+    {
+        SDL_OutOfMemory();
+        goto fail;
+    }
+    for (int i = 0; i < ng->node_count; i++)
+    {
+        NavNode *node = &ng->nodes[i];
+        node->slot = fill[node->cluster]++;
+        ng->cluster_nodes[ng->cluster_first[node->cluster] + node->slot] = i;
+    }
+    SDL_free(fill);
+
+    // --- Paths Inside Each Cluster ---
+    for (int c = 0; c < cluster_count; c++)
+    {
+        NavBounds bounds = cluster_bounds(ng, c);
+        for (int i = ng->cluster_first[c]; i < ng->cluster_first[c + 1]; i++)
+        {
+            int from = ng->cluster_nodes[i];
+            tile_search(ng, ng->nodes[from].tile, -1, &bounds);
+            for (int j = ng->cluster_first[c]; j < ng->cluster_first[c + 1]; j++)
+            {
+                int to = ng->cluster_nodes[j];
+                Uint32 cost = search_cost(&ng->tiles, ng->nodes[to].tile);
+                if (to != from && cost != NAV_COST_NONE && !push_link(&links, from, to, cost))
+                    goto fail;
+            }
+        }
+    }
+
+    // --- Group Edges by Node ---
+    ng->edges = (NavEdge *)SDL_malloc((size_t)SDL_max(links.count, 1) * sizeof(NavEdge));
+    ng->start_cost = (Uint32 *)SDL_malloc((size_t)max_cluster_nodes * sizeof(Uint32));
+    ng->goal_cost = (Uint32 *)SDL_malloc((size_t)max_cluster_nodes * sizeof(Uint32));
+    if (!ng->edges || !ng->start_cost || !ng->goal_cost || !search_alloc(&ng->graph, ng->node_count + 2))
+    {
+        SDL_OutOfMemory();
+        goto fail;
+    }
+    for (int i = 0; i < ng->node_count; i++)
+        ng->nodes[i].edge_count = 0;
+    for (int l = 0; l < links.count; l++)
+        ng->nodes[links.links[l].from].edge_count++;
+    int first = 0;
+    for (int i = 0; i < ng->node_count; i++)
+    {
+        ng->nodes[i].first_edge = first;
+        first += ng->nodes[i].edge_count;
+        ng->nodes[i].edge_count = 0;
+    }
+    for (int l = 0; l < links.count; l++)
+    {
+        NavNode *node = &ng->nodes[links.links[l].from];
+        ng->edges[node->first_edge + node->edge_count++] = (NavEdge){links.links[l].to, links.links[l].cost};
+    }
+    ng->edge_count = links.count;
+
+    SDL_free(links.links);
+    return true;
+
+fail:
+    SDL_free(links.links);
+    return false;
+}
+
+/**
+ * @brief Searches the entrance graph from the start to the goal.
+ * The start and goal are temporary nodes (ids node_count and node_count + 1) joined to their
+ * clusters by start_cost and goal_cost.
+ * @return Number of entrance nodes written to out_nodes, or -1 if there is no route.
+ */
+static int graph_search(NavGrid ng, int start_tile, int goal_tile, int *out_nodes, int max_nodes)
+{
+    NavSearch *s = &ng->graph;
+    int start = ng->node_count;
+    int goal = ng->node_count + 1;
+    int start_cluster = cluster_of(ng, start_tile);
+    int goal_cluster = cluster_of(ng, goal_tile);
+
+    search_begin(s, ng->node_count + 2);
+    search_relax(s, start, 0, octile(ng, start_tile, goal_tile), -1);
+    while (s->heap_count > 0)
+    {
+        int u = search_pop(s);
+        ng->stats.expanded++;
+        if (u == goal)
+            break;
+
+        if (u == start)
+        {
+            for (int i = ng->cluster_first[start_cluster]; i < ng->cluster_first[start_cluster + 1]; i++)
+            {
+                int v = ng->cluster_nodes[i];
+                Uint32 cost = ng->start_cost[ng->nodes[v].slot];
+                if (cost != NAV_COST_NONE)
+                    search_relax(s, v, cost, octile(ng, ng->nodes[v].tile, goal_tile), u);
+            }
+            continue;
+        }
+
+        const NavNode *node = &ng->nodes[u];
+        for (int e = node->first_edge; e < node->first_edge + node->edge_count; e++)
+        {
+            const NavEdge *edge = &ng->edges[e];
+            search_relax(s, edge->to, s->g[u] + edge->cost, octile(ng, ng->nodes[edge->to].tile, goal_tile), u);
+        }
+        if (node->cluster == goal_cluster && ng->goal_cost[node->slot] != NAV_COST_NONE)
+            search_relax(s, goal, s->g[u] + ng->goal_cost[node->slot], 0, u);
+    }
+
+    if (search_cost(s, goal) == NAV_COST_NONE)
+        return -1;
+    int count = 0;
+    for (int id = s->parent[goal]; id != start; id = s->parent[id])
+        count++;
+    if (count > max_nodes)
+    {
+        SDL_SetError("Route through %d entrances is longer than %d", count, max_nodes);
+        return -1;
+    }
+    int n = count;
+    for (int id = s->parent[goal]; id != start; id = s->parent[id])
+        out_nodes[--n] = id;
+    return count;
+}
+
+/**
+ * @brief Runs a Dijkstra search inside the cluster of a tile and copies the cost to each of
+ * the cluster's entrances, by slot. Costs are symmetric, so this serves the goal too.
+ */
+static void connect_to_cluster(NavGrid ng, int tile, Uint32 *out_cost)
+{
+    int cluster = cluster_of(ng, tile);
+    NavBounds bounds = cluster_bounds(ng, cluster);
+    tile_search(ng, tile, -1, &bounds);
+    for (int i = ng->cluster_first[cluster]; i < ng->cluster_first[cluster + 1]; i++)
+    {
+        const NavNode *node = &ng->nodes[ng->cluster_nodes[i]];
+        out_cost[node->slot] = search_cost(&ng->tiles, node->tile);
+    }
+}
+
+static NavRoute *cache_find(NavGrid ng, int key)
+{
+    for (int i = 0; i < NAV_PATH_CACHE_SIZE; i++)
+    {
+        if (ng->cache_keys[i] == key)
+        {
+            ng->cache[i].last_used = ++ng->cache_clock;
+            return &ng->cache[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Stores a route, replacing the entry with the same key or the least recently used one.
+ */
+static void cache_store(NavGrid ng, int key, const int *nodes, int count)
+{
+    int victim = 0;
+    for (int i = 0; i < NAV_PATH_CACHE_SIZE; i++)
+    {
+        if (ng->cache_keys[i] == key || ng->cache_keys[i] < 0)
+        {
+            victim = i;
+            break;
+        }
+        if (ng->cache[i].last_used < ng->cache[victim].last_used)
+            victim = i;
+    }
+    ng->cache_keys[victim] = key;
+    ng->cache[victim].last_used = ++ng->cache_clock;
+    ng->cache[victim].count = count;
+    SDL_memcpy(ng->cache[victim].nodes, nodes, (size_t)count * sizeof(int));
+}
+
+/**
+ * @brief Refines the next route segment into tile waypoints.
+ * Consecutive route tiles share a cluster or sit on both sides of a border, so the search
+ * never leaves the one or two clusters involved.
+ */
+static bool refine_segment(NavGrid ng, NavPath *path)
+{
+    int from = path->route[path->route_next - 1];
+    int to = path->route[path->route_next];
+    path->route_next++;
+    path->segment_count = 0;
+    path->segment_next = 0;
+
+    if (from != to)
+    {
+        NavBounds a = cluster_bounds(ng, cluster_of(ng, from));
+        NavBounds b = cluster_bounds(ng, cluster_of(ng, to));
+        NavBounds bounds = {SDL_min(a.x0, b.x0), SDL_min(a.y0, b.y0), SDL_max(a.x1, b.x1), SDL_max(a.y1, b.y1)};
+        if (!tile_search(ng, from, to, &bounds))
+        {
+            SDL_SetError("Route segment %d -> %d has no path", from, to);
+            return false;
+        }
+        path->segment_count = tile_path(ng, from, to, path->segment, NAV_MAX_SEGMENT_POINTS);
+        if (path->segment_count < 0)
+        {
+            path->segment_count = 0;
+            return false;
+        }
+    }
+
+    // End exactly on the requested position rather than on the center of its tile.
+    if (path->route_next == path->route_count)
+    {
+        if (path->segment_count == 0)
+            path->segment_count = 1;
+        path->segment[path->segment_count - 1] = path->goal;
+    }
+    return true;
+}
+
+// --- Public API Function Implementations ---
+
+NavGrid NavGrid_Create(int width, int height, const SDL_FRect *blocked, int blocked_count, SDL_FPoint clearance)
+{
+    if (width <= 0 || height <= 0 || (blocked_count > 0 && !blocked))
+    {
+        SDL_SetError("Invalid arguments for NavGrid_Create");
+        return NULL;
+    }
+
+    NavGrid ng = (NavGrid)SDL_calloc(1, sizeof(struct NavGrid_s));
+    if (!ng)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ng->cols = (int)SDL_ceilf(width / NAV_TILE_SIZE);
+    ng->rows = (int)SDL_ceilf(height / NAV_TILE_SIZE);
+    ng->cluster_cols = (ng->cols + NAV_CLUSTER_SIZE - 1) / NAV_CLUSTER_SIZE;
+    ng->cluster_rows = (ng->rows + NAV_CLUSTER_SIZE - 1) / NAV_CLUSTER_SIZE;
+    NavGrid_ClearCache(ng);
+
+    size_t count = (size_t)ng->cols * (size_t)ng->rows;
+    ng->blocked = (Uint8 *)SDL_calloc(count, sizeof(Uint8));
+    ng->node_of_tile = (int *)SDL_malloc(count * sizeof(int));
+    if (!ng->blocked || !ng->node_of_tile || !search_alloc(&ng->tiles, (int)count))
+    {
+        SDL_OutOfMemory();
+        NavGrid_Destroy(ng);
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++)
+        ng->node_of_tile[i] = -1;
+
+    for (int i = 0; i < blocked_count; i++)
+    {
+        SDL_FRect area = Collision_InflateRect(&blocked[i], clearance);
+        mark_blocked(ng, &area);
+    }
+
+    if (!build_graph(ng))
+    {
+        NavGrid_Destroy(ng);
+        return NULL;
+    }
+    return ng;
+}
+
+NavGrid NavGrid_Init(AppState *state, SDL_FPoint clearance)
+{
+    if (!state || !state->map_state || !state->world)
+    {
+        SDL_SetError("Invalid AppState or missing map_state/world for NavGrid_Init");
+        return NULL;
+    }
+
+    // --- Collect Obstacles ---
+    SDL_FRect blocked[MAP_MAX_COLLISION_RECTS + MAX_TOTAL_TOWERS + MAX_BASES];
+    const SDL_FRect *terrain = NULL;
+    int count = Map_GetCollisionRects(state->map_state, &terrain);
+    SDL_memcpy(blocked, terrain, (size_t)count * sizeof(SDL_FRect));
+
+    EcsIter it = Ecs_Query(state->world, ECS_MASK(ECS_COLLIDER) | ECS_MASK(ECS_BOUNDS), 0);
+    while (EcsIter_Next(&it))
+    {
+        const SDL_FRect *bounds = EcsIter_Column(&it, ECS_BOUNDS);
+        const EcsCollider *collider = EcsIter_Column(&it, ECS_COLLIDER);
+        for (int row = 0; row < it.count && count < (int)SDL_arraysize(blocked); row++)
+        {
+            if (collider[row].kind & SPATIAL_KIND_BUILDING)
+                blocked[count++] = bounds[row];
+        }
+    }
+
+    NavGrid ng = NavGrid_Create(Map_GetWidthPixels(state->map_state), Map_GetHeightPixels(state->map_state), blocked, count, clearance);
+    if (!ng)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[NavGrid Init] Failed to build the grid: %s", SDL_GetError());
+        return NULL;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "NavGrid initialized (%dx%d tiles, %d clusters, %d entrances, %d edges).",
+                ng->cols, ng->rows, ng->cluster_cols * ng->cluster_rows, ng->node_count, ng->edge_count);
+    return ng;
+}
+
+void NavGrid_Destroy(NavGrid ng)
+{
+    if (!ng)
+        return;
+    SDL_free(ng->blocked);
+    SDL_free(ng->nodes);
+    SDL_free(ng->node_of_tile);
+    SDL_free(ng->edges);
+    SDL_free(ng->cluster_first);
+    SDL_free(ng->cluster_nodes);
+    SDL_free(ng->start_cost);
+    SDL_free(ng->goal_cost);
+    search_free(&ng->tiles);
+    search_free(&ng->graph);
+    SDL_free(ng);
+}
+
+bool NavGrid_FindPath(NavGrid ng, SDL_FPoint from, SDL_FPoint to, NavPath *out_path)
+{
+    if (!ng || !out_path)
+        return false;
+    ng->stats.queries++;
+
+    int start = tile_at(ng, from);
+    int goal = tile_at(ng, to);
+    if (start < 0 || goal < 0 || ng->blocked[start] || ng->blocked[goal])
+    {
+        SDL_SetError("Path end outside the grid or on a blocked tile");
+        return false;
+    }
+    int start_cluster = cluster_of(ng, start);
+    int goal_cluster = cluster_of(ng, goal);
+
+    out_path->route[0] = start;
+    out_path->route_next = 1;
+    out_path->segment_count = 0;
+    out_path->segment_next = 0;
+    out_path->goal = to;
+
+    // --- Same Cluster ---
+    connect_to_cluster(ng, start, ng->start_cost);
+    if (start_cluster == goal_cluster && search_cost(&ng->tiles, goal) != NAV_COST_NONE)
+    {
+        out_path->route[1] = goal;
+        out_path->route_count = 2;
+        return true;
+    }
+    connect_to_cluster(ng, goal, ng->goal_cost);
+
+    // --- Cached Route ---
+    // Usable if this start and goal reach the entrances it begins and ends at.
+    int key = start_cluster * ng->cluster_cols * ng->cluster_rows + goal_cluster;
+    int *chain = &out_path->route[1];
+    int chain_count = -1;
+    const NavRoute *cached = cache_find(ng, key);
+    if (cached && ng->start_cost[ng->nodes[cached->nodes[0]].slot] != NAV_COST_NONE &&
+        ng->goal_cost[ng->nodes[cached->nodes[cached->count - 1]].slot] != NAV_COST_NONE)
+    {
+        ng->stats.cache_hits++;
+        SDL_memcpy(chain, cached->nodes, (size_t)cached->count * sizeof(int));
+        chain_count = cached->count;
+    }
+    else
+    {
+        chain_count = graph_search(ng, start, goal, chain, NAV_MAX_ROUTE_POINTS - 2);
+        if (chain_count <= 0)
+        {
+            if (chain_count == 0)
+                SDL_SetError("No route between the start and goal clusters");
+            return false;
+        }
+        cache_store(ng, key, chain, chain_count);
+    }
+
+    for (int i = 0; i < chain_count; i++)
+        chain[i] = ng->nodes[chain[i]].tile;
+    out_path->route[chain_count + 1] = goal;
+    out_path->route_count = chain_count + 2;
+    return true;
+}
+
+bool NavGrid_NextWaypoint(NavGrid ng, NavPath *path, SDL_FPoint *out_point)
+{
+    if (!ng || !path || !out_point)
+        return false;
+
+    while (path->segment_next >= path->segment_count)
+    {
+        if (path->route_next >= path->route_count)
+            return false;
+        if (!refine_segment(ng, path))
+        {
+            path->route_next = path->route_count;
+            return false;
+        }
+    }
+    *out_point = path->segment[path->segment_next++];
+    return true;
+}
+
+int NavGrid_FindDirectPath(NavGrid ng, SDL_FPoint from, SDL_FPoint to, SDL_FPoint *out_points, int max_points)
+{
+    if (!ng || !out_points || max_points <= 0)
+        return -1;
+
+    int start = tile_at(ng, from);
+    int goal = tile_at(ng, to);
+    if (start < 0 || goal < 0 || ng->blocked[start] || ng->blocked[goal])
+    {
+        SDL_SetError("Path end outside the grid or on a blocked tile");
+        return -1;
+    }
+
+    NavBounds bounds = {0, 0, ng->cols, ng->rows};
+    if (!tile_search(ng, start, goal, &bounds))
+    {
+        SDL_SetError("No path between the start and goal");
+        return -1;
+    }
+    int count = tile_path(ng, start, goal, out_points, max_points);
+    if (count < 0)
+        return -1;
+    if (count == 0)
+        count = 1;
+    out_points[count - 1] = to;
+    return count;
+}
+
+void NavGrid_ClearCache(NavGrid ng)
+{
+    if (!ng)
+        return;
+    for (int i = 0; i < NAV_PATH_CACHE_SIZE; i++)
+        ng->cache_keys[i] = -1;
+}
+
+void NavGrid_GetStats(NavGrid ng, NavStats *out_stats)
+{
+    if (!ng || !out_stats)
+        return;
+    *out_stats = ng->stats;
+}
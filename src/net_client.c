@@ -1,4 +1,5 @@
 #include "../include/net_client.h"
+#include "../include/desync.h"
 
 // --- Internal Structures ---
 
@@ -19,11 +20,15 @@ typedef enum ClientNetworkStatus
 struct NetClientState_s
 {
     SDLNet_Address *server_address_resolved; /**< Resolved server address structure, or NULL. */
-    SDLNet_StreamSocket *server_connection;  /**< Active socket connection to the server, or NULL. */
+    SDLNet_StreamSocket *pending_socket;     /**< Socket of an ongoing TCP connection attempt, or NULL. */
+    NetConnection server_connection;         /**< Active connection to the server (TCP or shared memory), or NULL. */
     ClientNetworkStatus network_status;      /**< Current connection status. */
     int my_client_id;                        /**< Client ID assigned by the server, or -1 if not assigned. */
     Uint64 last_state_send_time;             /**< Timestamp of the last player state message sent. */
+    SimClock clock;                          /**< Clock used for send intervals (shared with AppState). */
     char hostname[MAX_NAME_LENGTH];          /**< Hostname to connect to, provided by the user or default. */
+    char shm_name[MAX_NAME_LENGTH];          /**< Shared-memory segment to attach to instead of TCP, or empty. */
+    NetMessageStats message_stats[NET_MESSAGE_TYPE_COUNT]; /**< Receive counters per message type. */
 };
 
 // --- Constants ---
@@ -45,7 +50,7 @@ static bool NetClient_SendBuffer(NetClientState nc_state, const void *buffer, in
     {
         return false;
     }
-    if (!SDLNet_WriteToStreamSocket(nc_state->server_connection, buffer, length))
+    if (!NetConnection_Write(nc_state->server_connection, buffer, length))
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Client] Send failed: %s. Disconnecting.", SDL_GetError());
         NetClient_Destroy(nc_state); // Trigger full cleanup on send failure
@@ -120,14 +125,14 @@ static void internal_attempt_connection(NetClientState nc_state)
         return;
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Attempting connection to port %d...", SERVER_PORT);
-    if (nc_state->server_connection)
+    if (nc_state->pending_socket)
     {
-        SDLNet_DestroyStreamSocket(nc_state->server_connection);
-        nc_state->server_connection = NULL;
+        SDLNet_DestroyStreamSocket(nc_state->pending_socket);
+        nc_state->pending_socket = NULL;
     }
 
-    nc_state->server_connection = SDLNet_CreateClient(nc_state->server_address_resolved, SERVER_PORT);
-    if (nc_state->server_connection == NULL)
+    nc_state->pending_socket = SDLNet_CreateClient(nc_state->server_address_resolved, SERVER_PORT);
+    if (nc_state->pending_socket == NULL)
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Client] SDLNet_CreateClient failed: %s", SDL_GetError());
     }
@@ -137,6 +142,45 @@ static void internal_attempt_connection(NetClientState nc_state)
     }
 }
 
+/**
+ * @brief Switches to the CONNECTED state on an established connection and sends C_HELLO.
+ * @param nc_state The NetClientState instance.
+ * @param connection The established connection. Ownership moves to nc_state.
+ */
+static void internal_on_connected(NetClientState nc_state, NetConnection connection)
+{
+    nc_state->server_connection = connection;
+    nc_state->network_status = CLIENT_STATUS_CONNECTED;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Connected to server!");
+
+    uint8_t msg_type = MSG_TYPE_C_HELLO;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Sending C_HELLO.");
+    if (!NetClient_SendBuffer(nc_state, &msg_type, sizeof(msg_type)))
+    {
+        return; // SendBuffer handles disconnect on failure
+    }
+    nc_state->last_state_send_time = SimClock_GetTicks(nc_state->clock);
+}
+
+/**
+ * @brief Attaches to the server's shared-memory segment. There is no resolve or
+ * connecting phase: the attempt either succeeds immediately or is retried next frame.
+ * @param nc_state The NetClientState instance.
+ */
+static void internal_attempt_shm_connection(NetClientState nc_state)
+{
+    if (!nc_state || nc_state->network_status != CLIENT_STATUS_DISCONNECTED)
+        return;
+
+    NetConnection connection = NetShm_Connect(nc_state->shm_name);
+    if (!connection)
+    {
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Client] Shared-memory attach to '%s' failed: %s", nc_state->shm_name, SDL_GetError());
+        return;
+    }
+    internal_on_connected(nc_state, connection);
+}
+
 /**
  * @brief Checks the status of an ongoing connection attempt.
  * Transitions state to CONNECTED on success, sends C_HELLO, or handles cleanup on failure.
@@ -144,22 +188,21 @@ static void internal_attempt_connection(NetClientState nc_state)
  */
 static void internal_check_connection_status(NetClientState nc_state)
 {
-    if (!nc_state || nc_state->network_status != CLIENT_STATUS_CONNECTING || !nc_state->server_connection)
+    if (!nc_state || nc_state->network_status != CLIENT_STATUS_CONNECTING || !nc_state->pending_socket)
         return;
 
-    int status = SDLNet_GetConnectionStatus(nc_state->server_connection);
+    int status = SDLNet_GetConnectionStatus(nc_state->pending_socket);
     if (status == 1) // 1 indicates success
     {
-        nc_state->network_status = CLIENT_STATUS_CONNECTED;
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Connected to server!");
-
-        uint8_t msg_type = MSG_TYPE_C_HELLO;
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Sending C_HELLO.");
-        if (!NetClient_SendBuffer(nc_state, &msg_type, sizeof(msg_type)))
+        NetConnection connection = NetConnection_FromStreamSocket(nc_state->pending_socket);
+        nc_state->pending_socket = NULL; // Owned by the connection now, or already destroyed
+        if (!connection)
         {
-            return; // SendBuffer handles disconnect on failure
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Client] Failed to wrap connection: %s", SDL_GetError());
+            NetClient_Destroy(nc_state);
+            return;
         }
-        nc_state->last_state_send_time = SDL_GetTicks();
+        internal_on_connected(nc_state, connection);
     }
     else if (status == -1) // -1 indicates failure
     {
@@ -190,227 +233,217 @@ static void internal_send_local_player_state(NetClientState nc_state, AppState *
     NetClient_SendBuffer(nc_state, &data, sizeof(Msg_PlayerStateData));
 }
 
+// --- Message Handlers ---
+
 /**
- * @brief Processes a single message received from the server based on its type.
- * @param nc_state The NetClientState instance.
- * @param buffer Pointer to the received data buffer.
- * @param bytesReceived Number of bytes in the buffer.
- * @param state The main AppState instance.
+ * @brief Signature of a client-side message handler referenced from NET_MESSAGE_SCHEMA.
+ * The dispatcher has already checked the message size and copied it into @p msg.
+ * @return False if handling destroyed nc_state (the dispatcher must stop), true otherwise.
  */
-static void internal_process_server_message(NetClientState nc_state, char *buffer, int bytesReceived, AppState *state)
+typedef bool (*ClientMessageHandler)(NetClientState nc_state, NetMessagePayload *msg, AppState *state);
+
+static bool client_on_welcome(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
 {
-    if (!nc_state || !state || bytesReceived < (int)sizeof(uint8_t))
+    (void)state;
+    if (nc_state->my_client_id != -1)
     {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete message (< type byte)");
-        return;
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Received duplicate S_WELCOME (myID already %d). Ignoring.", nc_state->my_client_id);
+        return true;
     }
+    nc_state->my_client_id = msg->as_S_WELCOME.assigned_client_id;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Received S_WELCOME, assigned myClientID = %d", nc_state->my_client_id);
+    return true;
+}
 
-    uint8_t msg_type_byte = (uint8_t)buffer[0];
+static bool client_on_game_start(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Received S_GAME_START, assigned myClientID = %d", nc_state->my_client_id);
+    CommandBuffer_SetGameState(state->command_buffer, GAME_STATE_PLAYING, false);
+    state->server_start_time = msg->as_S_GAME_START.server_start_time_stamp;
+    state->client_start_time = SimClock_GetTicks(state->clock);
 
-    switch ((MessageType)msg_type_byte)
+    if (!state->player_manager || !state->camera_state)
     {
-    case MSG_TYPE_S_WELCOME:
-        if (nc_state->my_client_id != -1)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Received duplicate S_WELCOME (myID already %d). Ignoring.", nc_state->my_client_id);
-            return;
-        }
-        if (bytesReceived >= (int)sizeof(Msg_WelcomeData))
-        {
-            Msg_WelcomeData welcome_data;
-            memcpy(&welcome_data, buffer, sizeof(Msg_WelcomeData));
-            nc_state->my_client_id = welcome_data.assigned_client_id;
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Received S_WELCOME, assigned myClientID = %d", nc_state->my_client_id);
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_WELCOME (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_WelcomeData));
-        }
-        break;
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Client] PlayerManager or CameraState is NULL when processing S_WELCOME.");
+        NetClient_Destroy(nc_state);
+        return false;
+    }
+    if (!PlayerManager_SetLocalPlayerID(state, nc_state->my_client_id))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Client] Failed to set local player ID %d in PlayerManager. Error: %s", nc_state->my_client_id, SDL_GetError());
+        NetClient_Destroy(nc_state);
+        return false;
+    }
+    // Hide lobby_client_msg after game start
+    update_hud_instance(state, get_hud_index_by_name(state, "lobby_client_msg"), "", (SDL_Color){255, 255, 255, 255}, (SDL_FPoint){0.0f, 50.0f}, 0);
+    return true;
+}
 
-    case MSG_TYPE_S_GAME_START:
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Received S_GAME_START, assigned myClientID = %d", nc_state->my_client_id);
-        state->currentGameState = GAME_STATE_PLAYING;
-        if (bytesReceived >= (int)sizeof(Msg_GameStart))
-        {
-            Msg_GameStart data;
-            memcpy(&data, buffer, sizeof(Msg_GameStart));
-            state->server_start_time = data.server_start_time_stamp;
-            state->client_start_time = SDL_GetTicks();
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_GAME_START (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_GameStart));
-        }
+static bool client_on_player_state(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    if (state->player_manager)
+    {
+        PlayerManager_UpdateRemotePlayer(state, &msg->as_S_PLAYER_STATE);
+    }
+    return true;
+}
 
-        if (!state->player_manager || !state->camera_state)
-        {
-            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Client] PlayerManager or CameraState is NULL when processing S_WELCOME.");
-            NetClient_Destroy(nc_state);
-            return;
-        }
-        if (!PlayerManager_SetLocalPlayerID(state, nc_state->my_client_id))
-        {
-            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Client] Failed to set local player ID %d in PlayerManager. Error: %s", nc_state->my_client_id, SDL_GetError());
-            NetClient_Destroy(nc_state);
-            return;
-        }
-        // Hide lobby_client_msg after game start
-        update_hud_instance(state, get_hud_index_by_name(state, "lobby_client_msg"), "", (SDL_Color){255, 255, 255, 255}, (SDL_FPoint){0.0f, 50.0f}, 0);
+static bool client_on_player_disconnect(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Received disconnect for client %u", (unsigned int)msg->as_S_PLAYER_DISCONNECT.client_id);
+    if (state->player_manager)
+    {
+        PlayerManager_RemovePlayer(state->player_manager, msg->as_S_PLAYER_DISCONNECT.client_id);
+    }
+    return true;
+}
 
-        break;
+static bool client_on_spawn_attack(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    if (state->attack_manager)
+    {
+        AttackManager_HandleServerSpawn(state->attack_manager, state, &msg->as_S_SPAWN_ATTACK);
+    }
+    return true;
+}
 
-    case MSG_TYPE_S_PLAYER_STATE:
-        if (bytesReceived >= (int)sizeof(Msg_PlayerStateData))
-        {
-            Msg_PlayerStateData state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_PlayerStateData));
-            if (state->player_manager)
-            {
-                PlayerManager_UpdateRemotePlayer(state, &state_data);
-            }
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_PLAYER_STATE msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_PlayerStateData));
-        }
-        break;
+static bool client_on_destroy_object(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    if (msg->as_S_DESTROY_OBJECT.object_type == OBJECT_TYPE_ATTACK && state->attack_manager)
+    {
+        AttackManager_HandleDestroyObject(state->attack_manager, state, &msg->as_S_DESTROY_OBJECT);
+    }
+    return true;
+}
 
-    case MSG_TYPE_S_PLAYER_DISCONNECT:
-        if (bytesReceived >= (int)sizeof(Msg_PlayerDisconnectData))
-        {
-            Msg_PlayerDisconnectData disconnect_data;
-            memcpy(&disconnect_data, buffer, sizeof(Msg_PlayerDisconnectData));
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Client] Received disconnect for client %u", (unsigned int)disconnect_data.client_id);
-            if (state->player_manager)
-            {
-                PlayerManager_RemovePlayer(state->player_manager, disconnect_data.client_id);
-            }
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_PLAYER_DISCONNECT msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_PlayerDisconnectData));
-        }
-        break;
+static bool client_on_minion_spawn(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    if (state->minion_manager)
+    {
+        MinionManager_HandleServerSpawn(state, &msg->as_S_MINION_SPAWN);
+    }
+    return true;
+}
 
-    case MSG_TYPE_S_SPAWN_ATTACK:
-        if (bytesReceived >= (int)sizeof(Msg_ServerSpawnAttackData))
-        {
-            Msg_ServerSpawnAttackData spawn_data;
-            memcpy(&spawn_data, buffer, sizeof(Msg_ServerSpawnAttackData));
-            if (state->attack_manager)
-            {
-                AttackManager_HandleServerSpawn(state->attack_manager, &spawn_data);
-            }
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_SPAWN_ATTACK msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_ServerSpawnAttackData));
-        }
-        break;
+static bool client_on_minion_state(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    if (state->minion_manager)
+    {
+        MinionManager_HandleStateBatch(state, &msg->as_S_MINION_STATE);
+    }
+    return true;
+}
 
-    case MSG_TYPE_S_DESTROY_OBJECT:
-        if (bytesReceived >= (int)sizeof(Msg_DestroyObjectData))
-        {
-            Msg_DestroyObjectData destroy_data;
-            memcpy(&destroy_data, buffer, sizeof(Msg_DestroyObjectData));
-            if (destroy_data.object_type == OBJECT_TYPE_ATTACK && state->attack_manager)
-            {
-                AttackManager_HandleDestroyObject(state->attack_manager, &destroy_data);
-            }
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_DESTROY_OBJECT msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_DestroyObjectData));
-        }
-        break;
+static bool client_on_world_hash(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    Desync_HandleWorldHash(state, &msg->as_S_WORLD_HASH);
+    return true;
+}
 
-    case MSG_TYPE_S_DAMAGE_PLAYER:
-        if (bytesReceived >= (int)sizeof(Msg_DamagePlayer))
-        {
-            Msg_DamagePlayer state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_DamagePlayer));
-            if (state->player_manager)
-            {
-                damagePlayer(*state, state_data.playerIndex, state_data.damageValue, false);
-            }
-        }
-        else
+static bool client_on_damage_batch(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    const Msg_DamageBatch *batch = &msg->as_S_DAMAGE_BATCH;
+    if (batch->count > MSG_DAMAGE_BATCH_MAX)
+    {
+        return false;
+    }
+    // Minion entries were already applied by the server; their result arrives with the state batch.
+    for (int i = 0; i < batch->count; i++)
+    {
+        if (batch->kind[i] != DAMAGE_TARGET_MINION && batch->kind[i] < DAMAGE_TARGET_KIND_COUNT)
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_DAMAGE_PLAYER msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_DamagePlayer));
+            DamageBus_PushRemote(state->damage_bus, (DamageTargetKind)batch->kind[i], batch->target[i], batch->damage[i], batch->health[i]);
         }
-        break;
+    }
+    return true;
+}
 
-    case MSG_TYPE_S_DAMAGE_MINION:
-        if (bytesReceived >= (int)sizeof(Msg_DamageMinion))
-        {
-            Msg_DamageMinion state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_DamageMinion));
-            if (state->minion_manager)
-            {
-                damageMinion(*state, state_data.minionIndex, 0, false, state_data.current_health);
-            }
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_DAMAGE_MINION msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_DamageMinion));
-        }
-        break;
+static bool client_on_game_result(NetClientState nc_state, NetMessagePayload *msg, AppState *state)
+{
+    (void)nc_state;
+    SDL_Log("\n---\nMatch Won by team %s\n---\n", msg->as_S_GAME_RESULT.winningTeam ? "RED" : "BLUE");
 
-    case MSG_TYPE_S_DAMAGE_TOWER:
-        if (bytesReceived >= (int)sizeof(Msg_DamageTower))
-        {
-            Msg_DamageTower state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_DamageTower));
-            if (state->tower_manager)
-            {
-                damageTower(*state, state_data.towerIndex, state_data.damageValue, false, state_data.current_health);
-            }
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_DAMAGE_TOWER msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_DamageTower));
-        }
-        break;
+    CommandBuffer_SetGameState(state->command_buffer, GAME_STATE_FINISHED, msg->as_S_GAME_RESULT.winningTeam);
+    return true;
+}
+
+// --- Dispatch Table ---
+
+/** Handlers for server-to-client messages, indexed by type byte. Generated from NET_MESSAGE_SCHEMA. */
+#define NET_CLIENT_ROUTE_C2S(name, handler)
+#define NET_CLIENT_ROUTE_S2C(name, handler) [MSG_TYPE_##name] = handler,
+#define NET_CLIENT_ROUTE(name, id, payload, direction, requires, relay, handler) NET_CLIENT_ROUTE_##direction(name, handler)
+static const ClientMessageHandler client_handlers[NET_MESSAGE_TYPE_COUNT] = {
+    NET_MESSAGE_SCHEMA(NET_CLIENT_ROUTE)};
+#undef NET_CLIENT_ROUTE
+#undef NET_CLIENT_ROUTE_S2C
+#undef NET_CLIENT_ROUTE_C2S
+
+SDL_COMPILE_TIME_ASSERT(client_payload_fits_buffer, sizeof(NetMessagePayload) <= BUFFER_SIZE);
 
-    case MSG_TYPE_S_DAMAGE_BASE:
-        if (bytesReceived >= (int)sizeof(Msg_DamageBase))
+/**
+ * @brief Processes every message contained in a buffer received from the server.
+ * Each message is checked against its schema entry (direction, size) and passed to its handler.
+ * @param nc_state The NetClientState instance.
+ * @param buffer Pointer to the received data buffer.
+ * @param bytesReceived Number of bytes in the buffer.
+ * @param state The main AppState instance.
+ * @return False if a handler destroyed nc_state, true otherwise.
+ */
+static bool internal_process_server_buffer(NetClientState nc_state, const char *buffer, int bytesReceived, AppState *state)
+{
+    if (!nc_state || !state)
+    {
+        return true;
+    }
+
+    int offset = 0;
+    while (offset < bytesReceived)
+    {
+        uint8_t msg_type_byte = (uint8_t)buffer[offset];
+        const NetMessageInfo *info = NetMessage_GetInfo(msg_type_byte);
+        NetMessageStats *stats = &nc_state->message_stats[msg_type_byte];
+
+        if (!info || info->direction != NET_DIR_S2C || !client_handlers[msg_type_byte])
         {
-            Msg_DamageBase state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_DamageBase));
-            if (state->base_manager)
-            {
-                damageBase(state, state_data.baseIndex, state_data.damageValue, false);
-            }
+            // Without a schema entry the next message boundary is unknown, so drop the rest.
+            stats->dropped++;
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd unknown message type (%u) from server", (unsigned int)msg_type_byte);
+            return true;
         }
-        else
+        if (bytesReceived - offset < (int)info->size)
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_DAMAGE_BASE msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_DamageBase));
+            stats->dropped++;
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete %s msg (%d bytes, needed %u)", info->name, bytesReceived - offset, (unsigned int)info->size);
+            return true;
         }
-        break;
-
-    case MSG_TYPE_S_GAME_RESULT:
-        if (bytesReceived >= (int)sizeof(Msg_MatchResult))
+        if (info->requirement == NET_REQ_WELCOMED && nc_state->my_client_id < 0)
         {
-            Msg_MatchResult received_match_result;
-            memcpy(&received_match_result, buffer, sizeof(Msg_MatchResult));
+            stats->dropped++;
+            offset += info->size;
+            continue;
+        }
 
-            SDL_Log("\n---\nMatch Won by team %s\n---\n", received_match_result.winningTeam ? "RED" : "BLUE");
+        NetMessagePayload msg;
+        memcpy(&msg, &buffer[offset], info->size);
+        offset += info->size;
+        stats->handled++;
+        stats->bytes += info->size;
 
-            state->winningTeam = received_match_result.winningTeam;
-            state->currentGameState = GAME_STATE_FINISHED;
-            hud_finish_msg(state);
-        }
-        else
+        if (!client_handlers[msg_type_byte](nc_state, &msg, state))
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd incomplete S_GAME_RESULT msg (%d bytes, needed %lu)", bytesReceived, (unsigned long)sizeof(Msg_MatchResult));
+            return false;
         }
-        break;
-
-    default:
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Client] Rcvd unknown message type (%u) from server", (unsigned int)msg_type_byte);
-        break;
     }
+    return true;
 }
 
 /**
@@ -431,20 +464,20 @@ static bool internal_receive_server_data(NetClientState nc_state, AppState *stat
     int bytesReceived;
     SDL_ClearError();
 
-    // Read all available data in the socket buffer for this frame
-    while ((bytesReceived = SDLNet_ReadFromStreamSocket(nc_state->server_connection, buffer, sizeof(buffer))) > 0)
+    // Read all available data for this frame. Every transport returns one whole message per read
+    // (TCP reassembles them from its length-prefixed frames), so keep reading until none is left:
+    // a minion state snapshot alone may be several messages.
+    while ((bytesReceived = NetConnection_Read(nc_state->server_connection, buffer, sizeof(buffer))) > 0)
     {
-        internal_process_server_message(nc_state, buffer, bytesReceived, state);
-        // Check if processing caused a disconnect (e.g., critical error)
-        if (nc_state->network_status != CLIENT_STATUS_CONNECTED)
+        if (!internal_process_server_buffer(nc_state, buffer, bytesReceived, state))
         {
+            // A handler hit a critical error and destroyed the client
+            if (state && state->net_client_state == nc_state)
+            {
+                state->net_client_state = NULL;
+            }
             return false;
         }
-        // Stop reading if the buffer wasn't filled, indicating no more immediate data
-        if (bytesReceived < (int)sizeof(buffer))
-        {
-            break;
-        }
     }
 
     // Handle read errors or closed connection
@@ -495,7 +528,7 @@ static void internal_handle_server_communication(NetClientState nc_state, AppSta
         return;
 
     // Send state updates periodically
-    Uint64 current_time = SDL_GetTicks();
+    Uint64 current_time = SimClock_GetTicks(nc_state->clock);
     if (nc_state->my_client_id >= 0 && current_time > nc_state->last_state_send_time + STATE_UPDATE_INTERVAL_MS)
     {
         internal_send_local_player_state(nc_state, state);
@@ -526,7 +559,11 @@ static void net_client_update_callback(EntityManager manager, AppState *state)
     switch (nc_state->network_status)
     {
     case CLIENT_STATUS_DISCONNECTED:
-        if (!nc_state->server_address_resolved)
+        if (nc_state->shm_name[0] != '\0')
+        {
+            internal_attempt_shm_connection(nc_state);
+        }
+        else if (!nc_state->server_address_resolved)
         {
             internal_attempt_resolve(nc_state);
         }
@@ -583,14 +620,27 @@ NetClientState NetClient_Init(AppState *state, const char *hostname)
     strncpy(nc_state->hostname, hostname, MAX_NAME_LENGTH - 1);
     nc_state->hostname[MAX_NAME_LENGTH - 1] = '\0'; // Ensure null-termination
 
+    // Attach through shared memory instead of TCP when --shm was given
+    if (state->shm_name)
+    {
+        strncpy(nc_state->shm_name, state->shm_name, MAX_NAME_LENGTH - 1);
+        nc_state->shm_name[MAX_NAME_LENGTH - 1] = '\0';
+    }
+
     nc_state->network_status = CLIENT_STATUS_DISCONNECTED;
     nc_state->server_address_resolved = NULL;
+    nc_state->pending_socket = NULL;
     nc_state->server_connection = NULL;
     nc_state->my_client_id = -1;
     nc_state->last_state_send_time = 0;
+    nc_state->clock = state->clock;
 
     EntityFunctions net_client_funcs = {
         .name = "net_client",
+        .update_phase = ENTITY_PHASE_NETWORK_IN,
+        .game_states = ENTITY_IN_ALL_STATES,
+        .reads = ENTITY_RES_ALL, // Message handlers reach into every module
+        .writes = ENTITY_RES_ALL,
         .update = net_client_update_callback,
         .cleanup = net_client_cleanup_callback,
         .render = NULL,
@@ -613,11 +663,17 @@ void NetClient_Destroy(NetClientState nc_state)
         return;
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Destroying NetClientState...");
+    NetMessage_LogStats("[Client]", nc_state->message_stats);
     if (nc_state->server_connection != NULL)
     {
-        SDLNet_DestroyStreamSocket(nc_state->server_connection);
+        NetConnection_Destroy(nc_state->server_connection);
         nc_state->server_connection = NULL;
     }
+    if (nc_state->pending_socket != NULL)
+    {
+        SDLNet_DestroyStreamSocket(nc_state->pending_socket);
+        nc_state->pending_socket = NULL;
+    }
     if (nc_state->server_address_resolved != NULL)
     {
         SDLNet_UnrefAddress(nc_state->server_address_resolved);
@@ -630,6 +686,23 @@ void NetClient_Destroy(NetClientState nc_state)
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "NetClientState container destroyed.");
 }
 
+const NetMessageStats *NetClient_GetMessageStats(NetClientState nc_state)
+{
+    return nc_state ? nc_state->message_stats : NULL;
+}
+
+int NetClient_DiscardPending(NetClientState nc_state)
+{
+    if (!nc_state || nc_state->network_status != CLIENT_STATUS_CONNECTED || !nc_state->server_connection)
+        return 0;
+
+    char buffer[BUFFER_SIZE];
+    int dropped = 0;
+    while (NetConnection_Read(nc_state->server_connection, buffer, sizeof(buffer)) > 0)
+        dropped++;
+    return dropped;
+}
+
 int NetClient_GetClientID(NetClientState nc_state)
 {
     return nc_state ? nc_state->my_client_id : -1;
@@ -657,77 +730,44 @@ bool NetClient_SendSpawnAttackRequest(NetClientState nc_state, AttackType type,
     return NetClient_SendBuffer(nc_state, &msg, sizeof(Msg_ClientSpawnAttackData));
 }
 
-bool NetClient_SendDamagePlayerRequest(NetClientState nc_state, int playerIndex, float damageValue)
+bool NetClient_SendDamageBatch(NetClientState nc_state, const Msg_DamageBatch *batch)
 {
-    if (!NetClient_IsConnected(nc_state))
+    if (!NetClient_IsConnected(nc_state) || !batch)
     {
         return false;
     }
 
-    Msg_DamagePlayer msg;
-    msg.message_type = MSG_TYPE_C_DAMAGE_PLAYER;
-    msg.playerIndex = playerIndex;
-    msg.damageValue = damageValue;
-
-    return NetClient_SendBuffer(nc_state, &msg, sizeof(Msg_DamagePlayer));
+    return NetClient_SendBuffer(nc_state, batch, sizeof(Msg_DamageBatch));
 }
 
-bool NetClient_SendDamageMinionRequest(NetClientState nc_state, int minionIndex, float sentCurrentHealth)
-{
-    if (!NetClient_IsConnected(nc_state))
-    {
-        return false;
-    }
-    Msg_DamageMinion msg;
-    msg.message_type = MSG_TYPE_C_DAMAGE_MINION;
-    msg.minionIndex = minionIndex;
-    msg.current_health = sentCurrentHealth;
-    return NetClient_SendBuffer(nc_state, &msg, sizeof(Msg_DamageMinion));
-}
-
-bool NetClient_SendDamageTowerRequest(NetClientState nc_state, int towerIndex, float damageValue, float current_health)
+bool NetClient_SendMatchResult(NetClientState nc_state, bool winningTeam)
 {
     if (!NetClient_IsConnected(nc_state))
     {
         return false;
     }
 
-    Msg_DamageTower msg;
-    msg.message_type = MSG_TYPE_C_DAMAGE_TOWER;
-    msg.towerIndex = towerIndex;
-    msg.damageValue = damageValue;
-    msg.current_health = current_health;
-
-    return NetClient_SendBuffer(nc_state, &msg, sizeof(Msg_DamageTower));
-}
-
-bool NetClient_SendDamageBaseRequest(NetClientState nc_state, int baseIndex, float damageValue)
-{
-    if (!NetClient_IsConnected(nc_state))
-    {
-        return false;
-    }
+    Msg_MatchResult msg;
+    msg.message_type = MSG_TYPE_C_MATCH_RESULT;
+    msg.winningTeam = winningTeam;
 
-    Msg_DamageBase msg;
-    msg.message_type = MSG_TYPE_C_DAMAGE_BASE;
-    msg.baseIndex = baseIndex;
-    msg.damageValue = damageValue;
+    SDL_Log("NetClient_SendMatchResult %d", msg.winningTeam);
 
-    return NetClient_SendBuffer(nc_state, &msg, sizeof(Msg_DamageBase));
+    return NetClient_SendBuffer(nc_state, &msg, sizeof(Msg_MatchResult));
 }
 
-bool NetClient_SendMatchResult(NetClientState nc_state, bool winningTeam)
+bool NetClient_SendDesyncReport(NetClientState nc_state, uint32_t server_time, uint8_t sections)
 {
     if (!NetClient_IsConnected(nc_state))
     {
         return false;
     }
 
-    Msg_MatchResult msg;
-    msg.message_type = MSG_TYPE_C_MATCH_RESULT;
-    msg.winningTeam = winningTeam;
+    Msg_DesyncReport msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.message_type = MSG_TYPE_C_DESYNC_REPORT;
+    msg.sections = sections;
+    msg.server_time = server_time;
 
-    SDL_Log("NetClient_SendMatchResult %d", msg.winningTeam);
-
-    return NetClient_SendBuffer(nc_state, &msg, sizeof(Msg_MatchResult));
+    return NetClient_SendBuffer(nc_state, &msg, sizeof(Msg_DesyncReport));
 }
\ No newline at end of file
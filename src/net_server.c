@@ -1,4 +1,5 @@
 #include "../include/net_server.h"
+#include "../include/desync.h"
 
 // --- Internal Structures ---
 
@@ -17,9 +18,9 @@ typedef enum ServerClientStatus
  */
 typedef struct ServerClientInfo
 {
-    SDLNet_StreamSocket *socket; /**< The communication socket for this client. */
-    ServerClientStatus status;   /**< The current status of this client connection. */
-    uint8_t client_id;           /**< The unique ID assigned to this client. */
+    NetConnection connection;  /**< The connection (TCP or shared memory) to this client. */
+    ServerClientStatus status; /**< The current status of this client connection. */
+    uint8_t client_id;         /**< The unique ID assigned to this client. */
 } ServerClientInfo;
 
 /**
@@ -28,8 +29,10 @@ typedef struct ServerClientInfo
 struct NetServerState_s
 {
     SDLNet_Server *listen_socket;          /**< The main server socket listening for new connections. */
+    NetShmListener shm_listener;           /**< Shared-memory segment for local processes, or NULL if disabled. */
     ServerClientInfo clients[MAX_CLIENTS]; /**< Array holding information for each potential client slot. */
     int connected_clients_count;           /**< Current number of clients in ACCEPTED or WELCOMED state. */
+    NetMessageStats message_stats[NET_MESSAGE_TYPE_COUNT]; /**< Receive counters per message type. */
 };
 
 // --- Static Helper Functions ---
@@ -63,11 +66,11 @@ static int find_inactive_client_slot(NetServerState ns_state)
  */
 static bool send_to_client(ServerClientInfo *client_info, const void *buffer, int length)
 {
-    if (!client_info || client_info->status == CLIENT_STATE_INACTIVE || !client_info->socket)
+    if (!client_info || client_info->status == CLIENT_STATE_INACTIVE || !client_info->connection)
     {
         return false;
     }
-    if (!SDLNet_WriteToStreamSocket(client_info->socket, buffer, length))
+    if (!NetConnection_Write(client_info->connection, buffer, length))
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server] Send failed to client ID %u: %s.", (unsigned int)client_info->client_id, SDL_GetError());
         return false;
@@ -109,10 +112,10 @@ static void disconnect_client(NetServerState ns_state, int client_index)
         ns_state->connected_clients_count--;
     }
 
-    if (client_info->socket)
+    if (client_info->connection)
     {
-        SDLNet_DestroyStreamSocket(client_info->socket);
-        client_info->socket = NULL;
+        NetConnection_Destroy(client_info->connection);
+        client_info->connection = NULL;
     }
 
     // Only notify others if the client was fully connected (WELCOMED)
@@ -157,248 +160,250 @@ static void internal_broadcast_message_impl(NetServerState ns_state, const void
     }
 }
 
+// --- Message Handlers ---
+
 /**
- * @brief Processes a message received from a specific client based on its type.
- * Handles C_HELLO, C_PLAYER_STATE, and C_SPAWN_ATTACK messages.
- * @param ns_state The NetServerState instance.
- * @param client_index The index of the sending client.
- * @param buffer Pointer to the received data buffer.
- * @param bytesReceived Number of bytes in the buffer.
- * @param state Pointer to the main AppState.
+ * @brief Signature of a server-side message handler referenced from NET_MESSAGE_SCHEMA.
+ * The dispatcher has already checked the client's state and the message size and copied
+ * the message into @p msg.
+ * @return True if the message was accepted (and may be relayed), false to drop it.
  */
-static void internal_process_client_message(NetServerState ns_state, int client_index, char *buffer, int bytesReceived, AppState *state)
-{
-    if (!ns_state || client_index < 0 || client_index >= MAX_CLIENTS || ns_state->clients[client_index].status == CLIENT_STATE_INACTIVE || bytesReceived < (int)sizeof(uint8_t) || !state)
-    {
-        return;
-    }
+typedef bool (*ServerMessageHandler)(NetServerState ns_state, int client_index, NetMessagePayload *msg, AppState *state);
 
+static bool server_on_hello(NetServerState ns_state, int client_index, NetMessagePayload *msg, AppState *state)
+{
+    (void)msg;
+    (void)state;
     ServerClientInfo *client_info = &ns_state->clients[client_index];
-    uint8_t msg_type_byte = (uint8_t)buffer[0];
     uint8_t sender_id = client_info->client_id;
 
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Server] Processing msg type %u from client %u (status: %d)", (unsigned int)msg_type_byte, (unsigned int)sender_id, client_info->status);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_HELLO from client ID %u. Sending S_WELCOME.", (unsigned int)sender_id);
+    Msg_WelcomeData welcome_msg;
+    welcome_msg.message_type = MSG_TYPE_S_WELCOME;
+    welcome_msg.assigned_client_id = sender_id;
 
-    switch ((MessageType)msg_type_byte)
+    if (!send_to_client(client_info, &welcome_msg, sizeof(welcome_msg)))
     {
-    case MSG_TYPE_C_HELLO:
-        if (client_info->status != CLIENT_STATE_ACCEPTED)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_HELLO from client ID %u in unexpected state (%d). Ignoring.", (unsigned int)sender_id, client_info->status);
-            break;
-        }
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_HELLO from client ID %u. Sending S_WELCOME.", (unsigned int)sender_id);
-        Msg_WelcomeData welcome_msg;
-        welcome_msg.message_type = MSG_TYPE_S_WELCOME;
-        welcome_msg.assigned_client_id = sender_id;
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Failed to send S_WELCOME to client ID %u after C_HELLO. Disconnecting.", (unsigned int)sender_id);
+        disconnect_client(ns_state, client_index);
+        return false;
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Server] S_WELCOME sent successfully to client ID %u. Setting state to WELCOMED.", (unsigned int)sender_id);
+    client_info->status = CLIENT_STATE_WELCOMED;
+    return true;
+}
 
-        if (send_to_client(client_info, &welcome_msg, sizeof(welcome_msg)))
-        {
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Server] S_WELCOME sent successfully to client ID %u. Setting state to WELCOMED.", (unsigned int)sender_id);
-            client_info->status = CLIENT_STATE_WELCOMED;
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Failed to send S_WELCOME to client ID %u after C_HELLO. Disconnecting.", (unsigned int)sender_id);
-            disconnect_client(ns_state, client_index);
-        }
-        break;
+static bool server_on_player_state(NetServerState ns_state, int client_index, NetMessagePayload *msg, AppState *state)
+{
+    (void)state;
+    uint8_t sender_id = ns_state->clients[client_index].client_id;
+    if (msg->as_C_PLAYER_STATE.client_id != sender_id)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received PLAYER_STATE from client %u claiming to be %u. Ignoring.", (unsigned int)sender_id, (unsigned int)msg->as_C_PLAYER_STATE.client_id);
+        return false;
+    }
+    return true;
+}
 
-    case MSG_TYPE_C_PLAYER_STATE:
-        if (client_info->status != CLIENT_STATE_WELCOMED)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_PLAYER_STATE from client ID %u not in WELCOMED state (%d). Ignoring.", (unsigned int)sender_id, client_info->status);
-            break;
-        }
-        if (bytesReceived >= (int)sizeof(Msg_PlayerStateData))
-        {
-            Msg_PlayerStateData state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_PlayerStateData));
+static bool server_on_spawn_attack(NetServerState ns_state, int client_index, NetMessagePayload *msg, AppState *state)
+{
+    if (!state->attack_manager)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server] AttackManager is NULL when processing C_SPAWN_ATTACK.");
+        return false;
+    }
+    AttackManager_HandleClientSpawnRequest(state->attack_manager, state, ns_state->clients[client_index].client_id, msg->as_C_SPAWN_ATTACK);
+    return true;
+}
 
-            if (state_data.client_id != sender_id)
-            {
-                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received PLAYER_STATE from client %u claiming to be %u. Ignoring.", (unsigned int)sender_id, (unsigned int)state_data.client_id);
-                break;
-            }
-            state_data.message_type = MSG_TYPE_S_PLAYER_STATE; // Change type for broadcast
-            NetServer_BroadcastMessage(ns_state, &state_data, sizeof(Msg_PlayerStateData), client_index);
-        }
-        else
+static bool server_on_damage_batch(NetServerState ns_state, int client_index, NetMessagePayload *msg, AppState *state)
+{
+    const Msg_DamageBatch *batch = &msg->as_C_DAMAGE_BATCH;
+    if (batch->count > MSG_DAMAGE_BATCH_MAX)
+    {
+        return false;
+    }
+    // Minions are simulated on the server only; the result reaches clients with the next state batch.
+    // The other entries are relayed to the remaining clients. Hits on players are also remembered
+    // for the towers, which defend players of their team.
+    for (int i = 0; i < batch->count; i++)
+    {
+        if (batch->kind[i] == DAMAGE_TARGET_MINION)
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd incomplete C_PLAYER_STATE msg from client %u (%d bytes, needed %lu)", (unsigned int)sender_id, bytesReceived, (unsigned long)sizeof(Msg_PlayerStateData));
+            DamageBus_PushRemote(state->damage_bus, DAMAGE_TARGET_MINION, batch->target[i], batch->damage[i], 0.0f);
         }
-        break;
-
-    case MSG_TYPE_C_SPAWN_ATTACK:
-        if (client_info->status != CLIENT_STATE_WELCOMED)
+        else if (batch->kind[i] == DAMAGE_TARGET_PLAYER)
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_SPAWN_ATTACK from client ID %u not in WELCOMED state (%d). Ignoring.", (unsigned int)sender_id, client_info->status);
-            break;
+            PlayerManager_RecordPlayerHit(state, ns_state->clients[client_index].client_id, batch->target[i]);
         }
-        if (bytesReceived >= (int)sizeof(Msg_ClientSpawnAttackData))
-        {
-            Msg_ClientSpawnAttackData req_data;
-            memcpy(&req_data, buffer, sizeof(Msg_ClientSpawnAttackData));
+    }
+    return true;
+}
 
-            if (state->attack_manager)
-            {
-                AttackManager_HandleClientSpawnRequest(state->attack_manager, state, sender_id, req_data);
-            }
-            else
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server] AttackManager is NULL when processing C_SPAWN_ATTACK.");
-            }
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd incomplete C_SPAWN_ATTACK msg from client %u (%d bytes, needed %lu)", (unsigned int)sender_id, bytesReceived, (unsigned long)sizeof(Msg_ClientSpawnAttackData));
-        }
-        break;
+static bool server_on_desync_report(NetServerState ns_state, int client_index, NetMessagePayload *msg, AppState *state)
+{
+    Desync_HandleReport(state, ns_state->clients[client_index].client_id, &msg->as_C_DESYNC_REPORT);
+    return true;
+}
 
-    case MSG_TYPE_C_DAMAGE_PLAYER:
-        if (client_info->status != CLIENT_STATE_WELCOMED)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_DAMAGE_PLAYER from client ID %u not in WELCOMED state (%d). Ignoring.", (unsigned int)sender_id, client_info->status);
-            break;
-        }
-        if (bytesReceived >= (int)sizeof(Msg_DamagePlayer))
-        {
-            Msg_DamagePlayer state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_DamagePlayer));
+// --- Dispatch Table ---
 
-            state_data.message_type = MSG_TYPE_S_DAMAGE_PLAYER; // Change type for broadcast
-            NetServer_BroadcastMessage(ns_state, &state_data, sizeof(Msg_DamagePlayer), client_index);
-        }
-        else
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd incomplete C_DAMAGE_PLAYER msg from client %u (%d bytes, needed %lu)", (unsigned int)sender_id, bytesReceived, (unsigned long)sizeof(Msg_DamagePlayer));
-        }
-        break;
+/** Handlers for client-to-server messages, indexed by type byte. Generated from NET_MESSAGE_SCHEMA. */
+#define NET_SERVER_ROUTE_C2S(name, handler) [MSG_TYPE_##name] = handler,
+#define NET_SERVER_ROUTE_S2C(name, handler)
+#define NET_SERVER_ROUTE(name, id, payload, direction, requires, relay, handler) NET_SERVER_ROUTE_##direction(name, handler)
+static const ServerMessageHandler server_handlers[NET_MESSAGE_TYPE_COUNT] = {
+    NET_MESSAGE_SCHEMA(NET_SERVER_ROUTE)};
+#undef NET_SERVER_ROUTE
+#undef NET_SERVER_ROUTE_S2C
+#undef NET_SERVER_ROUTE_C2S
 
-    case MSG_TYPE_C_DAMAGE_MINION:
-        if (client_info->status != CLIENT_STATE_WELCOMED)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_DAMAGE_MINION from client ID %u not in WELCOMED state (%d). Ignoring.", (unsigned int)sender_id, client_info->status);
-            break;
-        }
-        if (bytesReceived >= (int)sizeof(Msg_DamageMinion))
-        {
-            Msg_DamageMinion state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_DamageMinion));
+SDL_COMPILE_TIME_ASSERT(server_payload_fits_buffer, sizeof(NetMessagePayload) <= BUFFER_SIZE);
 
-            state_data.message_type = MSG_TYPE_S_DAMAGE_MINION;     // Change type for broadcast
-            NetServer_BroadcastMessage(ns_state, &state_data, sizeof(Msg_DamageMinion), client_index);
-        }
-        else 
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd incomplete C_DAMAGE_MINION msg from client %u (%d bytes, needed %lu)", (unsigned int)sender_id, bytesReceived, (unsigned long)sizeof(Msg_DamageMinion));
-        }
-        break;
+/**
+ * @brief Checks a client's handshake state against a schema requirement.
+ */
+static bool client_meets_requirement(const ServerClientInfo *client_info, uint8_t requirement)
+{
+    switch ((NetMessageRequirement)requirement)
+    {
+    case NET_REQ_ACCEPTED:
+        return client_info->status == CLIENT_STATE_ACCEPTED;
+    case NET_REQ_WELCOMED:
+        return client_info->status == CLIENT_STATE_WELCOMED;
+    default:
+        return true;
+    }
+}
+
+/**
+ * @brief Processes every message contained in a buffer received from a specific client.
+ * Each message is checked against its schema entry (direction, client state, size), passed
+ * to its handler and, if the schema says so, relayed to the other clients under its server type.
+ * @param ns_state The NetServerState instance.
+ * @param client_index The index of the sending client.
+ * @param buffer Pointer to the received data buffer.
+ * @param bytesReceived Number of bytes in the buffer.
+ * @param state Pointer to the main AppState.
+ */
+static void internal_process_client_buffer(NetServerState ns_state, int client_index, const char *buffer, int bytesReceived, AppState *state)
+{
+    if (!ns_state || client_index < 0 || client_index >= MAX_CLIENTS || !state)
+    {
+        return;
+    }
 
+    ServerClientInfo *client_info = &ns_state->clients[client_index];
+    int offset = 0;
+    while (offset < bytesReceived && client_info->status != CLIENT_STATE_INACTIVE)
+    {
+        uint8_t msg_type_byte = (uint8_t)buffer[offset];
+        const NetMessageInfo *info = NetMessage_GetInfo(msg_type_byte);
+        NetMessageStats *stats = &ns_state->message_stats[msg_type_byte];
 
-    case MSG_TYPE_C_DAMAGE_TOWER:
-        if (client_info->status != CLIENT_STATE_WELCOMED)
+        if (!info || info->direction != NET_DIR_C2S)
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_DAMAGE_TOWER from client ID %u not in WELCOMED state (%d). Ignoring.", (unsigned int)sender_id, client_info->status);
-            break;
-        }
-        if (bytesReceived >= (int)sizeof(Msg_DamageTower))
-        {
-            Msg_DamageTower state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_DamageTower));
-
-            state_data.message_type = MSG_TYPE_S_DAMAGE_TOWER; // Change type for broadcast
-            NetServer_BroadcastMessage(ns_state, &state_data, sizeof(Msg_DamageTower), client_index);
+            // Without a schema entry the next message boundary is unknown, so drop the rest.
+            stats->dropped++;
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd unknown message type (%u) from client %u", (unsigned int)msg_type_byte, (unsigned int)client_info->client_id);
+            return;
         }
-        else
+        if (bytesReceived - offset < (int)info->size)
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd incomplete C_DAMAGE_TOWER msg from client %u (%d bytes, needed %lu)", (unsigned int)sender_id, bytesReceived, (unsigned long)sizeof(Msg_DamageTower));
+            stats->dropped++;
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd incomplete %s msg from client %u (%d bytes, needed %u)", info->name, (unsigned int)client_info->client_id, bytesReceived - offset, (unsigned int)info->size);
+            return;
         }
-        break;
 
-    case MSG_TYPE_C_DAMAGE_BASE:
-        if (client_info->status != CLIENT_STATE_WELCOMED)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_DAMAGE_BASE from client ID %u not in WELCOMED state (%d). Ignoring.", (unsigned int)sender_id, client_info->status);
-            break;
-        }
-        if (bytesReceived >= (int)sizeof(Msg_DamageBase))
-        {
-            Msg_DamageBase state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_DamageBase));
+        NetMessagePayload msg;
+        memcpy(&msg, &buffer[offset], info->size);
+        offset += info->size;
 
-            state_data.message_type = MSG_TYPE_S_DAMAGE_BASE; // Change type for broadcast
-            NetServer_BroadcastMessage(ns_state, &state_data, sizeof(Msg_DamageBase), client_index);
-        }
-        else
+        if (!client_meets_requirement(client_info, info->requirement))
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd incomplete C_DAMAGE_BASE msg from client %u (%d bytes, needed %lu)", (unsigned int)sender_id, bytesReceived, (unsigned long)sizeof(Msg_DamageBase));
+            stats->dropped++;
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received %s from client ID %u in unexpected state (%d). Ignoring.", info->name, (unsigned int)client_info->client_id, client_info->status);
+            continue;
         }
-        break;
 
-    case MSG_TYPE_C_MATCH_RESULT:
-        if (client_info->status != CLIENT_STATE_WELCOMED)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Received C_MATCH_RESULT from client ID %u not in WELCOMED state (%d). Ignoring.", (unsigned int)sender_id, client_info->status);
-            break;
-        }
-        if (bytesReceived >= (int)sizeof(Msg_MatchResult))
+        ServerMessageHandler handler = server_handlers[msg_type_byte];
+        if (handler && !handler(ns_state, client_index, &msg, state))
         {
-            Msg_MatchResult state_data;
-            memcpy(&state_data, buffer, sizeof(Msg_MatchResult));
-            state_data.message_type = MSG_TYPE_S_GAME_RESULT; // Change type for broadcast
-            NetServer_BroadcastMessage(ns_state, &state_data, sizeof(Msg_MatchResult), client_index);
+            stats->dropped++;
+            continue;
         }
-        else
+        stats->handled++;
+        stats->bytes += info->size;
+
+        if (info->relay_type != MSG_TYPE_INVALID)
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd incomplete C_MATCH_RESULT msg from client %u (%d bytes, needed %lu)", (unsigned int)sender_id, bytesReceived, (unsigned long)sizeof(Msg_MatchResult));
+            msg.message_type = info->relay_type; // Change type for broadcast
+            NetServer_BroadcastMessage(ns_state, &msg, info->size, client_index);
         }
-        break;
-
-    default:
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rcvd unknown message type (%u) from client %u", (unsigned int)msg_type_byte, (unsigned int)sender_id);
-        break;
     }
 }
 
 /**
- * @brief Checks for and accepts a new client connection if a slot is available.
+ * @brief Assigns a freshly accepted connection to a free client slot.
  * Assigns a client ID and sets the initial state to ACCEPTED.
  * @param ns_state The NetServerState instance.
+ * @param connection The new connection. Destroyed if the server is full.
+ */
+static void register_new_client(NetServerState ns_state, NetConnection connection)
+{
+    int client_index = find_inactive_client_slot(ns_state);
+    if (client_index == -1)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rejected new client connection: Server full.");
+        NetConnection_Destroy(connection);
+        return;
+    }
+
+    ServerClientInfo *client_info = &ns_state->clients[client_index];
+    client_info->connection = connection;
+    client_info->status = CLIENT_STATE_ACCEPTED;
+    client_info->client_id = (uint8_t)client_index; // Use index as ID for simplicity
+    ns_state->connected_clients_count++;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Server] Accepted new %s client connection, assigned ID %u at index %d. Waiting for C_HELLO.",
+                NetConnection_GetKind(connection) == NET_TRANSPORT_SHM ? "shared-memory" : "TCP", (unsigned int)client_info->client_id, client_index);
+}
+
+/**
+ * @brief Checks for and accepts new client connections on every enabled transport.
+ * @param ns_state The NetServerState instance.
  * @param state The main AppState instance (unused in this function).
  */
 static void accept_new_client(NetServerState ns_state, AppState *state)
 {
     (void)state; // state is not directly used here but might be needed in future extensions
-    if (!ns_state || !ns_state->listen_socket)
+    if (!ns_state)
         return;
 
+    // Servers started with shm_only have no TCP port; their shared-memory clients are still accepted below.
     SDLNet_StreamSocket *new_client_socket = NULL;
-
-    if (SDLNet_AcceptClient(ns_state->listen_socket, &new_client_socket))
+    if (ns_state->listen_socket)
     {
-        if (new_client_socket != NULL)
+        if (SDLNet_AcceptClient(ns_state->listen_socket, &new_client_socket))
         {
-            int client_index = find_inactive_client_slot(ns_state);
-            if (client_index != -1)
-            {
-                ServerClientInfo *client_info = &ns_state->clients[client_index];
-                client_info->socket = new_client_socket;
-                client_info->status = CLIENT_STATE_ACCEPTED;
-                client_info->client_id = (uint8_t)client_index; // Use index as ID for simplicity
-                ns_state->connected_clients_count++;
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Server] Accepted new client connection, assigned ID %u at index %d. Waiting for C_HELLO.", (unsigned int)client_info->client_id, client_index);
-            }
-            else
+            if (new_client_socket != NULL)
             {
-                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] Rejected new client connection: Server full.");
-                SDLNet_DestroyStreamSocket(new_client_socket);
+                NetConnection connection = NetConnection_FromStreamSocket(new_client_socket);
+                if (connection)
+                {
+                    register_new_client(ns_state, connection);
+                }
             }
         }
+        else
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server] SDLNet_AcceptClient failed: %s", SDL_GetError());
+        }
     }
-    else
+
+    NetConnection shm_connection;
+    while (ns_state->shm_listener && (shm_connection = NetShm_Accept(ns_state->shm_listener)) != NULL)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server] SDLNet_AcceptClient failed: %s", SDL_GetError());
+        register_new_client(ns_state, shm_connection);
     }
 }
 
@@ -428,11 +433,11 @@ static void receive_from_all_clients(NetServerState ns_state, AppState *state)
         while (client_info->status != CLIENT_STATE_INACTIVE && bytesReceived > 0)
         {
             SDL_ClearError();
-            bytesReceived = SDLNet_ReadFromStreamSocket(client_info->socket, buffer, sizeof(buffer));
+            bytesReceived = NetConnection_Read(client_info->connection, buffer, sizeof(buffer));
 
             if (bytesReceived > 0)
             {
-                internal_process_client_message(ns_state, i, buffer, bytesReceived, state);
+                internal_process_client_buffer(ns_state, i, buffer, bytesReceived, state);
                 // Check status again in case processing caused disconnect
                 if (client_info->status == CLIENT_STATE_INACTIVE)
                 {
@@ -534,24 +539,47 @@ NetServerState NetServer_Init(AppState *state)
     }
 
     ns_state->listen_socket = NULL;
+    ns_state->shm_listener = NULL;
     ns_state->connected_clients_count = 0;
     for (int i = 0; i < MAX_CLIENTS; ++i)
     {
         ns_state->clients[i].status = CLIENT_STATE_INACTIVE;
-        ns_state->clients[i].socket = NULL;
+        ns_state->clients[i].connection = NULL;
     }
 
-    ns_state->listen_socket = SDLNet_CreateServer(NULL, SERVER_PORT);
-    if (!ns_state->listen_socket)
+    // Servers that only serve local tools leave the port to others in the same process.
+    if (!state->shm_only || !state->shm_name)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server Init] SDLNet_CreateServer failed: %s", SDL_GetError());
-        SDL_free(ns_state);
-        return NULL;
+        ns_state->listen_socket = SDLNet_CreateServer(NULL, SERVER_PORT);
+        if (!ns_state->listen_socket)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server Init] SDLNet_CreateServer failed: %s", SDL_GetError());
+            SDL_free(ns_state);
+            return NULL;
+        }
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Server] Listening on port %d...", SERVER_PORT);
+    }
+
+    // Local bots and tools can additionally attach through shared memory.
+    if (state->shm_name)
+    {
+        ns_state->shm_listener = NetShm_CreateListener(state->shm_name);
+        if (!ns_state->shm_listener)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server Init] NetShm_CreateListener failed: %s", SDL_GetError());
+            if (ns_state->listen_socket)
+                SDLNet_DestroyServer(ns_state->listen_socket);
+            SDL_free(ns_state);
+            return NULL;
+        }
     }
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Server] Listening on port %d...", SERVER_PORT);
 
     EntityFunctions net_server_funcs = {
         .name = "net_server",
+        .update_phase = ENTITY_PHASE_NETWORK_IN,
+        .game_states = ENTITY_IN_ALL_STATES,
+        .reads = ENTITY_RES_ALL, // Message handlers reach into every module
+        .writes = ENTITY_RES_ALL,
         .update = net_server_update_callback,
         .cleanup = net_server_cleanup_callback,
         .render = NULL,
@@ -562,6 +590,7 @@ NetServerState NetServer_Init(AppState *state)
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Server Init] Failed to add entity to manager: %s", SDL_GetError());
         if (ns_state->listen_socket)
             SDLNet_DestroyServer(ns_state->listen_socket);
+        NetShm_DestroyListener(ns_state->shm_listener);
         SDL_free(ns_state);
         return NULL;
     }
@@ -576,15 +605,16 @@ void NetServer_Destroy(NetServerState ns_state)
         return;
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Destroying NetServerState...");
+    NetMessage_LogStats("[Server]", ns_state->message_stats);
 
     for (int i = 0; i < MAX_CLIENTS; ++i)
     {
         if (ns_state->clients[i].status != CLIENT_STATE_INACTIVE)
         {
-            if (ns_state->clients[i].socket)
+            if (ns_state->clients[i].connection)
             {
-                SDLNet_DestroyStreamSocket(ns_state->clients[i].socket);
-                ns_state->clients[i].socket = NULL;
+                NetConnection_Destroy(ns_state->clients[i].connection);
+                ns_state->clients[i].connection = NULL;
             }
             ns_state->clients[i].status = CLIENT_STATE_INACTIVE;
         }
@@ -596,6 +626,10 @@ void NetServer_Destroy(NetServerState ns_state)
         ns_state->listen_socket = NULL;
     }
 
+    // Connections accepted from the segment were destroyed above.
+    NetShm_DestroyListener(ns_state->shm_listener);
+    ns_state->shm_listener = NULL;
+
     SDL_free(ns_state);
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "NetServerState container destroyed.");
 }
@@ -604,3 +638,43 @@ void NetServer_BroadcastMessage(NetServerState ns_state, const void *buffer, int
 {
     internal_broadcast_message_impl(ns_state, buffer, length, exclude_client_index);
 }
+
+void NetServer_StartMatch(AppState *state)
+{
+    if (!state || !state->net_server_state)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Server] NetServer_StartMatch called without a running server.");
+        return;
+    }
+
+    SDL_Log("Host selected 'start'. Transitioning to GAME_STATE_PLAYING.");
+    CommandBuffer_SetGameState(state->command_buffer, GAME_STATE_PLAYING, false);
+
+    // Broadcast MSG_TYPE_S_GAME_START to all clients
+    Msg_GameStart msg;
+    msg.message_type = MSG_TYPE_S_GAME_START;
+    msg.server_start_time_stamp = SimClock_GetTicks(state->clock);
+    NetServer_BroadcastMessage(state->net_server_state, &msg, sizeof(Msg_GameStart), -1);
+}
+
+const NetMessageStats *NetServer_GetMessageStats(NetServerState ns_state)
+{
+    return ns_state ? ns_state->message_stats : NULL;
+}
+
+int NetServer_DiscardPending(NetServerState ns_state)
+{
+    if (!ns_state)
+        return 0;
+
+    char buffer[BUFFER_SIZE];
+    int dropped = 0;
+    for (int i = 0; i < MAX_CLIENTS; ++i)
+    {
+        if (ns_state->clients[i].status == CLIENT_STATE_INACTIVE)
+            continue;
+        while (NetConnection_Read(ns_state->clients[i].connection, buffer, sizeof(buffer)) > 0)
+            dropped++;
+    }
+    return dropped;
+}
@@ -0,0 +1,733 @@
+#include "../include/net_shm.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NET_SHM_SUPPORTED 1
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+// --- Constants ---
+#define NET_SHM_MAGIC 0x4C6F5453u /**< "LoTS" */
+#define NET_SHM_VERSION 1u
+#define NET_SHM_CACHE_LINE 64
+#define NET_SHM_HEADER_SIZE ((int)sizeof(uint16_t)) /**< Length prefix in front of every message. */
+
+SDL_COMPILE_TIME_ASSERT(shm_ring_pow2, (NET_SHM_RING_SIZE & (NET_SHM_RING_SIZE - 1)) == 0);
+SDL_COMPILE_TIME_ASSERT(shm_message_fits_prefix, BUFFER_SIZE <= 0xFFFF);
+
+// --- Internal Structures ---
+
+/**
+ * @brief Lifecycle of a client slot inside the segment.
+ */
+typedef enum NetShmSlotStatus
+{
+    NET_SHM_SLOT_FREE = 0,    /**< Nobody uses the slot. */
+    NET_SHM_SLOT_CLAIMED = 1, /**< A client is resetting the rings. */
+    NET_SHM_SLOT_PENDING = 2, /**< The client is ready and waits for the server to accept it. */
+    NET_SHM_SLOT_OPEN = 3,    /**< Both sides are attached. */
+    NET_SHM_SLOT_CLOSED = 4   /**< One side of an OPEN slot closed; the other side frees the slot when it closes too. */
+} NetShmSlotStatus;
+
+/**
+ * @brief Single-producer/single-consumer byte ring. Head and tail are free-running
+ * 32-bit counters; each lives on its own cache line to avoid false sharing.
+ */
+typedef struct NetShmRing
+{
+    SDL_AtomicInt head; /**< Bytes written so far. Owned by the producer. Doubles as the futex word. */
+    char pad0[NET_SHM_CACHE_LINE - sizeof(SDL_AtomicInt)];
+    SDL_AtomicInt tail; /**< Bytes consumed so far. Owned by the consumer. */
+    char pad1[NET_SHM_CACHE_LINE - sizeof(SDL_AtomicInt)];
+    SDL_AtomicInt waiting; /**< Non-zero while the consumer sleeps in wait_readable. */
+    char pad2[NET_SHM_CACHE_LINE - sizeof(SDL_AtomicInt)];
+    uint8_t data[NET_SHM_RING_SIZE];
+} NetShmRing;
+
+/**
+ * @brief One client's pair of rings.
+ */
+typedef struct NetShmSlot
+{
+    SDL_AtomicInt status; /**< NetShmSlotStatus. */
+    char pad[NET_SHM_CACHE_LINE - sizeof(SDL_AtomicInt)];
+    NetShmRing to_server; /**< Client -> server messages. */
+    NetShmRing to_client; /**< Server -> client messages. */
+} NetShmSlot;
+
+/**
+ * @brief Layout of the whole shared-memory object.
+ */
+typedef struct NetShmSegment
+{
+    uint32_t magic;
+    uint32_t version;
+    SDL_AtomicInt server_alive; /**< Cleared when the server destroys the listener. */
+    SDL_AtomicInt server_refs;  /**< Users of the server process's mapping: the listener and every connection on it. */
+    char pad[NET_SHM_CACHE_LINE - 2 * sizeof(uint32_t) - 2 * sizeof(SDL_AtomicInt)];
+    NetShmSlot slots[MAX_CLIENTS];
+} NetShmSegment;
+
+/**
+ * @brief Backend state of one end of a shared-memory connection.
+ */
+typedef struct NetShmConnection
+{
+    NetShmSegment *segment; /**< Mapped segment. */
+    bool owns_mapping;      /**< True on the client side of a POSIX segment, which maps it per connection. */
+    bool is_local;          /**< True for a process-local segment. */
+    bool holds_ref;         /**< True if the connection uses the server process's mapping and holds one of its server_refs. */
+    NetShmSlot *slot;       /**< Slot used by this connection. */
+    NetShmRing *tx;         /**< Ring this end produces into. */
+    NetShmRing *rx;         /**< Ring this end consumes from. */
+    uint8_t *backlog;       /**< Length-prefixed messages that did not fit into tx yet, oldest first. */
+    int backlog_bytes;      /**< Bytes in backlog. */
+    int backlog_capacity;   /**< Bytes allocated for backlog. */
+} NetShmConnection;
+
+/**
+ * @brief Internal state for the NetShmListener.
+ */
+struct NetShmListener_s
+{
+    char path[MAX_NAME_LENGTH];          /**< Full shared-memory object name, or the local name as given. */
+    NetShmSegment *segment;              /**< Mapped (or heap-allocated) segment. */
+    bool is_local;                       /**< True for a process-local segment (name starts with NET_SHM_LOCAL_PREFIX). */
+    struct NetShmListener_s *next_local; /**< Next entry in the process-local registry. */
+};
+
+// --- Static Variables ---
+
+/** Process-local listeners, looked up by name in NetShm_Connect. */
+static NetShmListener local_listeners = NULL;
+/** Guards local_listeners: tools may run a separate match on every thread. */
+static SDL_SpinLock local_listeners_lock = 0;
+
+// --- Static Helper Functions ---
+
+#ifdef NET_SHM_SUPPORTED
+static bool build_shm_path(const char *name, char *out, size_t out_size)
+{
+    if (!name || !name[0] || strchr(name, '/'))
+    {
+        SDL_SetError("Invalid shared-memory name '%s'", name ? name : "(null)");
+        return false;
+    }
+    if (SDL_snprintf(out, out_size, "%s%s", NET_SHM_NAME_PREFIX, name) >= (int)out_size)
+    {
+        SDL_SetError("Shared-memory name '%s' is too long", name);
+        return false;
+    }
+    return true;
+}
+#endif // NET_SHM_SUPPORTED
+
+static bool is_local_name(const char *name)
+{
+    return name && name[0] == NET_SHM_LOCAL_PREFIX;
+}
+
+static void futex_wake(SDL_AtomicInt *word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, &word->value, FUTEX_WAKE, 1, NULL, NULL, 0);
+#else
+    (void)word; // Consumers poll on platforms without futex
+#endif
+}
+
+/**
+ * @brief Sleeps until the futex word no longer holds the expected value or the timeout expires.
+ */
+static void futex_wait(SDL_AtomicInt *word, int expected, Sint32 timeout_ms)
+{
+#if defined(__linux__)
+    struct timespec ts;
+    struct timespec *ts_ptr = NULL;
+    if (timeout_ms >= 0)
+    {
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+        ts_ptr = &ts;
+    }
+    syscall(SYS_futex, &word->value, FUTEX_WAIT, expected, ts_ptr, NULL, 0);
+#else
+    (void)expected;
+    SDL_Delay(timeout_ms < 0 || timeout_ms > 1 ? 1 : (Uint32)timeout_ms);
+    (void)word;
+#endif
+}
+
+static void ring_reset(NetShmRing *ring)
+{
+    SDL_SetAtomicInt(&ring->head, 0);
+    SDL_SetAtomicInt(&ring->tail, 0);
+    SDL_SetAtomicInt(&ring->waiting, 0);
+}
+
+static void ring_copy_in(NetShmRing *ring, Uint32 pos, const void *src, int length)
+{
+    Uint32 offset = pos & (NET_SHM_RING_SIZE - 1);
+    Uint32 first = SDL_min((Uint32)length, NET_SHM_RING_SIZE - offset);
+    memcpy(&ring->data[offset], src, first);
+    memcpy(&ring->data[0], (const uint8_t *)src + first, (Uint32)length - first);
+}
+
+static void ring_copy_out(const NetShmRing *ring, Uint32 pos, void *dst, int length)
+{
+    Uint32 offset = pos & (NET_SHM_RING_SIZE - 1);
+    Uint32 first = SDL_min((Uint32)length, NET_SHM_RING_SIZE - offset);
+    memcpy(dst, &ring->data[offset], first);
+    memcpy((uint8_t *)dst + first, &ring->data[0], (Uint32)length - first);
+}
+
+static bool peer_closed(const NetShmConnection *c)
+{
+    return SDL_GetAtomicInt(&c->slot->status) == NET_SHM_SLOT_CLOSED ||
+           !SDL_GetAtomicInt(&c->segment->server_alive);
+}
+
+/**
+ * @brief Drops one reference to the server process's mapping and releases it with the last one,
+ * so connections may outlive the listener (they then read the server as closed).
+ */
+static void release_server_mapping(NetShmSegment *segment, bool is_local)
+{
+    if (SDL_AddAtomicInt(&segment->server_refs, -1) != 1)
+        return;
+    if (is_local)
+    {
+        SDL_aligned_free(segment);
+        return;
+    }
+#ifdef NET_SHM_SUPPORTED
+    munmap(segment, sizeof(NetShmSegment));
+#endif
+}
+
+/**
+ * @brief Moves the oldest backlogged messages into the ring, as many whole ones as fit.
+ */
+static void flush_backlog(NetShmConnection *c)
+{
+    if (c->backlog_bytes == 0)
+        return;
+
+    NetShmRing *ring = c->tx;
+    Uint32 head = (Uint32)SDL_GetAtomicInt(&ring->head);
+    Uint32 tail = (Uint32)SDL_GetAtomicInt(&ring->tail);
+    Uint32 space = NET_SHM_RING_SIZE - (head - tail);
+    int moved = 0;
+    while (moved < c->backlog_bytes)
+    {
+        uint16_t length;
+        memcpy(&length, c->backlog + moved, NET_SHM_HEADER_SIZE);
+        Uint32 needed = (Uint32)(NET_SHM_HEADER_SIZE + length);
+        if (needed > space)
+            break;
+        ring_copy_in(ring, head, c->backlog + moved, (int)needed);
+        head += needed;
+        space -= needed;
+        moved += (int)needed;
+    }
+    if (moved == 0)
+        return;
+
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicInt(&ring->head, (int)head);
+    if (SDL_GetAtomicInt(&ring->waiting))
+        futex_wake(&ring->head);
+    c->backlog_bytes -= moved;
+    memmove(c->backlog, c->backlog + moved, (size_t)c->backlog_bytes);
+}
+
+/**
+ * @brief Queues a message behind the backlog, to be sent once the peer has read enough.
+ * @return False if the peer is NET_SHM_BACKLOG_LIMIT bytes behind or memory ran out.
+ */
+static bool append_backlog(NetShmConnection *c, const void *buffer, int length)
+{
+    int needed = NET_SHM_HEADER_SIZE + length;
+    if (c->backlog_bytes + needed > NET_SHM_BACKLOG_LIMIT)
+    {
+        SDL_SetError("Shared-memory peer stopped reading (%d bytes waiting)", c->backlog_bytes);
+        return false;
+    }
+    if (c->backlog_bytes + needed > c->backlog_capacity)
+    {
+        int capacity = SDL_max(c->backlog_capacity * 2, NET_SHM_RING_SIZE);
+        uint8_t *backlog = (uint8_t *)SDL_realloc(c->backlog, (size_t)capacity);
+        if (!backlog)
+            return SDL_OutOfMemory();
+        c->backlog = backlog;
+        c->backlog_capacity = capacity;
+    }
+    uint16_t prefix = (uint16_t)length;
+    memcpy(c->backlog + c->backlog_bytes, &prefix, NET_SHM_HEADER_SIZE);
+    memcpy(c->backlog + c->backlog_bytes + NET_SHM_HEADER_SIZE, buffer, (size_t)length);
+    c->backlog_bytes += needed;
+    return true;
+}
+
+// --- Backend Ops ---
+
+static bool shm_write(void *impl, const void *buffer, int length)
+{
+    NetShmConnection *c = (NetShmConnection *)impl;
+    if (length <= 0 || length > BUFFER_SIZE)
+    {
+        SDL_SetError("Shared-memory message of %d bytes is out of range", length);
+        return false;
+    }
+    if (peer_closed(c))
+    {
+        SDL_SetError("Shared-memory peer closed the connection");
+        return false;
+    }
+
+    // A full ring only means the peer is a frame behind: keep the message until it catches up,
+    // behind any older ones so the order holds.
+    flush_backlog(c);
+    NetShmRing *ring = c->tx;
+    Uint32 head = (Uint32)SDL_GetAtomicInt(&ring->head);
+    Uint32 tail = (Uint32)SDL_GetAtomicInt(&ring->tail);
+    Uint32 needed = (Uint32)(NET_SHM_HEADER_SIZE + length);
+    if (c->backlog_bytes > 0 || needed > NET_SHM_RING_SIZE - (head - tail))
+        return append_backlog(c, buffer, length);
+
+    uint16_t prefix = (uint16_t)length;
+    ring_copy_in(ring, head, &prefix, NET_SHM_HEADER_SIZE);
+    ring_copy_in(ring, head + NET_SHM_HEADER_SIZE, buffer, length);
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicInt(&ring->head, (int)(head + needed));
+
+    if (SDL_GetAtomicInt(&ring->waiting))
+        futex_wake(&ring->head);
+    return true;
+}
+
+static int shm_read(void *impl, void *buffer, int max_length)
+{
+    NetShmConnection *c = (NetShmConnection *)impl;
+    flush_backlog(c); // Both ends read every frame, so a backlog drains even if nothing new is sent.
+    NetShmRing *ring = c->rx;
+    Uint32 tail = (Uint32)SDL_GetAtomicInt(&ring->tail);
+    Uint32 head = (Uint32)SDL_GetAtomicInt(&ring->head);
+
+    if (head == tail)
+    {
+        if (peer_closed(c))
+        {
+            SDL_SetError("Shared-memory peer closed the connection");
+            return -1;
+        }
+        return 0;
+    }
+    SDL_MemoryBarrierAcquire();
+
+    uint16_t length;
+    ring_copy_out(ring, tail, &length, NET_SHM_HEADER_SIZE);
+    int copied = SDL_min((int)length, max_length);
+    if (copied < (int)length)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Shm] Truncated %u byte message to %d bytes", (unsigned int)length, max_length);
+    }
+    ring_copy_out(ring, tail + NET_SHM_HEADER_SIZE, buffer, copied);
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicInt(&ring->tail, (int)(tail + NET_SHM_HEADER_SIZE + length));
+    return copied;
+}
+
+static bool shm_wait_readable(void *impl, Sint32 timeout_ms)
+{
+    NetShmConnection *c = (NetShmConnection *)impl;
+    NetShmRing *ring = c->rx;
+    Uint64 deadline = timeout_ms >= 0 ? SDL_GetTicks() + (Uint64)timeout_ms : 0;
+
+    SDL_SetAtomicInt(&ring->waiting, 1);
+    for (;;)
+    {
+        int head = SDL_GetAtomicInt(&ring->head);
+        if (head != SDL_GetAtomicInt(&ring->tail) || peer_closed(c))
+            break;
+
+        Sint32 remaining = -1;
+        if (timeout_ms >= 0)
+        {
+            Uint64 now = SDL_GetTicks();
+            if (now >= deadline)
+                break;
+            remaining = (Sint32)(deadline - now);
+        }
+        futex_wait(&ring->head, head, remaining);
+    }
+    SDL_SetAtomicInt(&ring->waiting, 0);
+    return SDL_GetAtomicInt(&ring->head) != SDL_GetAtomicInt(&ring->tail);
+}
+
+static void shm_destroy(void *impl)
+{
+    NetShmConnection *c = (NetShmConnection *)impl;
+
+    // The first side to close marks the slot CLOSED, the second one frees it. A client that closes
+    // before the server accepted it has no second side, so its slot is freed at once; Accept only
+    // takes PENDING slots, so it never picks up a CLOSED one.
+    for (;;)
+    {
+        int status = SDL_GetAtomicInt(&c->slot->status);
+        int next = (status == NET_SHM_SLOT_CLOSED || status == NET_SHM_SLOT_PENDING) ? NET_SHM_SLOT_FREE : NET_SHM_SLOT_CLOSED;
+        if (SDL_CompareAndSwapAtomicInt(&c->slot->status, status, next))
+            break;
+    }
+    futex_wake(&c->tx->head); // Let a sleeping peer notice the close
+
+    if (c->holds_ref)
+        release_server_mapping(c->segment, c->is_local);
+#ifdef NET_SHM_SUPPORTED
+    if (c->owns_mapping)
+        munmap(c->segment, sizeof(NetShmSegment));
+#endif
+    SDL_free(c->backlog);
+    SDL_free(c);
+}
+
+static const NetConnectionOps shm_ops = {
+    .write = shm_write,
+    .read = shm_read,
+    .wait_readable = shm_wait_readable,
+    .destroy = shm_destroy};
+
+/**
+ * @brief Wraps one end of a slot into a NetConnection.
+ * Server-side and process-local connections share the listener's mapping; the caller must keep
+ * the listener alive (or hold the registry lock) until this returns.
+ */
+static NetConnection create_shm_connection(NetShmSegment *segment, NetShmSlot *slot, bool is_server, bool owns_mapping, bool is_local)
+{
+    NetShmConnection *c = (NetShmConnection *)SDL_calloc(1, sizeof(NetShmConnection));
+    if (!c)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    c->segment = segment;
+    c->owns_mapping = owns_mapping;
+    c->is_local = is_local;
+    c->holds_ref = is_server || is_local;
+    if (c->holds_ref)
+        SDL_AddAtomicInt(&segment->server_refs, 1);
+    c->slot = slot;
+    c->tx = is_server ? &slot->to_client : &slot->to_server;
+    c->rx = is_server ? &slot->to_server : &slot->to_client;
+    return NetConnection_Create(NET_TRANSPORT_SHM, &shm_ops, c);
+}
+
+
+/**
+ * @brief Claims a FREE slot of the segment for a new client and marks it PENDING.
+ * @return A client-side NetConnection, or NULL if every slot is taken or allocation failed.
+ */
+static NetConnection claim_client_slot(NetShmSegment *segment, const char *path, bool owns_mapping, bool is_local)
+{
+    for (int i = 0; i < MAX_CLIENTS; ++i)
+    {
+        NetShmSlot *slot = &segment->slots[i];
+        if (!SDL_CompareAndSwapAtomicInt(&slot->status, NET_SHM_SLOT_FREE, NET_SHM_SLOT_CLAIMED))
+            continue;
+
+        ring_reset(&slot->to_server);
+        ring_reset(&slot->to_client);
+        SDL_SetAtomicInt(&slot->status, NET_SHM_SLOT_PENDING);
+
+        NetConnection conn = create_shm_connection(segment, slot, false, owns_mapping, is_local);
+        if (!conn)
+        {
+            SDL_SetAtomicInt(&slot->status, NET_SHM_SLOT_FREE);
+        }
+        else
+        {
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Shm] Attached to '%s' in slot %d.", path, i);
+        }
+        return conn;
+    }
+
+    SDL_SetError("Shared-memory segment '%s' has no free client slot", path);
+    return NULL;
+}
+
+static void init_segment_header(NetShmSegment *segment)
+{
+    segment->magic = NET_SHM_MAGIC;
+    segment->version = NET_SHM_VERSION;
+    SDL_SetAtomicInt(&segment->server_alive, 1);
+    SDL_SetAtomicInt(&segment->server_refs, 1); // The listener's own reference
+}
+
+static bool local_name_taken(const char *name)
+{
+    for (NetShmListener it = local_listeners; it; it = it->next_local)
+    {
+        if (strcmp(it->path, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+static NetShmListener create_local_listener(const char *name)
+{
+    if (strlen(name) >= MAX_NAME_LENGTH)
+    {
+        SDL_SetError("Shared-memory name '%s' is too long", name);
+        return NULL;
+    }
+
+    NetShmListener listener = (NetShmListener)SDL_calloc(1, sizeof(struct NetShmListener_s));
+    if (!listener)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    listener->segment = (NetShmSegment *)SDL_aligned_alloc(NET_SHM_CACHE_LINE, sizeof(NetShmSegment));
+    if (!listener->segment)
+    {
+        SDL_OutOfMemory();
+        SDL_free(listener);
+        return NULL;
+    }
+    memset(listener->segment, 0, sizeof(NetShmSegment));
+    init_segment_header(listener->segment);
+
+    SDL_strlcpy(listener->path, name, sizeof(listener->path));
+    listener->is_local = true;
+
+    SDL_LockSpinlock(&local_listeners_lock);
+    bool taken = local_name_taken(name);
+    if (!taken)
+    {
+        listener->next_local = local_listeners;
+        local_listeners = listener;
+    }
+    SDL_UnlockSpinlock(&local_listeners_lock);
+    if (taken)
+    {
+        SDL_SetError("Local shared-memory segment '%s' already exists", name);
+        SDL_aligned_free(listener->segment);
+        SDL_free(listener);
+        return NULL;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Shm] Listening on local segment '%s'.", listener->path);
+    return listener;
+}
+
+static void destroy_local_listener(NetShmListener listener)
+{
+    SDL_LockSpinlock(&local_listeners_lock);
+    for (NetShmListener *link = &local_listeners; *link; link = &(*link)->next_local)
+    {
+        if (*link == listener)
+        {
+            *link = listener->next_local;
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&local_listeners_lock);
+    // Connections still open keep the segment until they close.
+    release_server_mapping(listener->segment, true);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Shm] Local segment '%s' destroyed.", listener->path);
+    SDL_free(listener);
+}
+
+static NetConnection connect_local(const char *name)
+{
+    NetConnection conn = NULL;
+    bool found = false;
+    SDL_LockSpinlock(&local_listeners_lock);
+    for (NetShmListener it = local_listeners; it && !found; it = it->next_local)
+    {
+        if (strcmp(it->path, name) == 0)
+        {
+            // Under the lock, so the segment cannot be destroyed while a slot is claimed.
+            conn = claim_client_slot(it->segment, name, false, true);
+            found = true;
+        }
+    }
+    SDL_UnlockSpinlock(&local_listeners_lock);
+    if (!found)
+        SDL_SetError("Local shared-memory segment '%s' has no live server", name);
+    return conn;
+}
+
+// --- Public API Function Implementations ---
+
+bool NetShm_IsSupported(void)
+{
+#ifdef NET_SHM_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+NetShmListener NetShm_CreateListener(const char *name)
+{
+    if (is_local_name(name))
+        return create_local_listener(name);
+
+#ifdef NET_SHM_SUPPORTED
+    NetShmListener listener = (NetShmListener)SDL_calloc(1, sizeof(struct NetShmListener_s));
+    if (!listener)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    if (!build_shm_path(name, listener->path, sizeof(listener->path)))
+    {
+        SDL_free(listener);
+        return NULL;
+    }
+
+    int fd = shm_open(listener->path, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && errno == EEXIST)
+    {
+        // Left behind by a server that did not shut down cleanly.
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Shm] Replacing stale segment '%s'", listener->path);
+        shm_unlink(listener->path);
+        fd = shm_open(listener->path, O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    if (fd < 0)
+    {
+        SDL_SetError("shm_open('%s') failed: %s", listener->path, strerror(errno));
+        SDL_free(listener);
+        return NULL;
+    }
+    if (ftruncate(fd, (off_t)sizeof(NetShmSegment)) != 0)
+    {
+        SDL_SetError("ftruncate('%s') failed: %s", listener->path, strerror(errno));
+        close(fd);
+        shm_unlink(listener->path);
+        SDL_free(listener);
+        return NULL;
+    }
+
+    void *mapping = mmap(NULL, sizeof(NetShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        SDL_SetError("mmap('%s') failed: %s", listener->path, strerror(errno));
+        shm_unlink(listener->path);
+        SDL_free(listener);
+        return NULL;
+    }
+
+    // A freshly truncated object is zero-filled, so every slot starts FREE.
+    listener->segment = (NetShmSegment *)mapping;
+    init_segment_header(listener->segment);
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Shm] Listening on shared-memory segment '%s' (%lu bytes).", listener->path, (unsigned long)sizeof(NetShmSegment));
+    return listener;
+#else
+    SDL_SetError("Shared-memory transport is not supported on this platform");
+    return NULL;
+#endif
+}
+
+NetConnection NetShm_Accept(NetShmListener listener)
+{
+    if (!listener)
+        return NULL;
+
+    for (int i = 0; i < MAX_CLIENTS; ++i)
+    {
+        NetShmSlot *slot = &listener->segment->slots[i];
+        if (SDL_CompareAndSwapAtomicInt(&slot->status, NET_SHM_SLOT_PENDING, NET_SHM_SLOT_OPEN))
+        {
+            return create_shm_connection(listener->segment, slot, true, false, listener->is_local);
+        }
+    }
+    return NULL;
+}
+
+void NetShm_DestroyListener(NetShmListener listener)
+{
+    if (!listener)
+        return;
+
+    SDL_SetAtomicInt(&listener->segment->server_alive, 0);
+    for (int i = 0; i < MAX_CLIENTS; ++i)
+    {
+        futex_wake(&listener->segment->slots[i].to_client.head);
+    }
+
+    if (listener->is_local)
+    {
+        destroy_local_listener(listener);
+        return;
+    }
+
+#ifdef NET_SHM_SUPPORTED
+    // Accepted connections keep the mapping until they close; new clients can no longer find the name.
+    shm_unlink(listener->path);
+    release_server_mapping(listener->segment, false);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "[Shm] Segment '%s' destroyed.", listener->path);
+#endif
+    SDL_free(listener);
+}
+
+NetConnection NetShm_Connect(const char *name)
+{
+    if (is_local_name(name))
+        return connect_local(name);
+
+#ifdef NET_SHM_SUPPORTED
+    char path[MAX_NAME_LENGTH];
+    if (!build_shm_path(name, path, sizeof(path)))
+        return NULL;
+
+    int fd = shm_open(path, O_RDWR, 0);
+    if (fd < 0)
+    {
+        SDL_SetError("shm_open('%s') failed: %s", path, strerror(errno));
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(NetShmSegment))
+    {
+        SDL_SetError("Shared-memory segment '%s' has an unexpected size", path);
+        close(fd);
+        return NULL;
+    }
+    void *mapping = mmap(NULL, sizeof(NetShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        SDL_SetError("mmap('%s') failed: %s", path, strerror(errno));
+        return NULL;
+    }
+
+    NetShmSegment *segment = (NetShmSegment *)mapping;
+    if (segment->magic != NET_SHM_MAGIC || segment->version != NET_SHM_VERSION || !SDL_GetAtomicInt(&segment->server_alive))
+    {
+        SDL_SetError("Shared-memory segment '%s' has no live server", path);
+        munmap(mapping, sizeof(NetShmSegment));
+        return NULL;
+    }
+
+    NetConnection conn = claim_client_slot(segment, path, true, false);
+    if (!conn)
+        munmap(mapping, sizeof(NetShmSegment));
+    return conn;
+#else
+    SDL_SetError("Shared-memory transport is not supported on this platform");
+    return NULL;
+#endif
+}
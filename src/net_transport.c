@@ -0,0 +1,199 @@
+#include "../include/net_transport.h"
+
+// --- Constants ---
+#define TCP_FRAME_HEADER_SIZE 2       /**< Little-endian payload length in front of every message. */
+#define TCP_RECEIVE_BUFFER_SIZE 4096  /**< Bytes a connection buffers until they form whole messages. */
+#define TCP_MAX_PAYLOAD_SIZE (TCP_RECEIVE_BUFFER_SIZE - TCP_FRAME_HEADER_SIZE)
+
+// --- Internal Structures ---
+
+/**
+ * @brief Internal state for a NetConnection.
+ */
+struct NetConnection_s
+{
+    NetTransportKind kind;       /**< Transport backend carrying this connection. */
+    const NetConnectionOps *ops; /**< Backend function table. */
+    void *impl;                  /**< Backend state. */
+};
+
+/**
+ * @brief State of a TCP connection.
+ * A stream socket has no message boundaries: one read may end inside a message or hold several.
+ * Every message is therefore sent behind its length, and received bytes are kept here until a
+ * whole message has arrived.
+ */
+typedef struct TcpStream
+{
+    SDLNet_StreamSocket *socket;
+    int received;                            /**< Bytes in buffer, starting at a frame header. */
+    bool closed;                             /**< The socket reported a closed connection or an error. */
+    Uint8 buffer[TCP_RECEIVE_BUFFER_SIZE];   /**< Received bytes not handed out yet. */
+} TcpStream;
+
+// --- TCP Backend ---
+
+/**
+ * @brief Returns the payload length of the first buffered frame, or -1 if its header is incomplete.
+ */
+static int tcp_frame_length(const TcpStream *stream)
+{
+    if (stream->received < TCP_FRAME_HEADER_SIZE)
+        return -1;
+    return (int)stream->buffer[0] | ((int)stream->buffer[1] << 8);
+}
+
+static bool tcp_write(void *impl, const void *buffer, int length)
+{
+    TcpStream *stream = (TcpStream *)impl;
+    if (length <= 0 || length > TCP_MAX_PAYLOAD_SIZE)
+        return SDL_SetError("TCP message of %d bytes (1 .. %d allowed)", length, TCP_MAX_PAYLOAD_SIZE);
+
+    // One write per message, so the header and the payload are never queued apart.
+    Uint8 frame[TCP_FRAME_HEADER_SIZE + TCP_MAX_PAYLOAD_SIZE];
+    frame[0] = (Uint8)(length & 0xFF);
+    frame[1] = (Uint8)(length >> 8);
+    memcpy(frame + TCP_FRAME_HEADER_SIZE, buffer, (size_t)length);
+    return SDLNet_WriteToStreamSocket(stream->socket, frame, TCP_FRAME_HEADER_SIZE + length);
+}
+
+static int tcp_read(void *impl, void *buffer, int max_length)
+{
+    TcpStream *stream = (TcpStream *)impl;
+
+    // Top up the buffer first; a message may arrive in pieces over several reads.
+    if (!stream->closed && stream->received < TCP_RECEIVE_BUFFER_SIZE)
+    {
+        int n = SDLNet_ReadFromStreamSocket(stream->socket, stream->buffer + stream->received, TCP_RECEIVE_BUFFER_SIZE - stream->received);
+        if (n < 0)
+            stream->closed = true;
+        else
+            stream->received += n;
+    }
+
+    int length = tcp_frame_length(stream);
+    if (length == 0 || length > TCP_MAX_PAYLOAD_SIZE)
+    {
+        // The stream is out of step with the frames; nothing after this point can be trusted.
+        SDL_SetError("Invalid TCP frame length %d", length);
+        return -1;
+    }
+    if (length < 0 || stream->received < TCP_FRAME_HEADER_SIZE + length)
+        return stream->closed ? -1 : 0;
+    if (length > max_length)
+    {
+        SDL_SetError("TCP message of %d bytes does not fit the %d byte buffer", length, max_length);
+        return -1;
+    }
+
+    memcpy(buffer, stream->buffer + TCP_FRAME_HEADER_SIZE, (size_t)length);
+    stream->received -= TCP_FRAME_HEADER_SIZE + length;
+    memmove(stream->buffer, stream->buffer + TCP_FRAME_HEADER_SIZE + length, (size_t)stream->received);
+    return length;
+}
+
+static bool tcp_wait_readable(void *impl, Sint32 timeout_ms)
+{
+    TcpStream *stream = (TcpStream *)impl;
+    int length = tcp_frame_length(stream);
+    if (length >= 0 && stream->received >= TCP_FRAME_HEADER_SIZE + length)
+        return true;
+    void *sockets[1] = {stream->socket};
+    return SDLNet_WaitUntilInputAvailable(sockets, 1, timeout_ms) > 0;
+}
+
+static void tcp_destroy(void *impl)
+{
+    TcpStream *stream = (TcpStream *)impl;
+    SDLNet_DestroyStreamSocket(stream->socket);
+    SDL_free(stream);
+}
+
+static const NetConnectionOps tcp_ops = {
+    .write = tcp_write,
+    .read = tcp_read,
+    .wait_readable = tcp_wait_readable,
+    .destroy = tcp_destroy};
+
+// --- Public API Function Implementations ---
+
+NetConnection NetConnection_Create(NetTransportKind kind, const NetConnectionOps *ops, void *impl)
+{
+    if (!ops || !ops->write || !ops->read || !ops->destroy || !impl)
+    {
+        SDL_SetError("Invalid backend for NetConnection_Create");
+        if (ops && ops->destroy && impl)
+            ops->destroy(impl);
+        return NULL;
+    }
+
+    NetConnection conn = (NetConnection)SDL_calloc(1, sizeof(struct NetConnection_s));
+    if (!conn)
+    {
+        SDL_OutOfMemory();
+        ops->destroy(impl);
+        return NULL;
+    }
+    conn->kind = kind;
+    conn->ops = ops;
+    conn->impl = impl;
+    return conn;
+}
+
+NetConnection NetConnection_FromStreamSocket(SDLNet_StreamSocket *socket)
+{
+    if (!socket)
+    {
+        SDL_SetError("Invalid socket for NetConnection_FromStreamSocket");
+        return NULL;
+    }
+    TcpStream *stream = (TcpStream *)SDL_calloc(1, sizeof(TcpStream));
+    if (!stream)
+    {
+        SDL_OutOfMemory();
+        SDLNet_DestroyStreamSocket(socket);
+        return NULL;
+    }
+    stream->socket = socket;
+    return NetConnection_Create(NET_TRANSPORT_TCP, &tcp_ops, stream);
+}
+
+bool NetConnection_Write(NetConnection conn, const void *buffer, int length)
+{
+    if (!conn)
+    {
+        SDL_SetError("NetConnection is NULL");
+        return false;
+    }
+    return conn->ops->write(conn->impl, buffer, length);
+}
+
+int NetConnection_Read(NetConnection conn, void *buffer, int max_length)
+{
+    if (!conn)
+    {
+        SDL_SetError("NetConnection is NULL");
+        return -1;
+    }
+    return conn->ops->read(conn->impl, buffer, max_length);
+}
+
+bool NetConnection_WaitReadable(NetConnection conn, Sint32 timeout_ms)
+{
+    if (!conn || !conn->ops->wait_readable)
+        return false;
+    return conn->ops->wait_readable(conn->impl, timeout_ms);
+}
+
+NetTransportKind NetConnection_GetKind(NetConnection conn)
+{
+    return conn ? conn->kind : NET_TRANSPORT_TCP;
+}
+
+void NetConnection_Destroy(NetConnection conn)
+{
+    if (!conn)
+        return;
+    conn->ops->destroy(conn->impl);
+    SDL_free(conn);
+}
@@ -0,0 +1,34 @@
+#include "../include/network_messages.h"
+
+// --- Static Variables ---
+
+/** Schema entries indexed by type byte. Unused types have a NULL name. */
+static const NetMessageInfo message_infos[NET_MESSAGE_TYPE_COUNT] = {
+#define NET_MESSAGE_INFO_ENTRY(name, id, payload, direction, requires, relay, handler) \
+    [id] = {#name, (uint16_t)sizeof(payload), NET_DIR_##direction, NET_REQ_##requires, MSG_TYPE_##relay},
+    NET_MESSAGE_SCHEMA(NET_MESSAGE_INFO_ENTRY)
+#undef NET_MESSAGE_INFO_ENTRY
+};
+
+// --- Public API Function Implementations ---
+
+const NetMessageInfo *NetMessage_GetInfo(uint8_t message_type)
+{
+    const NetMessageInfo *info = &message_infos[message_type];
+    return info->name ? info : NULL;
+}
+
+void NetMessage_LogStats(const char *tag, const NetMessageStats *stats)
+{
+    if (!stats)
+        return;
+
+    for (int i = 0; i < NET_MESSAGE_TYPE_COUNT; ++i)
+    {
+        if (stats[i].handled == 0 && stats[i].dropped == 0)
+            continue;
+        const NetMessageInfo *info = NetMessage_GetInfo((uint8_t)i);
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s %-20s handled %6u  dropped %4u  bytes %8llu",
+                    tag, info ? info->name : "(unknown)", (unsigned int)stats[i].handled, (unsigned int)stats[i].dropped, (unsigned long long)stats[i].bytes);
+    }
+}
@@ -4,15 +4,64 @@
 
 // --- Static Helper Functions ---
 
-static void playerDeathTimer(PlayerInstance *p)
+/**
+ * @brief Returns one component of a player's entity.
+ * @return The component, or NULL if the slot is inactive.
+ */
+static void *player_component(PlayerManager pm, const PlayerInstance *p, EcsComponent component)
+{
+    return Ecs_Get(pm->world, p->entity, component);
+}
+
+/**
+ * @brief Moves a player's entity and its collision bounds to a position.
+ */
+static void place_player(PlayerManager pm, PlayerInstance *p, SDL_FPoint position)
+{
+    *(SDL_FPoint *)player_component(pm, p, ECS_POSITION) = position;
+    *(SDL_FRect *)player_component(pm, p, ECS_BOUNDS) = (SDL_FRect){position.x - PLAYER_WIDTH / 2.0f, position.y - PLAYER_HEIGHT / 2.0f,
+                                                                    PLAYER_WIDTH, PLAYER_HEIGHT};
+}
+
+static SDL_FPoint get_player_spawn(bool team)
+{
+    return team ? (SDL_FPoint){BASE_RED_POS_X + 300, BUILDINGS_POS_Y} : (SDL_FPoint){BASE_BLUE_POS_X - 300, BUILDINGS_POS_Y};
+}
+
+/**
+ * @brief Creates the entity of a player slot that becomes active.
+ * @param pm The PlayerManager instance.
+ * @param p The player slot; its index must be set.
+ * @param team The player's team.
+ * @param health The player's health.
+ * @param position The player's position; the previous position starts there too.
+ * @return True on success, false if the entity could not be created.
+ */
+static bool create_player_entity(PlayerManager pm, PlayerInstance *p, bool team, float health, SDL_FPoint position)
+{
+    p->entity = Ecs_CreateEntity(pm->world, PLAYER_COMPONENTS);
+    if (p->entity == ECS_ENTITY_NONE)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[PlayerManager] Failed to create entity for player %d: %s", p->index, SDL_GetError());
+        return false;
+    }
+    *(bool *)player_component(pm, p, ECS_TEAM) = team;
+    *(EcsHealth *)player_component(pm, p, ECS_HEALTH) = (EcsHealth){health, PLAYER_HEALTH_MAX, false};
+    *(EcsCollider *)player_component(pm, p, ECS_COLLIDER) = (EcsCollider){SPATIAL_KIND_PLAYER, p->index};
+    *(SDL_FPoint *)player_component(pm, p, ECS_PREV_POSITION) = position;
+    place_player(pm, p, position);
+    return true;
+}
+
+static void playerDeathTimer(PlayerManager pm, PlayerInstance *p, AppState *state)
 {
-    if ((SDL_GetTicks() - p->deathTime) >= PLAYER_DEATH_TIMER)
+    if ((SimClock_GetTicks(state->clock) - p->deathTime) >= PLAYER_DEATH_TIMER)
     {
         SDL_Log("Player is back to life");
         p->dead = false;
         p->playDeathAnim = false;
-        p->current_health = PLAYER_HEALTH_MAX;
-        p->position = p->team ? (SDL_FPoint){BASE_RED_POS_X + 300, BUILDINGS_POS_Y} : (SDL_FPoint){BASE_BLUE_POS_X - 300, BUILDINGS_POS_Y};
+        ((EcsHealth *)player_component(pm, p, ECS_HEALTH))->current = PLAYER_HEALTH_MAX;
+        place_player(pm, p, get_player_spawn(*(const bool *)player_component(pm, p, ECS_TEAM)));
     }
 }
 
@@ -29,6 +78,9 @@ static void handle_local_player_input(PlayerManager pm, AppState *state)
         return;
 
     PlayerInstance *p = &pm->players[pm->local_player_client_id];
+    SDL_FPoint *position = player_component(pm, p, ECS_POSITION);
+    if (!position)
+        return;
     const bool *keyboard_state = SDL_GetKeyboardState(NULL);
     bool was_moving = p->is_moving; // Track previous state to detect changes for animation reset.
     p->is_moving = false;
@@ -62,61 +114,39 @@ static void handle_local_player_input(PlayerManager pm, AppState *state)
     }
 
     // --- Normalize and Apply Movement ---
-    float len_sq = move_x * move_x + move_y * move_y;
     // Normalize the movement vector only if there is input, prevents division by zero
     // and ensures consistent speed regardless of direction (diagonal vs cardinal).
-    if (len_sq > 0.001f)
-    {
-        float len = sqrtf(len_sq);
-        move_x = (move_x / len) * PLAYER_SPEED * state->delta_time;
-        move_y = (move_y / len) * PLAYER_SPEED * state->delta_time;
-    }
+    SDL_FPoint direction = SimMath_Normalize(move_x, move_y, 0.03f);
+    move_x = direction.x * PLAYER_SPEED * state->delta_time;
+    move_y = direction.y * PLAYER_SPEED * state->delta_time;
 
     // Create Rect of the player
     SDL_FRect player_bounds = {
-        move_x - PLAYER_WIDTH / 2.0f + p->position.x,
-        move_y - PLAYER_HEIGHT / 2.0f + p->position.y,
+        move_x - PLAYER_WIDTH / 2.0f + position->x,
+        move_y - PLAYER_HEIGHT / 2.0f + position->y,
         PLAYER_WIDTH,
         PLAYER_HEIGHT};
 
-    bool collision = false;
-
-    for (int i = 0; i < MAX_TOTAL_TOWERS; i++)
-    {
-        if (SDL_HasRectIntersectionFloat(&player_bounds, &state->tower_manager->towers[i].rect))
-        {
-            collision = true;
-        }
-    }
-
-    for (int i = 0; i < MAX_BASES; i++)
-    {
-        if (SDL_HasRectIntersectionFloat(&player_bounds, &state->base_manager->bases[i].rect))
-        {
-            collision = true;
-        }
-    }
+    // Buildings block the whole body, the cliff and the water only the player's feet (its center).
+    SpatialEntry blocker;
+    SDL_FPoint next_center = {position->x + move_x, position->y + move_y};
+    bool collision = SpatialHash_QueryRect(state->spatial_hash, &player_bounds, SPATIAL_KIND_BUILDING,
+                                           SPATIAL_HASH_ANY_TEAM, &blocker, 1) > 0 ||
+                     Map_IsBlocked(state->map_state, next_center);
 
+    SDL_FPoint next = *position;
     if (!collision) // If player doesn't intersect, update position
     {
-        p->position.x += move_x;
-        p->position.y += move_y;
+        next = next_center;
     }
 
     // --- Clamp Position ---
     if (state->map_state)
     {
-        // Prevent player from moving outside the map horizontally.
-        p->position.x = fmaxf(PLAYER_WIDTH / 2.0f, fminf(p->position.x, Map_GetWidthPixels(state->map_state) - PLAYER_WIDTH / 2.0f));
-        // Prevent player from moving outside the map vertically.
-        p->position.y = fmaxf(CLIFF_BOUNDARY, fminf(p->position.y, WATER_BOUNDARY));
+        // Prevent player from moving outside the map horizontally; the collision layer closes it off vertically.
+        next.x = fmaxf(PLAYER_WIDTH / 2.0f, fminf(next.x, Map_GetWidthPixels(state->map_state) - PLAYER_WIDTH / 2.0f));
     }
-
-    p->rect = (SDL_FRect){
-        p->position.x - PLAYER_WIDTH / 2.0f,
-        p->position.y - PLAYER_HEIGHT / 2.0f,
-        PLAYER_WIDTH,
-        PLAYER_HEIGHT};
+    place_player(pm, p, next);
 
     // --- Animation State Reset ---
     // If movement state changed (started/stopped moving), reset animation to the beginning.
@@ -245,30 +275,56 @@ static void update_player_animation(PlayerInstance *p, float delta_time)
  * @param p Pointer to the PlayerInstance to render.
  * @param state The main application state.
  */
+/**
+ * @brief Blends a player's previous and current simulation positions for rendering.
+ * @param pm The PlayerManager instance.
+ * @param p Pointer to the PlayerInstance.
+ * @param alpha Interpolation factor (0 = previous step, 1 = current step).
+ * @return The position to draw the player at.
+ */
+static SDL_FPoint get_player_render_position(PlayerManager pm, const PlayerInstance *p, float alpha)
+{
+    const SDL_FPoint *prev = player_component(pm, p, ECS_PREV_POSITION);
+    const SDL_FPoint *position = player_component(pm, p, ECS_POSITION);
+    SDL_FPoint pos = {
+        prev->x + (position->x - prev->x) * alpha,
+        prev->y + (position->y - prev->y) * alpha};
+    return pos;
+}
+
+/**
+ * @brief Returns the sprite atlas of a player's team. Entities only store the team, so
+ * PlayerInstance and its components stay plain data that world snapshots can copy.
+ */
+static SDL_Texture *get_player_texture(PlayerManager pm, bool team)
+{
+    return team ? pm->red_texture : pm->blue_texture;
+}
+
 static void render_single_player(PlayerManager pm, PlayerInstance *p, AppState *state)
 {
     if (!pm || !p || !p->active || !pm->player_texture || !state || !state->camera_state)
     {
         return;
     }
-
-    if (p->dead)
-    {
-        playerDeathTimer(p);
-    }
+    const bool *team = player_component(pm, p, ECS_TEAM);
+    const EcsHealth *health = player_component(pm, p, ECS_HEALTH);
+    if (!team || !health)
+        return;
 
     CameraState camera = state->camera_state;
     float cam_x = Camera_GetX(camera);
     float cam_y = Camera_GetY(camera);
 
     // Calculate screen coordinates relative to the camera's view.
-    float screen_x = p->position.x - cam_x - PLAYER_WIDTH / 2.0f;
-    float screen_y = p->position.y - cam_y - PLAYER_HEIGHT / 2.0f;
+    SDL_FPoint world_pos = get_player_render_position(pm, p, state->render_alpha);
+    float screen_x = world_pos.x - cam_x - PLAYER_WIDTH / 2.0f;
+    float screen_y = world_pos.y - cam_y - PLAYER_HEIGHT / 2.0f;
 
     SDL_FRect dst_rect = {screen_x, screen_y, PLAYER_WIDTH, PLAYER_HEIGHT};
 
     SDL_RenderTextureRotated(state->renderer,
-                             p->texture,
+                             get_player_texture(pm, *team),
                              &p->sprite_portion, // Source rect from atlas
                              &dst_rect,          // Destination rect on screen
                              0.0,                // No rotation needed for player sprite
@@ -276,12 +332,12 @@ static void render_single_player(PlayerManager pm, PlayerInstance *p, AppState *
                              p->flip_mode);      // Horizontal flip state
 
     char text_buffer[16];
-    snprintf(text_buffer, sizeof(text_buffer), "%d/%d", p->current_health, PLAYER_HEALTH_MAX);
+    snprintf(text_buffer, sizeof(text_buffer), "%.0f/%d", SDL_ceilf(health->current), PLAYER_HEALTH_MAX);
 
     char player_name[32];
     snprintf(player_name, sizeof(player_name), "player_%d_health_value", p->index);
 
-    SDL_Color team_color = p->team ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){0, 0, 255, 255};
+    SDL_Color team_color = *team ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){0, 0, 255, 255};
 
     update_hud_instance(state, get_hud_index_by_name(state, player_name), text_buffer,
                         team_color, (SDL_FPoint){screen_x, screen_y - 20}, 1);
@@ -303,10 +359,26 @@ static void player_manager_update_callback(EntityManager manager, AppState *stat
     if (!pm || !state)
         return;
 
+    // --- Step Snapshot and Respawn Timers ---
+    for (int i = 0; i < MAX_CLIENTS; ++i)
+    {
+        if (!pm->players[i].active)
+            continue;
+        *(SDL_FPoint *)player_component(pm, &pm->players[i], ECS_PREV_POSITION) =
+            *(const SDL_FPoint *)player_component(pm, &pm->players[i], ECS_POSITION);
+        if (pm->players[i].dead)
+        {
+            playerDeathTimer(pm, &pm->players[i], state);
+        }
+    }
+
     // --- Update Local Player ---
     if (pm->local_player_client_id >= 0)
     {
-        handle_local_player_input(pm, state);
+        if (!state->headless)
+        {
+            handle_local_player_input(pm, state);
+        }
         update_player_animation(&pm->players[pm->local_player_client_id], state->delta_time);
     }
 }
@@ -352,7 +424,11 @@ static void player_manager_event_callback(EntityManager manager, AppState *state
     }
 
     PlayerInstance *local_player = &pm->players[pm->local_player_client_id];
+    const SDL_FPoint *position = player_component(pm, local_player, ECS_POSITION);
+    const bool *team = player_component(pm, local_player, ECS_TEAM);
     CameraState camera = state->camera_state;
+    if (!position || !team)
+        return;
 
     // --- Handle Attack Input ---
     if (event->type == SDL_EVENT_MOUSE_BUTTON_DOWN && event->button.button == SDL_BUTTON_LEFT)
@@ -377,15 +453,15 @@ static void player_manager_event_callback(EntityManager manager, AppState *state
         float target_world_y = mouse_view_y + Camera_GetY(camera);
 
         // Check if the target is within the player's attack range.
-        float dist_x = target_world_x - local_player->position.x;
-        float dist_y = target_world_y - local_player->position.y;
+        float dist_x = target_world_x - position->x;
+        float dist_y = target_world_y - position->y;
         float distance = sqrtf(dist_x * dist_x + dist_y * dist_y);
 
         if (distance <= PLAYER_ATTACK_RANGE)
         {
             state->player_manager->players[state->player_manager->local_player_client_id].playAttackAnim = true;
             // Send request to the network client module to inform the server.
-            NetClient_SendSpawnAttackRequest(state->net_client_state, PLAYER_ATTACK_TYPE_FIREBALL, target_world_x, target_world_y, local_player->team);
+            NetClient_SendSpawnAttackRequest(state->net_client_state, PLAYER_ATTACK_TYPE_FIREBALL, target_world_x, target_world_y, *team);
         }
     }
 }
@@ -404,6 +480,11 @@ static void player_manager_cleanup_callback(EntityManager manager, AppState *sta
         return;
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "PlayerManager entity cleanup callback triggered.");
+    for (int i = 0; i < MAX_CLIENTS; ++i)
+    {
+        Ecs_DestroyEntity(pm->world, pm->players[i].entity);
+        pm->players[i].entity = ECS_ENTITY_NONE;
+    }
     if (pm->player_texture)
     {
         SDL_DestroyTexture(pm->player_texture);
@@ -415,9 +496,9 @@ static void player_manager_cleanup_callback(EntityManager manager, AppState *sta
 
 PlayerManager PlayerManager_Init(AppState *state)
 {
-    if (!state || !state->renderer || !state->entity_manager)
+    if (!state || !state->entity_manager || !state->world)
     {
-        SDL_SetError("Invalid AppState or missing renderer/entity_manager for PlayerManager_Init");
+        SDL_SetError("Invalid AppState or missing entity_manager/world for PlayerManager_Init");
         return NULL;
     }
 
@@ -428,36 +509,45 @@ PlayerManager PlayerManager_Init(AppState *state)
         return NULL;
     }
 
+    pm->world = state->world;
     pm->local_player_client_id = -1; // Initialize as having no local player yet.
     for (int i = 0; i < MAX_CLIENTS; ++i)
     {
         pm->players[i].active = false;
         pm->players[i].is_local = false;
-        pm->players[i].team = state->team;
+        pm->players[i].entity = ECS_ENTITY_NONE;
     }
 
-    pm->blue_texture = IMG_LoadTexture(state->renderer, BLUE_WIZARD_PATH);
-    pm->red_texture = IMG_LoadTexture(state->renderer, RED_WIZARD_PATH);
+    // Without a renderer (headless tools) the players are simulated but never drawn.
+    if (state->renderer)
+    {
+        pm->blue_texture = IMG_LoadTexture(state->renderer, BLUE_WIZARD_PATH);
+        pm->red_texture = IMG_LoadTexture(state->renderer, RED_WIZARD_PATH);
 
-    pm->player_texture = pm->blue_texture;
+        pm->player_texture = pm->blue_texture;
 
-    if (state->team)
-    {
-        pm->player_texture = pm->red_texture;
-    }
+        if (state->team)
+        {
+            pm->player_texture = pm->red_texture;
+        }
 
-    if (!pm->player_texture)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[PlayerManager Init] Failed load texture : %s", SDL_GetError());
-        SDL_free(pm);
-        return NULL;
+        if (!pm->player_texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[PlayerManager Init] Failed load texture : %s", SDL_GetError());
+            SDL_free(pm);
+            return NULL;
+        }
+        // Use nearest neighbor scaling for pixel art.
+        SDL_SetTextureScaleMode(pm->player_texture, SDL_SCALEMODE_NEAREST);
     }
-    // Use nearest neighbor scaling for pixel art.
-    SDL_SetTextureScaleMode(pm->player_texture, SDL_SCALEMODE_NEAREST);
 
     // --- Register with EntityManager ---
     EntityFunctions player_funcs = {
         .name = "player_manager",
+        .update_phase = ENTITY_PHASE_SIMULATE,
+        .render_phase = ENTITY_PHASE_RENDER,
+        .reads = ENTITY_RES_INPUT | ENTITY_RES_MAP | ENTITY_RES_CAMERA,
+        .writes = ENTITY_RES_PLAYERS | ENTITY_RES_NETWORK | ENTITY_RES_HUD | ENTITY_RES_RENDERER,
         .update = player_manager_update_callback,
         .render = player_manager_render_callback,
         .cleanup = player_manager_cleanup_callback,
@@ -501,9 +591,14 @@ bool PlayerManager_SetLocalPlayerID(AppState *state, uint8_t client_id)
         return false; // Avoid setting local player twice.
     }
 
-    pm->local_player_client_id = client_id;
-
     PlayerInstance *current_player = &pm->players[client_id];
+    current_player->index = client_id;
+    Ecs_DestroyEntity(pm->world, current_player->entity); // The slot may already hold a remote player
+
+    // Initial spawn position.
+    if (!create_player_entity(pm, current_player, state->team, PLAYER_HEALTH_MAX, get_player_spawn(state->team)))
+        return false;
+    pm->local_player_client_id = client_id;
 
     // Set initial state for the newly identified local player.
     current_player->active = true;
@@ -513,23 +608,6 @@ bool PlayerManager_SetLocalPlayerID(AppState *state, uint8_t client_id)
     current_player->is_moving = false;
     current_player->current_frame = 0;
     current_player->anim_timer = 0.0f;
-    current_player->texture = pm->player_texture;
-    current_player->current_health = PLAYER_HEALTH_MAX;
-    current_player->index = client_id;
-
-    // Initial spawn position.
-    current_player->position = (SDL_FPoint){BASE_BLUE_POS_X - 300, BUILDINGS_POS_Y};
-
-    if (current_player->team)
-    {
-        current_player->position = (SDL_FPoint){BASE_RED_POS_X + 300, BUILDINGS_POS_Y};
-    }
-
-    current_player->rect = (SDL_FRect){
-        current_player->position.x - PLAYER_WIDTH / 2.0f,
-        current_player->position.y - PLAYER_HEIGHT / 2.0f,
-        PLAYER_WIDTH,
-        PLAYER_HEIGHT};
 
     char player_name[32];
     snprintf(player_name, sizeof(player_name), "player_%d_health_value", client_id);
@@ -557,17 +635,11 @@ void PlayerManager_UpdateRemotePlayer(AppState *state, const Msg_PlayerStateData
     {
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Activating remote player %u", (unsigned int)id);
         memset(&pm->players[id], 0, sizeof(PlayerInstance)); // Clear slot before use.
+        pm->players[id].index = id;
+        if (!create_player_entity(pm, &pm->players[id], data->team, (float)data->current_health, data->position))
+            return;
         pm->players[id].active = true;
         pm->players[id].is_local = false;
-        pm->players[id].team = data->team;
-        pm->players[id].texture = pm->blue_texture;
-        pm->players[id].current_health = data->current_health;
-        pm->players[id].index = id;
-
-        if (pm->players[id].team)
-        {
-            pm->players[id].texture = pm->red_texture;
-        }
 
         char player_name[32];
         snprintf(player_name, sizeof(player_name), "player_%d_health_value", id);
@@ -576,17 +648,11 @@ void PlayerManager_UpdateRemotePlayer(AppState *state, const Msg_PlayerStateData
     }
 
     // Apply the received state directly.
-    pm->players[id].position = data->position;
+    place_player(pm, &pm->players[id], data->position);
     pm->players[id].sprite_portion = data->sprite_portion;
     pm->players[id].flip_mode = data->flip_mode;
     // Infer movement state from the received sprite row for animation purposes.
     pm->players[id].is_moving = (fabsf(data->sprite_portion.y - PLAYER_SPRITE_WALK_ROW_Y) < 0.1f);
-
-    pm->players[id].rect = (SDL_FRect){
-        pm->players[id].position.x - PLAYER_WIDTH / 2.0f,
-        pm->players[id].position.y - PLAYER_HEIGHT / 2.0f,
-        PLAYER_WIDTH,
-        PLAYER_HEIGHT};
 }
 
 void PlayerManager_RemovePlayer(PlayerManager pm, uint8_t client_id)
@@ -599,7 +665,9 @@ void PlayerManager_RemovePlayer(PlayerManager pm, uint8_t client_id)
     {
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Deactivating player %u", (unsigned int)client_id);
         pm->players[client_id].active = false;
+        Ecs_DestroyEntity(pm->world, pm->players[client_id].entity);
         memset(&pm->players[client_id], 0, sizeof(PlayerInstance)); // Clear data for the inactive slot.
+        pm->players[client_id].entity = ECS_ENTITY_NONE;
         // If the local player is somehow removed, update the local ID tracker.
         if (client_id == pm->local_player_client_id)
         {
@@ -613,7 +681,17 @@ bool PlayerManager_GetLocalPlayerPosition(PlayerManager pm, SDL_FPoint *out_pos)
 {
     if (pm && out_pos && pm->local_player_client_id >= 0 && pm->players[pm->local_player_client_id].active)
     {
-        *out_pos = pm->players[pm->local_player_client_id].position;
+        *out_pos = *(const SDL_FPoint *)player_component(pm, &pm->players[pm->local_player_client_id], ECS_POSITION);
+        return true;
+    }
+    return false;
+}
+
+bool PlayerManager_GetLocalPlayerRenderPosition(PlayerManager pm, float alpha, SDL_FPoint *out_pos)
+{
+    if (pm && out_pos && pm->local_player_client_id >= 0 && pm->players[pm->local_player_client_id].active)
+    {
+        *out_pos = get_player_render_position(pm, &pm->players[pm->local_player_client_id], alpha);
         return true;
     }
     return false;
@@ -628,7 +706,7 @@ bool PlayerManager_GetPlayerPosition(PlayerManager pm, uint8_t client_id, SDL_FP
     // Only return position if the requested player is currently active.
     if (pm->players[client_id].active)
     {
-        *out_pos = pm->players[client_id].position;
+        *out_pos = *(const SDL_FPoint *)player_component(pm, &pm->players[client_id], ECS_POSITION);
         return true;
     }
     return false;
@@ -646,36 +724,105 @@ bool PlayerManager_GetLocalPlayerState(PlayerManager pm, Msg_PlayerStateData *ou
     // Populate the network message struct with current local player state.
     out_data->message_type = MSG_TYPE_C_PLAYER_STATE; // Set message type for server identification.
     out_data->client_id = (uint8_t)pm->local_player_client_id;
-    out_data->position = p->position;
+    out_data->position = *(const SDL_FPoint *)player_component(pm, p, ECS_POSITION);
     out_data->sprite_portion = p->sprite_portion;
     out_data->flip_mode = p->flip_mode;
-    out_data->team = p->team;
-    out_data->current_health = p->current_health;
+    out_data->team = *(const bool *)player_component(pm, p, ECS_TEAM);
+    out_data->current_health = (int)SDL_ceilf(((const EcsHealth *)player_component(pm, p, ECS_HEALTH))->current);
 
     return true;
 }
 
-void damagePlayer(AppState state, int playerIndex, float damageValue, bool sendToServer)
+void PlayerManager_HandleHit(AppState *state, int playerIndex, bool killed)
 {
-    PlayerInstance *p = &state.player_manager->players[playerIndex];
+    if (!state || !state->player_manager || playerIndex < 0 || playerIndex >= MAX_CLIENTS)
+    {
+        return;
+    }
+    PlayerInstance *p = &state->player_manager->players[playerIndex];
+    p->playHurtAnim = true;
 
-    if (p->current_health > 0)
+    if (killed && !p->dead)
     {
-        p->current_health -= damageValue;
-        p->playHurtAnim = true;
-        SDL_Log("Player %d health %d", playerIndex, p->current_health);
+        p->dead = true;
+        p->playDeathAnim = true;
+        p->deathTime = SimClock_GetTicks(state->clock);
+        SDL_Log("Player %d Destroyed", playerIndex);
     }
+}
 
-    if (sendToServer)
+void PlayerManager_SaveState(PlayerManager pm, PlayerRecord *out)
+{
+    if (!pm || !out)
+        return;
+    memset(out, 0, MAX_CLIENTS * sizeof(PlayerRecord));
+    for (int i = 0; i < MAX_CLIENTS; ++i)
     {
-        NetClient_SendDamagePlayerRequest(state.net_client_state, playerIndex, damageValue);
+        const PlayerInstance *p = &pm->players[i];
+        PlayerRecord *record = &out[i];
+        record->instance = *p;
+        record->instance.entity = ECS_ENTITY_NONE;
+        if (!p->active || p->entity == ECS_ENTITY_NONE)
+            continue;
+        record->position = *(const SDL_FPoint *)player_component(pm, p, ECS_POSITION);
+        record->prev_position = *(const SDL_FPoint *)player_component(pm, p, ECS_PREV_POSITION);
+        record->team = *(const bool *)player_component(pm, p, ECS_TEAM);
+        record->health = *(const EcsHealth *)player_component(pm, p, ECS_HEALTH);
     }
+}
 
-    if (p->current_health <= 0 && !p->dead)
+bool PlayerManager_RestoreState(PlayerManager pm, const PlayerRecord *records)
+{
+    if (!pm || !records)
+        return false;
+
+    // Players keep their entity and have its components overwritten. Only slots that are active in
+    // the save but have no entity now need a new one; those come first, so a failure changes nothing.
+    EcsEntity entities[MAX_CLIENTS];
+    for (int i = 0; i < MAX_CLIENTS; ++i)
     {
-        p->dead = true;
-        p->playDeathAnim = true;
-        p->deathTime = SDL_GetTicks();
-        SDL_Log("Player %d Destroyed", playerIndex);
+        entities[i] = pm->players[i].entity;
+        if (!records[i].instance.active || entities[i] != ECS_ENTITY_NONE)
+            continue;
+        entities[i] = Ecs_CreateEntity(pm->world, PLAYER_COMPONENTS);
+        if (entities[i] == ECS_ENTITY_NONE)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[PlayerManager] Failed to create entity for player %d: %s", i, SDL_GetError());
+            for (int k = 0; k < i; ++k)
+                if (entities[k] != pm->players[k].entity)
+                    Ecs_DestroyEntity(pm->world, entities[k]);
+            return false;
+        }
+    }
+
+    for (int i = 0; i < MAX_CLIENTS; ++i)
+    {
+        PlayerInstance *p = &pm->players[i];
+        const PlayerRecord *record = &records[i];
+        *p = record->instance;
+        p->entity = entities[i];
+        if (!p->active)
+        {
+            Ecs_DestroyEntity(pm->world, p->entity);
+            p->entity = ECS_ENTITY_NONE;
+            continue;
+        }
+        *(bool *)player_component(pm, p, ECS_TEAM) = record->team;
+        *(EcsHealth *)player_component(pm, p, ECS_HEALTH) = record->health;
+        *(EcsCollider *)player_component(pm, p, ECS_COLLIDER) = (EcsCollider){SPATIAL_KIND_PLAYER, p->index};
+        *(SDL_FPoint *)player_component(pm, p, ECS_PREV_POSITION) = record->prev_position;
+        place_player(pm, p, record->position);
+    }
+    return true;
+}
+
+void PlayerManager_RecordPlayerHit(AppState *state, int attacker, int victim)
+{
+    if (!state || !state->player_manager || attacker < 0 || attacker >= MAX_CLIENTS || victim < 0 || victim >= MAX_CLIENTS)
+    {
+        return;
     }
+    PlayerInstance *p = &state->player_manager->players[attacker];
+    p->player_hit_time = state->sync_clock;
+    p->player_hit_victim = victim;
 }
\ No newline at end of file
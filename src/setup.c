@@ -0,0 +1,143 @@
+#include "../include/setup.h"
+
+// --- Public Functions ---
+
+const char *AppSetup_InitModules(AppState *state, const char *hostname)
+{
+  // --- Create Job System ---
+  state->jobs = JobSystem_Create(state->job_workers);
+  if (!state->jobs)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Init] JobSystem_Create failed: %s", SDL_GetError());
+    return "JobSystem_Create";
+  }
+
+  // --- Create Entity Manager ---
+  state->entity_manager = EntityManager_Create(MAX_MANAGED_ENTITIES);
+  if (!state->entity_manager)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Init] EntityManager_Create failed: %s", SDL_GetError());
+    return "EntityManager_Create";
+  }
+
+  // Component storage for the modules below; the shared systems iterate it.
+  state->world = EcsWorld_Create();
+  if (!state->world)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Init] EcsWorld_Create failed: %s", SDL_GetError());
+    return "EcsWorld_Create";
+  }
+
+  // --- Initialize Core Modules (Order Matters!) ---
+  if (state->is_server)
+  {
+    state->net_server_state = NetServer_Init(state);
+    if (!state->net_server_state)
+      return "NetServer_Init";
+  }
+
+  // Always initialize the client module
+  state->net_client_state = NetClient_Init(state, hostname);
+  if (!state->net_client_state)
+    return "NetClient_Init";
+
+  state->map_state = Map_Init(state);
+  if (!state->map_state)
+    return "Map_Init";
+
+  // Rebuilt at the start of every step, so it must run before any module that queries it.
+  state->spatial_hash = SpatialHash_Init(state);
+  if (!state->spatial_hash)
+    return "SpatialHash_Init";
+
+  // Resolves in the post-sim phase, ahead of the HUD update that follows it.
+  state->damage_bus = DamageBus_Init(state);
+  if (!state->damage_bus)
+    return "DamageBus_Init";
+
+  // The sync point: applies after the damage bus so deaths and match results land on the same frame.
+  state->command_buffer = CommandBuffer_Init(state);
+  if (!state->command_buffer)
+    return "CommandBuffer_Init";
+
+  state->HUD_manager = HUDManager_Init(state);
+  if (!state->HUD_manager)
+    return "HUDManager_Init";
+
+  state->base_manager = BaseManager_Init(state);
+  if (!state->base_manager)
+    return "Base_Init";
+
+  state->tower_manager = TowerManager_Init(state);
+  if (!state->tower_manager)
+    return "Tower_Init";
+
+  // Baked from the map's collision layer and the buildings, so it needs both.
+  state->flow_field = FlowField_Init(state, (SDL_FPoint){MINION_WIDTH / 2.0f, MINION_HEIGHT / 2.0f});
+  if (!state->flow_field)
+    return "FlowField_Init";
+
+  // Built from the same terrain and buildings, for paths to arbitrary points.
+  state->nav_grid = NavGrid_Init(state, (SDL_FPoint){PLAYER_WIDTH / 2.0f, PLAYER_HEIGHT / 2.0f});
+  if (!state->nav_grid)
+    return "NavGrid_Init";
+
+  // Draws the buildings; within the render phase, registration order is draw order.
+  if (!Systems_Init(state))
+    return "Systems_Init";
+
+  state->attack_manager = AttackManager_Init(state);
+  if (!state->attack_manager)
+    return "Attack_Init";
+
+  state->player_manager = PlayerManager_Init(state);
+  if (!state->player_manager)
+    return "PlayerManager_Init";
+
+  state->minion_manager = MinionManager_Init(state);
+  if (!state->minion_manager)
+    return "MinionManager_Init";
+
+  // Hashes the world in the network-out phase, after the minion state batch of the same step.
+  state->desync_detector = Desync_Init(state);
+  if (!state->desync_detector)
+    return "Desync_Init";
+
+  state->camera_state = Camera_Init(state);
+  if (!state->camera_state)
+    return "Camera_Init";
+
+  return NULL;
+}
+
+void AppSetup_DestroyModules(AppState *state)
+{
+  // --- Destroy ADT Modules (Reverse Order of Creation) ---
+  // EntityManager_Destroy calls the cleanup callbacks for all registered entities in reverse
+  // order. They read their module's state, so they run first; the ones that free it also clear
+  // its AppState pointer, which turns the matching Destroy call below into a no-op.
+  // The individual Destroy functions primarily free the manager's state struct.
+  EntityManager_Destroy(state->entity_manager, state);
+  state->entity_manager = NULL;
+  Camera_Destroy(state->camera_state);
+  Desync_Destroy(state->desync_detector);
+  PlayerManager_Destroy(state->player_manager);
+  AttackManager_Destroy(state->attack_manager);
+  NavGrid_Destroy(state->nav_grid);
+  FlowField_Destroy(state->flow_field);
+  TowerManager_Destroy(state->tower_manager);
+  BaseManager_Destroy(state->base_manager);
+  CommandBuffer_Destroy(state->command_buffer);
+  DamageBus_Destroy(state->damage_bus);
+  SpatialHash_Destroy(state->spatial_hash);
+  Map_Destroy(state->map_state);
+  NetClient_Destroy(state->net_client_state);
+  if (state->net_server_state)
+  {
+    NetServer_Destroy(state->net_server_state);
+  }
+  EcsWorld_Destroy(state->world); // After the cleanups, which destroy their entities
+  state->world = NULL;
+  JobSystem_Destroy(state->jobs); // Last: the cleanups above may still wait on jobs
+  state->jobs = NULL;
+}
@@ -0,0 +1,62 @@
+#include "../include/sim_clock.h"
+
+// --- Internal Structures ---
+
+/**
+ * @brief Internal state for the SimClock.
+ */
+struct SimClock_s
+{
+    bool is_virtual;    /**< True if the clock only moves through SimClock_Advance. */
+    Uint64 virtual_now; /**< Current reading of a virtual clock in milliseconds. */
+};
+
+// --- Public API Function Implementations ---
+
+SimClock SimClock_CreateReal(void)
+{
+    SimClock clock = (SimClock)SDL_calloc(1, sizeof(struct SimClock_s));
+    if (!clock)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    clock->is_virtual = false;
+    return clock;
+}
+
+SimClock SimClock_CreateVirtual(Uint64 start_ms)
+{
+    SimClock clock = (SimClock)SDL_calloc(1, sizeof(struct SimClock_s));
+    if (!clock)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    clock->is_virtual = true;
+    clock->virtual_now = start_ms;
+    return clock;
+}
+
+void SimClock_Destroy(SimClock clock)
+{
+    SDL_free(clock);
+}
+
+Uint64 SimClock_GetTicks(SimClock clock)
+{
+    if (!clock || !clock->is_virtual)
+        return SDL_GetTicks();
+    return clock->virtual_now;
+}
+
+void SimClock_Advance(SimClock clock, Uint64 ms)
+{
+    if (clock && clock->is_virtual)
+        clock->virtual_now += ms;
+}
+
+bool SimClock_IsVirtual(SimClock clock)
+{
+    return clock && clock->is_virtual;
+}
@@ -0,0 +1,385 @@
+#include "../include/sim_kernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIM_KERNEL_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIM_KERNEL_SSE2 1
+#endif
+
+// The point kernels treat an array of points as an array of x, y pairs.
+SDL_COMPILE_TIME_ASSERT(sim_kernel_point_layout, sizeof(SDL_FPoint) == 2 * sizeof(float));
+
+// --- Static Variables ---
+
+static bool scalar_only = false; /**< Set by SimKernel_SetScalarOnly. */
+
+// --- Scalar Kernels ---
+// Also finish the elements left over after the vector loops.
+
+static void integrate_scalar(float *x, float *y, const float *vx, const float *vy, int start, int count, float dt)
+{
+    for (int i = start; i < count; i++)
+    {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+}
+
+static void countdown_scalar(float *timers, int start, int count, float dt)
+{
+    for (int i = start; i < count; i++)
+    {
+        float t = timers[i] - dt;
+        timers[i] = t > 0.0f ? t : 0.0f;
+    }
+}
+
+static void step_animation_scalar(float *timers, Sint32 *frames, int start, int count, float dt, float frame_time, int frame_count)
+{
+    for (int i = start; i < count; i++)
+    {
+        timers[i] += dt;
+        if (timers[i] >= frame_time)
+        {
+            timers[i] -= frame_time;
+            frames[i] = frames[i] + 1 >= frame_count ? 0 : frames[i] + 1;
+        }
+    }
+}
+
+static void interpolate_scalar(float *x, float *y, const float *from_x, const float *from_y,
+                               const float *to_x, const float *to_y, float *t, int start, int count, float rate)
+{
+    for (int i = start; i < count; i++)
+    {
+        if (t[i] >= 1.0f)
+        {
+            x[i] = to_x[i];
+            y[i] = to_y[i];
+            continue;
+        }
+        t[i] += rate;
+        float k = t[i] < 1.0f ? t[i] : 1.0f;
+        x[i] = from_x[i] + (to_x[i] - from_x[i]) * k;
+        y[i] = from_y[i] + (to_y[i] - from_y[i]) * k;
+    }
+}
+
+static void interpolate_points_scalar(SDL_FPoint *points, const SDL_FPoint *from, const SDL_FPoint *to, float *t,
+                                      int start, int count, float rate)
+{
+    for (int i = start; i < count; i++)
+    {
+        if (t[i] >= 1.0f)
+        {
+            points[i] = to[i];
+            continue;
+        }
+        t[i] += rate;
+        float k = t[i] < 1.0f ? t[i] : 1.0f;
+        points[i].x = from[i].x + (to[i].x - from[i].x) * k;
+        points[i].y = from[i].y + (to[i].y - from[i].y) * k;
+    }
+}
+
+// --- Vector Kernels ---
+// Each returns the number of elements it handled; the caller finishes the rest with the scalar kernel.
+
+#if defined(SIM_KERNEL_AVX2)
+
+static int integrate_vector(float *x, float *y, const float *vx, const float *vy, int count, float dt)
+{
+    __m256 vdt = _mm256_set1_ps(dt);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt));
+        __m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt));
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(y + i, py);
+    }
+    return i;
+}
+
+static int countdown_vector(float *timers, int count, float dt)
+{
+    __m256 vdt = _mm256_set1_ps(dt);
+    __m256 zero = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(timers + i, _mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(timers + i), vdt), zero));
+    return i;
+}
+
+static int step_animation_vector(float *timers, Sint32 *frames, int count, float dt, float frame_time, int frame_count)
+{
+    __m256 vdt = _mm256_set1_ps(dt);
+    __m256 vft = _mm256_set1_ps(frame_time);
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i last = _mm256_set1_epi32(frame_count - 1);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 t = _mm256_add_ps(_mm256_loadu_ps(timers + i), vdt);
+        __m256 due = _mm256_cmp_ps(t, vft, _CMP_GE_OQ);
+        t = _mm256_sub_ps(t, _mm256_and_ps(due, vft));
+
+        __m256i f = _mm256_loadu_si256((const __m256i *)(frames + i));
+        __m256i next = _mm256_add_epi32(f, one);
+        next = _mm256_andnot_si256(_mm256_cmpgt_epi32(next, last), next); // Wrap to frame 0
+        f = _mm256_blendv_epi8(f, next, _mm256_castps_si256(due));
+
+        _mm256_storeu_ps(timers + i, t);
+        _mm256_storeu_si256((__m256i *)(frames + i), f);
+    }
+    return i;
+}
+
+static int interpolate_vector(float *x, float *y, const float *from_x, const float *from_y,
+                              const float *to_x, const float *to_y, float *t, int count, float rate)
+{
+    __m256 vrate = _mm256_set1_ps(rate);
+    __m256 one = _mm256_set1_ps(1.0f);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 vt = _mm256_loadu_ps(t + i);
+        __m256 moving = _mm256_cmp_ps(vt, one, _CMP_LT_OQ);
+        vt = _mm256_add_ps(vt, _mm256_and_ps(moving, vrate));
+        __m256 k = _mm256_min_ps(vt, one);
+
+        __m256 fx = _mm256_loadu_ps(from_x + i), tx = _mm256_loadu_ps(to_x + i);
+        __m256 fy = _mm256_loadu_ps(from_y + i), ty = _mm256_loadu_ps(to_y + i);
+        __m256 lx = _mm256_add_ps(fx, _mm256_mul_ps(_mm256_sub_ps(tx, fx), k));
+        __m256 ly = _mm256_add_ps(fy, _mm256_mul_ps(_mm256_sub_ps(ty, fy), k));
+
+        _mm256_storeu_ps(t + i, vt);
+        _mm256_storeu_ps(x + i, _mm256_blendv_ps(tx, lx, moving));
+        _mm256_storeu_ps(y + i, _mm256_blendv_ps(ty, ly, moving));
+    }
+    return i;
+}
+
+static int interpolate_points_vector(SDL_FPoint *points, const SDL_FPoint *from, const SDL_FPoint *to, float *t, int count, float rate)
+{
+    __m128 vrate = _mm_set1_ps(rate);
+    __m128 one = _mm_set1_ps(1.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 vt = _mm_loadu_ps(t + i);
+        __m128 moving = _mm_cmplt_ps(vt, one);
+        vt = _mm_add_ps(vt, _mm_and_ps(moving, vrate));
+        __m128 k = _mm_min_ps(vt, one);
+        _mm_storeu_ps(t + i, vt);
+
+        // Four points are eight floats: repeat each point's progress for its x and y.
+        __m256 k2 = _mm256_set_m128(_mm_unpackhi_ps(k, k), _mm_unpacklo_ps(k, k));
+        __m256 moving2 = _mm256_set_m128(_mm_unpackhi_ps(moving, moving), _mm_unpacklo_ps(moving, moving));
+        __m256 f = _mm256_loadu_ps(&from[i].x), g = _mm256_loadu_ps(&to[i].x);
+        __m256 l = _mm256_add_ps(f, _mm256_mul_ps(_mm256_sub_ps(g, f), k2));
+        _mm256_storeu_ps(&points[i].x, _mm256_blendv_ps(g, l, moving2));
+    }
+    return i;
+}
+
+#elif defined(SIM_KERNEL_SSE2)
+
+/**
+ * @brief SSE2 has no blend instruction: picks a where mask is set, b elsewhere.
+ */
+static __m128 select_ps(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static int integrate_vector(float *x, float *y, const float *vx, const float *vy, int count, float dt)
+{
+    __m128 vdt = _mm_set1_ps(dt);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), vdt));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), vdt));
+        _mm_storeu_ps(x + i, px);
+        _mm_storeu_ps(y + i, py);
+    }
+    return i;
+}
+
+static int countdown_vector(float *timers, int count, float dt)
+{
+    __m128 vdt = _mm_set1_ps(dt);
+    __m128 zero = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(timers + i, _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(timers + i), vdt), zero));
+    return i;
+}
+
+static int step_animation_vector(float *timers, Sint32 *frames, int count, float dt, float frame_time, int frame_count)
+{
+    __m128 vdt = _mm_set1_ps(dt);
+    __m128 vft = _mm_set1_ps(frame_time);
+    __m128i one = _mm_set1_epi32(1);
+    __m128i last = _mm_set1_epi32(frame_count - 1);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 t = _mm_add_ps(_mm_loadu_ps(timers + i), vdt);
+        __m128 due = _mm_cmpge_ps(t, vft);
+        t = _mm_sub_ps(t, _mm_and_ps(due, vft));
+
+        __m128i f = _mm_loadu_si128((const __m128i *)(frames + i));
+        __m128i next = _mm_add_epi32(f, one);
+        next = _mm_andnot_si128(_mm_cmpgt_epi32(next, last), next); // Wrap to frame 0
+        __m128i due_i = _mm_castps_si128(due);
+        f = _mm_or_si128(_mm_and_si128(due_i, next), _mm_andnot_si128(due_i, f));
+
+        _mm_storeu_ps(timers + i, t);
+        _mm_storeu_si128((__m128i *)(frames + i), f);
+    }
+    return i;
+}
+
+static int interpolate_vector(float *x, float *y, const float *from_x, const float *from_y,
+                              const float *to_x, const float *to_y, float *t, int count, float rate)
+{
+    __m128 vrate = _mm_set1_ps(rate);
+    __m128 one = _mm_set1_ps(1.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 vt = _mm_loadu_ps(t + i);
+        __m128 moving = _mm_cmplt_ps(vt, one);
+        vt = _mm_add_ps(vt, _mm_and_ps(moving, vrate));
+        __m128 k = _mm_min_ps(vt, one);
+
+        __m128 fx = _mm_loadu_ps(from_x + i), tx = _mm_loadu_ps(to_x + i);
+        __m128 fy = _mm_loadu_ps(from_y + i), ty = _mm_loadu_ps(to_y + i);
+        __m128 lx = _mm_add_ps(fx, _mm_mul_ps(_mm_sub_ps(tx, fx), k));
+        __m128 ly = _mm_add_ps(fy, _mm_mul_ps(_mm_sub_ps(ty, fy), k));
+
+        _mm_storeu_ps(t + i, vt);
+        _mm_storeu_ps(x + i, select_ps(moving, lx, tx));
+        _mm_storeu_ps(y + i, select_ps(moving, ly, ty));
+    }
+    return i;
+}
+
+static int interpolate_points_vector(SDL_FPoint *points, const SDL_FPoint *from, const SDL_FPoint *to, float *t, int count, float rate)
+{
+    __m128 vrate = _mm_set1_ps(rate);
+    __m128 one = _mm_set1_ps(1.0f);
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        // Two points are four floats: load their two progress values and repeat each for x and y.
+        __m128 vt = _mm_castpd_ps(_mm_load_sd((const double *)(t + i)));
+        __m128 moving = _mm_cmplt_ps(vt, one);
+        vt = _mm_add_ps(vt, _mm_and_ps(moving, vrate));
+        __m128 k = _mm_min_ps(vt, one);
+        _mm_store_sd((double *)(t + i), _mm_castps_pd(vt));
+
+        k = _mm_unpacklo_ps(k, k);
+        moving = _mm_unpacklo_ps(moving, moving);
+        __m128 f = _mm_loadu_ps(&from[i].x), g = _mm_loadu_ps(&to[i].x);
+        __m128 l = _mm_add_ps(f, _mm_mul_ps(_mm_sub_ps(g, f), k));
+        _mm_storeu_ps(&points[i].x, select_ps(moving, l, g));
+    }
+    return i;
+}
+
+#else
+
+static int integrate_vector(float *x, float *y, const float *vx, const float *vy, int count, float dt)
+{
+    (void)x, (void)y, (void)vx, (void)vy, (void)count, (void)dt;
+    return 0;
+}
+
+static int countdown_vector(float *timers, int count, float dt)
+{
+    (void)timers, (void)count, (void)dt;
+    return 0;
+}
+
+static int step_animation_vector(float *timers, Sint32 *frames, int count, float dt, float frame_time, int frame_count)
+{
+    (void)timers, (void)frames, (void)count, (void)dt, (void)frame_time, (void)frame_count;
+    return 0;
+}
+
+static int interpolate_vector(float *x, float *y, const float *from_x, const float *from_y,
+                              const float *to_x, const float *to_y, float *t, int count, float rate)
+{
+    (void)x, (void)y, (void)from_x, (void)from_y, (void)to_x, (void)to_y, (void)t, (void)count, (void)rate;
+    return 0;
+}
+
+static int interpolate_points_vector(SDL_FPoint *points, const SDL_FPoint *from, const SDL_FPoint *to, float *t, int count, float rate)
+{
+    (void)points, (void)from, (void)to, (void)t, (void)count, (void)rate;
+    return 0;
+}
+
+#endif
+
+// --- Public API Function Implementations ---
+
+const char *SimKernel_GetBackendName(void)
+{
+#if defined(SIM_KERNEL_AVX2)
+    return scalar_only ? "scalar" : "avx2";
+#elif defined(SIM_KERNEL_SSE2)
+    return scalar_only ? "scalar" : "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void SimKernel_SetScalarOnly(bool enable)
+{
+    scalar_only = enable;
+}
+
+void SimKernel_Integrate(float *x, float *y, const float *vx, const float *vy, int count, float dt)
+{
+    int done = scalar_only ? 0 : integrate_vector(x, y, vx, vy, count, dt);
+    integrate_scalar(x, y, vx, vy, done, count, dt);
+}
+
+void SimKernel_Countdown(float *timers, int count, float dt)
+{
+    int done = scalar_only ? 0 : countdown_vector(timers, count, dt);
+    countdown_scalar(timers, done, count, dt);
+}
+
+void SimKernel_StepAnimation(float *timers, Sint32 *frames, int count, float dt, float frame_time, int frame_count)
+{
+    int done = scalar_only ? 0 : step_animation_vector(timers, frames, count, dt, frame_time, frame_count);
+    step_animation_scalar(timers, frames, done, count, dt, frame_time, frame_count);
+}
+
+void SimKernel_Interpolate(float *x, float *y, const float *from_x, const float *from_y,
+                           const float *to_x, const float *to_y, float *t, int count, float rate)
+{
+    int done = scalar_only ? 0 : interpolate_vector(x, y, from_x, from_y, to_x, to_y, t, count, rate);
+    interpolate_scalar(x, y, from_x, from_y, to_x, to_y, t, done, count, rate);
+}
+
+void SimKernel_IntegratePoints(SDL_FPoint *points, const SDL_FPoint *velocities, int count, float dt)
+{
+    // Every float gets the same update, so the 2 * count floats are passed as two halves of count floats.
+    float *flat = &points->x;
+    const float *vflat = &velocities->x;
+    SimKernel_Integrate(flat, flat + count, vflat, vflat + count, count, dt);
+}
+
+void SimKernel_InterpolatePoints(SDL_FPoint *points, const SDL_FPoint *from, const SDL_FPoint *to, float *t, int count, float rate)
+{
+    int done = scalar_only ? 0 : interpolate_points_vector(points, from, to, t, count, rate);
+    interpolate_points_scalar(points, from, to, t, done, count, rate);
+}
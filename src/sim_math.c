@@ -0,0 +1,184 @@
+#include "../include/sim_math.h"
+
+// --- Constants ---
+#define FIXED_CORDIC_STEPS 16
+#define FIXED_DEGREES_PER_RADIAN 3754936 /**< 180 / pi as a Fixed value. */
+
+/** atan(2^-i) in Q16.16, the rotation angles of the CORDIC steps. */
+static const Fixed cordic_angles[FIXED_CORDIC_STEPS] = {
+    51472, 30386, 16055, 8150, 4091, 2047, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2};
+
+// --- Static Helper Functions ---
+
+static Fixed saturate(Sint64 value)
+{
+    if (value > FIXED_MAX)
+        return FIXED_MAX;
+    if (value < FIXED_MIN)
+        return FIXED_MIN;
+    return (Fixed)value;
+}
+
+/**
+ * @brief Integer square root of a 64-bit value, rounded down.
+ * Starts from a double estimate and corrects it with integer compares, so the result is
+ * exactly floor(sqrt(value)) however the estimate was rounded.
+ */
+static Uint64 isqrt64(Uint64 value)
+{
+    Uint64 root = (Uint64)SDL_sqrt((double)value);
+    if (root > 0xFFFFFFFFu)
+        root = 0xFFFFFFFFu; // root * root must not overflow
+    while (root * root > value)
+        root--;
+    while (root < 0xFFFFFFFFu && (root + 1) * (root + 1) <= value)
+        root++;
+    return root;
+}
+
+// --- Fixed-Point Functions ---
+
+Fixed Fixed_FromFloat(float value)
+{
+    // Scaling by a power of two is exact, so the only rounding is the final one.
+    float scaled = value * (float)FIXED_ONE;
+    if (scaled >= (float)FIXED_MAX)
+        return FIXED_MAX;
+    if (scaled <= (float)FIXED_MIN)
+        return FIXED_MIN;
+    return (Fixed)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+float Fixed_ToFloat(Fixed value)
+{
+    return (float)value / (float)FIXED_ONE;
+}
+
+Fixed Fixed_Mul(Fixed a, Fixed b)
+{
+    Sint64 product = (Sint64)a * b;
+    return saturate((product + (product >= 0 ? FIXED_ONE / 2 : -(FIXED_ONE / 2))) / FIXED_ONE);
+}
+
+Fixed Fixed_Div(Fixed a, Fixed b)
+{
+    if (b == 0)
+        return a >= 0 ? FIXED_MAX : FIXED_MIN;
+    return saturate(((Sint64)a * FIXED_ONE) / b);
+}
+
+Fixed Fixed_Sqrt(Fixed value)
+{
+    if (value <= 0)
+        return 0;
+    return (Fixed)isqrt64((Uint64)value << FIXED_SHIFT);
+}
+
+Fixed Fixed_Length(Fixed x, Fixed y)
+{
+    // sqrt(x^2 + y^2) of the raw values already is the length in Q16.16.
+    Uint64 sum = (Uint64)((Sint64)x * x) + (Uint64)((Sint64)y * y);
+    Uint64 length = isqrt64(sum);
+    return length > (Uint64)FIXED_MAX ? FIXED_MAX : (Fixed)length;
+}
+
+bool Fixed_Normalize(Fixed *x, Fixed *y)
+{
+    Fixed length = Fixed_Length(*x, *y);
+    if (length == 0)
+        return false;
+    *x = Fixed_Div(*x, length);
+    *y = Fixed_Div(*y, length);
+    return true;
+}
+
+Fixed Fixed_Atan2(Fixed y, Fixed x)
+{
+    if (x == 0 && y == 0)
+        return 0;
+
+    // Rotate into the right half plane, then let CORDIC turn the vector onto the x axis
+    // while adding up the angles it turned by. 64 bits keep the growing x from overflowing.
+    Sint64 cx = x;
+    Sint64 cy = y;
+    Sint64 angle = 0;
+    if (cx < 0)
+    {
+        Sint64 old_x = cx;
+        if (cy >= 0)
+        {
+            cx = cy;
+            cy = -old_x;
+            angle = FIXED_HALF_PI;
+        }
+        else
+        {
+            cx = -cy;
+            cy = old_x;
+            angle = -FIXED_HALF_PI;
+        }
+    }
+    for (int i = 0; i < FIXED_CORDIC_STEPS; i++)
+    {
+        Sint64 old_x = cx;
+        if (cy > 0)
+        {
+            cx += cy >> i;
+            cy -= old_x >> i;
+            angle += cordic_angles[i];
+        }
+        else
+        {
+            cx -= cy >> i;
+            cy += old_x >> i;
+            angle -= cordic_angles[i];
+        }
+    }
+    return saturate(angle);
+}
+
+// --- Simulation Math ---
+
+const char *SimMath_GetBackendName(void)
+{
+#ifdef SIM_DETERMINISTIC
+    return "fixed";
+#else
+    return "float";
+#endif
+}
+
+float SimMath_Length(float x, float y)
+{
+#ifdef SIM_DETERMINISTIC
+    return Fixed_ToFloat(Fixed_Length(Fixed_FromFloat(x), Fixed_FromFloat(y)));
+#else
+    return SDL_sqrtf(x * x + y * y);
+#endif
+}
+
+SDL_FPoint SimMath_Normalize(float x, float y, float min_length)
+{
+#ifdef SIM_DETERMINISTIC
+    Fixed fx = Fixed_FromFloat(x);
+    Fixed fy = Fixed_FromFloat(y);
+    if (Fixed_Length(fx, fy) < Fixed_FromFloat(min_length) || !Fixed_Normalize(&fx, &fy))
+        return (SDL_FPoint){0.0f, 0.0f};
+    return (SDL_FPoint){Fixed_ToFloat(fx), Fixed_ToFloat(fy)};
+#else
+    float length = SDL_sqrtf(x * x + y * y);
+    if (length < min_length || length <= 0.0f)
+        return (SDL_FPoint){0.0f, 0.0f};
+    return (SDL_FPoint){x / length, y / length};
+#endif
+}
+
+float SimMath_AngleDeg(float y, float x)
+{
+#ifdef SIM_DETERMINISTIC
+    Fixed radians = Fixed_Atan2(Fixed_FromFloat(y), Fixed_FromFloat(x));
+    return Fixed_ToFloat(Fixed_Mul(radians, FIXED_DEGREES_PER_RADIAN));
+#else
+    return SDL_atan2f(y, x) * (180.0f / SDL_PI_F);
+#endif
+}
@@ -0,0 +1,48 @@
+#include "../include/sim_rng.h"
+
+// --- Constants ---
+#define SIM_RNG_MULTIPLIER 6364136223846793005ull /**< PCG32 LCG multiplier. */
+
+void SimRng_Seed(SimRng *rng, Uint64 seed, Uint64 stream)
+{
+    rng->state = 0;
+    rng->increment = (stream << 1) | 1u;
+    SimRng_Next(rng);
+    rng->state += seed;
+    SimRng_Next(rng);
+}
+
+void SimRng_SeedStreams(SimRng *streams, Uint64 seed)
+{
+    for (int s = 0; s < SIM_RNG_STREAM_COUNT; s++)
+        SimRng_Seed(&streams[s], seed, (Uint64)s);
+}
+
+Uint32 SimRng_Next(SimRng *rng)
+{
+    Uint64 old = rng->state;
+    rng->state = old * SIM_RNG_MULTIPLIER + rng->increment;
+    Uint32 xorshifted = (Uint32)(((old >> 18) ^ old) >> 27);
+    Uint32 rotation = (Uint32)(old >> 59);
+    return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31u));
+}
+
+int SimRng_Range(SimRng *rng, int range)
+{
+    if (range <= 1)
+        return 0;
+    // Reject the few values that would make the low results more likely.
+    Uint32 bound = (Uint32)range;
+    Uint32 threshold = (0u - bound) % bound;
+    for (;;)
+    {
+        Uint32 value = SimRng_Next(rng);
+        if (value >= threshold)
+            return (int)(value % bound);
+    }
+}
+
+float SimRng_Float(SimRng *rng)
+{
+    return (float)(SimRng_Next(rng) >> 8) * (1.0f / 16777216.0f);
+}
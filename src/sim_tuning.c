@@ -0,0 +1,23 @@
+#include "../include/sim_tuning.h"
+#include "../include/attack.h"
+#include "../include/minion.h"
+
+void SimTuning_SetDefaults(SimTuning *tuning)
+{
+    tuning->player_attack_damage = PLAYER_ATTACK_DAMAGE_VALUE;
+    tuning->tower_attack_damage = TOWER_ATTACK_DAMAGE_VALUE;
+    tuning->minion_damage = MINION_DAMAGE_VALUE;
+    tuning->minion_unit_damage = MINION_UNIT_DAMAGE_VALUE;
+}
+
+float *SimTuning_Find(SimTuning *tuning, const char *name)
+{
+    if (!tuning || !name)
+        return NULL;
+#define SIM_TUNING_LOOKUP(field)         \
+    if (SDL_strcmp(name, #field) == 0) \
+        return &tuning->field;
+    SIM_TUNING_SCHEMA(SIM_TUNING_LOOKUP)
+#undef SIM_TUNING_LOOKUP
+    return NULL;
+}
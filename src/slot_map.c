@@ -0,0 +1,313 @@
+#include "../include/slot_map.h"
+
+// --- Internal Structures ---
+
+/**
+ * @brief Internal state for the SlotMap.
+ * Live slots are kept in the dense list and free slots in the free list; each slot
+ * records its position in whichever list holds it, so both can be edited in O(1).
+ */
+struct SlotMap_s
+{
+    Uint32 *generations; /**< Current generation of each slot (1 .. generation_mask). */
+    int *list_pos;       /**< Position of each slot in the dense list (live) or free list (free). */
+    bool *live;          /**< Whether each slot is in use. */
+    int *dense;          /**< Live slots. */
+    int *free_slots;     /**< Free slots; the last entry is reused first. */
+    int count;           /**< Number of live slots. */
+    int free_count;      /**< Number of free slots. */
+    int capacity;        /**< Number of allocated slots. */
+    int max_capacity;    /**< Upper bound on capacity. */
+    int index_bits;      /**< Handle bits used for the slot index. */
+    Uint32 index_mask;
+    Uint32 generation_mask;
+};
+
+// --- Static Helper Functions ---
+
+static SlotHandle make_handle(SlotMap sm, int slot)
+{
+    return (sm->generations[slot] << sm->index_bits) | (Uint32)slot;
+}
+
+static void free_list_remove(SlotMap sm, int slot)
+{
+    int pos = sm->list_pos[slot];
+    int last = sm->free_slots[--sm->free_count];
+    sm->free_slots[pos] = last;
+    sm->list_pos[last] = pos;
+}
+
+static void dense_add(SlotMap sm, int slot)
+{
+    sm->live[slot] = true;
+    sm->list_pos[slot] = sm->count;
+    sm->dense[sm->count++] = slot;
+}
+
+/**
+ * @brief Grows every per-slot array so it holds at least min_capacity slots.
+ * New slots go on the free list in ascending order, lowest on top.
+ * @return True on success, false if max_capacity would be exceeded or memory ran out.
+ */
+static bool grow(SlotMap sm, int min_capacity)
+{
+    if (min_capacity > sm->max_capacity)
+    {
+        SDL_SetError("SlotMap is full (%d slots)", sm->max_capacity);
+        return false;
+    }
+
+    int capacity = sm->capacity ? sm->capacity : 1;
+    while (capacity < min_capacity)
+        capacity *= 2;
+    if (capacity > sm->max_capacity)
+        capacity = sm->max_capacity;
+
+    Uint32 *generations = (Uint32 *)SDL_realloc(sm->generations, (size_t)capacity * sizeof(Uint32));
+    if (generations)
+        sm->generations = generations;
+    int *list_pos = (int *)SDL_realloc(sm->list_pos, (size_t)capacity * sizeof(int));
+    if (list_pos)
+        sm->list_pos = list_pos;
+    bool *live = (bool *)SDL_realloc(sm->live, (size_t)capacity * sizeof(bool));
+    if (live)
+        sm->live = live;
+    int *dense = (int *)SDL_realloc(sm->dense, (size_t)capacity * sizeof(int));
+    if (dense)
+        sm->dense = dense;
+    int *free_slots = (int *)SDL_realloc(sm->free_slots, (size_t)capacity * sizeof(int));
+    if (free_slots)
+        sm->free_slots = free_slots;
+
+    if (!generations || !list_pos || !live || !dense || !free_slots)
+    {
+        SDL_OutOfMemory();
+        return false;
+    }
+
+    for (int slot = capacity - 1; slot >= sm->capacity; slot--)
+    {
+        sm->generations[slot] = 1;
+        sm->live[slot] = false;
+        sm->list_pos[slot] = sm->free_count;
+        sm->free_slots[sm->free_count++] = slot;
+    }
+    sm->capacity = capacity;
+    return true;
+}
+
+// --- Public API Function Implementations ---
+
+SlotMap SlotMap_Create(int initial_capacity, int max_capacity, int index_bits, int generation_bits)
+{
+    if (index_bits < 1 || generation_bits < 1 || index_bits + generation_bits > 32 ||
+        max_capacity < 1 || (Sint64)max_capacity > ((Sint64)1 << index_bits))
+    {
+        SDL_SetError("Invalid SlotMap layout (%d index bits, %d generation bits, max %d)", index_bits, generation_bits, max_capacity);
+        return NULL;
+    }
+
+    SlotMap sm = (SlotMap)SDL_calloc(1, sizeof(struct SlotMap_s));
+    if (!sm)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    sm->max_capacity = max_capacity;
+    sm->index_bits = index_bits;
+    sm->index_mask = (Uint32)(((Uint64)1 << index_bits) - 1);
+    sm->generation_mask = (Uint32)(((Uint64)1 << generation_bits) - 1);
+
+    if (!grow(sm, SDL_clamp(initial_capacity, 1, max_capacity)))
+    {
+        SlotMap_Destroy(sm);
+        return NULL;
+    }
+    return sm;
+}
+
+void SlotMap_Destroy(SlotMap sm)
+{
+    if (!sm)
+        return;
+    SDL_free(sm->generations);
+    SDL_free(sm->list_pos);
+    SDL_free(sm->live);
+    SDL_free(sm->dense);
+    SDL_free(sm->free_slots);
+    SDL_free(sm);
+}
+
+SlotHandle SlotMap_Alloc(SlotMap sm)
+{
+    if (!sm)
+        return SLOT_HANDLE_INVALID;
+    if (sm->free_count == 0 && !grow(sm, sm->capacity + 1))
+        return SLOT_HANDLE_INVALID;
+
+    int slot = sm->free_slots[sm->free_count - 1];
+    free_list_remove(sm, slot);
+    dense_add(sm, slot);
+    return make_handle(sm, slot);
+}
+
+bool SlotMap_Reserve(SlotMap sm, int count)
+{
+    if (!sm)
+        return false;
+    if (count <= sm->free_count)
+        return true;
+    return grow(sm, sm->capacity + (count - sm->free_count));
+}
+
+bool SlotMap_AllocAt(SlotMap sm, SlotHandle handle)
+{
+    if (!sm || handle == SLOT_HANDLE_INVALID)
+        return false;
+
+    int slot = (int)(handle & sm->index_mask);
+    Uint32 generation = (handle >> sm->index_bits) & sm->generation_mask;
+    if (generation == 0)
+        return false;
+    if (slot >= sm->capacity && !grow(sm, slot + 1))
+        return false;
+    if (sm->live[slot])
+        return false;
+
+    free_list_remove(sm, slot);
+    sm->generations[slot] = generation;
+    dense_add(sm, slot);
+    return true;
+}
+
+bool SlotMap_Free(SlotMap sm, SlotHandle handle)
+{
+    int slot = SlotMap_Resolve(sm, handle);
+    if (slot < 0)
+        return false;
+
+    // Swap the last live slot into the hole in the dense list.
+    int pos = sm->list_pos[slot];
+    int last = sm->dense[--sm->count];
+    sm->dense[pos] = last;
+    sm->list_pos[last] = pos;
+
+    sm->live[slot] = false;
+    sm->generations[slot] = (sm->generations[slot] & sm->generation_mask) == sm->generation_mask ? 1 : sm->generations[slot] + 1;
+    sm->list_pos[slot] = sm->free_count;
+    sm->free_slots[sm->free_count++] = slot;
+    return true;
+}
+
+int SlotMap_Resolve(SlotMap sm, SlotHandle handle)
+{
+    if (!sm || handle == SLOT_HANDLE_INVALID)
+        return -1;
+    int slot = (int)(handle & sm->index_mask);
+    if (slot >= sm->capacity || !sm->live[slot])
+        return -1;
+    if (sm->generations[slot] != ((handle >> sm->index_bits) & sm->generation_mask))
+        return -1;
+    return slot;
+}
+
+SlotHandle SlotMap_GetHandle(SlotMap sm, int slot)
+{
+    if (!sm || slot < 0 || slot >= sm->capacity || !sm->live[slot])
+        return SLOT_HANDLE_INVALID;
+    return make_handle(sm, slot);
+}
+
+int SlotMap_GetCount(SlotMap sm)
+{
+    return sm ? sm->count : 0;
+}
+
+int SlotMap_GetCapacity(SlotMap sm)
+{
+    return sm ? sm->capacity : 0;
+}
+
+int SlotMap_GetSlotAt(SlotMap sm, int n)
+{
+    if (!sm || n < 0 || n >= sm->count)
+        return -1;
+    return sm->dense[n];
+}
+
+bool SlotMap_SaveState(SlotMap sm, Uint32 *words, int max_words)
+{
+    if (!sm || !words || max_words < SLOT_MAP_STATE_WORDS(sm->capacity))
+    {
+        SDL_SetError("SlotMap state needs %d words", sm ? SLOT_MAP_STATE_WORDS(sm->capacity) : 0);
+        return false;
+    }
+    words[0] = (Uint32)sm->capacity;
+    words[1] = (Uint32)sm->count;
+    words[2] = (Uint32)sm->free_count;
+    Uint32 *generations = &words[3];
+    Uint32 *dense = &generations[sm->capacity];
+    Uint32 *free_slots = &dense[sm->count];
+    SDL_memcpy(generations, sm->generations, (size_t)sm->capacity * sizeof(Uint32));
+    for (int i = 0; i < sm->count; i++)
+        dense[i] = (Uint32)sm->dense[i];
+    for (int i = 0; i < sm->free_count; i++)
+        free_slots[i] = (Uint32)sm->free_slots[i];
+    return true;
+}
+
+bool SlotMap_PeekState(SlotMap sm, const Uint32 *words, int *out_capacity, int *out_count)
+{
+    if (!sm || !words)
+        return false;
+    int capacity = (int)words[0];
+    int count = (int)words[1];
+    int free_count = (int)words[2];
+    if (capacity < 1 || capacity > sm->max_capacity || count < 0 || free_count < 0 || count + free_count != capacity)
+    {
+        SDL_SetError("Invalid SlotMap state (%d slots, %d live, %d free)", capacity, count, free_count);
+        return false;
+    }
+    if (out_capacity)
+        *out_capacity = capacity;
+    if (out_count)
+        *out_count = count;
+    return true;
+}
+
+bool SlotMap_RestoreState(SlotMap sm, const Uint32 *words)
+{
+    int capacity, count;
+    if (!SlotMap_PeekState(sm, words, &capacity, &count))
+        return false;
+    int free_count = (int)words[2];
+    if (capacity > sm->capacity && !grow(sm, capacity))
+        return false;
+
+    const Uint32 *generations = &words[3];
+    const Uint32 *dense = &generations[capacity];
+    const Uint32 *free_slots = &dense[count];
+    SDL_memcpy(sm->generations, generations, (size_t)capacity * sizeof(Uint32));
+    SDL_memset(sm->live, 0, (size_t)sm->capacity * sizeof(bool));
+
+    // Slots added since the save go to the bottom of the free list, in the order grow() adds them,
+    // so they are handed out only after the saved free slots, as they would have been.
+    sm->free_count = 0;
+    for (int slot = sm->capacity - 1; slot >= capacity; slot--)
+    {
+        sm->generations[slot] = 1;
+        sm->list_pos[slot] = sm->free_count;
+        sm->free_slots[sm->free_count++] = slot;
+    }
+    for (int i = 0; i < free_count; i++)
+    {
+        int slot = (int)free_slots[i];
+        sm->list_pos[slot] = sm->free_count;
+        sm->free_slots[sm->free_count++] = slot;
+    }
+    sm->count = 0;
+    for (int i = 0; i < count; i++)
+        dense_add(sm, (int)dense[i]);
+    return true;
+}
@@ -0,0 +1,394 @@
+#include "../include/spatial_hash.h"
+#include "../include/base.h"
+#include "../include/tower.h"
+#include "../include/player.h"
+#include "../include/minion.h"
+#include "../include/ecs.h"
+
+// --- Constants ---
+#define SPATIAL_HASH_MAX_ENTRIES (MAX_CLIENTS + MINION_MAX_AMOUNT + MAX_TOTAL_TOWERS + MAX_BASES)
+#define SPATIAL_HASH_BUCKET_MASK (SPATIAL_HASH_BUCKET_COUNT - 1)
+
+// --- Internal Structures ---
+
+/**
+ * @brief Internal state for the spatial hash.
+ * Entries are bucketed with a counting sort: bucket b owns refs[bucket_start[b] .. bucket_start[b + 1]).
+ * An entry that spans several cells is referenced once per cell, so each query skips repeats with
+ * its own visited set. Queries never write to the hash, so any number of threads may run them at
+ * once between rebuilds.
+ */
+struct SpatialHash_s
+{
+    SpatialEntry entries[SPATIAL_HASH_MAX_ENTRIES];  /**< Objects captured at the last rebuild. */
+    int entry_count;                                 /**< Number of valid entries. */
+    int bucket_start[SPATIAL_HASH_BUCKET_COUNT + 1]; /**< Prefix sums of references per bucket. */
+    int bucket_fill[SPATIAL_HASH_BUCKET_COUNT];      /**< Write cursor per bucket during a rebuild. */
+    Uint16 *refs;                                    /**< Entry indices grouped by bucket. */
+    int ref_capacity;                                /**< Allocated length of refs. */
+};
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Converts a world coordinate to a cell coordinate.
+ */
+static int cell_coord(float world)
+{
+    return (int)SDL_floorf(world / SPATIAL_HASH_CELL_SIZE);
+}
+
+/**
+ * @brief Maps a cell to its bucket. Large primes spread neighbouring cells across the table.
+ */
+static int cell_bucket(int cx, int cy)
+{
+    return (int)(((Uint32)cx * 73856093u) ^ ((Uint32)cy * 19349663u)) & SPATIAL_HASH_BUCKET_MASK;
+}
+
+/**
+ * @brief Appends one object to the entry list.
+ */
+static void add_entry(SpatialHash sh, SpatialKind kind, int index, EcsEntity entity, bool team, SDL_FPoint position, SDL_FRect rect)
+{
+    if (sh->entry_count >= SPATIAL_HASH_MAX_ENTRIES)
+        return;
+
+    SpatialEntry *e = &sh->entries[sh->entry_count++];
+    e->kind = kind;
+    e->index = index;
+    e->entity = entity;
+    e->team = team;
+    e->position = position;
+    e->rect = rect;
+}
+
+/**
+ * @brief Checks an entry against the kind and team filters of a query.
+ */
+static bool entry_matches(const SpatialEntry *e, int kind_mask, int team)
+{
+    if (!(e->kind & kind_mask))
+        return false;
+    return team == SPATIAL_HASH_ANY_TEAM || e->team == (team != 0);
+}
+
+/**
+ * @brief Makes sure refs can hold the given number of references.
+ * @return True on success, false if the allocation failed.
+ */
+static bool reserve_refs(SpatialHash sh, int needed)
+{
+    if (needed <= sh->ref_capacity)
+        return true;
+
+    int capacity = sh->ref_capacity ? sh->ref_capacity : SPATIAL_HASH_MAX_ENTRIES * 4;
+    while (capacity < needed)
+        capacity *= 2;
+
+    Uint16 *refs = (Uint16 *)SDL_realloc(sh->refs, (size_t)capacity * sizeof(Uint16));
+    if (!refs)
+    {
+        SDL_OutOfMemory();
+        return false;
+    }
+    sh->refs = refs;
+    sh->ref_capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Visits every entry whose bounds touch the cells covered by a rectangle, once each.
+ * @param visit Called with each entry that passes the filters. Return false to stop early.
+ */
+static void for_each_candidate(const struct SpatialHash_s *sh, const SDL_FRect *area, int kind_mask, int team,
+                               bool (*visit)(const SpatialEntry *e, void *userdata), void *userdata)
+{
+    Uint32 visited[(SPATIAL_HASH_MAX_ENTRIES + 31) / 32] = {0};
+    int x0 = cell_coord(area->x), x1 = cell_coord(area->x + area->w);
+    int y0 = cell_coord(area->y), y1 = cell_coord(area->y + area->h);
+
+    for (int cy = y0; cy <= y1; cy++)
+    {
+        for (int cx = x0; cx <= x1; cx++)
+        {
+            int bucket = cell_bucket(cx, cy);
+            for (int r = sh->bucket_start[bucket]; r < sh->bucket_start[bucket + 1]; r++)
+            {
+                int i = sh->refs[r];
+                if (visited[i >> 5] & (1u << (i & 31)))
+                    continue;
+                visited[i >> 5] |= 1u << (i & 31);
+
+                if (entry_matches(&sh->entries[i], kind_mask, team) && !visit(&sh->entries[i], userdata))
+                    return;
+            }
+        }
+    }
+}
+
+// --- Query Visitors ---
+
+/**
+ * @brief Output buffer shared by the collecting visitors.
+ */
+typedef struct QueryOutput
+{
+    SpatialEntry *out;
+    int max_out;
+    int count;
+    SDL_FRect rect;             /**< Rect queries: the query rectangle. */
+    SDL_FPoint center;          /**< Radius queries: the circle center. */
+    float radius_sq;            /**< Radius queries: squared radius. */
+    bool found;                 /**< Nearest queries: whether out[0] holds a result. */
+    float best_sq;              /**< Nearest queries: squared distance of out[0]. */
+    SpatialSweepHit *sweep_out; /**< Segment queries: output, sorted by contact. */
+    SDL_FPoint from;            /**< Segment queries: start of the segment. */
+    SDL_FPoint to;              /**< Segment queries: end of the segment. */
+    SDL_FPoint extent;          /**< Segment queries: half size of the swept box. */
+} QueryOutput;
+
+static bool visit_rect(const SpatialEntry *e, void *userdata)
+{
+    QueryOutput *q = (QueryOutput *)userdata;
+    if (SDL_HasRectIntersectionFloat(&q->rect, &e->rect))
+        q->out[q->count++] = *e;
+    return q->count < q->max_out;
+}
+
+static bool visit_radius(const SpatialEntry *e, void *userdata)
+{
+    QueryOutput *q = (QueryOutput *)userdata;
+    float dx = e->position.x - q->center.x;
+    float dy = e->position.y - q->center.y;
+    if (dx * dx + dy * dy <= q->radius_sq)
+        q->out[q->count++] = *e;
+    return q->count < q->max_out;
+}
+
+/**
+ * @brief Orders sweep hits by contact, then by stable keys, so every peer sees the same order.
+ */
+static bool sweep_hit_before(const SpatialSweepHit *a, const SpatialSweepHit *b)
+{
+    if (a->t != b->t)
+        return a->t < b->t;
+    if (a->entry.kind != b->entry.kind)
+        return a->entry.kind < b->entry.kind;
+    return a->entry.index < b->entry.index;
+}
+
+static bool visit_segment(const SpatialEntry *e, void *userdata)
+{
+    QueryOutput *q = (QueryOutput *)userdata;
+    SDL_FRect grown = Collision_InflateRect(&e->rect, q->extent);
+    SpatialSweepHit hit = {*e, 0.0f};
+    if (!Collision_SegmentRect(q->from, q->to, &grown, &hit.t))
+        return true;
+
+    // Insertion into the sorted output; when it is full the latest contact drops out.
+    int pos = q->count < q->max_out ? q->count++ : q->max_out;
+    while (pos > 0 && sweep_hit_before(&hit, &q->sweep_out[pos - 1]))
+    {
+        if (pos < q->max_out)
+            q->sweep_out[pos] = q->sweep_out[pos - 1];
+        pos--;
+    }
+    if (pos < q->max_out)
+        q->sweep_out[pos] = hit;
+    return true;
+}
+
+static bool visit_nearest(const SpatialEntry *e, void *userdata)
+{
+    QueryOutput *q = (QueryOutput *)userdata;
+    float dx = e->position.x - q->center.x;
+    float dy = e->position.y - q->center.y;
+    float dist_sq = dx * dx + dy * dy;
+    if (dist_sq > q->radius_sq)
+        return true;
+
+    // Bucket order depends on the hash, so break ties on stable keys instead.
+    if (q->found)
+    {
+        if (dist_sq > q->best_sq)
+            return true;
+        if (dist_sq == q->best_sq && (e->kind > q->out->kind || (e->kind == q->out->kind && e->index > q->out->index)))
+            return true;
+    }
+    *q->out = *e;
+    q->best_sq = dist_sq;
+    q->found = true;
+    return true;
+}
+
+// --- Static Callback Functions (for EntityManager) ---
+
+/**
+ * @brief Entity update callback: captures this step's positions before the queries run.
+ */
+static void spatial_hash_update_callback(EntityManager manager, AppState *state)
+{
+    (void)manager;
+    if (!state || !state->spatial_hash)
+        return;
+    SpatialHash_Rebuild(state->spatial_hash, state);
+}
+
+// --- Public API Function Implementations ---
+
+SpatialHash SpatialHash_Init(AppState *state)
+{
+    if (!state || !state->entity_manager)
+    {
+        SDL_SetError("Invalid AppState or missing entity_manager for SpatialHash_Init");
+        return NULL;
+    }
+
+    SpatialHash sh = (SpatialHash)SDL_calloc(1, sizeof(struct SpatialHash_s));
+    if (!sh)
+    {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    if (!reserve_refs(sh, SPATIAL_HASH_MAX_ENTRIES * 4))
+    {
+        SDL_free(sh);
+        return NULL;
+    }
+
+    EntityFunctions spatial_funcs = {
+        .name = "spatial_hash",
+        .update_phase = ENTITY_PHASE_SIMULATE,
+        .reads = ENTITY_RES_PLAYERS | ENTITY_RES_MINIONS | ENTITY_RES_WORLD,
+        .writes = ENTITY_RES_SPATIAL_HASH,
+        .update = spatial_hash_update_callback,
+        .render = NULL,
+        .cleanup = NULL,
+        .handle_events = NULL};
+
+    if (!EntityManager_Add(state->entity_manager, &spatial_funcs))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[SpatialHash Init] Failed to add entity to manager: %s", SDL_GetError());
+        SpatialHash_Destroy(sh);
+        return NULL;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "SpatialHash initialized and entity registered.");
+    return sh;
+}
+
+void SpatialHash_Destroy(SpatialHash sh)
+{
+    if (!sh)
+        return;
+    SDL_free(sh->refs);
+    SDL_free(sh);
+}
+
+void SpatialHash_Rebuild(SpatialHash sh, AppState *state)
+{
+    if (!sh || !state)
+        return;
+
+    sh->entry_count = 0;
+
+    // --- Gather Entries ---
+    // Every entity with a collider, whatever module created it: towers, bases, players and minions.
+    EcsIter it = Ecs_Query(state->world, ECS_MASK(ECS_COLLIDER) | ECS_MASK(ECS_POSITION) | ECS_MASK(ECS_BOUNDS) | ECS_MASK(ECS_TEAM), 0);
+    while (EcsIter_Next(&it))
+    {
+        const EcsCollider *collider = EcsIter_Column(&it, ECS_COLLIDER);
+        const SDL_FPoint *position = EcsIter_Column(&it, ECS_POSITION);
+        const SDL_FRect *bounds = EcsIter_Column(&it, ECS_BOUNDS);
+        const bool *team = EcsIter_Column(&it, ECS_TEAM);
+        for (int row = 0; row < it.count; row++)
+            add_entry(sh, collider[row].kind, collider[row].index, it.entities[row], team[row], position[row], bounds[row]);
+    }
+
+    // --- Count References Per Bucket ---
+    SDL_memset(sh->bucket_start, 0, sizeof(sh->bucket_start));
+    int total = 0;
+    for (int i = 0; i < sh->entry_count; i++)
+    {
+        const SDL_FRect *r = &sh->entries[i].rect;
+        int x0 = cell_coord(r->x), x1 = cell_coord(r->x + r->w);
+        int y0 = cell_coord(r->y), y1 = cell_coord(r->y + r->h);
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++)
+                sh->bucket_start[cell_bucket(cx, cy) + 1]++;
+        total += (x1 - x0 + 1) * (y1 - y0 + 1);
+    }
+
+    if (!reserve_refs(sh, total))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[SpatialHash] Rebuild failed, queries return nothing this step.");
+        sh->entry_count = 0;
+        SDL_memset(sh->bucket_start, 0, sizeof(sh->bucket_start));
+        return;
+    }
+
+    for (int b = 0; b < SPATIAL_HASH_BUCKET_COUNT; b++)
+    {
+        sh->bucket_start[b + 1] += sh->bucket_start[b];
+        sh->bucket_fill[b] = sh->bucket_start[b];
+    }
+
+    // --- Scatter References ---
+    for (int i = 0; i < sh->entry_count; i++)
+    {
+        const SDL_FRect *r = &sh->entries[i].rect;
+        int x0 = cell_coord(r->x), x1 = cell_coord(r->x + r->w);
+        int y0 = cell_coord(r->y), y1 = cell_coord(r->y + r->h);
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++)
+                sh->refs[sh->bucket_fill[cell_bucket(cx, cy)]++] = (Uint16)i;
+    }
+}
+
+int SpatialHash_QueryRect(SpatialHash sh, const SDL_FRect *rect, int kind_mask, int team, SpatialEntry *out, int max_out)
+{
+    if (!sh || !rect || !out || max_out <= 0)
+        return 0;
+
+    QueryOutput q = {.out = out, .max_out = max_out, .rect = *rect};
+    for_each_candidate(sh, rect, kind_mask, team, visit_rect, &q);
+    return q.count;
+}
+
+int SpatialHash_QueryRadius(SpatialHash sh, SDL_FPoint center, float radius, int kind_mask, int team, SpatialEntry *out, int max_out)
+{
+    if (!sh || !out || max_out <= 0 || radius < 0.0f)
+        return 0;
+
+    SDL_FRect area = {center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f};
+    QueryOutput q = {.out = out, .max_out = max_out, .center = center, .radius_sq = radius * radius};
+    for_each_candidate(sh, &area, kind_mask, team, visit_radius, &q);
+    return q.count;
+}
+
+int SpatialHash_QuerySegment(SpatialHash sh, SDL_FPoint from, SDL_FPoint to, SDL_FPoint extent, int kind_mask, int team,
+                             SpatialSweepHit *out, int max_out)
+{
+    if (!sh || !out || max_out <= 0)
+        return 0;
+
+    // Only the cells under the segment's bounding box (grown by the box) can hold a contact.
+    SDL_FRect path = {SDL_min(from.x, to.x), SDL_min(from.y, to.y), SDL_fabsf(to.x - from.x), SDL_fabsf(to.y - from.y)};
+    SDL_FRect area = Collision_InflateRect(&path, extent);
+    QueryOutput q = {.sweep_out = out, .max_out = max_out, .from = from, .to = to, .extent = extent};
+    for_each_candidate(sh, &area, kind_mask, team, visit_segment, &q);
+    return q.count;
+}
+
+bool SpatialHash_FindNearest(SpatialHash sh, SDL_FPoint center, float radius, int kind_mask, int team, SpatialEntry *out_entry)
+{
+    if (!sh || !out_entry || radius < 0.0f)
+        return false;
+
+    SDL_FRect area = {center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f};
+    QueryOutput q = {.out = out_entry, .max_out = 1, .center = center, .radius_sq = radius * radius};
+    for_each_candidate(sh, &area, kind_mask, team, visit_nearest, &q);
+    return q.found;
+}
@@ -0,0 +1,192 @@
+#include "../include/systems.h"
+#include "../include/tower.h"
+#include "../include/base.h"
+#include "../include/player.h"
+#include "../include/minion.h"
+
+// --- Constants ---
+#define SYSTEM_SPRITE_MASK (ECS_MASK(ECS_POSITION) | ECS_MASK(ECS_SPRITE))
+#define SYSTEM_LABEL_MASK (SYSTEM_SPRITE_MASK | ECS_MASK(ECS_HEALTH) | ECS_MASK(ECS_HEALTH_LABEL) | ECS_MASK(ECS_TEAM))
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Tells the owner of an entity that it got hit, and that it died if its health just ran out.
+ * @param state Pointer to the main AppState.
+ * @param entity The entity that got hit.
+ * @param killed True if its health dropped to 0 or below with this hit.
+ * @param local true if this instance landed the hit.
+ */
+static void notify_owner(AppState *state, EcsEntity entity, bool killed, bool local)
+{
+    const EcsCollider *collider = Ecs_Get(state->world, entity, ECS_COLLIDER);
+    if (!collider)
+        return;
+
+    switch (collider->kind)
+    {
+    case SPATIAL_KIND_PLAYER:
+        PlayerManager_HandleHit(state, collider->index, killed);
+        break;
+    case SPATIAL_KIND_TOWER:
+        if (killed)
+            TowerManager_HandleDestroyed(state, collider->index);
+        break;
+    case SPATIAL_KIND_BASE:
+        if (killed)
+            BaseManager_HandleDestroyed(state, collider->index, local);
+        break;
+    case SPATIAL_KIND_MINION:
+        MinionManager_HandleHit(state, collider->index, killed);
+        break;
+    default:
+        break;
+    }
+}
+
+// --- Static Callback Functions (for EntityManager) ---
+
+/**
+ * @brief Draws every sprite centered on its position relative to the camera.
+ * @param manager The EntityManager instance (unused).
+ * @param state Pointer to the main AppState.
+ */
+static void sprite_render_system(EntityManager manager, AppState *state)
+{
+    (void)manager;
+    if (!state || !state->world || !state->renderer || !state->camera_state)
+        return;
+
+    float cam_x = Camera_GetX(state->camera_state);
+    float cam_y = Camera_GetY(state->camera_state);
+
+    EcsIter it = Ecs_Query(state->world, SYSTEM_SPRITE_MASK, 0);
+    while (EcsIter_Next(&it))
+    {
+        const SDL_FPoint *position = EcsIter_Column(&it, ECS_POSITION);
+        const EcsSprite *sprite = EcsIter_Column(&it, ECS_SPRITE);
+        const EcsHealth *health = EcsIter_Column(&it, ECS_HEALTH); // Optional
+
+        for (int row = 0; row < it.count; row++)
+        {
+            SDL_Texture *texture = sprite[row].texture;
+            if (health && health[row].current <= 0 && sprite[row].destroyed_texture)
+                texture = sprite[row].destroyed_texture;
+            if (!texture)
+                continue;
+
+            SDL_FRect dst_rect = {
+                .x = position[row].x - cam_x - sprite[row].width / 2.0f,
+                .y = position[row].y - cam_y - sprite[row].height / 2.0f,
+                .w = sprite[row].width,
+                .h = sprite[row].height};
+            SDL_RenderTexture(state->renderer, texture, NULL, &dst_rect);
+        }
+    }
+}
+
+/**
+ * @brief Writes "current/max" health in team color above each labeled sprite.
+ * @param manager The EntityManager instance (unused).
+ * @param state Pointer to the main AppState.
+ */
+static void health_label_system(EntityManager manager, AppState *state)
+{
+    (void)manager;
+    if (!state || !state->world || !state->HUD_manager || !state->camera_state)
+        return;
+
+    float cam_x = Camera_GetX(state->camera_state);
+    float cam_y = Camera_GetY(state->camera_state);
+
+    EcsIter it = Ecs_Query(state->world, SYSTEM_LABEL_MASK, 0);
+    while (EcsIter_Next(&it))
+    {
+        const SDL_FPoint *position = EcsIter_Column(&it, ECS_POSITION);
+        const EcsSprite *sprite = EcsIter_Column(&it, ECS_SPRITE);
+        const EcsHealth *health = EcsIter_Column(&it, ECS_HEALTH);
+        const EcsHealthLabel *label = EcsIter_Column(&it, ECS_HEALTH_LABEL);
+        const bool *team = EcsIter_Column(&it, ECS_TEAM);
+
+        for (int row = 0; row < it.count; row++)
+        {
+            if (label[row].hud_index < 0)
+                continue;
+
+            char text_buffer[16];
+            snprintf(text_buffer, sizeof(text_buffer), "%.0f/%.0f", health[row].current, health[row].max);
+            SDL_Color team_color = team[row] ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){0, 0, 255, 255};
+            SDL_FPoint text_pos = {
+                position[row].x - cam_x - sprite[row].width / 2.0f,
+                position[row].y - cam_y - sprite[row].height / 2.0f + label[row].offset_y};
+
+            update_hud_instance(state, label[row].hud_index, text_buffer, team_color, text_pos, 0);
+        }
+    }
+}
+
+// --- Public API Function Implementations ---
+
+bool Systems_Init(AppState *state)
+{
+    if (!state || !state->entity_manager || !state->world)
+    {
+        SDL_SetError("Invalid AppState or missing entity_manager/world for Systems_Init");
+        return false;
+    }
+
+    EntityFunctions sprite_funcs = {
+        .name = "sprite_render_system",
+        .render_phase = ENTITY_PHASE_RENDER,
+        .reads = ENTITY_RES_WORLD | ENTITY_RES_CAMERA,
+        .writes = ENTITY_RES_RENDERER,
+        .render = sprite_render_system,
+        .update = NULL,
+        .cleanup = NULL,
+        .handle_events = NULL};
+    EntityFunctions label_funcs = {
+        .name = "health_label_system",
+        .render_phase = ENTITY_PHASE_RENDER,
+        .reads = ENTITY_RES_WORLD | ENTITY_RES_CAMERA,
+        .writes = ENTITY_RES_HUD | ENTITY_RES_RENDERER,
+        .render = health_label_system,
+        .update = NULL,
+        .cleanup = NULL,
+        .handle_events = NULL};
+
+    if (!EntityManager_Add(state->entity_manager, &sprite_funcs) ||
+        !EntityManager_Add(state->entity_manager, &label_funcs))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Systems Init] Failed to add system to manager: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Shared ECS systems registered.");
+    return true;
+}
+
+bool Systems_ApplyDamage(AppState *state, EcsEntity entity, float amount, bool local, float *health_after)
+{
+    EcsHealth *health = state ? Ecs_Get(state->world, entity, ECS_HEALTH) : NULL;
+    if (!health || health->immune || health->current <= 0)
+        return false;
+
+    health->current -= amount;
+    if (health_after)
+        *health_after = health->current;
+    notify_owner(state, entity, health->current <= 0, local);
+    return true;
+}
+
+bool Systems_SetHealth(AppState *state, EcsEntity entity, float current, bool local)
+{
+    EcsHealth *health = state ? Ecs_Get(state->world, entity, ECS_HEALTH) : NULL;
+    if (!health || health->immune)
+        return false;
+
+    bool alive = health->current > 0;
+    health->current = current;
+    if (alive && current <= 0)
+        notify_owner(state, entity, true, local);
+    return true;
+}
@@ -1,56 +1,138 @@
 #include "../include/tower.h"
 
+// --- Internal Structures ---
+
+/**
+ * @brief Work shared by the targeting jobs of one step.
+ */
+typedef struct TowerTargetingJob
+{
+    TowerManagerState tm_state;
+    AppState *state;
+} TowerTargetingJob;
+
 // --- Static Helper Functions ---
 
 /**
- * @brief Renders a single tower instance relative to the camera.
- * @param tower Pointer to the TowerInstance to render.
+ * @brief Looks up the position of a tower target.
  * @param state Pointer to the main AppState.
+ * @param target The target.
+ * @param out_pos Receives the target's position.
+ * @return True if the target still lives (and, for minions, is still the same minion), false otherwise.
  */
-static void render_single_tower(const TowerInstance *tower, AppState *state)
+static bool get_target_position(AppState *state, const TowerTarget *target, SDL_FPoint *out_pos)
 {
-    if (!tower || !tower->texture || !state || !state->renderer || !state->camera_state)
+    if (target->kind == SPATIAL_KIND_MINION && state->minion_manager)
     {
-        return;
+        MinionManager mm = state->minion_manager;
+        if (MinionManager_GetHandle(mm, target->index) != target->handle)
+            return false;
+        EcsEntity entity = MinionManager_GetEntity(mm, target->index);
+        const EcsHealth *health = Ecs_Get(state->world, entity, ECS_HEALTH);
+        const SDL_FPoint *position = Ecs_Get(state->world, entity, ECS_POSITION);
+        if (!health || !position || health->current <= 0)
+            return false;
+        *out_pos = *position;
+        return true;
     }
+    if (target->kind == SPATIAL_KIND_PLAYER && state->player_manager)
+    {
+        const PlayerInstance *player = &state->player_manager->players[target->index];
+        const SDL_FPoint *position = Ecs_Get(state->world, player->entity, ECS_POSITION);
+        if (!player->active || player->dead || !position)
+            return false;
+        *out_pos = *position;
+        return true;
+    }
+    return false;
+}
 
-    CameraState camera = state->camera_state;
-    float cam_x = Camera_GetX(camera);
-    float cam_y = Camera_GetY(camera);
-
-    float towerX = tower->position.x - cam_x - TOWER_RENDER_WIDTH / 2.0f;
-    float towerY = tower->position.y - cam_y - TOWER_RENDER_HEIGHT / 2.0f;
-
-    // Calculate screen position, rendering upwards from the defined position point.
-    SDL_FRect dst_rect = {
-        .x = towerX,
-        .y = towerY,
-        .w = TOWER_RENDER_WIDTH,
-        .h = TOWER_RENDER_HEIGHT};
-
-    SDL_RenderTexture(state->renderer, tower->texture, NULL, &dst_rect);
+/**
+ * @brief Builds the target for a spatial hash entry.
+ */
+static TowerTarget target_from_entry(AppState *state, const SpatialEntry *entry)
+{
+    TowerTarget target = {entry->kind, entry->index, 0};
+    if (entry->kind == SPATIAL_KIND_MINION)
+        target.handle = state->minion_manager->minions[entry->index].handle;
+    return target;
+}
 
-    char text_buffer[16];
-    snprintf(text_buffer, sizeof(text_buffer), "%.0f/%d", tower->current_health, TOWER_HEALTH_MAX);
+static bool in_range(SDL_FPoint tower_pos, SDL_FPoint point)
+{
+    float dx = point.x - tower_pos.x;
+    float dy = point.y - tower_pos.y;
+    return dx * dx + dy * dy <= TOWER_ATTACK_RANGE * TOWER_ATTACK_RANGE;
+}
 
-    char tower_name[32];
-    snprintf(tower_name, sizeof(tower_name), "tower_%d_health_value", tower->index);
+/**
+ * @brief Picks a new target among the enemy units in range, MOBA style:
+ * 1. an enemy player who just hit a player of the tower's team standing in range (call for help),
+ * 2. the nearest enemy minion,
+ * 3. the nearest enemy player.
+ * Ties are broken by index. Runs on the job workers and only reads shared state.
+ * @param state Pointer to the main AppState.
+ * @param tower_pos The tower's position.
+ * @param team The tower's team.
+ * @param out_help Receives whether the target answers a call for help.
+ * @return The chosen target, kind 0 if nothing is in range.
+ */
+static TowerTarget choose_target(AppState *state, SDL_FPoint tower_pos, bool team, bool *out_help)
+{
+    SpatialEntry candidates[TOWER_TARGET_CANDIDATES];
+    int count = SpatialHash_QueryRadius(state->spatial_hash, tower_pos, TOWER_ATTACK_RANGE, SPATIAL_KIND_UNIT,
+                                        !team, candidates, TOWER_TARGET_CANDIDATES);
+    TowerTarget best = {0, 0, 0};
+    int best_rank = 0;
+    float best_sq = 0.0f;
+    for (int c = 0; c < count; c++)
+    {
+        TowerTarget candidate = target_from_entry(state, &candidates[c]);
+        SDL_FPoint at;
+        if (!get_target_position(state, &candidate, &at))
+            continue; // Dead players stay in the hash
 
-    SDL_Color team_color = tower->team ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){0, 0, 255, 255};
+        int rank = candidate.kind == SPATIAL_KIND_MINION ? 2 : 1;
+        if (candidate.kind == SPATIAL_KIND_PLAYER)
+        {
+            const PlayerInstance *attacker = &state->player_manager->players[candidate.index];
+            TowerTarget victim = {SPATIAL_KIND_PLAYER, attacker->player_hit_victim, 0};
+            SDL_FPoint victim_pos;
+            if (attacker->player_hit_time != 0 && state->sync_clock - attacker->player_hit_time <= TOWER_CALL_FOR_HELP_MS &&
+                get_target_position(state, &victim, &victim_pos) && in_range(tower_pos, victim_pos))
+                rank = 3;
+        }
 
-    update_hud_instance(state, get_hud_index_by_name(state, tower_name), text_buffer,
-                        team_color, (SDL_FPoint){towerX, towerY - 30}, 0);
+        float dx = at.x - tower_pos.x;
+        float dy = at.y - tower_pos.y;
+        float dist_sq = dx * dx + dy * dy;
+        if (rank > best_rank || (rank == best_rank && (dist_sq < best_sq || (dist_sq == best_sq && candidate.index < best.index))))
+        {
+            best = candidate;
+            best_rank = rank;
+            best_sq = dist_sq;
+        }
+    }
+    *out_help = best_rank == 3;
+    return best;
 }
 
 /**
- * @brief Updates a single tower instance, handling attack cooldowns and initiating attacks (server-only).
+ * @brief Updates a single tower instance, handling attack cooldowns and choosing targets (server-only).
+ * The target is kept until it dies or leaves range; only a call for help takes the tower off it.
+ * Runs on the job workers: the target and the shot are only recorded in the tower, and announced
+ * and spawned later by fire_pending_shots.
  * @param tower Pointer to the TowerInstance to update.
  * @param state Pointer to the main AppState.
  * @param towerIndex The index of this tower within the TowerManager's array.
  */
 static void update_single_tower(TowerInstance *tower, AppState *state, int towerIndex)
 {
-    if (!tower || !state || !state->is_server || tower->destroyed)
+    if (!tower || !state || !state->is_server)
+        return;
+    tower->pending_shot = false;
+    tower->next_target = (TowerTarget){0, 0, 0};
+    if (tower->destroyed)
         return;
 
     if (tower->attack_cooldown_timer > 0.0f)
@@ -58,111 +140,131 @@ static void update_single_tower(TowerInstance *tower, AppState *state, int tower
         tower->attack_cooldown_timer -= state->delta_time;
     }
 
-    if (tower->attack_cooldown_timer <= 0.0f)
+    if (!state->player_manager || !state->attack_manager)
     {
-        if (!state->player_manager || !state->attack_manager)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Missing PlayerManager or AttackManager for tower %d attack logic.", towerIndex);
-            return;
-        }
-
-        PlayerManager pm = state->player_manager;
-        AttackManager am = state->attack_manager;
-        MinionManager mm = state->minion_manager;
-        SDL_FPoint target_pos = {0.0f, 0.0f};
-        bool target_found = false;
-        float min_dist_sq = TOWER_ATTACK_RANGE * TOWER_ATTACK_RANGE;
-
-        for (int i = 0; i < MAX_CLIENTS; ++i)
-        {
-            if (pm->players[i].active && pm->players[i].team != tower->team)
-            {
-                SDL_FPoint player_pos;
-                if (PlayerManager_GetPlayerPosition(pm, i, &player_pos))
-                {
-                    float dx = player_pos.x - tower->position.x;
-                    float dy = player_pos.y - tower->position.y;
-                    float dist_sq = dx * dx + dy * dy;
-
-                    if (dist_sq <= min_dist_sq)
-                    {
-                        min_dist_sq = dist_sq;
-                        target_pos = player_pos;
-                        target_found = true;
-                    }
-                }
-            }
-        }
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Missing PlayerManager or AttackManager for tower %d attack logic.", towerIndex);
+        return;
+    }
+    const SDL_FPoint *position = Ecs_Get(state->world, tower->entity, ECS_POSITION);
+    const bool *team = Ecs_Get(state->world, tower->entity, ECS_TEAM);
+    if (!position || !team)
+        return;
 
-        for (int i = 0; i < MINION_MAX_AMOUNT; i++)
-        {
-            SDL_FPoint minion_pos;
-            if (tower->team != mm->minions[i].team)
-            {
-                if (MinionManager_GetMinionPosition(mm, i, &minion_pos))
-                {
-                    float dx = minion_pos.x - tower->position.x;
-                    float dy = minion_pos.y - tower->position.y;
-                    float dest_sq = dx * dx + dy * dy;
-                    if (dest_sq <= min_dist_sq)
-                    {
-                        min_dist_sq = dest_sq;
-                        target_pos = minion_pos;
-                        target_found = true;
-                    }
-                }
-            }
-        }
+    // Drop the current target as soon as it dies or walks out of range.
+    SDL_FPoint target_pos;
+    if (get_target_position(state, &tower->target, &target_pos) && in_range(*position, target_pos))
+        tower->next_target = tower->target;
 
-        if (target_found)
-        {
-            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Tower %d targeting player at (%.1f, %.1f)", towerIndex, target_pos.x, target_pos.y);
+    if (tower->attack_cooldown_timer > 0.0f)
+        return;
 
-            AttackManager_ServerSpawnTowerAttack(am, state, TOWER_ATTACK_TYPE, target_pos, towerIndex);
+    // Look for a new target when the old one is gone, or when a player of the team calls for help.
+    bool help = false;
+    TowerTarget chosen = choose_target(state, *position, *team, &help);
+    if (tower->next_target.kind == 0 || help)
+        tower->next_target = chosen;
+    if (!get_target_position(state, &tower->next_target, &target_pos))
+        return;
 
-            tower->attack_cooldown_timer = TOWER_ATTACK_COOLDOWN;
-        }
-    }
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Tower %d targeting unit at (%.1f, %.1f)", towerIndex, target_pos.x, target_pos.y);
+    tower->pending_shot = true;
+    tower->pending_target = target_pos;
+    tower->attack_cooldown_timer = TOWER_ATTACK_COOLDOWN;
 }
 
-// --- Static Callback Functions (for EntityManager) ---
+/**
+ * @brief JobRangeFunc running the targeting of a range of towers.
+ */
+static void run_tower_targeting_range(void *data, int begin, int end)
+{
+    const TowerTargetingJob *job = (const TowerTargetingJob *)data;
+    for (int i = begin; i < end; ++i)
+        update_single_tower(&job->tm_state->towers[i], job->state, i);
+}
 
 /**
- * @brief Internal function to update all active towers.
+ * @brief Makes a target the tower's current one and records a TowerTargetEvent if it changed.
+ * Main thread only.
  * @param tm_state The internal state of the tower manager module.
- * @param state The main application state.
+ * @param towerIndex The index of the tower.
+ * @param target The new target (kind 0 for none).
  */
-static void Internal_TowerManagerUpdate(TowerManagerState tm_state, AppState *state)
+static void set_tower_target(TowerManagerState tm_state, int towerIndex, TowerTarget target)
 {
-    if (!tm_state || !state)
+    TowerInstance *tower = &tm_state->towers[towerIndex];
+    if (tower->target.kind == target.kind && tower->target.index == target.index && tower->target.handle == target.handle)
         return;
+    tower->target = target;
 
-    // Only run tower updates on the server
-    if (!state->is_server)
+    TowerTargetEvent *event = &tm_state->target_events[tm_state->target_event_count % TOWER_TARGET_EVENT_CAPACITY];
+    event->tower = towerIndex;
+    event->target = target;
+    tm_state->target_event_count++;
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Tower %d target: kind %d index %d", towerIndex, (int)target.kind, target.index);
+}
+
+/**
+ * @brief Clients only: forgets the target of towers that stopped firing or whose target died.
+ * @param tm_state The internal state of the tower manager module.
+ * @param state The main application state.
+ */
+static void expire_client_targets(TowerManagerState tm_state, AppState *state)
+{
+    for (int i = 0; i < tm_state->tower_count; ++i)
     {
-        return;
+        TowerInstance *tower = &tm_state->towers[i];
+        if (tower->target.kind == 0)
+            continue;
+        SDL_FPoint target_pos;
+        // A tower with a target fires every cooldown; allow one missed shot for network jitter.
+        if (tower->destroyed || !get_target_position(state, &tower->target, &target_pos) ||
+            state->sync_clock - tower->last_shot_time > (Uint64)(TOWER_ATTACK_COOLDOWN * 2000.0f))
+            set_tower_target(tm_state, i, (TowerTarget){0, 0, 0});
     }
+}
 
+/**
+ * @brief Announces the targets chosen by the targeting pass and spawns its shots, in tower order
+ * so events and attack IDs do not depend on how the jobs were scheduled.
+ * @param tm_state The internal state of the tower manager module.
+ * @param state The main application state.
+ */
+static void fire_pending_shots(TowerManagerState tm_state, AppState *state)
+{
     for (int i = 0; i < tm_state->tower_count; ++i)
     {
-        // Pass the index 'i' to the update function
-        update_single_tower(&tm_state->towers[i], state, i);
+        TowerInstance *tower = &tm_state->towers[i];
+        set_tower_target(tm_state, i, tower->next_target);
+        if (!tower->pending_shot)
+            continue;
+        tower->pending_shot = false;
+        AttackManager_ServerSpawnTowerAttack(state->attack_manager, state, TOWER_ATTACK_TYPE, tower->pending_target, i);
     }
 }
 
+// --- Static Callback Functions (for EntityManager) ---
+
 /**
- * @brief Internal function to render all active towers.
+ * @brief Internal function to update all active towers.
  * @param tm_state The internal state of the tower manager module.
  * @param state The main application state.
  */
-static void Internal_TowerManagerRender(TowerManagerState tm_state, AppState *state)
+static void Internal_TowerManagerUpdate(TowerManagerState tm_state, AppState *state)
 {
     if (!tm_state || !state)
         return;
-    for (int i = 0; i < tm_state->tower_count; ++i)
+
+    // Only run tower targeting on the server; clients follow the shots it broadcasts.
+    if (!state->is_server)
     {
-        render_single_tower(&tm_state->towers[i], state);
+        expire_client_targets(tm_state, state);
+        return;
     }
+
+    // Target in parallel, then record the shots on the main thread (commands are recorded single-threaded).
+    TowerTargetingJob job = {tm_state, state};
+    JobSystem_ParallelFor(state->jobs, tm_state->tower_count, TOWER_TARGETING_CHUNK, run_tower_targeting_range, &job);
+    fire_pending_shots(tm_state, state);
 }
 
 /**
@@ -197,17 +299,6 @@ static void tower_manager_update_callback(EntityManager manager, AppState *state
     Internal_TowerManagerUpdate(state->tower_manager, state);
 }
 
-/**
- * @brief Wrapper function conforming to EntityFunctions.render signature.
- * @param manager The EntityManager instance.
- * @param state Pointer to the main AppState.
- */
-static void tower_manager_render_callback(EntityManager manager, AppState *state)
-{
-    (void)manager; // Manager instance is not used in this specific implementation
-    Internal_TowerManagerRender(state->tower_manager, state);
-}
-
 /**
  * @brief Wrapper function conforming to EntityFunctions.cleanup signature.
  * @param manager The EntityManager instance.
@@ -216,6 +307,11 @@ static void tower_manager_render_callback(EntityManager manager, AppState *state
 static void tower_manager_cleanup_callback(EntityManager manager, AppState *state)
 {
     (void)manager; // Manager instance is not used in this specific implementation
+    if (state && state->tower_manager)
+    {
+        for (int i = 0; i < state->tower_manager->tower_count; i++)
+            Ecs_DestroyEntity(state->world, state->tower_manager->towers[i].entity);
+    }
     Internal_TowerManagerCleanup(state ? state->tower_manager : NULL);
     if (state)
     {
@@ -227,9 +323,9 @@ static void tower_manager_cleanup_callback(EntityManager manager, AppState *stat
 
 TowerManagerState TowerManager_Init(AppState *state)
 {
-    if (!state || !state->renderer || !state->entity_manager)
+    if (!state || !state->entity_manager || !state->world)
     {
-        SDL_SetError("Invalid AppState or missing renderer/entity_manager for TowerManager_Init");
+        SDL_SetError("Invalid AppState or missing entity_manager/world for TowerManager_Init");
         return NULL;
     }
 
@@ -247,94 +343,97 @@ TowerManagerState TowerManager_Init(AppState *state)
     const char blue_tower_path[] = "./resources/Sprites/Blue_Team/Tower_Blue.png";
     const char destroyed_tower_path[] = "./resources/Sprites/Tower_Destroyed.png";
 
-    tm_state->red_texture = IMG_LoadTexture(state->renderer, red_tower_path);
-    if (!tm_state->red_texture)
+    // Only drawn, so a state without a renderer (headless tools) skips them.
+    if (state->renderer)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Tower Init] Failed load texture '%s': %s", red_tower_path, SDL_GetError());
-        SDL_free(tm_state);
-        return NULL;
-    }
-    SDL_SetTextureScaleMode(tm_state->red_texture, SDL_SCALEMODE_NEAREST);
+        tm_state->red_texture = IMG_LoadTexture(state->renderer, red_tower_path);
+        if (!tm_state->red_texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Tower Init] Failed load texture '%s': %s", red_tower_path, SDL_GetError());
+            SDL_free(tm_state);
+            return NULL;
+        }
+        SDL_SetTextureScaleMode(tm_state->red_texture, SDL_SCALEMODE_NEAREST);
 
-    tm_state->blue_texture = IMG_LoadTexture(state->renderer, blue_tower_path);
-    if (!tm_state->blue_texture)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Tower Init] Failed load texture '%s': %s", blue_tower_path, SDL_GetError());
-        SDL_DestroyTexture(tm_state->red_texture); // Clean up already loaded texture
-        SDL_free(tm_state);
-        return NULL;
-    }
-    SDL_SetTextureScaleMode(tm_state->blue_texture, SDL_SCALEMODE_NEAREST);
+        tm_state->blue_texture = IMG_LoadTexture(state->renderer, blue_tower_path);
+        if (!tm_state->blue_texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Tower Init] Failed load texture '%s': %s", blue_tower_path, SDL_GetError());
+            SDL_DestroyTexture(tm_state->red_texture); // Clean up already loaded texture
+            SDL_free(tm_state);
+            return NULL;
+        }
+        SDL_SetTextureScaleMode(tm_state->blue_texture, SDL_SCALEMODE_NEAREST);
 
-    tm_state->destroyed_texture = IMG_LoadTexture(state->renderer, destroyed_tower_path);
-    if (!tm_state->destroyed_texture)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Tower Init] Failed load texture '%s': %s", destroyed_tower_path, SDL_GetError());
-        SDL_DestroyTexture(tm_state->red_texture); // Clean up already loaded texture
-        SDL_free(tm_state);
-        return NULL;
+        tm_state->destroyed_texture = IMG_LoadTexture(state->renderer, destroyed_tower_path);
+        if (!tm_state->destroyed_texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Tower Init] Failed load texture '%s': %s", destroyed_tower_path, SDL_GetError());
+            SDL_DestroyTexture(tm_state->red_texture); // Clean up already loaded texture
+            SDL_free(tm_state);
+            return NULL;
+        }
+        SDL_SetTextureScaleMode(tm_state->destroyed_texture, SDL_SCALEMODE_NEAREST);
     }
-    SDL_SetTextureScaleMode(tm_state->destroyed_texture, SDL_SCALEMODE_NEAREST);
 
-    for (int i = 0; i < MAX_TOWERS_PER_TEAM; i++)
+    for (int i = 0; i < MAX_TOTAL_TOWERS; i++)
     {
-        tm_state->towers[i] = (TowerInstance){
-            .position = {TOWER_RED_1_X + i * TOWER_DISTANCE_X, BUILDINGS_POS_Y},
-            .texture = tm_state->red_texture,
-            .current_health = TOWER_HEALTH_MAX,
-            .attack_cooldown_timer = 0.0f,
-            .team = RED_TEAM,
-            .teamFirstTower = (i == 1) ? true : false,
-            .immune = (i == 0) ? true : false,
-            .index = i,
-            .destroyed = false,
-        };
-
-        tm_state->towers[i].rect = (SDL_FRect){
-            (TOWER_RED_1_X + i * TOWER_DISTANCE_X) - TOWER_RENDER_WIDTH / 2.0f,
-            BUILDINGS_POS_Y - TOWER_RENDER_HEIGHT / 2.0f,
-            TOWER_RENDER_WIDTH,
-            TOWER_RENDER_HEIGHT};
+        // Red towers count up from TOWER_RED_1_X, blue towers down from TOWER_BLUE_1_X.
+        bool team = i < MAX_TOWERS_PER_TEAM ? RED_TEAM : BLUE_TEAM;
+        int team_slot = i % MAX_TOWERS_PER_TEAM;
+        SDL_FPoint position = {
+            team == RED_TEAM ? TOWER_RED_1_X + team_slot * TOWER_DISTANCE_X : TOWER_BLUE_1_X - team_slot * TOWER_DISTANCE_X,
+            BUILDINGS_POS_Y};
 
         char tower_name[32];
         snprintf(tower_name, sizeof(tower_name), "tower_%d_health_value", i);
 
         create_hud_instance(state, get_hud_element_count(state->HUD_manager), tower_name, true);
-    }
 
-    for (int i = MAX_TOWERS_PER_TEAM; i < MAX_TOTAL_TOWERS; i++)
-    {
+        EcsEntity entity = Ecs_CreateEntity(state->world, TOWER_COMPONENTS);
+        if (entity == ECS_ENTITY_NONE)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Tower Init] Failed to create tower entity: %s", SDL_GetError());
+            Internal_TowerManagerCleanup(tm_state);
+            SDL_free(tm_state);
+            return NULL;
+        }
+
         tm_state->towers[i] = (TowerInstance){
-            .position = {TOWER_BLUE_1_X - (i - MAX_TOWERS_PER_TEAM) * TOWER_DISTANCE_X, BUILDINGS_POS_Y},
-            .texture = tm_state->blue_texture,
-            .current_health = TOWER_HEALTH_MAX,
-            .attack_cooldown_timer = 0.0f,
-            .team = BLUE_TEAM,
-            .teamFirstTower = (i == 3) ? true : false,
-            .immune = (i == 2) ? true : false,
             .index = i,
+            .entity = entity,
+            .attack_cooldown_timer = 0.0f,
+            .teamFirstTower = (team_slot == 1) ? true : false,
             .destroyed = false,
         };
 
-        tm_state->towers[i].rect = (SDL_FRect){
-            (TOWER_BLUE_1_X - (i - MAX_TOWERS_PER_TEAM) * TOWER_DISTANCE_X) - TOWER_RENDER_WIDTH / 2.0f,
-            BUILDINGS_POS_Y - TOWER_RENDER_HEIGHT / 2.0f,
+        *(SDL_FPoint *)Ecs_Get(state->world, entity, ECS_POSITION) = position;
+        *(SDL_FRect *)Ecs_Get(state->world, entity, ECS_BOUNDS) = (SDL_FRect){
+            position.x - TOWER_RENDER_WIDTH / 2.0f,
+            position.y - TOWER_RENDER_HEIGHT / 2.0f,
             TOWER_RENDER_WIDTH,
             TOWER_RENDER_HEIGHT};
-
-        char tower_name[32];
-        snprintf(tower_name, sizeof(tower_name), "tower_%d_health_value", i);
-
-        create_hud_instance(state, get_hud_element_count(state->HUD_manager), tower_name, true);
+        *(bool *)Ecs_Get(state->world, entity, ECS_TEAM) = team;
+        *(EcsHealth *)Ecs_Get(state->world, entity, ECS_HEALTH) = (EcsHealth){TOWER_HEALTH_MAX, TOWER_HEALTH_MAX, team_slot == 0};
+        *(EcsSprite *)Ecs_Get(state->world, entity, ECS_SPRITE) = (EcsSprite){
+            team == RED_TEAM ? tm_state->red_texture : tm_state->blue_texture,
+            tm_state->destroyed_texture,
+            TOWER_RENDER_WIDTH,
+            TOWER_RENDER_HEIGHT};
+        *(EcsHealthLabel *)Ecs_Get(state->world, entity, ECS_HEALTH_LABEL) = (EcsHealthLabel){get_hud_index_by_name(state, tower_name), -30.0f};
+        *(EcsCollider *)Ecs_Get(state->world, entity, ECS_COLLIDER) = (EcsCollider){SPATIAL_KIND_TOWER, i};
+        tm_state->tower_count = i + 1;
     }
 
-    tm_state->tower_count = MAX_TOTAL_TOWERS;
-
     // --- Register with EntityManager ---
+    // Drawing is done by the shared sprite and health label systems.
     EntityFunctions tower_funcs = {
         .name = "tower_manager",
+        .update_phase = ENTITY_PHASE_SIMULATE,
+        .reads = ENTITY_RES_SPATIAL_HASH | ENTITY_RES_WORLD,
+        .writes = ENTITY_RES_TOWERS | ENTITY_RES_ATTACKS | ENTITY_RES_NETWORK,
         .update = tower_manager_update_callback,
-        .render = tower_manager_render_callback,
+        .render = NULL,
         .cleanup = tower_manager_cleanup_callback,
         .handle_events = NULL};
 
@@ -363,39 +462,61 @@ void TowerManager_Destroy(TowerManagerState tm_state)
     }
 }
 
-void damageTower(AppState state, int towerIndex, float damageValue, bool sendToServer, float current_health)
+void TowerManager_HandleDestroyed(AppState *state, int towerIndex)
 {
-    TowerInstance *tempTower = &state.tower_manager->towers[towerIndex];
+    if (!state || !state->tower_manager || towerIndex < 0 || towerIndex >= state->tower_manager->tower_count)
+        return;
+    TowerInstance *tower = &state->tower_manager->towers[towerIndex];
+    const bool *team = Ecs_Get(state->world, tower->entity, ECS_TEAM);
+    if (!team || tower->destroyed)
+        return;
+
+    tower->destroyed = true;
+    SDL_Log("Tower %d Destroyed", towerIndex);
+    // The ruin now blocks the lane and the next building becomes the goal.
+    FlowField_Bake(state->flow_field, state);
+
+    EcsEntity next = tower->teamFirstTower ? state->tower_manager->towers[towerIndex - 1].entity
+                                           : state->base_manager->bases[*team].entity;
+    EcsHealth *next_health = Ecs_Get(state->world, next, ECS_HEALTH);
+    if (next_health)
+        next_health->immune = false;
+}
 
-    if (tempTower->immune)
+void TowerManager_NoteShot(AppState *state, int towerIndex, SDL_FPoint target_pos)
+{
+    TowerManagerState tm_state = state ? state->tower_manager : NULL;
+    if (!tm_state || state->is_server || towerIndex < 0 || towerIndex >= tm_state->tower_count)
     {
         return;
     }
-
-    if (!sendToServer)
+    TowerInstance *tower = &tm_state->towers[towerIndex];
+    const bool *team = Ecs_Get(state->world, tower->entity, ECS_TEAM);
+    if (!team)
     {
-        tempTower->current_health = current_health;
+        return;
     }
-    if (sendToServer && tempTower->current_health > 0)
+    tower->last_shot_time = state->sync_clock;
+
+    // The server aimed at the target's position; here the unit is at most one state interval off.
+    SpatialEntry entry;
+    if (SpatialHash_FindNearest(state->spatial_hash, target_pos, TOWER_TARGET_MATCH_RADIUS, SPATIAL_KIND_UNIT, !*team, &entry))
     {
-        tempTower->current_health -= damageValue;
-        current_health = tempTower->current_health;
-        NetClient_SendDamageTowerRequest(state.net_client_state, towerIndex, damageValue, current_health);
+        set_tower_target(tm_state, towerIndex, target_from_entry(state, &entry));
     }
+}
 
-    if (tempTower->current_health <= 0)
+bool TowerManager_PollTargetEvent(TowerManagerState tm_state, Uint32 *cursor, TowerTargetEvent *out_event)
+{
+    if (!tm_state || !cursor || !out_event || *cursor == tm_state->target_event_count)
     {
-        tempTower->texture = state.tower_manager->destroyed_texture;
-        tempTower->destroyed = true;
-        SDL_Log("Tower %d Destroyed", towerIndex);
-
-        if (tempTower->teamFirstTower)
-        {
-            state.tower_manager->towers[towerIndex - 1].immune = false;
-        }
-        else
-        {
-            state.base_manager->bases[tempTower->team].immune = false;
-        }
+        return false;
+    }
+    if (tm_state->target_event_count - *cursor > TOWER_TARGET_EVENT_CAPACITY)
+    {
+        *cursor = tm_state->target_event_count - TOWER_TARGET_EVENT_CAPACITY;
     }
+    *out_event = tm_state->target_events[*cursor % TOWER_TARGET_EVENT_CAPACITY];
+    (*cursor)++;
+    return true;
 }
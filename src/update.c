@@ -2,37 +2,66 @@
 
 // --- Public Functions ---
 
+void app_simulate_step(AppState *state, Uint64 step_tick)
+{
+  // Every step sees the same delta, so the outcome no longer depends on the frame rate.
+  state->delta_time = state->sim_step;
+  state->sync_clock = step_tick - state->client_start_time + state->server_start_time;
+
+  // --- Update Entities ---
+  // Delegate entity updates to the EntityManager.
+  if (state->entity_manager)
+  {
+    EntityManager_UpdateAll(state->entity_manager, state);
+  }
+  else
+  {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "EntityManager not initialized in app_update.");
+  }
+}
+
 void app_update(void *appstate)
 {
   AppState *state = (AppState *)appstate;
 
-  // --- Calculate Delta Time ---
+  if (state->sim_step <= 0.0f)
+  {
+    state->sim_step = 1.0f / (float)DEFAULT_SIM_HZ;
+  }
+
+  // --- Measure Frame Time ---
   state->last_tick = state->current_tick;
-  state->current_tick = SDL_GetTicks();
-  // Handle first frame case to avoid large initial delta_time
+  state->current_tick = SimClock_GetTicks(state->clock);
+  // Handle first frame case: simulate exactly one step
   if (state->last_tick == 0)
   {
-    state->last_tick = state->current_tick - 16; // Assume ~60 fps for first frame
+    state->last_tick = state->current_tick;
+    state->sim_accumulator = state->sim_step;
   }
-  Uint64 delta_ticks = state->current_tick - state->last_tick;
-  state->delta_time = (float)delta_ticks / 1000.0f;
-  // Clamp delta_time to prevent large jumps (e.g., after debugging pause)
-  const float max_delta_time = 0.1f; // Max delta = 100ms (10 FPS)
-  if (state->delta_time > max_delta_time)
+  Uint64 frame_ms = state->current_tick - state->last_tick;
+  // Clamp long frames (e.g., after a debugging pause) so the catch-up stays bounded
+  if (frame_ms > MAX_FRAME_TIME_MS)
   {
-    state->delta_time = max_delta_time;
+    frame_ms = MAX_FRAME_TIME_MS;
   }
+  state->sim_accumulator += (float)frame_ms / 1000.0f;
 
-  state->sync_clock = SDL_GetTicks() - state->client_start_time + state->server_start_time;
-
-  // --- Update Entities ---
-  // Delegate entity updates to the EntityManager.
-  if (state->entity_manager)
+  // --- Run Fixed Steps ---
+  int steps = 0;
+  while (state->sim_accumulator >= state->sim_step && steps < MAX_SIM_STEPS_PER_FRAME)
   {
-    EntityManager_UpdateAll(state->entity_manager, state);
+    state->sim_accumulator -= state->sim_step;
+    // Time at the end of this step; the remaining accumulator has not been simulated yet.
+    Uint64 step_tick = state->current_tick - (Uint64)(state->sim_accumulator * 1000.0f);
+    app_simulate_step(state, step_tick);
+    steps++;
   }
-  else
+  if (state->sim_accumulator >= state->sim_step)
   {
-    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "EntityManager not initialized in app_update.");
+    // Still behind after the catch-up limit: drop whole steps instead of spiralling.
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "[Update] Simulation fell behind, dropping %.1f ms.", state->sim_accumulator * 1000.0f);
+    state->sim_accumulator = SDL_fmodf(state->sim_accumulator, state->sim_step);
   }
+
+  state->render_alpha = state->sim_accumulator / state->sim_step;
 }
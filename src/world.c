@@ -0,0 +1,185 @@
+#include "../include/world.h"
+#include "../include/damage_bus.h"
+#include "../include/command_buffer.h"
+
+// --- Constants ---
+#define WORLD_SNAPSHOT_ALIGN(size) (((size) + 7) & ~(size_t)7) /**< Keeps every part of the data block 8-byte aligned. */
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Copies the health component of a building, or zero if the entity is gone.
+ */
+static void save_health(AppState *state, EcsEntity entity, EcsHealth *out)
+{
+    const EcsHealth *health = Ecs_Get(state->world, entity, ECS_HEALTH);
+    *out = health ? *health : (EcsHealth){0};
+}
+
+static void restore_health(AppState *state, EcsEntity entity, const EcsHealth *saved)
+{
+    EcsHealth *health = Ecs_Get(state->world, entity, ECS_HEALTH);
+    if (health)
+        *health = *saved;
+}
+
+static Uint32 float_bits(float value)
+{
+    Uint32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief Hashes a building's health component; a missing entity hashes as zero health.
+ */
+static Uint64 hash_health(Uint64 hash, AppState *state, EcsEntity entity)
+{
+    const EcsHealth *health = Ecs_Get(state->world, entity, ECS_HEALTH);
+    hash = World_HashStep(hash, health ? float_bits(health->current) : 0u);
+    return World_HashStep(hash, health ? health->immune : 0u);
+}
+
+static bool has_world(AppState *state)
+{
+    return state && state->player_manager && state->minion_manager && state->attack_manager &&
+           state->tower_manager && state->base_manager && state->world;
+}
+
+// --- Public API Function Implementations ---
+
+Uint64 World_HashStep(Uint64 hash, Uint64 value)
+{
+    hash ^= value;
+    hash *= 0xff51afd7ed558ccdull;
+    return hash ^ (hash >> 33);
+}
+
+Uint64 World_HashBegin(WorldHashSection section, int slot)
+{
+    return World_HashStep(0xcbf29ce484222325ull, ((Uint64)section << 32) | (Uint32)slot);
+}
+
+bool World_Save(AppState *state, WorldSnapshot **snapshot)
+{
+    if (!has_world(state) || !snapshot)
+    {
+        SDL_SetError("Invalid AppState or snapshot for World_Save");
+        return false;
+    }
+
+    size_t minion_bytes = WORLD_SNAPSHOT_ALIGN(MinionManager_GetStateSize(state->minion_manager));
+    size_t attack_bytes = WORLD_SNAPSHOT_ALIGN(AttackManager_GetStateSize(state->attack_manager));
+    size_t size = sizeof(WorldSnapshot) + minion_bytes + attack_bytes;
+    WorldSnapshot *out = *snapshot;
+    if (!out || out->size != size)
+    {
+        out = (WorldSnapshot *)SDL_realloc(out, size);
+        if (!out)
+        {
+            SDL_OutOfMemory();
+            return false;
+        }
+        *snapshot = out;
+    }
+    memset(out, 0, size);
+    out->size = size;
+    out->minion_bytes = minion_bytes;
+    out->attack_bytes = attack_bytes;
+
+    out->sync_clock = state->sync_clock;
+    out->game_state = state->currentGameState;
+    out->winning_team = state->winningTeam;
+    memcpy(out->rng, state->rng, sizeof(out->rng));
+    PlayerManager_SaveState(state->player_manager, out->players);
+    memcpy(out->towers, state->tower_manager->towers, sizeof(out->towers));
+    for (int i = 0; i < MAX_TOTAL_TOWERS; i++)
+        save_health(state, state->tower_manager->towers[i].entity, &out->tower_health[i]);
+    for (int i = 0; i < MAX_BASES; i++)
+        save_health(state, state->base_manager->bases[i].entity, &out->base_health[i]);
+
+    return MinionManager_SaveState(state->minion_manager, &out->minions, out->data) &&
+           AttackManager_SaveState(state->attack_manager, &out->attacks, out->data + minion_bytes);
+}
+
+void World_DestroySnapshot(WorldSnapshot *snapshot)
+{
+    SDL_free(snapshot);
+}
+
+bool World_Restore(AppState *state, const WorldSnapshot *snapshot)
+{
+    if (!has_world(state) || !snapshot || snapshot->size < sizeof(WorldSnapshot) + snapshot->minion_bytes + snapshot->attack_bytes)
+    {
+        SDL_SetError("Invalid AppState or snapshot for World_Restore");
+        return false;
+    }
+    if (!MinionManager_RestoreState(state->minion_manager, &snapshot->minions, snapshot->data) ||
+        !AttackManager_RestoreState(state->attack_manager, &snapshot->attacks, snapshot->data + snapshot->minion_bytes) ||
+        !PlayerManager_RestoreState(state->player_manager, snapshot->players))
+        return false;
+    // Queued hits and commands were meant for the world being replaced.
+    DamageBus_Clear(state->damage_bus);
+    CommandBuffer_Clear(state->command_buffer);
+
+    // The flow fields route around ruins, so they only need a new bake if a tower changed sides of that line.
+    bool rebake = false;
+    for (int i = 0; i < MAX_TOTAL_TOWERS; i++)
+        rebake |= state->tower_manager->towers[i].destroyed != snapshot->towers[i].destroyed;
+
+    state->sync_clock = snapshot->sync_clock;
+    state->currentGameState = snapshot->game_state;
+    state->winningTeam = snapshot->winning_team;
+    memcpy(state->rng, snapshot->rng, sizeof(state->rng));
+    memcpy(state->tower_manager->towers, snapshot->towers, sizeof(snapshot->towers));
+    for (int i = 0; i < MAX_TOTAL_TOWERS; i++)
+        restore_health(state, state->tower_manager->towers[i].entity, &snapshot->tower_health[i]);
+    for (int i = 0; i < MAX_BASES; i++)
+        restore_health(state, state->base_manager->bases[i].entity, &snapshot->base_health[i]);
+
+    SpatialHash_Rebuild(state->spatial_hash, state);
+    if (rebake)
+        FlowField_Bake(state->flow_field, state);
+    return true;
+}
+
+bool World_ComputeHash(AppState *state, WorldHash *out)
+{
+    if (!has_world(state) || !out)
+        return false;
+    memset(out, 0, sizeof(*out));
+
+    // The minion pool keeps its fold up to date as minions change; the buildings are few enough to hash here.
+    out->sections[WORLD_HASH_MINIONS] = MinionManager_GetStateHash(state->minion_manager);
+
+    for (int i = 0; i < MAX_TOTAL_TOWERS; i++)
+    {
+        const TowerInstance *tower = &state->tower_manager->towers[i];
+        Uint64 hash = World_HashBegin(WORLD_HASH_TOWERS, i);
+        hash = hash_health(hash, state, tower->entity);
+        out->sections[WORLD_HASH_TOWERS] ^= World_HashStep(hash, tower->destroyed);
+    }
+
+    for (int i = 0; i < MAX_BASES; i++)
+    {
+        out->sections[WORLD_HASH_BASES] ^= hash_health(World_HashBegin(WORLD_HASH_BASES, i), state, state->base_manager->bases[i].entity);
+    }
+
+    Uint64 hash = World_HashStep(World_HashBegin(WORLD_HASH_GAME, 0), (Uint64)state->currentGameState);
+    out->sections[WORLD_HASH_GAME] = World_HashStep(hash, state->currentGameState == GAME_STATE_FINISHED && state->winningTeam);
+    return true;
+}
+
+bool World_WriteSnapshot(const WorldSnapshot *snapshot, const char *path)
+{
+    if (!snapshot || !path)
+    {
+        SDL_SetError("Invalid snapshot or path for World_WriteSnapshot");
+        return false;
+    }
+    SDL_IOStream *file = SDL_IOFromFile(path, "wb");
+    if (!file)
+        return false;
+    bool written = SDL_WriteIO(file, snapshot, (size_t)snapshot->size) == snapshot->size;
+    return SDL_CloseIO(file) && written;
+}
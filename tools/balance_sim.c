@@ -0,0 +1,735 @@
+/**
+ * @file balance_sim.c
+ * @brief Plays many headless matches with bot players and reports how the balance values change the outcome.
+ *
+ * Every worker thread owns one headless server (no renderer, no TCP port) on its
+ * own virtual clock and process-local shared-memory segment. It starts a match once, saves the
+ * world, and then plays match after match from that save: World_Restore puts the world back,
+ * the match gets its own seed and balance values, and fixed steps run back to back until a base
+ * falls or the time limit is reached. Matches are numbered, and the seeds and values depend only
+ * on the number, so the thread count does not change which matches are played.
+ *
+ * Bots push their lane: they walk towards the enemy base, stop at the first enemy unit or
+ * building in attack range and fire at it at the configured rate. The server resolves the hits of
+ * their attacks itself (AppState.resolve_all_hits), and the player manager respawns them.
+ *
+ * Config files hold "key = value" lines ('#' starts a comment):
+ *   name = towers          Label in the report (default: the file name)
+ *   matches = 1000         Matches per variant
+ *   players = 4            Bot players, 0 .. MAX_CLIENTS, split between the teams (the first is blue)
+ *   attack_rate = 1.0      Attacks per second of every bot
+ *   max_duration = 900     Simulated seconds before a match counts as a timeout
+ *   step_ms = 16           Length of one tick
+ *   seed = 1               Base seed; match n uses seed + n
+ * and any SimTuning value (see SIM_TUNING_SCHEMA) with one or more comma-separated values, e.g.
+ *   tower_attack_damage = 40, 50, 60
+ * Every combination of the listed values is one variant; values not listed keep their defaults.
+ * The results go to stdout as JSON: win rates, match lengths and tower fall times per variant.
+ *
+ * Usage: balance_sim [--config FILE] [--threads N] [--matches N] [--verbose]
+ */
+
+#include "../include/setup.h"
+#include "../include/update.h"
+#include "../include/world.h"
+
+// --- Constants ---
+#define BALANCE_SHM_PREFIX "@balance_"
+#define BALANCE_CONNECT_TIMEOUT_MS 5000
+#define BALANCE_START_TIME_MS 1000
+#define BALANCE_NAME_LENGTH 64
+#define BALANCE_MAX_THREADS 64
+#define BALANCE_MAX_VALUES 16          /**< Values one tuning key may list. */
+#define BALANCE_MAX_VARIANTS 256       /**< Combinations of listed values. */
+#define BALANCE_BOT_SPAWN_OFFSET 300.0f /**< Distance of the spawn points from the bases, as for real players. */
+#define BALANCE_BOT_AIM_SPREAD 16.0f   /**< Bots aim up to this far off their target. */
+
+// --- Internal Structures ---
+
+/**
+ * @brief What a balance run plays.
+ */
+typedef struct BalanceConfig
+{
+  char name[BALANCE_NAME_LENGTH];
+  int matches;       /**< Matches per variant. */
+  int players;       /**< Bot players, including the server's own seat. */
+  float attack_rate; /**< Attacks per second of every bot. */
+  int max_duration;  /**< Simulated seconds before a match is stopped. */
+  int step_ms;       /**< Length of one tick in milliseconds. */
+  Uint64 seed;
+  int value_counts[BALANCE_MAX_VALUES];                 /**< Values listed per tuning key (indexed like tuning_names); 0 keeps the default. */
+  float values[BALANCE_MAX_VALUES][BALANCE_MAX_VALUES]; /**< The listed values per tuning key. */
+} BalanceConfig;
+
+/**
+ * @brief A player slot driven by a bot.
+ */
+typedef struct BalanceBot
+{
+  Uint8 id; /**< Player index (client ID) of the bot. */
+  bool team;
+  SDL_FPoint position;
+  float attack_debt; /**< Attacks owed at the configured rate; one is fired per whole unit. */
+} BalanceBot;
+
+/**
+ * @brief Outcome of one match.
+ */
+typedef struct BalanceResult
+{
+  bool finished;                            /**< A base fell before the time limit. */
+  bool winner;                              /**< Winning team, if finished. */
+  float length_s;                           /**< Simulated seconds played. */
+  float tower_fall_s[MAX_TOTAL_TOWERS];     /**< Seconds into the match each tower fell, negative if it stood. */
+  bool tower_team[MAX_TOTAL_TOWERS];
+} BalanceResult;
+
+/**
+ * @brief State shared by the worker threads.
+ */
+typedef struct BalanceRun
+{
+  const BalanceConfig *config;
+  int variants;
+  int total_matches;
+  SDL_AtomicInt next_match; /**< Number of the next match to hand out. */
+  BalanceResult *results;   /**< One entry per match, written by the thread that played it. */
+} BalanceRun;
+
+/**
+ * @brief One worker thread and the server it plays on.
+ */
+typedef struct BalanceWorker
+{
+  int index;
+  BalanceRun *run;
+  SDL_Thread *thread;
+  bool ok;           /**< Set by the thread once it finished without errors. */
+  int matches;       /**< Matches played by this thread. */
+  Uint64 ticks;      /**< Simulation steps run by this thread. */
+} BalanceWorker;
+
+// --- Static Variables ---
+
+/** Names of the SimTuning values, in schema order. */
+static const char *const tuning_names[] = {
+#define BALANCE_TUNING_NAME(name) #name,
+    SIM_TUNING_SCHEMA(BALANCE_TUNING_NAME)
+#undef BALANCE_TUNING_NAME
+};
+#define BALANCE_TUNING_COUNT ((int)SDL_arraysize(tuning_names))
+SDL_COMPILE_TIME_ASSERT(balance_tuning_fits, SDL_arraysize(tuning_names) <= BALANCE_MAX_VALUES);
+
+// --- Static Helper Functions ---
+
+static char *trim(char *text)
+{
+  while (*text == ' ' || *text == '\t')
+    text++;
+  char *end = text + SDL_strlen(text);
+  while (end > text && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+    *--end = '\0';
+  return text;
+}
+
+/**
+ * @brief Copies a label, keeping only characters that need no escaping in JSON.
+ */
+static void set_name(BalanceConfig *config, const char *name)
+{
+  size_t n = 0;
+  for (; *name && n + 1 < sizeof(config->name); ++name)
+  {
+    if (SDL_isalnum(*name) || *name == '_' || *name == '-' || *name == '.')
+      config->name[n++] = *name;
+  }
+  config->name[n] = '\0';
+}
+
+static int find_tuning(const char *key)
+{
+  for (int k = 0; k < BALANCE_TUNING_COUNT; ++k)
+  {
+    if (!SDL_strcmp(key, tuning_names[k]))
+      return k;
+  }
+  return -1;
+}
+
+/**
+ * @brief Reads the comma-separated values of a tuning key.
+ */
+static bool parse_values(const char *path, BalanceConfig *config, int k, char *text)
+{
+  config->value_counts[k] = 0;
+  char *saveptr = NULL;
+  for (char *item = SDL_strtok_r(text, ",", &saveptr); item; item = SDL_strtok_r(NULL, ",", &saveptr))
+  {
+    if (config->value_counts[k] == BALANCE_MAX_VALUES)
+      return SDL_SetError("%s: more than %d values for '%s'", path, BALANCE_MAX_VALUES, tuning_names[k]);
+    config->values[k][config->value_counts[k]++] = (float)SDL_atof(trim(item));
+  }
+  if (config->value_counts[k] == 0)
+    return SDL_SetError("%s: no value for '%s'", path, tuning_names[k]);
+  return true;
+}
+
+/**
+ * @brief Reads a config file over the defaults already in config.
+ * @return True on success, false if the file cannot be read or has an unknown key.
+ */
+static bool load_config(const char *path, BalanceConfig *config)
+{
+  char *text = (char *)SDL_LoadFile(path, NULL);
+  if (!text)
+    return false;
+
+  // Default label: the file name without directory and extension.
+  const char *base = SDL_strrchr(path, '/') ? SDL_strrchr(path, '/') + 1 : path;
+  char label[BALANCE_NAME_LENGTH];
+  SDL_strlcpy(label, base, sizeof(label));
+  char *dot = SDL_strrchr(label, '.');
+  if (dot)
+    *dot = '\0';
+  set_name(config, label);
+
+  bool ok = true;
+  char *saveptr = NULL;
+  for (char *line = SDL_strtok_r(text, "\n", &saveptr); line && ok; line = SDL_strtok_r(NULL, "\n", &saveptr))
+  {
+    char *comment = SDL_strchr(line, '#');
+    if (comment)
+      *comment = '\0';
+    char *equals = SDL_strchr(line, '=');
+    if (!equals)
+    {
+      if (*trim(line))
+        ok = SDL_SetError("%s: expected 'key = value', got '%s'", path, trim(line));
+      continue;
+    }
+    *equals = '\0';
+    const char *key = trim(line);
+    char *value = trim(equals + 1);
+
+    int tuning = find_tuning(key);
+    if (tuning >= 0)
+      ok = parse_values(path, config, tuning, value);
+    else if (!SDL_strcmp(key, "name"))
+      set_name(config, value);
+    else if (!SDL_strcmp(key, "matches"))
+      config->matches = SDL_atoi(value);
+    else if (!SDL_strcmp(key, "players"))
+      config->players = SDL_atoi(value);
+    else if (!SDL_strcmp(key, "attack_rate"))
+      config->attack_rate = (float)SDL_atof(value);
+    else if (!SDL_strcmp(key, "max_duration"))
+      config->max_duration = SDL_atoi(value);
+    else if (!SDL_strcmp(key, "step_ms"))
+      config->step_ms = SDL_atoi(value);
+    else if (!SDL_strcmp(key, "seed"))
+      config->seed = SDL_strtoull(value, NULL, 0);
+    else
+      ok = SDL_SetError("%s: unknown key '%s'", path, key);
+  }
+  SDL_free(text);
+  return ok;
+}
+
+static int count_variants(const BalanceConfig *config)
+{
+  int variants = 1;
+  for (int k = 0; k < BALANCE_TUNING_COUNT; ++k)
+    variants *= SDL_max(config->value_counts[k], 1);
+  return variants;
+}
+
+/**
+ * @brief Balance values of a variant: the variant number counts through the listed values,
+ * the first key fastest.
+ */
+static void build_variant(const BalanceConfig *config, int variant, SimTuning *out)
+{
+  SimTuning_SetDefaults(out);
+  for (int k = 0; k < BALANCE_TUNING_COUNT; ++k)
+  {
+    int count = config->value_counts[k];
+    if (count == 0)
+      continue;
+    *SimTuning_Find(out, tuning_names[k]) = config->values[k][variant % count];
+    variant /= count;
+  }
+}
+
+/**
+ * @brief Creates a headless server with all game modules that only local tools can join.
+ * @return The state, or NULL on failure.
+ */
+static AppState *create_server(SimClock clock, const BalanceConfig *config, const char *shm_name)
+{
+  AppState *state = (AppState *)SDL_calloc(1, sizeof(AppState));
+  if (!state)
+  {
+    SDL_OutOfMemory();
+    return NULL;
+  }
+  state->is_server = true;
+  state->team = BLUE_TEAM;
+  state->headless = true;
+  state->shm_name = shm_name;
+  state->shm_only = true;
+  state->resolve_all_hits = true;
+  state->clock = clock;
+  state->currentGameState = GAME_STATE_LOBBY;
+  state->job_workers = 0; // The threads run whole matches; each match stays on one.
+  state->sim_step = (float)config->step_ms / 1000.0f;
+  SimRng_SeedStreams(state->rng, config->seed);
+  SimTuning_SetDefaults(&state->tuning);
+
+  const char *failed_stage = AppSetup_InitModules(state, DEFAULT_HOSTNAME);
+  if (failed_stage)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Balance] Initialization failed at stage '%s': %s", failed_stage, SDL_GetError());
+    AppSetup_DestroyModules(state);
+    SDL_free(state);
+    return NULL;
+  }
+  return state;
+}
+
+static void destroy_server(AppState *state)
+{
+  if (!state)
+    return;
+  AppSetup_DestroyModules(state);
+  SDL_free(state);
+}
+
+/**
+ * @brief Runs the lobby until the server's own client is connected, then starts the match.
+ */
+static bool start_match(AppState *state, SimClock clock, int step_ms)
+{
+  Uint64 deadline = SimClock_GetTicks(clock) + BALANCE_CONNECT_TIMEOUT_MS;
+  while (!NetClient_IsConnected(state->net_client_state) || NetClient_GetClientID(state->net_client_state) < 0)
+  {
+    if (SimClock_GetTicks(clock) >= deadline)
+      return SDL_SetError("The server's client did not connect within %d ms of simulated time", BALANCE_CONNECT_TIMEOUT_MS);
+    SimClock_Advance(clock, (Uint64)step_ms);
+    app_update(state);
+  }
+  NetServer_StartMatch(state);
+  while (state->currentGameState != GAME_STATE_PLAYING)
+  {
+    SimClock_Advance(clock, (Uint64)step_ms);
+    app_update(state);
+  }
+  return true;
+}
+
+static SDL_FPoint spawn_point(bool team)
+{
+  return team ? (SDL_FPoint){BASE_RED_POS_X + BALANCE_BOT_SPAWN_OFFSET, BUILDINGS_POS_Y}
+              : (SDL_FPoint){BASE_BLUE_POS_X - BALANCE_BOT_SPAWN_OFFSET, BUILDINGS_POS_Y};
+}
+
+/**
+ * @brief Puts a bot's player where the bot is. Remote seats go through the same function as the
+ * messages of real clients; the server's own seat has no client, so it is moved directly.
+ */
+static void place_bot(AppState *state, const BalanceBot *bot, bool facing_left)
+{
+  PlayerManager pm = state->player_manager;
+  if (bot->id == pm->local_player_client_id)
+  {
+    PlayerInstance *p = &pm->players[bot->id];
+    *(SDL_FPoint *)Ecs_Get(state->world, p->entity, ECS_POSITION) = bot->position;
+    *(SDL_FRect *)Ecs_Get(state->world, p->entity, ECS_BOUNDS) =
+        (SDL_FRect){bot->position.x - PLAYER_WIDTH / 2.0f, bot->position.y - PLAYER_HEIGHT / 2.0f, PLAYER_WIDTH, PLAYER_HEIGHT};
+    p->flip_mode = facing_left ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+    return;
+  }
+
+  Msg_PlayerStateData player = {0};
+  player.message_type = MSG_TYPE_C_PLAYER_STATE;
+  player.client_id = bot->id;
+  player.position = bot->position;
+  player.sprite_portion = (SDL_FRect){0.0f, PLAYER_SPRITE_WALK_ROW_Y, PLAYER_SPRITE_FRAME_WIDTH, PLAYER_SPRITE_FRAME_HEIGHT};
+  player.flip_mode = facing_left ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+  player.team = bot->team;
+  player.current_health = PLAYER_HEALTH_MAX;
+  PlayerManager_UpdateRemotePlayer(state, &player);
+}
+
+/**
+ * @brief Creates the bots and their players. The server's own seat is the first bot (blue);
+ * the others alternate red and blue. With no bots the server's player leaves the match.
+ * @return Number of bots.
+ */
+static int create_bots(AppState *state, const BalanceConfig *config, BalanceBot *bots)
+{
+  int local_id = NetClient_GetClientID(state->net_client_state);
+  if (config->players == 0)
+  {
+    PlayerManager_RemovePlayer(state->player_manager, (uint8_t)local_id);
+    return 0;
+  }
+
+  const bool *local_team = Ecs_Get(state->world, state->player_manager->players[local_id].entity, ECS_TEAM);
+  bots[0] = (BalanceBot){(Uint8)local_id, local_team ? *local_team : state->team, {0.0f, 0.0f}, 0.0f};
+  int count = 1;
+  for (int id = 0; id < MAX_CLIENTS && count < config->players; ++id)
+  {
+    if (id == local_id)
+      continue;
+    bool team = (count % 2 == 1) ? RED_TEAM : BLUE_TEAM;
+    bots[count++] = (BalanceBot){(Uint8)id, team, {0.0f, 0.0f}, 0.0f};
+  }
+  for (int b = 0; b < count; ++b)
+  {
+    bots[b].position = spawn_point(bots[b].team);
+    place_bot(state, &bots[b], bots[b].team == BLUE_TEAM);
+  }
+  return count;
+}
+
+/**
+ * @brief Moves a bot one tick and fires the attacks it owes.
+ * Dead bots wait at their spawn point until the player manager revives them.
+ */
+static void drive_bot(AppState *state, BalanceBot *bot, const BalanceConfig *config, SimRng *rng)
+{
+  const PlayerInstance *p = &state->player_manager->players[bot->id];
+  float forward = bot->team == RED_TEAM ? 1.0f : -1.0f; // Red starts on the left
+  if (p->dead)
+  {
+    bot->position = spawn_point(bot->team);
+    bot->attack_debt = 0.0f;
+    place_bot(state, bot, forward < 0.0f);
+    return;
+  }
+
+  float dt = (float)config->step_ms / 1000.0f;
+  SpatialEntry target;
+  bool engaged = SpatialHash_FindNearest(state->spatial_hash, bot->position, PLAYER_ATTACK_RANGE, SPATIAL_KIND_ALL, !bot->team, &target);
+  if (!engaged)
+  {
+    // Walk up to the enemy's spawn point, which is in range of their base.
+    float goal = spawn_point(!bot->team).x;
+    bot->position.x += forward * PLAYER_SPEED * dt;
+    bot->position.x = forward > 0.0f ? SDL_min(bot->position.x, goal) : SDL_max(bot->position.x, goal);
+  }
+  place_bot(state, bot, forward < 0.0f);
+
+  bot->attack_debt += config->attack_rate * dt;
+  if (!engaged)
+  {
+    bot->attack_debt = SDL_min(bot->attack_debt, 1.0f); // Ready to fire when something comes into range
+    return;
+  }
+  for (; bot->attack_debt >= 1.0f; bot->attack_debt -= 1.0f)
+  {
+    Msg_ClientSpawnAttackData attack = {0};
+    attack.message_type = MSG_TYPE_C_SPAWN_ATTACK;
+    attack.attack_type = bot->team == RED_TEAM ? PLAYER_ATTACK_TYPE_FIREBALL : PLAYER_ATTACK_TYPE_LIGHTNING_ARROW;
+    attack.target_pos = (SDL_FPoint){target.position.x + (SimRng_Float(rng) * 2.0f - 1.0f) * BALANCE_BOT_AIM_SPREAD,
+                                     target.position.y + (SimRng_Float(rng) * 2.0f - 1.0f) * BALANCE_BOT_AIM_SPREAD};
+    attack.team = bot->team;
+    AttackManager_HandleClientSpawnRequest(state->attack_manager, state, bot->id, attack);
+  }
+}
+
+/**
+ * @brief Plays one match from the saved start and records its outcome.
+ * @return Number of simulation steps run.
+ */
+static int play_match(AppState *state, SimClock clock, const WorldSnapshot *start, const BalanceConfig *config,
+                      BalanceBot *bots, int bot_count, int match, int variant, BalanceResult *out)
+{
+  World_Restore(state, start);
+  // The last match's messages are still in both rings; the new one must not see them.
+  NetServer_DiscardPending(state->net_server_state);
+  NetClient_DiscardPending(state->net_client_state);
+  // The virtual clock only runs forward; continue the sync clock from the save instead.
+  state->client_start_time = SimClock_GetTicks(clock) - (start->sync_clock - state->server_start_time);
+  build_variant(config, variant, &state->tuning);
+  SimRng_SeedStreams(state->rng, config->seed + (Uint64)match);
+  SimRng bot_rng;
+  SimRng_Seed(&bot_rng, config->seed + (Uint64)match, SIM_RNG_STREAM_COUNT);
+  for (int b = 0; b < bot_count; ++b)
+  {
+    bots[b].position = spawn_point(bots[b].team);
+    bots[b].attack_debt = 0.0f;
+  }
+
+  memset(out, 0, sizeof(*out));
+  for (int i = 0; i < MAX_TOTAL_TOWERS; ++i)
+  {
+    const bool *team = Ecs_Get(state->world, state->tower_manager->towers[i].entity, ECS_TEAM);
+    out->tower_team[i] = team ? *team : false;
+    out->tower_fall_s[i] = -1.0f;
+  }
+
+  int max_ticks = config->max_duration * 1000 / config->step_ms;
+  int t = 0;
+  for (; t < max_ticks && state->currentGameState == GAME_STATE_PLAYING; ++t)
+  {
+    for (int b = 0; b < bot_count; ++b)
+      drive_bot(state, &bots[b], config, &bot_rng);
+    SimClock_Advance(clock, (Uint64)config->step_ms);
+    app_simulate_step(state, SimClock_GetTicks(clock));
+
+    float elapsed_s = (float)(state->sync_clock - start->sync_clock) / 1000.0f;
+    for (int i = 0; i < MAX_TOTAL_TOWERS; ++i)
+    {
+      if (out->tower_fall_s[i] < 0.0f && state->tower_manager->towers[i].destroyed)
+        out->tower_fall_s[i] = elapsed_s;
+    }
+  }
+
+  out->finished = state->currentGameState == GAME_STATE_FINISHED;
+  out->winner = state->winningTeam;
+  out->length_s = (float)(state->sync_clock - start->sync_clock) / 1000.0f;
+  return t;
+}
+
+/**
+ * @brief Thread body: sets up a server, then plays matches until none are left.
+ */
+static int worker_main(void *data)
+{
+  BalanceWorker *worker = (BalanceWorker *)data;
+  BalanceRun *run = worker->run;
+  const BalanceConfig *config = run->config;
+
+  char shm_name[MAX_NAME_LENGTH];
+  SDL_snprintf(shm_name, sizeof(shm_name), BALANCE_SHM_PREFIX "%d", worker->index);
+  SimClock clock = SimClock_CreateVirtual(BALANCE_START_TIME_MS);
+  AppState *state = clock ? create_server(clock, config, shm_name) : NULL;
+  WorldSnapshot *start = NULL;
+  BalanceBot bots[MAX_CLIENTS];
+  int bot_count = 0;
+
+  bool ready = state && start_match(state, clock, config->step_ms);
+  if (ready)
+  {
+    bot_count = create_bots(state, config, bots);
+    // One step so the bots' players exist everywhere before the save.
+    SimClock_Advance(clock, (Uint64)config->step_ms);
+    app_simulate_step(state, SimClock_GetTicks(clock));
+    ready = World_Save(state, &start);
+  }
+  if (!ready)
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Balance] Worker %d could not set up its match: %s", worker->index, SDL_GetError());
+
+  for (int match = ready ? SDL_AddAtomicInt(&run->next_match, 1) : run->total_matches; match < run->total_matches;
+       match = SDL_AddAtomicInt(&run->next_match, 1))
+  {
+    int variant = match / config->matches;
+    worker->ticks += (Uint64)play_match(state, clock, start, config, bots, bot_count, match, variant, &run->results[match]);
+    worker->matches++;
+  }
+
+  World_DestroySnapshot(start);
+  destroy_server(state);
+  SimClock_Destroy(clock);
+  worker->ok = ready;
+  return ready ? 0 : 1;
+}
+
+static int compare_floats(const void *a, const void *b)
+{
+  float x = *(const float *)a;
+  float y = *(const float *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Sorts the values and prints {"count", "mean", "p10", "p50", "p90"} in seconds.
+ */
+static void print_distribution(float *values, int count)
+{
+  if (count == 0)
+  {
+    printf("{\"count\": 0}");
+    return;
+  }
+  SDL_qsort(values, (size_t)count, sizeof(float), compare_floats);
+  double sum = 0.0;
+  for (int i = 0; i < count; ++i)
+    sum += values[i];
+  printf("{\"count\": %d, \"mean\": %.2f, \"p10\": %.2f, \"p50\": %.2f, \"p90\": %.2f}", count, sum / count,
+         values[(count - 1) / 10], values[(count - 1) / 2], values[(count - 1) * 9 / 10]);
+}
+
+/**
+ * @brief Prints the results as one JSON object on stdout.
+ */
+static void report_json(const BalanceRun *run, int threads, Uint64 wall_ns, Uint64 ticks)
+{
+  const BalanceConfig *config = run->config;
+  double wall_s = (double)wall_ns / 1e9;
+  printf("{\n");
+  printf("  \"config\": \"%s\",\n", config->name);
+  printf("  \"players\": %d,\n  \"attack_rate\": %.3f,\n  \"max_duration\": %d,\n  \"step_ms\": %d,\n", config->players,
+         config->attack_rate, config->max_duration, config->step_ms);
+  printf("  \"threads\": %d,\n  \"matches\": %d,\n  \"wall_s\": %.3f,\n  \"matches_per_sec\": %.2f,\n  \"ticks_per_sec\": %.1f,\n",
+         threads, run->total_matches, wall_s, run->total_matches / wall_s, (double)ticks / wall_s);
+  printf("  \"variants\": [");
+
+  float *scratch = (float *)SDL_malloc((size_t)config->matches * sizeof(float));
+  for (int v = 0; v < run->variants && scratch; ++v)
+  {
+    const BalanceResult *results = &run->results[v * config->matches];
+    SimTuning tuning;
+    build_variant(config, v, &tuning);
+
+    int wins[2] = {0, 0};
+    int finished = 0;
+    for (int m = 0; m < config->matches; ++m)
+    {
+      if (results[m].finished)
+      {
+        wins[results[m].winner]++;
+        scratch[finished++] = results[m].length_s;
+      }
+    }
+
+    printf("%s\n    {\n      \"tuning\": {", v ? "," : "");
+    for (int k = 0; k < BALANCE_TUNING_COUNT; ++k)
+      printf("%s\"%s\": %.3f", k ? ", " : "", tuning_names[k], *SimTuning_Find(&tuning, tuning_names[k]));
+    printf("},\n");
+    printf("      \"blue_wins\": %d, \"red_wins\": %d, \"timeouts\": %d,\n", wins[BLUE_TEAM], wins[RED_TEAM], config->matches - finished);
+    printf("      \"blue_win_rate\": %.4f, \"red_win_rate\": %.4f,\n", (double)wins[BLUE_TEAM] / config->matches,
+           (double)wins[RED_TEAM] / config->matches);
+    printf("      \"length_s\": ");
+    print_distribution(scratch, finished);
+    printf(",\n      \"tower_falls\": [");
+    for (int i = 0; i < MAX_TOTAL_TOWERS; ++i)
+    {
+      int falls = 0;
+      for (int m = 0; m < config->matches; ++m)
+      {
+        if (results[m].tower_fall_s[i] >= 0.0f)
+          scratch[falls++] = results[m].tower_fall_s[i];
+      }
+      printf("%s\n        {\"tower\": %d, \"team\": \"%s\", \"fall_rate\": %.4f, \"fall_s\": ", i ? "," : "", i,
+             results[0].tower_team[i] == RED_TEAM ? "red" : "blue", (double)falls / config->matches);
+      print_distribution(scratch, falls);
+      printf("}");
+    }
+    printf("\n      ]\n    }");
+  }
+  printf("\n  ]\n}\n");
+  fflush(stdout);
+  SDL_free(scratch);
+}
+
+// --- Entry Point ---
+
+int main(int argc, char **argv)
+{
+  BalanceConfig config = {"default", 100, 4, 1.0f, 900, 16, 1, {0}, {{0}}};
+  const char *config_path = NULL;
+  int threads = 0;
+  int matches = 0;
+  bool verbose = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!strcmp(argv[i], "--config") && (i + 1 < argc))
+    {
+      config_path = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--threads") && (i + 1 < argc))
+    {
+      threads = SDL_atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--matches") && (i + 1 < argc))
+    {
+      matches = SDL_atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--verbose"))
+    {
+      verbose = true;
+    }
+  }
+  if (config_path && !load_config(config_path, &config))
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Balance] Config '%s': %s", config_path, SDL_GetError());
+    return 1;
+  }
+  if (matches > 0)
+    config.matches = matches;
+  config.matches = SDL_max(config.matches, 1);
+  config.players = CLAMP(config.players, 0, MAX_CLIENTS);
+  config.attack_rate = SDL_max(config.attack_rate, 0.0f);
+  config.max_duration = SDL_max(config.max_duration, 1);
+  config.step_ms = CLAMP(config.step_ms, 1, 100);
+
+  BalanceRun run = {0};
+  run.config = &config;
+  run.variants = count_variants(&config);
+  if (run.variants > BALANCE_MAX_VARIANTS)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Balance] %d variants, at most %d are supported.", run.variants, BALANCE_MAX_VARIANTS);
+    return 1;
+  }
+  run.total_matches = run.variants * config.matches;
+
+  // Thousands of matches would otherwise log every spawn and hit.
+  if (!verbose)
+    SDL_SetLogPriorities(SDL_LOG_PRIORITY_WARN);
+  if (!SDL_Init(0) || !SDLNet_Init() || !TTF_Init())
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Balance] SDL initialization failed: %s", SDL_GetError());
+    return 1;
+  }
+  if (threads <= 0)
+    threads = SDL_GetNumLogicalCPUCores();
+  threads = CLAMP(threads, 1, SDL_min(BALANCE_MAX_THREADS, run.total_matches));
+
+  int result = 1;
+  BalanceWorker workers[BALANCE_MAX_THREADS];
+  run.results = (BalanceResult *)SDL_calloc((size_t)run.total_matches, sizeof(BalanceResult));
+  if (!run.results)
+    goto done;
+
+  SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Balance] %d variants x %d matches on %d threads", run.variants, config.matches, threads);
+  Uint64 start = SDL_GetTicksNS();
+  for (int w = 0; w < threads; ++w)
+  {
+    workers[w] = (BalanceWorker){w, &run, NULL, false, 0, 0};
+    workers[w].thread = SDL_CreateThread(worker_main, "balance_worker", &workers[w]);
+    if (!workers[w].thread)
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Balance] SDL_CreateThread failed: %s", SDL_GetError());
+  }
+  bool all_ok = true;
+  Uint64 ticks = 0;
+  int played = 0;
+  for (int w = 0; w < threads; ++w)
+  {
+    SDL_WaitThread(workers[w].thread, NULL);
+    all_ok &= workers[w].ok;
+    ticks += workers[w].ticks;
+    played += workers[w].matches;
+  }
+  Uint64 wall_ns = SDL_GetTicksNS() - start;
+
+  // A worker that failed to set up leaves its share to the others; only a shortfall is an error.
+  if (played < run.total_matches)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Balance] Only %d of %d matches were played.", played, run.total_matches);
+    goto done;
+  }
+  if (!all_ok)
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "[Balance] Some workers failed; the others played their matches.");
+  report_json(&run, threads, wall_ns, ticks);
+  result = 0;
+
+done:
+  SDL_free(run.results);
+  TTF_Quit();
+  SDLNet_Quit();
+  SDL_Quit();
+  return result;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file bench_kernels.c
+ * @brief Measures the per-step minion kernels against the old array-of-structs layout.
+ *
+ * Runs movement, cooldown and animation updates for a large pool three ways:
+ * the fat per-minion record the game used before (one struct per minion, scalar loop),
+ * the structure-of-arrays pool with the scalar fallback, and the same pool with the
+ * widest vector path compiled in. Also checks that the scalar and vector paths agree.
+ *
+ * Usage: bench_kernels [--entities N] [--steps S]
+ */
+
+#include "../include/sim_kernels.h"
+
+// --- Constants ---
+#define BENCH_DEFAULT_ENTITIES 10000
+#define BENCH_DEFAULT_STEPS 2000
+#define BENCH_STEP (1.0f / 60.0f)
+#define BENCH_FRAME_TIME 0.1f
+#define BENCH_FRAME_COUNT 6
+
+// --- Internal Structures ---
+
+/**
+ * @brief Copy of the per-minion record before the hot/cold split, used as the baseline.
+ */
+typedef struct LegacyMinion
+{
+  bool team;
+  SDL_FPoint position;
+  SDL_FPoint prev_position;
+  SDL_FRect sprite_portion;
+  SDL_FlipMode flip_mode;
+  bool active;
+  bool is_attacking;
+  SDL_Texture *texture;
+  int current_health;
+  float anim_timer;
+  int current_frame;
+  float attack_cooldown_timer;
+  SDL_FPoint velocity;
+  uint8_t generation;
+  SDL_FPoint net_from;
+  SDL_FPoint net_to;
+  float net_lerp_t;
+} LegacyMinion;
+
+/**
+ * @brief Structure-of-arrays pool with the same per-step fields as the minion archetype's columns.
+ */
+typedef struct BenchPool
+{
+  float *pos_x, *pos_y, *vel_x, *vel_y, *cooldown, *anim_timer;
+  Sint32 *frame;
+} BenchPool;
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Deterministic pseudo-random float in [0, 1).
+ */
+static float bench_random(Uint32 *seed)
+{
+  *seed = *seed * 1664525u + 1013904223u;
+  return (float)(*seed >> 8) / 16777216.0f;
+}
+
+static bool pool_alloc(BenchPool *pool, int count)
+{
+  size_t bytes = (size_t)SIM_KERNEL_PAD(count) * sizeof(float);
+  pool->pos_x = SDL_calloc(1, bytes);
+  pool->pos_y = SDL_calloc(1, bytes);
+  pool->vel_x = SDL_calloc(1, bytes);
+  pool->vel_y = SDL_calloc(1, bytes);
+  pool->cooldown = SDL_calloc(1, bytes);
+  pool->anim_timer = SDL_calloc(1, bytes);
+  pool->frame = SDL_calloc(1, bytes);
+  return pool->pos_x && pool->pos_y && pool->vel_x && pool->vel_y && pool->cooldown && pool->anim_timer && pool->frame;
+}
+
+static void pool_free(BenchPool *pool)
+{
+  SDL_free(pool->pos_x);
+  SDL_free(pool->pos_y);
+  SDL_free(pool->vel_x);
+  SDL_free(pool->vel_y);
+  SDL_free(pool->cooldown);
+  SDL_free(pool->anim_timer);
+  SDL_free(pool->frame);
+}
+
+static void pool_fill(BenchPool *pool, LegacyMinion *legacy, int count)
+{
+  Uint32 seed = 12345;
+  for (int i = 0; i < count; ++i)
+  {
+    pool->pos_x[i] = bench_random(&seed) * 3200.0f;
+    pool->pos_y[i] = bench_random(&seed) * 1500.0f;
+    pool->vel_x[i] = (bench_random(&seed) - 0.5f) * 300.0f;
+    pool->vel_y[i] = (bench_random(&seed) - 0.5f) * 300.0f;
+    pool->cooldown[i] = bench_random(&seed);
+    pool->anim_timer[i] = bench_random(&seed) * BENCH_FRAME_TIME;
+    pool->frame[i] = (Sint32)(bench_random(&seed) * BENCH_FRAME_COUNT);
+
+    if (legacy)
+    {
+      legacy[i].active = true;
+      legacy[i].position = (SDL_FPoint){pool->pos_x[i], pool->pos_y[i]};
+      legacy[i].velocity = (SDL_FPoint){pool->vel_x[i], pool->vel_y[i]};
+      legacy[i].attack_cooldown_timer = pool->cooldown[i];
+      legacy[i].anim_timer = pool->anim_timer[i];
+      legacy[i].current_frame = pool->frame[i];
+    }
+  }
+}
+
+static void step_legacy(LegacyMinion *legacy, int count)
+{
+  for (int i = 0; i < count; ++i)
+  {
+    LegacyMinion *m = &legacy[i];
+    if (!m->active)
+      continue;
+    m->position.x += m->velocity.x * BENCH_STEP;
+    m->position.y += m->velocity.y * BENCH_STEP;
+    m->attack_cooldown_timer = SDL_max(m->attack_cooldown_timer - BENCH_STEP, 0.0f);
+    m->anim_timer += BENCH_STEP;
+    if (m->anim_timer >= BENCH_FRAME_TIME)
+    {
+      m->anim_timer -= BENCH_FRAME_TIME;
+      m->current_frame = (m->current_frame + 1) % BENCH_FRAME_COUNT;
+    }
+  }
+}
+
+static void step_pool(BenchPool *pool, int count)
+{
+  SimKernel_Integrate(pool->pos_x, pool->pos_y, pool->vel_x, pool->vel_y, count, BENCH_STEP);
+  SimKernel_Countdown(pool->cooldown, count, BENCH_STEP);
+  SimKernel_StepAnimation(pool->anim_timer, pool->frame, count, BENCH_STEP, BENCH_FRAME_TIME, BENCH_FRAME_COUNT);
+}
+
+/**
+ * @brief Prints one result row.
+ * @param checksum Sum of positions, printed so the work cannot be optimized away.
+ */
+static void report(const char *name, Uint64 elapsed_ns, int count, int steps, double checksum)
+{
+  double ns_per_entity = (double)elapsed_ns / ((double)count * (double)steps);
+  SDL_Log("%-14s %10.3f ms total %8.3f ns/entity/step  (checksum %.1f)",
+          name, (double)elapsed_ns / 1e6, ns_per_entity, checksum);
+}
+
+static double pool_checksum(const BenchPool *pool, int count)
+{
+  double sum = 0.0;
+  for (int i = 0; i < count; ++i)
+    sum += pool->pos_x[i] + pool->pos_y[i] + pool->frame[i];
+  return sum;
+}
+
+// --- Entry Point ---
+
+int main(int argc, char **argv)
+{
+  int count = BENCH_DEFAULT_ENTITIES;
+  int steps = BENCH_DEFAULT_STEPS;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!SDL_strcmp(argv[i], "--entities") && (i + 1 < argc))
+    {
+      count = SDL_atoi(argv[++i]);
+    }
+    else if (!SDL_strcmp(argv[i], "--steps") && (i + 1 < argc))
+    {
+      steps = SDL_atoi(argv[++i]);
+    }
+  }
+  count = SDL_max(count, 1);
+  steps = SDL_max(steps, 1);
+
+  LegacyMinion *legacy = SDL_calloc((size_t)count, sizeof(LegacyMinion));
+  BenchPool scalar_pool = {0};
+  BenchPool vector_pool = {0};
+  int result = 1;
+
+  if (!legacy || !pool_alloc(&scalar_pool, count) || !pool_alloc(&vector_pool, count))
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] Out of memory for %d entities.", count);
+    goto done;
+  }
+
+  pool_fill(&scalar_pool, legacy, count);
+  pool_fill(&vector_pool, NULL, count);
+  SDL_Log("[Bench] %d entities, %d steps, vector path: %s", count, steps, SimKernel_GetBackendName());
+
+  // --- Array of Structs Baseline ---
+  Uint64 start = SDL_GetTicksNS();
+  for (int s = 0; s < steps; ++s)
+    step_legacy(legacy, count);
+  double legacy_sum = 0.0;
+  for (int i = 0; i < count; ++i)
+    legacy_sum += legacy[i].position.x + legacy[i].position.y + legacy[i].current_frame;
+  report("aos-scalar", SDL_GetTicksNS() - start, count, steps, legacy_sum);
+
+  // --- Structure of Arrays, Scalar Fallback ---
+  SimKernel_SetScalarOnly(true);
+  start = SDL_GetTicksNS();
+  for (int s = 0; s < steps; ++s)
+    step_pool(&scalar_pool, count);
+  report("soa-scalar", SDL_GetTicksNS() - start, count, steps, pool_checksum(&scalar_pool, count));
+
+  // --- Structure of Arrays, Vector Path ---
+  SimKernel_SetScalarOnly(false);
+  start = SDL_GetTicksNS();
+  for (int s = 0; s < steps; ++s)
+    step_pool(&vector_pool, count);
+  report("soa-vector", SDL_GetTicksNS() - start, count, steps, pool_checksum(&vector_pool, count));
+
+  // --- Scalar and Vector Paths Must Agree ---
+  int mismatched = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    if (scalar_pool.pos_x[i] != vector_pool.pos_x[i] || scalar_pool.pos_y[i] != vector_pool.pos_y[i] ||
+        scalar_pool.cooldown[i] != vector_pool.cooldown[i] || scalar_pool.frame[i] != vector_pool.frame[i])
+      mismatched++;
+  }
+  SDL_Log("[Bench] %s: %d of %d entities differ between scalar and vector paths.",
+          mismatched ? "FAILED" : "OK", mismatched, count);
+  result = mismatched ? 1 : 0;
+
+done:
+  SDL_free(legacy);
+  pool_free(&scalar_pool);
+  pool_free(&vector_pool);
+  return result;
+}
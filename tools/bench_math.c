@@ -0,0 +1,204 @@
+/**
+ * @file bench_math.c
+ * @brief Compares the fixed-point simulation math with the float path it replaces.
+ *
+ * Runs length, normalize and atan2 over the same random vectors (in the range of world
+ * positions and velocities) with the C library floats and with the Fixed functions, and
+ * reports operations per second and the largest difference between the two. Also prints
+ * a checksum of the fixed results: it must be the same for every compiler, flag set and
+ * CPU, which is the point of the fixed path.
+ *
+ * Usage: bench_math [--count N] [--rounds R]
+ */
+
+#include "../include/sim_math.h"
+#include "../include/sim_rng.h"
+
+// --- Constants ---
+#define BENCH_DEFAULT_COUNT 4096
+#define BENCH_DEFAULT_ROUNDS 500
+#define BENCH_VECTOR_RANGE 4096.0f /**< Components are drawn from -range .. range. */
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Prints one result row.
+ */
+static void report(const char *name, Uint64 elapsed_ns, Uint64 operations)
+{
+  double seconds = (double)elapsed_ns / 1e9;
+  SDL_Log("%-16s %12.1f Mops/s %8.2f ns/op", name, (double)operations / seconds / 1e6, seconds * 1e9 / (double)operations);
+}
+
+/**
+ * @brief FNV-1a over the raw bits of a Fixed result.
+ */
+static Uint64 hash_fixed(Uint64 hash, Fixed value)
+{
+  Uint32 bits = (Uint32)value;
+  for (int b = 0; b < 4; ++b)
+  {
+    hash ^= (bits >> (b * 8)) & 0xffu;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// --- Entry Point ---
+
+int main(int argc, char **argv)
+{
+  int count = BENCH_DEFAULT_COUNT;
+  int rounds = BENCH_DEFAULT_ROUNDS;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!SDL_strcmp(argv[i], "--count") && (i + 1 < argc))
+    {
+      count = SDL_atoi(argv[++i]);
+    }
+    else if (!SDL_strcmp(argv[i], "--rounds") && (i + 1 < argc))
+    {
+      rounds = SDL_atoi(argv[++i]);
+    }
+  }
+  count = SDL_max(count, 1);
+  rounds = SDL_max(rounds, 1);
+
+  float *fx = SDL_malloc((size_t)count * sizeof(float));
+  float *fy = SDL_malloc((size_t)count * sizeof(float));
+  Fixed *qx = SDL_malloc((size_t)count * sizeof(Fixed));
+  Fixed *qy = SDL_malloc((size_t)count * sizeof(Fixed));
+  if (!fx || !fy || !qx || !qy)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] Out of memory for %d vectors.", count);
+    SDL_free(fx);
+    SDL_free(fy);
+    SDL_free(qx);
+    SDL_free(qy);
+    return 1;
+  }
+
+  SimRng rng;
+  SimRng_Seed(&rng, SIM_RNG_DEFAULT_SEED, 0);
+  for (int i = 0; i < count; ++i)
+  {
+    fx[i] = (SimRng_Float(&rng) * 2.0f - 1.0f) * BENCH_VECTOR_RANGE;
+    fy[i] = (SimRng_Float(&rng) * 2.0f - 1.0f) * BENCH_VECTOR_RANGE;
+    qx[i] = Fixed_FromFloat(fx[i]);
+    qy[i] = Fixed_FromFloat(fy[i]);
+  }
+
+  SDL_Log("[Bench] %d vectors x %d rounds, game built with SimMath backend \"%s\"", count, rounds, SimMath_GetBackendName());
+  Uint64 operations = (Uint64)count * (Uint64)rounds;
+  volatile float float_sink = 0.0f;
+  volatile Fixed fixed_sink = 0;
+
+  // --- Length ---
+  Uint64 start = SDL_GetTicksNS();
+  for (int r = 0; r < rounds; ++r)
+  {
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i)
+      sum += SDL_sqrtf(fx[i] * fx[i] + fy[i] * fy[i]);
+    float_sink = sum;
+  }
+  report("length float", SDL_GetTicksNS() - start, operations);
+
+  start = SDL_GetTicksNS();
+  for (int r = 0; r < rounds; ++r)
+  {
+    Fixed sum = 0;
+    for (int i = 0; i < count; ++i)
+      sum += Fixed_Length(qx[i], qy[i]) >> 8;
+    fixed_sink = sum;
+  }
+  report("length fixed", SDL_GetTicksNS() - start, operations);
+
+  // --- Normalize ---
+  start = SDL_GetTicksNS();
+  for (int r = 0; r < rounds; ++r)
+  {
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i)
+    {
+      float length = SDL_sqrtf(fx[i] * fx[i] + fy[i] * fy[i]);
+      sum += fx[i] / length + fy[i] / length;
+    }
+    float_sink = sum;
+  }
+  report("normalize float", SDL_GetTicksNS() - start, operations);
+
+  start = SDL_GetTicksNS();
+  for (int r = 0; r < rounds; ++r)
+  {
+    Fixed sum = 0;
+    for (int i = 0; i < count; ++i)
+    {
+      Fixed x = qx[i];
+      Fixed y = qy[i];
+      Fixed_Normalize(&x, &y);
+      sum += x + y;
+    }
+    fixed_sink = sum;
+  }
+  report("normalize fixed", SDL_GetTicksNS() - start, operations);
+
+  // --- Atan2 ---
+  start = SDL_GetTicksNS();
+  for (int r = 0; r < rounds; ++r)
+  {
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i)
+      sum += SDL_atan2f(fy[i], fx[i]);
+    float_sink = sum;
+  }
+  report("atan2 float", SDL_GetTicksNS() - start, operations);
+
+  start = SDL_GetTicksNS();
+  for (int r = 0; r < rounds; ++r)
+  {
+    Fixed sum = 0;
+    for (int i = 0; i < count; ++i)
+      sum += Fixed_Atan2(qy[i], qx[i]);
+    fixed_sink = sum;
+  }
+  report("atan2 fixed", SDL_GetTicksNS() - start, operations);
+  (void)float_sink;
+  (void)fixed_sink;
+
+  // --- Accuracy and Checksum ---
+  float length_error = 0.0f;
+  float normal_error = 0.0f;
+  float angle_error = 0.0f;
+  Uint64 checksum = 1469598103934665603ull;
+  for (int i = 0; i < count; ++i)
+  {
+    float length = SDL_sqrtf(fx[i] * fx[i] + fy[i] * fy[i]);
+    Fixed fixed_length = Fixed_Length(qx[i], qy[i]);
+    length_error = SDL_max(length_error, SDL_fabsf(Fixed_ToFloat(fixed_length) - length));
+
+    Fixed x = qx[i];
+    Fixed y = qy[i];
+    Fixed_Normalize(&x, &y);
+    normal_error = SDL_max(normal_error, SDL_fabsf(Fixed_ToFloat(x) - fx[i] / length));
+    normal_error = SDL_max(normal_error, SDL_fabsf(Fixed_ToFloat(y) - fy[i] / length));
+
+    Fixed angle = Fixed_Atan2(qy[i], qx[i]);
+    angle_error = SDL_max(angle_error, SDL_fabsf(Fixed_ToFloat(angle) - SDL_atan2f(fy[i], fx[i])));
+
+    checksum = hash_fixed(checksum, fixed_length);
+    checksum = hash_fixed(checksum, x);
+    checksum = hash_fixed(checksum, y);
+    checksum = hash_fixed(checksum, angle);
+  }
+  SDL_Log("[Bench] Largest difference to float: length %.6f px, normalize %.6f, atan2 %.6f rad",
+          length_error, normal_error, angle_error);
+  SDL_Log("[Bench] Fixed checksum: %016" SDL_PRIx64 " (identical on every build)", checksum);
+
+  SDL_free(fx);
+  SDL_free(fy);
+  SDL_free(qx);
+  SDL_free(qy);
+  return 0;
+}
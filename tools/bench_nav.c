@@ -0,0 +1,203 @@
+/**
+ * @file bench_nav.c
+ * @brief Measures path queries per second on the game map.
+ *
+ * Loads the terrain of resources/Map/tiledMap.json (buildings need the full game and are
+ * left out) and answers the same random queries four ways: plain A* over the whole grid,
+ * the hierarchical search with every waypoint refined, the hierarchical route alone with
+ * an empty cache, and routes to a few shared goals with a warm cache, as bots converging
+ * on objectives would ask for them. Also reports how much longer the hierarchical paths are.
+ *
+ * Usage: bench_nav [--queries N]
+ */
+
+#include "../include/nav_grid.h"
+#include "../include/player.h"
+
+// --- Constants ---
+#define BENCH_DEFAULT_QUERIES 20000
+#define BENCH_MAX_POINTS 4096 /**< Waypoints buffer of the plain A* runs. */
+#define BENCH_HOTSPOTS 6      /**< Shared goals of the warm-cache run. */
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Deterministic pseudo-random integer in [0, range).
+ */
+static int bench_random(Uint32 *seed, int range)
+{
+  *seed = *seed * 1664525u + 1013904223u;
+  return (int)((Uint64)(*seed >> 8) * (Uint64)range >> 24);
+}
+
+/**
+ * @brief Picks the center of a random tile that no obstacle covers.
+ */
+static SDL_FPoint random_open_point(Uint32 *seed, SDL_Point size, const SDL_FRect *blocked, int count, SDL_FPoint clearance)
+{
+  for (;;)
+  {
+    SDL_FPoint point = {(bench_random(seed, size.x / MAP_TILE_WIDTH) + 0.5f) * MAP_TILE_WIDTH,
+                        (bench_random(seed, size.y / MAP_TILE_HEIGHT) + 0.5f) * MAP_TILE_HEIGHT};
+    bool open = true;
+    for (int i = 0; i < count && open; ++i)
+    {
+      SDL_FRect area = Collision_InflateRect(&blocked[i], clearance);
+      open = !SDL_PointInRectFloat(&point, &area);
+    }
+    if (open)
+      return point;
+  }
+}
+
+static float segment_length(SDL_FPoint a, SDL_FPoint b)
+{
+  float dx = b.x - a.x;
+  float dy = b.y - a.y;
+  return SDL_sqrtf(dx * dx + dy * dy);
+}
+
+/**
+ * @brief Prints one result row.
+ */
+static void report(const char *name, Uint64 elapsed_ns, int queries, int failed)
+{
+  double seconds = (double)elapsed_ns / 1e9;
+  SDL_Log("%-12s %12.0f queries/s %10.2f us/query  (%d without a path)",
+          name, queries / seconds, seconds * 1e6 / queries, failed);
+}
+
+// --- Entry Point ---
+
+int main(int argc, char **argv)
+{
+  int queries = BENCH_DEFAULT_QUERIES;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!SDL_strcmp(argv[i], "--queries") && (i + 1 < argc))
+    {
+      queries = SDL_atoi(argv[++i]);
+    }
+  }
+  queries = SDL_max(queries, 1);
+
+  SDL_FRect blocked[MAP_MAX_COLLISION_RECTS];
+  int blocked_count = 0;
+  SDL_Point size = {0, 0};
+  if (!Map_LoadCollisionLayer(MAP_FILE_PATH, blocked, &blocked_count, &size))
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] %s", SDL_GetError());
+    return 1;
+  }
+
+  SDL_FPoint clearance = {PLAYER_WIDTH / 2.0f, PLAYER_HEIGHT / 2.0f};
+  Uint64 start = SDL_GetTicksNS();
+  NavGrid ng = NavGrid_Create(size.x, size.y, blocked, blocked_count, clearance);
+  if (!ng)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] Failed to build the grid: %s", SDL_GetError());
+    return 1;
+  }
+  SDL_Log("[Bench] %dx%d px map, %d collision rects, grid built in %.2f ms, %d queries",
+          size.x, size.y, blocked_count, (double)(SDL_GetTicksNS() - start) / 1e6, queries);
+
+  SDL_FPoint *ends = SDL_malloc((size_t)queries * 2 * sizeof(SDL_FPoint));
+  SDL_FPoint *points = SDL_malloc(BENCH_MAX_POINTS * sizeof(SDL_FPoint));
+  NavPath *path = SDL_malloc(sizeof(NavPath));
+  int result = 1;
+  if (!ends || !points || !path)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] Out of memory for %d queries.", queries);
+    goto done;
+  }
+
+  Uint32 seed = 12345;
+  for (int i = 0; i < queries * 2; ++i)
+    ends[i] = random_open_point(&seed, size, blocked, blocked_count, clearance);
+
+  // --- Plain A* ---
+  double direct_length = 0.0;
+  int failed = 0;
+  start = SDL_GetTicksNS();
+  for (int q = 0; q < queries; ++q)
+  {
+    int count = NavGrid_FindDirectPath(ng, ends[q * 2], ends[q * 2 + 1], points, BENCH_MAX_POINTS);
+    if (count < 0)
+    {
+      failed++;
+      continue;
+    }
+    SDL_FPoint at = ends[q * 2];
+    for (int p = 0; p < count; ++p)
+    {
+      direct_length += segment_length(at, points[p]);
+      at = points[p];
+    }
+  }
+  report("astar", SDL_GetTicksNS() - start, queries, failed);
+
+  // --- Hierarchical, Fully Refined ---
+  double route_length = 0.0;
+  failed = 0;
+  start = SDL_GetTicksNS();
+  for (int q = 0; q < queries; ++q)
+  {
+    NavGrid_ClearCache(ng);
+    if (!NavGrid_FindPath(ng, ends[q * 2], ends[q * 2 + 1], path))
+    {
+      failed++;
+      continue;
+    }
+    SDL_FPoint at = ends[q * 2];
+    SDL_FPoint next;
+    while (NavGrid_NextWaypoint(ng, path, &next))
+    {
+      route_length += segment_length(at, next);
+      at = next;
+    }
+  }
+  report("hpa-refined", SDL_GetTicksNS() - start, queries, failed);
+
+  // --- Hierarchical Route Only ---
+  failed = 0;
+  start = SDL_GetTicksNS();
+  for (int q = 0; q < queries; ++q)
+  {
+    NavGrid_ClearCache(ng);
+    if (!NavGrid_FindPath(ng, ends[q * 2], ends[q * 2 + 1], path))
+      failed++;
+  }
+  report("hpa-route", SDL_GetTicksNS() - start, queries, failed);
+
+  // --- Shared Goals, Warm Cache ---
+  SDL_FPoint hotspots[BENCH_HOTSPOTS];
+  for (int h = 0; h < BENCH_HOTSPOTS; ++h)
+    hotspots[h] = random_open_point(&seed, size, blocked, blocked_count, clearance);
+  NavStats before;
+  NavStats after;
+  NavGrid_ClearCache(ng);
+  NavGrid_GetStats(ng, &before);
+  failed = 0;
+  start = SDL_GetTicksNS();
+  for (int q = 0; q < queries; ++q)
+  {
+    if (!NavGrid_FindPath(ng, ends[q * 2], hotspots[q % BENCH_HOTSPOTS], path))
+      failed++;
+  }
+  report("hpa-cached", SDL_GetTicksNS() - start, queries, failed);
+  NavGrid_GetStats(ng, &after);
+
+  SDL_Log("[Bench] Cache hits: %.1f%% of the shared-goal queries.",
+          100.0 * (double)(after.cache_hits - before.cache_hits) / (double)(after.queries - before.queries));
+  SDL_Log("[Bench] Hierarchical paths are %.2f%% longer than plain A*.",
+          direct_length > 0.0 ? 100.0 * (route_length / direct_length - 1.0) : 0.0);
+  result = 0;
+
+done:
+  SDL_free(ends);
+  SDL_free(points);
+  SDL_free(path);
+  NavGrid_Destroy(ng);
+  return result;
+}
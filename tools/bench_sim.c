@@ -0,0 +1,475 @@
+/**
+ * @file bench_sim.c
+ * @brief Measures the cost of the simulation alone, without rendering or remote peers.
+ *
+ * Creates one headless server (no renderer, the video subsystem is never
+ * initialized) on a virtual clock, starts a match and runs fixed simulation steps back to back.
+ * Bot players stand in for clients: they walk their lane and fire at the rate the scenario asks
+ * for, entering the game through the same functions as the messages of real clients.
+ * Only the steps are timed. The results go to stdout as JSON: ticks per second, tick time
+ * percentiles, allocations, the mean and peak minion count and the time of every system
+ * (EntityManager entity) and phase.
+ *
+ * Scenario files hold "key = value" lines ('#' starts a comment):
+ *   name = lane           Label in the report (default: the file name)
+ *   players = 3           Bot players besides the server's own, 0 .. MAX_CLIENTS - 1
+ *   minion_waves = 0      Extra minion waves spawned at the start, on top of the regular ones
+ *   attack_rate = 1.0     Attacks per second of every bot
+ *   duration = 120        Simulated seconds
+ *   step_ms = 16          Length of one tick
+ *   seed = 1              Seed of the match and of the bots
+ *
+ * Usage: bench_sim [--scenario FILE] [--jobs N]
+ */
+
+#include "../include/setup.h"
+#include "../include/update.h"
+
+// --- Constants ---
+#define BENCH_SHM_NAME "@bench_sim"
+#define BENCH_CONNECT_TIMEOUT_MS 5000
+#define BENCH_START_TIME_MS 1000
+#define BENCH_NAME_LENGTH 64
+#define BENCH_BOT_SPAWN_OFFSET 300.0f  /**< Distance of the spawn points from the bases, as for real players. */
+#define BENCH_BOT_AIM_SPREAD 40.0f     /**< Bots aim this far off their lane, up and down. */
+#define BENCH_MAX_SYSTEMS MAX_MANAGED_ENTITIES
+
+// --- Internal Structures ---
+
+/**
+ * @brief What a benchmark run simulates.
+ */
+typedef struct BenchScenario
+{
+  char name[BENCH_NAME_LENGTH];
+  int players;       /**< Bot players besides the server's own. */
+  int minion_waves;  /**< Extra minion waves spawned when the match starts. */
+  float attack_rate; /**< Attacks per second of every bot. */
+  int duration;      /**< Simulated seconds. */
+  int step_ms;       /**< Length of one tick in milliseconds. */
+  Uint64 seed;
+} BenchScenario;
+
+/**
+ * @brief A player slot driven by the benchmark instead of a client.
+ */
+typedef struct BenchBot
+{
+  Uint8 id;           /**< Player index (client ID) of the bot. */
+  bool team;
+  SDL_FPoint position;
+  float direction;    /**< +1 or -1 along the lane. */
+  float attack_debt;  /**< Attacks owed at the scenario's rate; one is fired per whole unit. */
+} BenchBot;
+
+// --- Static Variables ---
+
+static SDL_AtomicInt bench_allocations;
+static SDL_malloc_func original_malloc;
+static SDL_calloc_func original_calloc;
+static SDL_realloc_func original_realloc;
+static SDL_free_func original_free;
+
+// --- Static Helper Functions ---
+
+static void *SDLCALL counting_malloc(size_t size)
+{
+  SDL_AddAtomicInt(&bench_allocations, 1);
+  return original_malloc(size);
+}
+
+static void *SDLCALL counting_calloc(size_t nmemb, size_t size)
+{
+  SDL_AddAtomicInt(&bench_allocations, 1);
+  return original_calloc(nmemb, size);
+}
+
+static void *SDLCALL counting_realloc(void *mem, size_t size)
+{
+  SDL_AddAtomicInt(&bench_allocations, 1);
+  return original_realloc(mem, size);
+}
+
+/**
+ * @brief Routes SDL_malloc and friends through counters. Must run before anything is allocated.
+ */
+static bool install_allocation_counter(void)
+{
+  SDL_GetOriginalMemoryFunctions(&original_malloc, &original_calloc, &original_realloc, &original_free);
+  return SDL_SetMemoryFunctions(counting_malloc, counting_calloc, counting_realloc, original_free);
+}
+
+static char *trim(char *text)
+{
+  while (*text == ' ' || *text == '\t')
+    text++;
+  char *end = text + SDL_strlen(text);
+  while (end > text && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+    *--end = '\0';
+  return text;
+}
+
+/**
+ * @brief Copies a label, keeping only characters that need no escaping in JSON.
+ */
+static void set_name(BenchScenario *scenario, const char *name)
+{
+  size_t n = 0;
+  for (; *name && n + 1 < sizeof(scenario->name); ++name)
+  {
+    if (SDL_isalnum(*name) || *name == '_' || *name == '-' || *name == '.')
+      scenario->name[n++] = *name;
+  }
+  scenario->name[n] = '\0';
+}
+
+/**
+ * @brief Reads a scenario file over the defaults already in scenario.
+ * @return True on success, false if the file cannot be read or has an unknown key.
+ */
+static bool load_scenario(const char *path, BenchScenario *scenario)
+{
+  char *text = (char *)SDL_LoadFile(path, NULL);
+  if (!text)
+    return false;
+
+  // Default label: the file name without directory and extension.
+  const char *base = SDL_strrchr(path, '/') ? SDL_strrchr(path, '/') + 1 : path;
+  char label[BENCH_NAME_LENGTH];
+  SDL_strlcpy(label, base, sizeof(label));
+  char *dot = SDL_strrchr(label, '.');
+  if (dot)
+    *dot = '\0';
+  set_name(scenario, label);
+
+  bool ok = true;
+  char *saveptr = NULL;
+  for (char *line = SDL_strtok_r(text, "\n", &saveptr); line && ok; line = SDL_strtok_r(NULL, "\n", &saveptr))
+  {
+    char *comment = SDL_strchr(line, '#');
+    if (comment)
+      *comment = '\0';
+    char *equals = SDL_strchr(line, '=');
+    if (!equals)
+    {
+      if (*trim(line))
+        ok = SDL_SetError("%s: expected 'key = value', got '%s'", path, trim(line));
+      continue;
+    }
+    *equals = '\0';
+    const char *key = trim(line);
+    const char *value = trim(equals + 1);
+
+    if (!SDL_strcmp(key, "name"))
+      set_name(scenario, value);
+    else if (!SDL_strcmp(key, "players"))
+      scenario->players = SDL_atoi(value);
+    else if (!SDL_strcmp(key, "minion_waves"))
+      scenario->minion_waves = SDL_atoi(value);
+    else if (!SDL_strcmp(key, "attack_rate"))
+      scenario->attack_rate = (float)SDL_atof(value);
+    else if (!SDL_strcmp(key, "duration"))
+      scenario->duration = SDL_atoi(value);
+    else if (!SDL_strcmp(key, "step_ms"))
+      scenario->step_ms = SDL_atoi(value);
+    else if (!SDL_strcmp(key, "seed"))
+      scenario->seed = SDL_strtoull(value, NULL, 0);
+    else
+      ok = SDL_SetError("%s: unknown key '%s'", path, key);
+  }
+  SDL_free(text);
+  return ok;
+}
+
+/**
+ * @brief Creates the headless server with all game modules.
+ * @return The state, or NULL on failure.
+ */
+static AppState *create_server(SimClock clock, const BenchScenario *scenario, int job_workers)
+{
+  AppState *state = (AppState *)SDL_calloc(1, sizeof(AppState));
+  if (!state)
+  {
+    SDL_OutOfMemory();
+    return NULL;
+  }
+  state->is_server = true;
+  state->team = BLUE_TEAM;
+  state->headless = true;
+  state->shm_name = BENCH_SHM_NAME;
+  state->clock = clock;
+  state->currentGameState = GAME_STATE_LOBBY;
+  state->job_workers = job_workers;
+  state->sim_step = (float)scenario->step_ms / 1000.0f;
+  SimRng_SeedStreams(state->rng, scenario->seed);
+  SimTuning_SetDefaults(&state->tuning);
+
+  const char *failed_stage = AppSetup_InitModules(state, DEFAULT_HOSTNAME);
+  if (failed_stage)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] Initialization failed at stage '%s': %s", failed_stage, SDL_GetError());
+    AppSetup_DestroyModules(state);
+    SDL_free(state);
+    return NULL;
+  }
+  return state;
+}
+
+static SDL_FPoint spawn_point(bool team)
+{
+  return team ? (SDL_FPoint){BASE_RED_POS_X + BENCH_BOT_SPAWN_OFFSET, BUILDINGS_POS_Y}
+              : (SDL_FPoint){BASE_BLUE_POS_X - BENCH_BOT_SPAWN_OFFSET, BUILDINGS_POS_Y};
+}
+
+/**
+ * @brief Moves a bot one tick along its lane and fires the attacks it owes.
+ * Bots walk from their spawn point to the enemy's and back, through both teams' towers.
+ */
+static void drive_bot(AppState *state, BenchBot *bot, const BenchScenario *scenario, SimRng *rng)
+{
+  float dt = (float)scenario->step_ms / 1000.0f;
+  float left = spawn_point(RED_TEAM).x;
+  float right = spawn_point(BLUE_TEAM).x;
+  bot->position.x += bot->direction * PLAYER_SPEED * dt;
+  if (bot->position.x >= right)
+    bot->direction = -1.0f;
+  else if (bot->position.x <= left)
+    bot->direction = 1.0f;
+
+  Msg_PlayerStateData player = {0};
+  player.message_type = MSG_TYPE_C_PLAYER_STATE;
+  player.client_id = bot->id;
+  player.position = bot->position;
+  player.sprite_portion = (SDL_FRect){0.0f, PLAYER_SPRITE_WALK_ROW_Y, PLAYER_SPRITE_FRAME_WIDTH, PLAYER_SPRITE_FRAME_HEIGHT};
+  player.flip_mode = bot->direction < 0.0f ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+  player.team = bot->team;
+  player.current_health = PLAYER_HEALTH_MAX;
+  PlayerManager_UpdateRemotePlayer(state, &player);
+
+  const PlayerInstance *p = &state->player_manager->players[bot->id];
+  bot->attack_debt += scenario->attack_rate * dt;
+  for (; bot->attack_debt >= 1.0f; bot->attack_debt -= 1.0f)
+  {
+    if (p->dead)
+      continue;
+    float ahead = bot->direction * PLAYER_ATTACK_RANGE * (0.5f + 0.5f * SimRng_Float(rng));
+    float spread = (SimRng_Float(rng) * 2.0f - 1.0f) * BENCH_BOT_AIM_SPREAD;
+    Msg_ClientSpawnAttackData attack = {0};
+    attack.message_type = MSG_TYPE_C_SPAWN_ATTACK;
+    attack.attack_type = PLAYER_ATTACK_TYPE_FIREBALL;
+    attack.target_pos = (SDL_FPoint){bot->position.x + ahead, bot->position.y + spread};
+    attack.team = bot->team;
+    AttackManager_HandleClientSpawnRequest(state->attack_manager, state, bot->id, attack);
+  }
+}
+
+static int compare_ticks(const void *a, const void *b)
+{
+  Uint64 x = *(const Uint64 *)a;
+  Uint64 y = *(const Uint64 *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Nearest-rank percentile of sorted tick times, in microseconds.
+ */
+static double percentile_us(const Uint64 *sorted, int count, double p)
+{
+  int rank = (int)SDL_ceil(p * count);
+  return (double)sorted[SDL_clamp(rank, 1, count) - 1] / 1e3;
+}
+
+static const char *phase_name(EntityPhase phase)
+{
+  switch (phase)
+  {
+  case ENTITY_PHASE_INPUT:
+    return "input";
+  case ENTITY_PHASE_NETWORK_IN:
+    return "network_in";
+  case ENTITY_PHASE_SIMULATE:
+    return "simulate";
+  case ENTITY_PHASE_POST_SIM:
+    return "post_sim";
+  case ENTITY_PHASE_NETWORK_OUT:
+    return "network_out";
+  default:
+    return "render";
+  }
+}
+
+/**
+ * @brief Prints the results as one JSON object on stdout.
+ */
+static void report_json(AppState *state, const BenchScenario *scenario, int job_workers,
+                        const Uint64 *sorted, int ticks, Uint64 total_ns, int allocations, Uint64 minion_sum, int minion_max)
+{
+  double mean_us = (double)total_ns / ticks / 1e3;
+  printf("{\n");
+  printf("  \"scenario\": \"%s\",\n", scenario->name);
+  printf("  \"players\": %d,\n  \"minion_waves\": %d,\n  \"attack_rate\": %.3f,\n", scenario->players, scenario->minion_waves, scenario->attack_rate);
+  printf("  \"step_ms\": %d,\n  \"jobs\": %d,\n  \"math_backend\": \"%s\",\n", scenario->step_ms, job_workers, SimMath_GetBackendName());
+  printf("  \"ticks\": %d,\n  \"wall_ms\": %.3f,\n  \"ticks_per_sec\": %.1f,\n", ticks, (double)total_ns / 1e6, ticks / ((double)total_ns / 1e9));
+  printf("  \"tick_us\": {\"mean\": %.3f, \"p50\": %.3f, \"p99\": %.3f, \"p999\": %.3f, \"max\": %.3f},\n", mean_us,
+         percentile_us(sorted, ticks, 0.50), percentile_us(sorted, ticks, 0.99), percentile_us(sorted, ticks, 0.999),
+         (double)sorted[ticks - 1] / 1e3);
+  printf("  \"allocations\": {\"total\": %d, \"per_tick\": %.3f},\n", allocations, (double)allocations / ticks);
+  printf("  \"minions\": {\"mean\": %.1f, \"max\": %d},\n", (double)minion_sum / ticks, minion_max);
+
+  EntityProfile profile[BENCH_MAX_SYSTEMS];
+  int systems = EntityManager_GetProfile(state->entity_manager, profile, BENCH_MAX_SYSTEMS);
+  Uint64 phase_ns[ENTITY_PHASE_COUNT] = {0};
+  printf("  \"systems\": [");
+  bool first = true;
+  for (int i = 0; i < systems; ++i)
+  {
+    if (profile[i].calls == 0)
+      continue;
+    const EntityFunctions *funcs = EntityManager_FindDefinition(state->entity_manager, profile[i].name);
+    phase_ns[funcs->update_phase] += profile[i].time_ns;
+    printf("%s\n    {\"name\": \"%s\", \"phase\": \"%s\", \"total_ms\": %.3f, \"us_per_tick\": %.3f, \"calls\": %llu}",
+           first ? "" : ",", profile[i].name, phase_name(funcs->update_phase), (double)profile[i].time_ns / 1e6,
+           (double)profile[i].time_ns / ticks / 1e3, (unsigned long long)profile[i].calls);
+    first = false;
+  }
+  printf("\n  ],\n  \"phases_us_per_tick\": {");
+  for (int phase = 0; phase < ENTITY_FIRST_RENDER_PHASE; ++phase)
+    printf("%s\"%s\": %.3f", phase ? ", " : "", phase_name((EntityPhase)phase), (double)phase_ns[phase] / ticks / 1e3);
+  printf("},\n");
+  printf("  \"end\": {\"game_state\": %d, \"minions\": %d}\n", (int)state->currentGameState,
+         SlotMap_GetCount(state->minion_manager->slots));
+  printf("}\n");
+  fflush(stdout);
+}
+
+// --- Entry Point ---
+
+int main(int argc, char **argv)
+{
+  // Before SDL allocates anything, so every free goes to the allocator that made the block.
+  if (!install_allocation_counter())
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] Could not install the allocation counter: %s", SDL_GetError());
+    return 1;
+  }
+
+  BenchScenario scenario = {"default", 3, 0, 1.0f, 60, 16, 1};
+  const char *scenario_path = NULL;
+  int job_workers = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!strcmp(argv[i], "--scenario") && (i + 1 < argc))
+    {
+      scenario_path = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--jobs") && (i + 1 < argc))
+    {
+      job_workers = SDL_atoi(argv[++i]);
+    }
+  }
+  if (scenario_path && !load_scenario(scenario_path, &scenario))
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] Scenario '%s': %s", scenario_path, SDL_GetError());
+    return 1;
+  }
+  // The server's own player occupies one slot.
+  scenario.players = CLAMP(scenario.players, 0, MAX_CLIENTS - 1);
+  scenario.minion_waves = SDL_max(scenario.minion_waves, 0);
+  scenario.attack_rate = SDL_max(scenario.attack_rate, 0.0f);
+  scenario.duration = SDL_max(scenario.duration, 1);
+  scenario.step_ms = CLAMP(scenario.step_ms, 1, 100);
+  job_workers = CLAMP(job_workers, 0, JOB_SYSTEM_MAX_WORKERS);
+
+  if (!SDL_Init(0) || !SDLNet_Init())
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] SDL initialization failed: %s", SDL_GetError());
+    return 1;
+  }
+
+  int result = 1;
+  int ticks = scenario.duration * 1000 / scenario.step_ms;
+  SimClock clock = SimClock_CreateVirtual(BENCH_START_TIME_MS);
+  AppState *state = clock ? create_server(clock, &scenario, job_workers) : NULL;
+  Uint64 *tick_ns = (Uint64 *)SDL_malloc((size_t)ticks * sizeof(Uint64));
+  if (!state || !tick_ns)
+    goto done;
+
+  // --- Lobby: wait for the server's own client, then start the match ---
+  Uint64 lobby_deadline = SimClock_GetTicks(clock) + BENCH_CONNECT_TIMEOUT_MS;
+  while (!NetClient_IsConnected(state->net_client_state) || NetClient_GetClientID(state->net_client_state) < 0)
+  {
+    if (SimClock_GetTicks(clock) >= lobby_deadline)
+    {
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Bench] The server's client did not connect within %d ms of simulated time.", BENCH_CONNECT_TIMEOUT_MS);
+      goto done;
+    }
+    SimClock_Advance(clock, (Uint64)scenario.step_ms);
+    app_update(state);
+  }
+  NetServer_StartMatch(state);
+  while (state->currentGameState != GAME_STATE_PLAYING)
+  {
+    SimClock_Advance(clock, (Uint64)scenario.step_ms);
+    app_update(state);
+  }
+
+  // --- Scenario Setup ---
+  SimRng bot_rng;
+  SimRng_Seed(&bot_rng, scenario.seed, SIM_RNG_STREAM_COUNT);
+  BenchBot bots[MAX_CLIENTS];
+  int local_id = NetClient_GetClientID(state->net_client_state);
+  int bot_count = 0;
+  for (int id = 0; id < MAX_CLIENTS && bot_count < scenario.players; ++id)
+  {
+    if (id == local_id)
+      continue;
+    bool team = (bot_count % 2 == 0) ? RED_TEAM : BLUE_TEAM;
+    bots[bot_count++] = (BenchBot){(Uint8)id, team, spawn_point(team), team ? 1.0f : -1.0f, 0.0f};
+  }
+  int extra_minions = SDL_min(scenario.minion_waves * MINION_WAVE_AMOUNT, MINION_MAX_AMOUNT / 2);
+  for (int i = 0; i < extra_minions; ++i)
+  {
+    MinionManager_ApplySpawn(state, BLUE_TEAM);
+    MinionManager_ApplySpawn(state, RED_TEAM);
+  }
+
+  // --- Measured Ticks ---
+  EntityManager_SetProfiling(state->entity_manager, true);
+  int allocations_start = SDL_GetAtomicInt(&bench_allocations);
+  Uint64 total_ns = 0;
+  Uint64 minion_sum = 0;
+  int minion_max = 0;
+  for (int t = 0; t < ticks; ++t)
+  {
+    for (int b = 0; b < bot_count; ++b)
+      drive_bot(state, &bots[b], &scenario, &bot_rng);
+    SimClock_Advance(clock, (Uint64)scenario.step_ms);
+
+    Uint64 start = SDL_GetTicksNS();
+    app_simulate_step(state, SimClock_GetTicks(clock));
+    tick_ns[t] = SDL_GetTicksNS() - start;
+    total_ns += tick_ns[t];
+
+    int minions = SlotMap_GetCount(state->minion_manager->slots);
+    minion_sum += (Uint64)minions;
+    minion_max = SDL_max(minion_max, minions);
+  }
+  int allocations = SDL_GetAtomicInt(&bench_allocations) - allocations_start;
+  EntityManager_SetProfiling(state->entity_manager, false);
+
+  SDL_qsort(tick_ns, (size_t)ticks, sizeof(Uint64), compare_ticks);
+  report_json(state, &scenario, job_workers, tick_ns, ticks, total_ns, allocations, minion_sum, minion_max);
+  result = 0;
+
+done:
+  SDL_free(tick_ns);
+  if (state)
+  {
+    AppSetup_DestroyModules(state);
+    SDL_free(state);
+  }
+  SimClock_Destroy(clock);
+  SDLNet_Quit();
+  SDL_Quit();
+  return result;
+}
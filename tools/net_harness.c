@@ -0,0 +1,339 @@
+/**
+ * @file net_harness.c
+ * @brief Runs one server and several clients in a single process on a shared virtual clock.
+ *
+ * Every AppState is headless (offscreen software renderer, no input) and attaches to the
+ * process-local shared-memory segment "@harness", so the whole match is driven by
+ * SimClock_Advance and runs as fast as the CPU allows. The same arguments always
+ * produce the same sequence of frames, whatever the number of server job workers.
+ * With --tcp the instances connect over the loopback TCP port instead, which checks the
+ * stream framing; frames then also depend on when the kernel delivers the bytes.
+ * --minion-waves spawns extra waves when the match starts, so the minion state snapshots
+ * span many messages.
+ * At the end the server's world is saved and restored to time World_Save and World_Restore,
+ * and every client must have received each message whole.
+ *
+ * Usage: harness [--clients N] [--seconds S] [--step MS] [--jobs N] [--tcp] [--minion-waves N]
+ */
+
+#include "../include/setup.h"
+#include "../include/update.h"
+#include "../include/world.h"
+
+// --- Constants ---
+#define HARNESS_SHM_NAME "@harness"
+#define HARNESS_DEFAULT_CLIENTS 3
+#define HARNESS_DEFAULT_SECONDS 600
+#define HARNESS_DEFAULT_STEP_MS 7
+#define HARNESS_CONNECT_TIMEOUT_MS 5000
+#define HARNESS_START_TIME_MS 1000
+#define HARNESS_OFFSCREEN_SIZE 64
+#define HARNESS_SNAPSHOT_ROUNDS 1000 /**< Saves and restores timed at the end of the match. */
+
+// --- Internal Structures ---
+
+/**
+ * @brief One simulated game instance and the offscreen surface it renders into.
+ */
+typedef struct HarnessInstance
+{
+  AppState *state;
+  SDL_Surface *target;
+} HarnessInstance;
+
+// --- Static Helper Functions ---
+
+/**
+ * @brief Creates a headless AppState with all game modules attached to the harness segment.
+ * @param job_workers Worker threads of the instance's JobSystem (0 keeps it on the calling thread).
+ * @param tcp Connect through the TCP port instead of the shared-memory segment.
+ * @return True on success, false on failure.
+ */
+static bool create_harness_instance(HarnessInstance *instance, SimClock clock, bool is_server, bool team, int job_workers, bool tcp)
+{
+  AppState *state = (AppState *)SDL_calloc(1, sizeof(AppState));
+  if (!state)
+  {
+    SDL_OutOfMemory();
+    return false;
+  }
+  state->is_server = is_server;
+  state->team = team;
+  state->headless = true;
+  state->shm_name = tcp ? NULL : HARNESS_SHM_NAME;
+  state->clock = clock;
+  state->currentGameState = GAME_STATE_LOBBY;
+  state->job_workers = job_workers;
+  SimRng_SeedStreams(state->rng, SIM_RNG_DEFAULT_SEED);
+  SimTuning_SetDefaults(&state->tuning);
+
+  // Textures are still loaded, so give every state an offscreen target instead of a window.
+  SDL_Surface *target = SDL_CreateSurface(HARNESS_OFFSCREEN_SIZE, HARNESS_OFFSCREEN_SIZE, SDL_PIXELFORMAT_RGBA8888);
+  state->renderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+  if (!state->renderer)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Harness] Offscreen renderer failed: %s", SDL_GetError());
+    SDL_DestroySurface(target);
+    SDL_free(state);
+    return false;
+  }
+
+  const char *failed_stage = AppSetup_InitModules(state, DEFAULT_HOSTNAME);
+  if (failed_stage)
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Harness] Initialization failed at stage '%s': %s", failed_stage, SDL_GetError());
+    AppSetup_DestroyModules(state);
+    SDL_DestroyRenderer(state->renderer);
+    SDL_DestroySurface(target);
+    SDL_free(state);
+    return false;
+  }
+
+  instance->state = state;
+  instance->target = target;
+  return true;
+}
+
+static void destroy_harness_instance(HarnessInstance *instance)
+{
+  if (!instance->state)
+    return;
+  AppSetup_DestroyModules(instance->state);
+  SDL_DestroyRenderer(instance->state->renderer);
+  SDL_DestroySurface(instance->target);
+  SDL_free(instance->state);
+  instance->state = NULL;
+}
+
+/**
+ * @brief Advances the shared clock by one step and runs one frame of every state.
+ * The server goes first so clients see its messages in the same step.
+ */
+static void step_all(SimClock clock, HarnessInstance *instances, int count, Uint64 step_ms)
+{
+  SimClock_Advance(clock, step_ms);
+  for (int i = 0; i < count; ++i)
+  {
+    app_update(instances[i].state);
+  }
+}
+
+static bool all_clients_connected(const HarnessInstance *instances, int count)
+{
+  for (int i = 0; i < count; ++i)
+  {
+    NetClientState nc = instances[i].state->net_client_state;
+    if (!NetClient_IsConnected(nc) || NetClient_GetClientID(nc) < 0)
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Compares a client's replicated minions against the server's.
+ * @param out_max_error Receives the largest position error in pixels.
+ * @return Number of server minions the client lacks (or holds in another slot), plus any extra client minions.
+ */
+static int compare_minions(MinionManager server, MinionManager client, float *out_max_error)
+{
+  int mismatched = 0;
+  int matched = 0;
+  float max_error = 0.0f;
+  for (int n = 0; n < SlotMap_GetCount(server->slots); ++n)
+  {
+    int i = SlotMap_GetSlotAt(server->slots, n);
+    if (SlotMap_Resolve(client->slots, server->minions[i].handle) != i)
+    {
+      mismatched++;
+      continue;
+    }
+    matched++;
+    SDL_FPoint server_pos, client_pos;
+    if (!MinionManager_GetMinionPosition(server, i, &server_pos) || !MinionManager_GetMinionPosition(client, i, &client_pos))
+    {
+      mismatched++;
+      continue;
+    }
+    float dx = server_pos.x - client_pos.x;
+    float dy = server_pos.y - client_pos.y;
+    max_error = SDL_max(max_error, SDL_sqrtf(dx * dx + dy * dy));
+  }
+  *out_max_error = max_error;
+  return mismatched + (SlotMap_GetCount(client->slots) - matched);
+}
+
+/**
+ * @brief Counts the messages a client rejected, e.g. because a read ended inside a message.
+ */
+static Uint32 count_dropped_messages(NetClientState nc)
+{
+  const NetMessageStats *stats = NetClient_GetMessageStats(nc);
+  Uint32 dropped = 0;
+  for (int i = 0; stats && i < NET_MESSAGE_TYPE_COUNT; ++i)
+    dropped += stats[i].dropped;
+  return dropped;
+}
+
+/**
+ * @brief Times World_Save and World_Restore on a state and checks that saving again
+ * after a restore gives the same bytes.
+ * @return True if every call succeeded and the round trip matched.
+ */
+static bool check_world_snapshot(AppState *state)
+{
+  WorldSnapshot *snapshots[2] = {NULL, NULL};
+  bool ok = true;
+  Uint64 start = SDL_GetTicksNS();
+  for (int i = 0; ok && i < HARNESS_SNAPSHOT_ROUNDS; ++i)
+    ok = World_Save(state, &snapshots[0]);
+  Uint64 save_ns = SDL_GetTicksNS() - start;
+
+  start = SDL_GetTicksNS();
+  for (int i = 0; ok && i < HARNESS_SNAPSHOT_ROUNDS; ++i)
+    ok = World_Restore(state, snapshots[0]);
+  Uint64 restore_ns = SDL_GetTicksNS() - start;
+
+  if (!ok)
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Harness] World snapshot failed: %s", SDL_GetError());
+  bool matched = ok && World_Save(state, &snapshots[1]) && snapshots[0]->size == snapshots[1]->size &&
+                 !memcmp(snapshots[0], snapshots[1], (size_t)snapshots[0]->size);
+  SDL_Log("[Harness] World snapshot: %u bytes, save %.2f us, restore %.2f us, round trip %s.",
+          ok ? (unsigned int)snapshots[0]->size : 0u, (double)save_ns / HARNESS_SNAPSHOT_ROUNDS / 1e3,
+          (double)restore_ns / HARNESS_SNAPSHOT_ROUNDS / 1e3, matched ? "identical" : "DIFFERENT");
+  World_DestroySnapshot(snapshots[0]);
+  World_DestroySnapshot(snapshots[1]);
+  return matched;
+}
+
+// --- Entry Point ---
+
+int main(int argc, char **argv)
+{
+  int client_count = HARNESS_DEFAULT_CLIENTS;
+  int seconds = HARNESS_DEFAULT_SECONDS;
+  int step_ms = HARNESS_DEFAULT_STEP_MS;
+  int job_workers = 0;
+  int minion_waves = 0;
+  bool tcp = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!strcmp(argv[i], "--clients") && (i + 1 < argc))
+    {
+      client_count = SDL_atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--seconds") && (i + 1 < argc))
+    {
+      seconds = SDL_atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--step") && (i + 1 < argc))
+    {
+      step_ms = SDL_atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--jobs") && (i + 1 < argc))
+    {
+      job_workers = SDL_atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--minion-waves") && (i + 1 < argc))
+    {
+      minion_waves = SDL_atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--tcp"))
+    {
+      tcp = true;
+    }
+  }
+  // The server's own client occupies one slot.
+  client_count = CLAMP(client_count, 0, MAX_CLIENTS - 1);
+  seconds = SDL_max(seconds, 1);
+  step_ms = CLAMP(step_ms, 1, 100);
+  job_workers = CLAMP(job_workers, 0, JOB_SYSTEM_MAX_WORKERS);
+  minion_waves = CLAMP(minion_waves, 0, MINION_MAX_AMOUNT / (2 * MINION_WAVE_AMOUNT));
+
+  if (!SDL_Init(0) || !SDLNet_Init())
+  {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Harness] SDL initialization failed: %s", SDL_GetError());
+    return 1;
+  }
+
+  SimClock clock = SimClock_CreateVirtual(HARNESS_START_TIME_MS);
+  HarnessInstance instances[MAX_CLIENTS] = {0};
+  int instance_count = 0;
+  int result = 1;
+
+  if (!clock)
+    goto done;
+
+  // --- Create Server and Clients ---
+  // Only the server runs the parallel simulation; the clients stay single-threaded.
+  if (!create_harness_instance(&instances[instance_count], clock, true, BLUE_TEAM, job_workers, tcp))
+    goto done;
+  instance_count++;
+  for (int i = 0; i < client_count; ++i)
+  {
+    if (!create_harness_instance(&instances[instance_count], clock, false, (i % 2 == 0) ? RED_TEAM : BLUE_TEAM, 0, tcp))
+      goto done;
+    instance_count++;
+  }
+
+  Uint64 wall_start = SDL_GetTicksNS();
+
+  // --- Lobby: wait until every client is welcomed ---
+  Uint64 lobby_deadline = SimClock_GetTicks(clock) + HARNESS_CONNECT_TIMEOUT_MS;
+  while (!all_clients_connected(instances, instance_count))
+  {
+    if (SimClock_GetTicks(clock) >= lobby_deadline)
+    {
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "[Harness] Clients did not connect within %d ms of simulated time.", HARNESS_CONNECT_TIMEOUT_MS);
+      goto done;
+    }
+    step_all(clock, instances, instance_count, (Uint64)step_ms);
+  }
+
+  // --- Match ---
+  NetServer_StartMatch(instances[0].state);
+  for (int i = 0; i < minion_waves * MINION_WAVE_AMOUNT; ++i)
+  {
+    MinionManager_ApplySpawn(instances[0].state, BLUE_TEAM);
+    MinionManager_ApplySpawn(instances[0].state, RED_TEAM);
+  }
+  Uint64 match_end = SimClock_GetTicks(clock) + (Uint64)seconds * 1000;
+  Uint64 frames = 0;
+  while (SimClock_GetTicks(clock) < match_end)
+  {
+    step_all(clock, instances, instance_count, (Uint64)step_ms);
+    frames++;
+  }
+
+  // --- Report ---
+  double wall_ms = (double)(SDL_GetTicksNS() - wall_start) / 1e6;
+  SDL_Log("[Harness] Simulated %d s with %d client(s) over %s in %.1f ms of wall time (%.0fx real time, %llu frames of %d ms), %d minion(s) alive.",
+          seconds, instance_count - 1, tcp ? "TCP" : "shared memory", wall_ms, wall_ms > 0.0 ? (seconds * 1000.0) / wall_ms : 0.0,
+          (unsigned long long)frames, step_ms, SlotMap_GetCount(instances[0].state->minion_manager->slots));
+
+  result = check_world_snapshot(instances[0].state) ? 0 : 1;
+  for (int i = 1; i < instance_count; ++i)
+  {
+    AppState *client = instances[i].state;
+    float max_error = 0.0f;
+    int mismatched = compare_minions(instances[0].state->minion_manager, client->minion_manager, &max_error);
+    Uint32 dropped = count_dropped_messages(client->net_client_state);
+    SDL_Log("[Harness] Client %d (id %d): %s, %d minion slot(s) out of sync, max position error %.2f px, %u message(s) dropped.",
+            i, NetClient_GetClientID(client->net_client_state),
+            client->currentGameState == GAME_STATE_PLAYING ? "playing" : "not playing",
+            mismatched, max_error, (unsigned int)dropped);
+    if (client->currentGameState != GAME_STATE_PLAYING || dropped > 0)
+      result = 1;
+  }
+
+done:
+  // Clients release their slots before the server frees the local segment.
+  for (int i = instance_count - 1; i >= 0; --i)
+  {
+    destroy_harness_instance(&instances[i]);
+  }
+  SimClock_Destroy(clock);
+  SDLNet_Quit();
+  SDL_Quit();
+  return result;
+}